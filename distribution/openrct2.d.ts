@@ -188,11 +188,12 @@ declare global {
 
         /**
          * Shared generic storage for all plugins. Data is persistent across instances
-         * of OpenRCT2 and is stored externally as a single JSON file in the OpenRCT2
+         * of OpenRCT2 and is stored externally as a single file in the OpenRCT2
          * user directory. Internally it is a JavaScript object. Objects and arrays
          * are only copied by reference. The external file is only written when using
          * the `set` method, do not rely on the file being saved by modifying your own
-         * objects. Functions and other internal structures will not be persisted.
+         * objects. Changes made to them are written along with the next `set`.
+         * Functions and other internal structures will not be persisted.
          */
         readonly sharedStorage: Configuration;
 
@@ -203,8 +204,9 @@ declare global {
          * Any references to objects, or arrays are copied by reference. If these arrays, objects,
          * or any other arrays, or objects that they reference change without a subsequent call to
          * the `set` method, their new state will still be serialised.
-         * Keep in mind that all data here will be serialised every time the park is
-         * saved, including when the park is periodically saved automatically.
+         * Keep in mind that every object or array passed to `set` or returned by `get` or `getAll`
+         * will be serialised every time the park is saved, including when the park is periodically
+         * saved automatically. Other values are only serialised again after they are set.
          * @param pluginName The name of the plugin to get a store for. If undefined, the
          *                   current plugin's name will be used. Plugin names are case sensitive.
          */
@@ -272,6 +274,16 @@ declare global {
          */
         getIcon(iconName: IconName): number;
 
+        /**
+         * Runs the given script in a separate environment on a background thread. The script has no access to the game,
+         * it can only receive messages by setting the global onmessage function and reply with the global postMessage
+         * function. console.log is also available.
+         * Messages are copied at the end of each tick, typed arrays arrive as Uint8Array and functions as empty objects.
+         * The worker is terminated when the plugin stops.
+         * @param script The code to run.
+         */
+        createWorker(script: string): Worker;
+
         /**
          * Gets a random integer within the specified range using the game's pseudo-
          * random number generator. This is part of the game state and shared across
@@ -491,8 +503,11 @@ declare global {
          */
         subscribe(hook: HookType, callback: Function): IDisposable;
 
-        subscribe(hook: "action.query", callback: (e: GameActionEventArgs) => void): IDisposable;
-        subscribe(hook: "action.execute", callback: (e: GameActionEventArgs) => void): IDisposable;
+        /**
+         * The filter is checked before the callback is called, actions that do not match it cost nothing.
+         */
+        subscribe(hook: "action.query", callback: (e: GameActionEventArgs) => void, filter?: ActionHookFilter): IDisposable;
+        subscribe(hook: "action.execute", callback: (e: GameActionEventArgs) => void, filter?: ActionHookFilter): IDisposable;
         subscribe(hook: "interval.tick", callback: () => void): IDisposable;
         subscribe(hook: "interval.day", callback: () => void): IDisposable;
         subscribe(hook: "network.chat", callback: (e: NetworkChatEventArgs) => void): IDisposable;
@@ -1318,6 +1333,32 @@ declare global {
         height: number;
     }
 
+    /**
+     * Restricts which actions an action hook is called for, properties that are not set match every action.
+     */
+    interface ActionHookFilter {
+        /**
+         * The names of the actions, e.g. "ridecreate". Names that are not actions of the game are an error.
+         */
+        actions?: string[];
+        /**
+         * The identifiers of custom actions, see registerAction.
+         */
+        customActions?: string[];
+        /**
+         * The ids of the players that ran the action.
+         */
+        players?: number[];
+        /**
+         * Game command flags the action must all have.
+         */
+        flags?: number;
+        /**
+         * Game command flags the action must not have any of.
+         */
+        excludeFlags?: number;
+    }
+
     interface GameActionEventArgs<T = object> {
         readonly player: number;
         readonly type: number;
@@ -1446,6 +1487,25 @@ declare global {
         getAllEntitiesOnTile(type: "staff", tilePos: CoordsXY): Staff[];
         getAllEntitiesOnTile(type: "car", tilePos: CoordsXY): Car[];
         getAllEntitiesOnTile(type: "litter", tilePos: CoordsXY): Litter[];
+
+        /**
+         * Reads the given fields of all entities of a type in one call, without creating an object
+         * for each entity. Each field is returned as a typed array, with the same index for the same entity.
+         * Guest fields are 0 for entities that are not guests, energy is 0 for entities that are not peeps.
+         * @param type The type of entity, as for {@link getAllEntities}.
+         * @param fields The fields to read.
+         */
+        queryEntities(type: EntityType, fields: EntityQueryField[]): EntityQueryResult;
+
+        /**
+         * Reads the given fields of the surface of every tile in a range in one call.
+         * The range is clamped to the map, each field is returned as a typed array of
+         * width * height values ordered row by row.
+         * @param range The range of the map in coordinates, not tiles.
+         * @param fields The fields to read.
+         */
+        querySurfaces(range: MapRange, fields: SurfaceQueryField[]): SurfaceQueryResult;
+
         createEntity(type: EntityType, initializer: object): Entity;
 
         /**
@@ -1457,6 +1517,30 @@ declare global {
         getTrackIterator(location: CoordsXY, elementIndex: number): TrackIterator | null;
     }
 
+    type EntityQueryField =
+        "id" | "x" | "y" | "z" | "energy" | "happiness" | "nausea" | "hunger" | "thirst" | "toilet" | "cash";
+
+    type EntityQueryResult = {
+        readonly count: number;
+    } & {
+        readonly [field in EntityQueryField]?: Uint8Array | Uint16Array | Int32Array;
+    };
+
+    type SurfaceQueryField =
+        "baseHeight" | "waterHeight" | "slope" | "surfaceStyle" | "edgeStyle" | "grassLength" | "ownership" | "numElements";
+
+    type SurfaceQueryResult = {
+        /**
+         * The tile coordinates of the first value.
+         */
+        readonly x: number;
+        readonly y: number;
+        readonly width: number;
+        readonly height: number;
+    } & {
+        readonly [field in SurfaceQueryField]?: Uint8Array | Uint16Array;
+    };
+
     type TileElementType =
         "surface" | "footpath" | "track" | "small_scenery" | "wall" | "entrance" | "large_scenery" | "banner";
 
@@ -3350,6 +3434,84 @@ declare global {
          * The number of bytes sent for each category.
          */
         readonly bytesSent: number[];
+
+        /**
+         * Traffic broken down by network command, e.g. "tick" or "game_action".
+         * Only commands that have been sent or received are present.
+         */
+        readonly commands: { [command: string]: NetworkCommandStats };
+
+        /**
+         * Traffic of each connection. For a client this is the connection to the server.
+         */
+        readonly connections: NetworkConnectionStats[];
+    }
+
+    /**
+     * Traffic of a single network command.
+     */
+    interface NetworkCommandStats {
+        readonly bytesSent: number;
+        readonly bytesReceived: number;
+        readonly packetsSent: number;
+        readonly packetsReceived: number;
+    }
+
+    /**
+     * Traffic and latency of a single connection.
+     */
+    interface NetworkConnectionStats {
+        /**
+         * The player using the connection, absent until the player has joined.
+         */
+        readonly player?: { readonly id: number; readonly name: string };
+        readonly address: string;
+        readonly bytesSent: number;
+        readonly bytesReceived: number;
+
+        /**
+         * The number of packets waiting to be sent.
+         */
+        readonly queueDepth: number;
+
+        /**
+         * The highest number of packets that were waiting to be sent at once.
+         */
+        readonly queueHighWater: number;
+
+        /**
+         * The number of system calls used to write the sent packets.
+         */
+        readonly socketWrites: number;
+
+        /**
+         * The number of system calls saved by writing packets together rather than one at a time.
+         */
+        readonly syscallsSaved: number;
+
+        /**
+         * Round trip times in milliseconds measured by the server.
+         */
+        readonly rtt: NetworkRttHistogram;
+    }
+
+    /**
+     * Round trip times in milliseconds. Percentiles are the upper limit of the bucket they fall in.
+     */
+    interface NetworkRttHistogram {
+        readonly count: number;
+        readonly min: number;
+        readonly max: number;
+        readonly mean: number;
+        readonly p50: number;
+        readonly p95: number;
+        readonly p99: number;
+
+        /**
+         * Upper limit of each bucket. There is one more bucket for everything above the last limit.
+         */
+        readonly limits: number[];
+        readonly counts: number[];
     }
 
     type PermissionType =
@@ -4545,6 +4707,31 @@ declare global {
         off(event: "data", callback: (data: string) => void): Socket;
     }
 
+    /**
+     * A script running on a background thread, see {@link Context.createWorker}.
+     */
+    interface Worker {
+        /**
+         * Sends a message to the worker at the end of the tick.
+         */
+        postMessage(message: any): void;
+
+        /**
+         * Stops the worker, interrupting any script it is running. Messages it has not replied to are lost.
+         */
+        terminate(): void;
+
+        /**
+         * Handlers are called when the worker's replies arrive, which is not on the same tick for every player.
+         * The game state can therefore only be changed through game actions.
+         */
+        on(event: "message", callback: (message: any) => void): Worker;
+        on(event: "error", callback: (error: string) => void): Worker;
+
+        off(event: "message", callback: (message: any) => void): Worker;
+        off(event: "error", callback: (error: string) => void): Worker;
+    }
+
     interface TitleSequence {
         /**
          * The name of the title sequence.
@@ -4859,6 +5046,11 @@ declare global {
 
     interface Profiler {
         getData(): ProfiledFunction[];
+
+        /**
+         * Gets the time spent in the hooks of each plugin, reset by {@link reset}.
+         */
+        getPluginData(): ProfiledPlugin[];
         start(): void;
         stop(): void;
         reset(): void;
@@ -4875,6 +5067,60 @@ declare global {
         readonly children: number[];
     }
 
+    interface ProfiledPlugin {
+        readonly name: string;
+
+        /**
+         * Calls to the plugin's hooks, keyed by hook type, e.g. "interval.tick".
+         */
+        readonly hooks: { [hook: string]: ProfiledHook };
+
+        /**
+         * The number of ticks in which the plugin's hooks took longer than the soft budget.
+         */
+        readonly overBudgetTicks: number;
+
+        /**
+         * Whether the plugin's hooks are no longer called for going over the hard budget.
+         */
+        readonly suspended: boolean;
+
+        /**
+         * Script memory allocated while the plugin was running.
+         */
+        readonly memory: ProfiledMemory;
+    }
+
+    interface ProfiledMemory {
+        /**
+         * Bytes allocated by the plugin that have not been freed yet.
+         */
+        readonly liveBytes: number;
+        readonly peakBytes: number;
+        readonly allocations: number;
+        readonly allocatedBytes: number;
+
+        /**
+         * Allocations and bytes allocated per second, measured over the last second.
+         */
+        readonly allocationRate: number;
+        readonly allocatedBytesRate: number;
+
+        /**
+         * Allocations that failed because the plugin reached the configured memory limit.
+         */
+        readonly failedAllocations: number;
+    }
+
+    /**
+     * Times are in microseconds.
+     */
+    interface ProfiledHook {
+        readonly callCount: number;
+        readonly totalTime: number;
+        readonly maxTime: number;
+    }
+
     interface ObjectManager {
         /**
          * Gets all the objects that are installed and can be loaded into the park.
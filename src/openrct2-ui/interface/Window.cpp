@@ -274,6 +274,7 @@ WindowBase* WindowCreate(
     // Setup window
     w->classification = cls;
     w->flags = flags;
+    WindowListChanged();
 
     // Play sounds and flash the window
     if (!(flags & (WF_STICK_TO_BACK | WF_STICK_TO_FRONT)))
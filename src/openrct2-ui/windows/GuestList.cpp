@@ -18,6 +18,7 @@
 #include <openrct2/drawing/Drawing.h>
 #include <openrct2/entity/EntityRegistry.h>
 #include <openrct2/entity/Guest.h>
+#include <openrct2/entity/GuestAggregation.h>
 #include <openrct2/localisation/Formatter.h>
 #include <openrct2/localisation/Formatting.h>
 #include <openrct2/localisation/Localisation.h>
@@ -27,6 +28,7 @@
 #include <openrct2/util/Math.hpp>
 #include <openrct2/util/Util.h>
 #include <openrct2/world/Park.h>
+#include <unordered_set>
 #include <vector>
 
 namespace OpenRCT2::Ui::Windows
@@ -619,6 +621,9 @@ static Widget window_guest_list_widgets[] = {
             {
                 _guestList.clear();
 
+                auto& guestAggregation = GetGuestAggregation();
+                const auto filterKind = GetFilterAggregationKind();
+                const auto keysInFilter = GetAggregationKeysInFilter();
                 for (auto peep : EntityList<Guest>())
                 {
                     EntitySetFlashing(peep, false);
@@ -626,7 +631,7 @@ static Widget window_guest_list_widgets[] = {
                         continue;
                     if (_selectedFilter)
                     {
-                        if (!IsPeepInFilter(*peep))
+                        if (keysInFilter.count(guestAggregation.GetKey(filterKind, peep->Id)) == 0)
                             continue;
                         EntitySetFlashing(peep, true);
                     }
@@ -802,6 +807,32 @@ static Widget window_guest_list_widgets[] = {
             return true;
         }
 
+        GuestAggregationKind GetFilterAggregationKind() const
+        {
+            return _selectedFilter == GuestFilterType::Guests ? GuestAggregationKind::Action : GuestAggregationKind::Thought;
+        }
+
+        /**
+         * Guests with the same aggregation key are formatted the same way, so only one guest of each group has to be
+         * formatted to find which guests are in the filter.
+         */
+        std::unordered_set<GuestAggregation::Key> GetAggregationKeysInFilter()
+        {
+            std::unordered_set<GuestAggregation::Key> keys;
+            if (!_selectedFilter)
+                return keys;
+
+            for (const auto& aggregate : GetGuestAggregation().GetGroups(GetFilterAggregationKind()))
+            {
+                auto* peep = GetEntity<Guest>(aggregate.Guests.front());
+                if (peep != nullptr && IsPeepInFilter(*peep))
+                {
+                    keys.insert(aggregate.GroupKey);
+                }
+            }
+            return keys;
+        }
+
         bool IsPeepInFilter(const Guest& peep)
         {
             auto guestViewType = _selectedFilter == GuestFilterType::Guests ? GuestViewType::Actions : GuestViewType::Thoughts;
@@ -848,17 +879,25 @@ static Widget window_guest_list_widgets[] = {
             _lastFindGroupsWait = 320;
             _groups.clear();
 
-            for (auto peep : EntityList<Guest>())
+            // Guests without a fresh thought are not in any group, they would only end up in the empty group.
+            auto kind = _selectedView == GuestViewType::Actions ? GuestAggregationKind::Action : GuestAggregationKind::Thought;
+            for (const auto& aggregate : GetGuestAggregation().GetGroups(kind))
             {
-                if (peep->OutsideOfPark)
+                auto* representative = GetEntity<Guest>(aggregate.Guests.front());
+                if (representative == nullptr)
                     continue;
 
-                auto& group = FindOrAddGroup(GetArgumentsFromPeep(*peep, _selectedView));
-                if (group.NumGuests < std::size(group.Faces))
+                // Different keys can still format the same way, e.g. rides with the same name.
+                auto& group = FindOrAddGroup(GetArgumentsFromPeep(*representative, _selectedView));
+                for (auto id : aggregate.Guests)
                 {
-                    group.Faces[group.NumGuests] = GetPeepFaceSpriteSmall(peep) - SPR_PEEP_SMALL_FACE_VERY_VERY_UNHAPPY;
+                    auto* peep = GetEntity<Guest>(id);
+                    if (peep != nullptr && group.NumGuests < std::size(group.Faces))
+                    {
+                        group.Faces[group.NumGuests] = GetPeepFaceSpriteSmall(peep) - SPR_PEEP_SMALL_FACE_VERY_VERY_UNHAPPY;
+                    }
+                    group.NumGuests++;
                 }
-                group.NumGuests++;
             }
 
             // Remove empty group (basically guests with no thoughts)
@@ -24,6 +24,8 @@
 #include <openrct2/actions/PeepSpawnPlaceAction.h>
 #include <openrct2/actions/SurfaceSetStyleAction.h>
 #include <openrct2/audio/audio.h>
+#include <openrct2/config/Config.h>
+#include <openrct2/core/JobPool.h>
 #include <openrct2/entity/EntityList.h>
 #include <openrct2/entity/EntityRegistry.h>
 #include <openrct2/entity/Staff.h>
@@ -38,6 +40,8 @@
 #include <openrct2/world/Footpath.h>
 #include <openrct2/world/Scenery.h>
 #include <openrct2/world/Surface.h>
+#include <openrct2/world/TileChangeJournal.h>
+#include <memory>
 #include <vector>
 
 namespace OpenRCT2::Ui::Windows
@@ -188,10 +192,11 @@ static constexpr ScreenCoordsXY MiniMapOffsets[] = {
     {
         uint8_t _rotation;
         uint8_t _activeTool;
-        uint32_t _currentLine;
         uint16_t _landRightsToolSize;
         int32_t _firstColumnWidth;
         std::vector<uint8_t> _mapImageData;
+        std::vector<TileCoordsXY> _changedTiles;
+        std::unique_ptr<JobPool> _mapPixelJobs;
         bool _mapWidthAndHeightLinked{ true };
         bool _recalculateScrollbars = false;
         enum class ResizeDirection
@@ -243,6 +248,7 @@ static constexpr ScreenCoordsXY MiniMapOffsets[] = {
         {
             _mapImageData.clear();
             _mapImageData.shrink_to_fit();
+            _mapPixelJobs.reset();
             if ((InputTestFlag(INPUT_FLAG_TOOL_ACTIVE)) && gCurrentToolWidget.window_classification == classification
                 && gCurrentToolWidget.window_number == number)
             {
@@ -346,6 +352,7 @@ static constexpr ScreenCoordsXY MiniMapOffsets[] = {
                         selected_tab = widgetIndex;
                         list_information_type = 0;
                         _recalculateScrollbars = true;
+                        SetAllMapPixels();
                     }
             }
         }
@@ -394,8 +401,7 @@ static constexpr ScreenCoordsXY MiniMapOffsets[] = {
                 CentreMapOnViewPoint();
             }
 
-            for (int32_t i = 0; i < 16; i++)
-                SetMapPixels();
+            UpdateMapPixels();
 
             Invalidate();
 
@@ -994,7 +1000,7 @@ static constexpr ScreenCoordsXY MiniMapOffsets[] = {
         void InitMap()
         {
             std::fill(_mapImageData.begin(), _mapImageData.end(), PALETTE_INDEX_10);
-            _currentLine = 0;
+            SetAllMapPixels();
         }
 
         void CentreMapOnViewPoint()
@@ -1065,68 +1071,131 @@ static constexpr ScreenCoordsXY MiniMapOffsets[] = {
             GameActions::Execute(&decreaseMapSizeAction);
         }
 
-        void SetMapPixels()
+        /**
+         * The map image is drawn in lines of tiles, each running diagonally down to the right across the image with every
+         * tile two pixels wide. Which tiles make up a line depends on the rotation.
+         */
+        static TileCoordsXY GetLineTile(uint8_t rotation, int32_t line, int32_t index)
         {
-            int32_t x = 0, y = 0, dx = 0, dy = 0;
+            constexpr int32_t last = MAXIMUM_MAP_SIZE_TECHNICAL - 1;
+            switch (rotation)
+            {
+                case 0:
+                    return { line, index };
+                case 1:
+                    return { last - index, line };
+                case 2:
+                    return { last - line, last - index };
+                default:
+                    return { index, last - line };
+            }
+        }
 
-            int32_t pos = (_currentLine * (MAP_WINDOW_MAP_SIZE - 1)) + MAXIMUM_MAP_SIZE_TECHNICAL - 1;
-            auto destinationPosition = ScreenCoordsXY{ pos % MAP_WINDOW_MAP_SIZE, pos / MAP_WINDOW_MAP_SIZE };
-            auto destination = _mapImageData.data() + (destinationPosition.y * MAP_WINDOW_MAP_SIZE) + destinationPosition.x;
-            switch (GetCurrentRotation())
+        static std::pair<int32_t, int32_t> GetTileLine(uint8_t rotation, const TileCoordsXY& tile)
+        {
+            constexpr int32_t last = MAXIMUM_MAP_SIZE_TECHNICAL - 1;
+            switch (rotation)
             {
                 case 0:
-                    x = _currentLine * COORDS_XY_STEP;
-                    y = 0;
-                    dx = 0;
-                    dy = COORDS_XY_STEP;
-                    break;
+                    return { tile.x, tile.y };
                 case 1:
-                    x = MAXIMUM_TILE_START_XY;
-                    y = _currentLine * COORDS_XY_STEP;
-                    dx = -COORDS_XY_STEP;
-                    dy = 0;
-                    break;
+                    return { tile.y, last - tile.x };
                 case 2:
-                    x = MAXIMUM_MAP_SIZE_BIG - ((_currentLine + 1) * COORDS_XY_STEP);
-                    y = MAXIMUM_TILE_START_XY;
-                    dx = 0;
-                    dy = -COORDS_XY_STEP;
+                    return { last - tile.x, last - tile.y };
+                default:
+                    return { last - tile.y, tile.x };
+            }
+        }
+
+        static size_t GetPixelOffset(int32_t line, int32_t index)
+        {
+            const int32_t pos = (line * (MAP_WINDOW_MAP_SIZE - 1)) + MAXIMUM_MAP_SIZE_TECHNICAL - 1;
+            const int32_t x = (pos % MAP_WINDOW_MAP_SIZE) + index;
+            const int32_t y = (pos / MAP_WINDOW_MAP_SIZE) + index;
+            return (static_cast<size_t>(y) * MAP_WINDOW_MAP_SIZE) + x;
+        }
+
+        void SetMapPixel(uint8_t rotation, int32_t line, int32_t index)
+        {
+            const auto coords = GetLineTile(rotation, line, index).ToCoordsXY();
+            if (MapIsEdge(coords))
+                return;
+
+            uint16_t colour = 0;
+            switch (selected_tab)
+            {
+                case PAGE_PEEPS:
+                    colour = GetPixelColourPeep(coords);
                     break;
-                case 3:
-                    x = 0;
-                    y = MAXIMUM_MAP_SIZE_BIG - ((_currentLine + 1) * COORDS_XY_STEP);
-                    dx = COORDS_XY_STEP;
-                    dy = 0;
+                case PAGE_RIDES:
+                    colour = GetPixelColourRide(coords);
                     break;
             }
+            auto destination = _mapImageData.data() + GetPixelOffset(line, index);
+            destination[0] = (colour >> 8) & 0xFF;
+            destination[1] = colour;
+        }
 
+        void SetMapLinePixels(uint8_t rotation, int32_t line)
+        {
             for (int32_t i = 0; i < MAXIMUM_MAP_SIZE_TECHNICAL; i++)
             {
-                if (!MapIsEdge({ x, y }))
+                SetMapPixel(rotation, line, i);
+            }
+        }
+
+        /**
+         * Colours every tile again, split over the job pool when multithreading is enabled. Lines are drawn to pixels of
+         * their own, and the game state is not changed until the jobs are done.
+         */
+        void SetAllMapPixels()
+        {
+            // Tiles that changed until now are coloured as well
+            GetTileChangeJournal().TakeChanges(_changedTiles);
+
+            if (!gConfigGeneral.MultiThreading)
+            {
+                _mapPixelJobs.reset();
+                for (int32_t line = 0; line < MAXIMUM_MAP_SIZE_TECHNICAL; line++)
                 {
-                    uint16_t colour = 0;
-                    switch (selected_tab)
+                    SetMapLinePixels(_rotation, line);
+                }
+                return;
+            }
+
+            if (_mapPixelJobs == nullptr)
+            {
+                _mapPixelJobs = std::make_unique<JobPool>();
+            }
+            constexpr int32_t LinesPerJob = 32;
+            for (int32_t first = 0; first < MAXIMUM_MAP_SIZE_TECHNICAL; first += LinesPerJob)
+            {
+                const auto last = std::min(first + LinesPerJob, MAXIMUM_MAP_SIZE_TECHNICAL);
+                const auto rotation = _rotation;
+                _mapPixelJobs->AddTask([this, rotation, first, last]() {
+                    for (int32_t line = first; line < last; line++)
                     {
-                        case PAGE_PEEPS:
-                            colour = GetPixelColourPeep({ x, y });
-                            break;
-                        case PAGE_RIDES:
-                            colour = GetPixelColourRide({ x, y });
-                            break;
+                        SetMapLinePixels(rotation, line);
                     }
-                    destination[0] = (colour >> 8) & 0xFF;
-                    destination[1] = colour;
-                }
-                x += dx;
-                y += dy;
+                });
+            }
+            _mapPixelJobs->Join();
+        }
 
-                destinationPosition.x++;
-                destinationPosition.y++;
-                destination = _mapImageData.data() + (destinationPosition.y * MAP_WINDOW_MAP_SIZE) + destinationPosition.x;
+        // Colours the tiles that changed since the last update.
+        void UpdateMapPixels()
+        {
+            if (GetTileChangeJournal().TakeChanges(_changedTiles))
+            {
+                SetAllMapPixels();
+                return;
+            }
+
+            for (const auto& tile : _changedTiles)
+            {
+                const auto [line, index] = GetTileLine(_rotation, tile);
+                SetMapPixel(_rotation, line, index);
             }
-            _currentLine++;
-            if (_currentLine >= MAXIMUM_MAP_SIZE_TECHNICAL)
-                _currentLine = 0;
         }
 
         uint16_t GetPixelColourPeep(const CoordsXY& c)
@@ -30,6 +30,7 @@
 #include <openrct2/Version.h>
 #include <openrct2/actions/BannerPlaceAction.h>
 #include <openrct2/actions/BannerSetColourAction.h>
+#include <openrct2/actions/BatchAction.h>
 #include <openrct2/actions/ClearAction.h>
 #include <openrct2/actions/FootpathAdditionPlaceAction.h>
 #include <openrct2/actions/GameSetSpeedAction.h>
@@ -2214,6 +2215,8 @@ static Widget _topToolbarWidgets[] = {
                         }
                     }
 
+                    // A cluster is sent as one action, only a single placement that failed is executed on its own.
+                    BatchAction batchAction;
                     bool forceError = true;
                     for (int32_t q = 0; q < quantity; q++)
                     {
@@ -2277,7 +2280,15 @@ static Widget _topToolbarWidgets[] = {
                         }
 
                         // Actually place
-                        if (success == GameActions::Status::Ok || ((q + 1 == quantity) && forceError))
+                        if (isCluster && success == GameActions::Status::Ok)
+                        {
+                            batchAction.AddAction(std::make_unique<SmallSceneryPlaceAction>(
+                                CoordsXYZD{ cur_grid_x, cur_grid_y, gSceneryPlaceZ, gSceneryPlaceRotation }, quadrant,
+                                selectedScenery, gWindowSceneryPrimaryColour, gWindowScenerySecondaryColour,
+                                gWindowSceneryTertiaryColour));
+                            forceError = false;
+                        }
+                        else if (success == GameActions::Status::Ok || ((q + 1 == quantity) && forceError))
                         {
                             auto smallSceneryPlaceAction = SmallSceneryPlaceAction(
                                 { cur_grid_x, cur_grid_y, gSceneryPlaceZ, gSceneryPlaceRotation }, quadrant, selectedScenery,
@@ -2302,6 +2313,17 @@ static Widget _topToolbarWidgets[] = {
                         }
                         gSceneryPlaceZ = zCoordinate;
                     }
+
+                    if (!batchAction.IsEmpty())
+                    {
+                        batchAction.SetCallback([](const GameAction* ga, const GameActions::Result* result) {
+                            if (result->Error == GameActions::Status::Ok)
+                            {
+                                OpenRCT2::Audio::Play3D(OpenRCT2::Audio::SoundId::PlaceItem, result->Position);
+                            }
+                        });
+                        GameActions::Execute(&batchAction);
+                    }
                     break;
                 }
                 case SCENERY_TYPE_PATH_ITEM:
@@ -999,7 +999,27 @@ namespace OpenRCT2
                 {
                     gNetworkStartPort = gConfigNetwork.DefaultPort;
                 }
-                _network.BeginClient(gNetworkStartHost, gNetworkStartPort);
+
+                if (gNetworkStartRelay)
+                {
+                    if (gNetworkStartRelayPort == 0)
+                    {
+                        gNetworkStartRelayPort = gConfigNetwork.DefaultPort;
+                    }
+
+                    if (gNetworkStartAddress.empty())
+                    {
+                        gNetworkStartAddress = gConfigNetwork.ListenAddress;
+                    }
+
+                    // --password is sent to the upstream server, spectators use the configured one.
+                    _network.SetPassword(gConfigNetwork.DefaultPassword.c_str());
+                    _network.BeginRelay(gNetworkStartHost, gNetworkStartPort, gNetworkStartRelayPort, gNetworkStartAddress);
+                }
+                else
+                {
+                    _network.BeginClient(gNetworkStartHost, gNetworkStartPort);
+                }
             }
 #endif // DISABLE_NETWORK
 
@@ -1172,6 +1192,8 @@ namespace OpenRCT2
             _drawingEngine->BeginDraw();
             _painter->Paint(*_drawingEngine);
             _drawingEngine->EndDraw();
+
+            GfxTrimLazyImages();
         }
 
         void Tick()
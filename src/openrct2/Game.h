@@ -105,6 +105,7 @@ enum class GameCommand : int32_t
     FreezeRideRating,
     SetGameSpeed,
     SetRestrictedScenery,
+    Batch,
     Count,
 };
 
@@ -183,6 +183,10 @@ void GameState::Tick()
                 // Make sure the client always knows about what tick the host is on.
                 NetworkSendTick();
             }
+            else if (NetworkGetMode() == NETWORK_MODE_CLIENT)
+            {
+                NetworkRelayTick();
+            }
 
             // Keep updating the money effect even when paused.
             UpdateMoneyEffect();
@@ -303,18 +307,21 @@ void GameState::UpdateLogic()
 
         // Check desync.
         bool desynced = NetworkCheckDesynchronisation();
-        if (desynced)
+        if (desynced && NetworkGetStatus() == NETWORK_STATUS_CONNECTED)
         {
-            // If desync debugging is enabled and we are still connected request the specific game state from server.
-            if (NetworkGamestateSnapshotsEnabled() && NetworkGetStatus() == NETWORK_STATUS_CONNECTED)
+            if (NetworkGamestateSnapshotsEnabled())
             {
                 // Create snapshot from this tick so we can compare it later
                 // as we won't pause the game on this event.
                 CreateStateSnapshot();
-
-                NetworkRequestGamestateSnapshot();
             }
+
+            // Ask the server which entities differ, falls back to the full game state if desync debugging is enabled.
+            NetworkRequestGamestateSnapshot();
         }
+
+        // Relays pass the tick on to their spectators once they have reached it.
+        NetworkRelayTick();
     }
 
 #ifdef ENABLE_SCRIPTING
@@ -0,0 +1,55 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2024 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#pragma once
+
+#include "core/MemoryStream.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+// A range of the serialised sprite data, either the header (key 0) or a single entity (entity index + 1).
+struct SnapshotChunk
+{
+    uint32_t key;
+    uint32_t offset;
+    uint32_t length;
+};
+
+// Full sprite data of a captured snapshot which the following captures are encoded against.
+struct SnapshotKeyframe
+{
+    OpenRCT2::MemoryStream data;
+    std::vector<SnapshotChunk> chunks; // Sorted by key.
+
+    const SnapshotChunk* FindChunk(uint32_t key) const
+    {
+        auto it = std::lower_bound(
+            chunks.begin(), chunks.end(), key, [](const SnapshotChunk& chunk, uint32_t k) { return chunk.key < k; });
+        if (it == chunks.end() || it->key != key)
+            return nullptr;
+        return &*it;
+    }
+};
+
+namespace SnapshotDelta
+{
+    /*
+     * Encodes the chunks of the stream against the keyframe. Chunks with the same key and length as in the
+     * keyframe are stored as XOR runs, all others are stored raw.
+     */
+    [[nodiscard]] std::vector<uint8_t> Encode(
+        const OpenRCT2::MemoryStream& stream, const std::vector<SnapshotChunk>& chunks, const SnapshotKeyframe& keyframe);
+
+    /*
+     * Rebuilds the stream from a delta, throws if it is corrupted or does not belong to the keyframe.
+     */
+    [[nodiscard]] OpenRCT2::MemoryStream Decode(const std::vector<uint8_t>& delta, const SnapshotKeyframe& keyframe);
+} // namespace SnapshotDelta
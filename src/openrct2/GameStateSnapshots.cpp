@@ -9,6 +9,7 @@
 
 #include "GameStateSnapshots.h"
 
+#include "GameStateSnapshotDelta.h"
 #include "core/CircularBuffer.h"
 #include "entity/Balloon.h"
 #include "entity/Duck.h"
@@ -22,9 +23,16 @@
 #include "entity/Staff.h"
 #include "ride/Vehicle.h"
 
+#include <algorithm>
+#include <memory>
+#include <stdexcept>
+
 static constexpr size_t MaximumGameStateSnapshots = 32;
 static constexpr uint32_t InvalidTick = 0xFFFFFFFF;
 
+// Captured snapshots are stored as a delta against the last keyframe, a new keyframe is taken every N captures.
+static constexpr uint32_t SnapshotKeyframeInterval = 8;
+
 #pragma pack(push, 1)
 union EntitySnapshot
 {
@@ -38,22 +46,179 @@ union EntitySnapshot
 assert_struct_size(EntitySnapshot, 0x200);
 #pragma pack(pop)
 
+namespace SnapshotDelta
+{
+    enum : uint8_t
+    {
+        CHUNK_RAW,
+        CHUNK_XOR,
+    };
+
+    static void WriteVarInt(std::vector<uint8_t>& out, uint32_t value)
+    {
+        while (value >= 0x80)
+        {
+            out.push_back(static_cast<uint8_t>(value | 0x80));
+            value >>= 7;
+        }
+        out.push_back(static_cast<uint8_t>(value));
+    }
+
+    static uint32_t ReadVarInt(const uint8_t*& ptr, const uint8_t* end)
+    {
+        uint32_t value = 0;
+        for (int32_t shift = 0; shift < 32; shift += 7)
+        {
+            if (ptr >= end)
+                break;
+            const uint8_t b = *ptr++;
+            value |= static_cast<uint32_t>(b & 0x7F) << shift;
+            if ((b & 0x80) == 0)
+                return value;
+        }
+        throw std::runtime_error("Snapshot delta corrupted.");
+    }
+
+    /*
+     * Writes the data XORed against the base as alternating runs of equal bytes and XORed literals.
+     */
+    static void EncodeXorRuns(std::vector<uint8_t>& out, const uint8_t* data, const uint8_t* base, uint32_t length)
+    {
+        uint32_t i = 0;
+        while (i < length)
+        {
+            uint32_t equalRun = 0;
+            while (i + equalRun < length && data[i + equalRun] == base[i + equalRun])
+                equalRun++;
+
+            const uint32_t literalStart = i + equalRun;
+            uint32_t literalLength = 0;
+            while (literalStart + literalLength < length && data[literalStart + literalLength] != base[literalStart + literalLength])
+                literalLength++;
+
+            WriteVarInt(out, equalRun);
+            WriteVarInt(out, literalLength);
+            for (uint32_t j = literalStart; j < literalStart + literalLength; j++)
+            {
+                out.push_back(data[j] ^ base[j]);
+            }
+            i = literalStart + literalLength;
+        }
+    }
+
+    std::vector<uint8_t> Encode(
+        const OpenRCT2::MemoryStream& stream, const std::vector<SnapshotChunk>& chunks, const SnapshotKeyframe& keyframe)
+    {
+        const auto* data = static_cast<const uint8_t*>(stream.GetData());
+        const auto* baseData = static_cast<const uint8_t*>(keyframe.data.GetData());
+
+        std::vector<uint8_t> out;
+        WriteVarInt(out, static_cast<uint32_t>(chunks.size()));
+        for (const auto& chunk : chunks)
+        {
+            WriteVarInt(out, chunk.key);
+            WriteVarInt(out, chunk.length);
+
+            const auto* baseChunk = keyframe.FindChunk(chunk.key);
+            if (baseChunk != nullptr && baseChunk->length == chunk.length)
+            {
+                out.push_back(CHUNK_XOR);
+                EncodeXorRuns(out, data + chunk.offset, baseData + baseChunk->offset, chunk.length);
+            }
+            else
+            {
+                out.push_back(CHUNK_RAW);
+                out.insert(out.end(), data + chunk.offset, data + chunk.offset + chunk.length);
+            }
+        }
+        return out;
+    }
+
+    OpenRCT2::MemoryStream Decode(const std::vector<uint8_t>& delta, const SnapshotKeyframe& keyframe)
+    {
+        const auto* baseData = static_cast<const uint8_t*>(keyframe.data.GetData());
+        const uint8_t* ptr = delta.data();
+        const uint8_t* end = delta.data() + delta.size();
+
+        OpenRCT2::MemoryStream stream;
+        std::vector<uint8_t> buffer;
+
+        const auto numChunks = ReadVarInt(ptr, end);
+        for (uint32_t i = 0; i < numChunks; i++)
+        {
+            const auto key = ReadVarInt(ptr, end);
+            const auto length = ReadVarInt(ptr, end);
+            if (ptr >= end)
+                throw std::runtime_error("Snapshot delta corrupted.");
+
+            const auto chunkType = *ptr++;
+            if (chunkType == CHUNK_RAW)
+            {
+                if (static_cast<size_t>(end - ptr) < length)
+                    throw std::runtime_error("Snapshot delta corrupted.");
+                stream.Write(ptr, length);
+                ptr += length;
+                continue;
+            }
+
+            const auto* baseChunk = keyframe.FindChunk(key);
+            if (baseChunk == nullptr || baseChunk->length != length)
+                throw std::runtime_error("Snapshot delta does not match keyframe.");
+
+            buffer.assign(baseData + baseChunk->offset, baseData + baseChunk->offset + length);
+            uint32_t pos = 0;
+            while (pos < length)
+            {
+                pos += ReadVarInt(ptr, end);
+                const auto literalLength = ReadVarInt(ptr, end);
+                if (pos + literalLength > length || static_cast<size_t>(end - ptr) < literalLength)
+                    throw std::runtime_error("Snapshot delta corrupted.");
+                for (uint32_t j = 0; j < literalLength; j++)
+                {
+                    buffer[pos++] ^= *ptr++;
+                }
+            }
+            stream.Write(buffer.data(), length);
+        }
+        return stream;
+    }
+} // namespace SnapshotDelta
+
 struct GameStateSnapshot_t
 {
     GameStateSnapshot_t& operator=(GameStateSnapshot_t&& mv) noexcept
     {
         tick = mv.tick;
         storedSprites = std::move(mv.storedSprites);
+        keyframe = std::move(mv.keyframe);
+        delta = std::move(mv.delta);
         return *this;
     }
 
     uint32_t tick = InvalidTick;
     uint32_t srand0 = 0;
 
+    // Sprite data is either stored in full (snapshots received or loaded), is the keyframe itself or
+    // is delta encoded against the keyframe.
     OpenRCT2::MemoryStream storedSprites;
+    std::shared_ptr<const SnapshotKeyframe> keyframe;
+    std::vector<uint8_t> delta;
+
     OpenRCT2::MemoryStream parkParameters;
 
-    template<typename T> bool EntitySizeCheck(DataSerialiser& ds)
+    /*
+     * Returns the full sprite data, reconstructing it from the keyframe if needed.
+     */
+    OpenRCT2::MemoryStream GetSpriteData() const
+    {
+        if (keyframe == nullptr)
+            return storedSprites;
+        if (delta.empty())
+            return keyframe->data;
+        return SnapshotDelta::Decode(delta, *keyframe);
+    }
+
+    template<typename T> static bool EntitySizeCheck(DataSerialiser& ds)
     {
         uint32_t size = sizeof(T);
         ds << size;
@@ -63,18 +228,31 @@ struct GameStateSnapshot_t
         }
         return true;
     }
-    template<typename... T> bool EntitiesSizeCheck(DataSerialiser& ds)
+    template<typename... T> static bool EntitiesSizeCheck(DataSerialiser& ds)
     {
         return (EntitySizeCheck<T>(ds) && ...);
     }
 
-    // Must pass a function that can access the sprite.
-    void SerialiseSprites(std::function<EntitySnapshot*(const EntityId)> getEntity, const size_t numSprites, bool saving)
+    // Must pass a function that can access the sprite. When saving the ranges of each entity in the stream
+    // can be returned through chunks.
+    static void SerialiseSprites(
+        OpenRCT2::MemoryStream& stream, std::function<EntitySnapshot*(const EntityId)> getEntity, const size_t numSprites,
+        bool saving, std::vector<SnapshotChunk>* chunks = nullptr)
     {
         const bool loading = !saving;
 
-        storedSprites.SetPosition(0);
-        DataSerialiser ds(saving, storedSprites);
+        stream.SetPosition(0);
+        DataSerialiser ds(saving, stream);
+
+        auto beginChunk = [&](uint32_t key) {
+            if (chunks == nullptr)
+                return;
+            const auto position = static_cast<uint32_t>(stream.GetPosition());
+            if (!chunks->empty())
+                chunks->back().length = position - chunks->back().offset;
+            chunks->push_back({ key, position, 0 });
+        };
+        beginChunk(0);
 
         std::vector<uint32_t> indexTable;
         indexTable.reserve(numSprites);
@@ -109,6 +287,7 @@ struct GameStateSnapshot_t
 
         for (uint32_t i = 0; i < numSavedSprites; i++)
         {
+            beginChunk(indexTable[i] + 1);
             ds << indexTable[i];
 
             const EntityId spriteIdx = EntityId::FromUnderlying(indexTable[i]);
@@ -157,6 +336,9 @@ struct GameStateSnapshot_t
                     break;
             }
         }
+
+        if (chunks != nullptr && !chunks->empty())
+            chunks->back().length = static_cast<uint32_t>(stream.GetPosition()) - chunks->back().offset;
     }
 };
 
@@ -165,6 +347,8 @@ struct GameStateSnapshots final : public IGameStateSnapshots
     virtual void Reset() override final
     {
         _snapshots.clear();
+        _lastKeyframe.reset();
+        _capturesSinceKeyframe = 0;
     }
 
     virtual GameStateSnapshot_t& CreateSnapshot() override final
@@ -183,10 +367,30 @@ struct GameStateSnapshots final : public IGameStateSnapshots
 
     virtual void Capture(GameStateSnapshot_t& snapshot) override final
     {
-        snapshot.SerialiseSprites(
-            [](const EntityId index) { return reinterpret_cast<EntitySnapshot*>(GetEntity(index)); }, MAX_ENTITIES, true);
+        std::vector<SnapshotChunk> chunks;
+        GameStateSnapshot_t::SerialiseSprites(
+            snapshot.storedSprites, [](const EntityId index) { return reinterpret_cast<EntitySnapshot*>(GetEntity(index)); },
+            MAX_ENTITIES, true, &chunks);
+
+        if (_lastKeyframe == nullptr || _capturesSinceKeyframe >= SnapshotKeyframeInterval)
+        {
+            auto keyframe = std::make_shared<SnapshotKeyframe>();
+            keyframe->data = std::move(snapshot.storedSprites);
+            keyframe->chunks = std::move(chunks);
 
-        // LOG_INFO("Snapshot size: %u bytes", static_cast<uint32_t>(snapshot.storedSprites.GetLength()));
+            _lastKeyframe = keyframe;
+            _capturesSinceKeyframe = 0;
+            snapshot.delta.clear();
+        }
+        else
+        {
+            snapshot.delta = SnapshotDelta::Encode(snapshot.storedSprites, chunks, *_lastKeyframe);
+        }
+        snapshot.keyframe = _lastKeyframe;
+        snapshot.storedSprites = OpenRCT2::MemoryStream{};
+        _capturesSinceKeyframe++;
+
+        // LOG_INFO("Snapshot size: %u bytes", static_cast<uint32_t>(snapshot.delta.size()));
     }
 
     virtual const GameStateSnapshot_t* GetLinkedSnapshot(uint32_t tick) const override final
@@ -203,11 +407,21 @@ struct GameStateSnapshots final : public IGameStateSnapshots
     {
         ds << snapshot.tick;
         ds << snapshot.srand0;
-        ds << snapshot.storedSprites;
+        if (ds.IsSaving())
+        {
+            // Always written in full so the format does not depend on the ring.
+            ds << snapshot.GetSpriteData();
+        }
+        else
+        {
+            snapshot.keyframe.reset();
+            snapshot.delta.clear();
+            ds << snapshot.storedSprites;
+        }
         ds << snapshot.parkParameters;
     }
 
-    std::vector<EntitySnapshot> BuildSpriteList(GameStateSnapshot_t& snapshot) const
+    std::vector<EntitySnapshot> BuildSpriteList(const GameStateSnapshot_t& snapshot) const
     {
         std::vector<EntitySnapshot> spriteList;
         spriteList.resize(MAX_ENTITIES);
@@ -218,8 +432,10 @@ struct GameStateSnapshots final : public IGameStateSnapshots
             sprite.base.Type = EntityType::Null;
         }
 
-        snapshot.SerialiseSprites(
-            [&spriteList](const EntityId index) { return &spriteList[index.ToUnderlying()]; }, MAX_ENTITIES, false);
+        auto spriteData = snapshot.GetSpriteData();
+        GameStateSnapshot_t::SerialiseSprites(
+            spriteData, [&spriteList](const EntityId index) { return &spriteList[index.ToUnderlying()]; }, MAX_ENTITIES,
+            false);
 
         return spriteList;
     }
@@ -629,8 +845,8 @@ struct GameStateSnapshots final : public IGameStateSnapshots
         res.srand0Left = base.srand0;
         res.srand0Right = cmp.srand0;
 
-        std::vector<EntitySnapshot> spritesBase = BuildSpriteList(const_cast<GameStateSnapshot_t&>(base));
-        std::vector<EntitySnapshot> spritesCmp = BuildSpriteList(const_cast<GameStateSnapshot_t&>(cmp));
+        std::vector<EntitySnapshot> spritesBase = BuildSpriteList(base);
+        std::vector<EntitySnapshot> spritesCmp = BuildSpriteList(cmp);
 
         for (uint32_t i = 0; i < static_cast<uint32_t>(spritesBase.size()); i++)
         {
@@ -787,6 +1003,8 @@ struct GameStateSnapshots final : public IGameStateSnapshots
 
 private:
     CircularBuffer<std::unique_ptr<GameStateSnapshot_t>, MaximumGameStateSnapshots> _snapshots;
+    std::shared_ptr<const SnapshotKeyframe> _lastKeyframe;
+    uint32_t _capturesSinceKeyframe = 0;
 };
 
 std::unique_ptr<IGameStateSnapshots> CreateGameStateSnapshots()
@@ -55,6 +55,8 @@ extern int32_t gNetworkStart;
 extern std::string gNetworkStartHost;
 extern int32_t gNetworkStartPort;
 extern std::string gNetworkStartAddress;
+extern bool gNetworkStartRelay;
+extern int32_t gNetworkStartRelayPort;
 #endif
 
 extern uint32_t gCurrentDrawCount;
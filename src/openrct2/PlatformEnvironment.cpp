@@ -74,6 +74,7 @@ static constexpr u8string_view FileNames[] = {
     u8"Saved Games" PATH_SEPARATOR "scores.dat", // SCORES (RCT2)
     u8"changelog.txt",                           // CHANGELOG
     u8"plugin.store.json",                       // PLUGIN_STORE
+    u8"plugin.store.dat",                        // PLUGIN_STORE_DATA
     u8"contributors.md",                         // CONTRIBUTORS
 };
 
@@ -69,7 +69,8 @@ namespace OpenRCT2
         SCORES_LEGACY,           // Scenario scores, legacy (scores.dat).
         SCORES_RCT2,             // Scenario scores, rct2 (\Saved Games\scores.dat).
         CHANGELOG,               // Notable changes to the game between versions, distributed with the game.
-        PLUGIN_STORE,            // Shared storage for plugins.
+        PLUGIN_STORE,            // Shared storage for plugins, legacy (plugin.store.json).
+        PLUGIN_STORE_DATA,       // Shared storage for plugins (plugin.store.dat).
         CONTRIBUTORS,            // Who has provided work to the game (Contributors.md).
     };
 
@@ -25,6 +25,8 @@
 #include "actions/TrackPlaceAction.h"
 #include "config/Config.h"
 #include "core/DataSerialiser.h"
+#include "core/File.h"
+#include "core/FileStream.h"
 #include "core/Path.hpp"
 #include "entity/EntityRegistry.h"
 #include "entity/EntityTweener.h"
@@ -36,6 +38,7 @@
 #include "world/Park.h"
 #include "zlib.h"
 
+#include <algorithm>
 #include <chrono>
 #include <memory>
 #include <vector>
@@ -71,6 +74,38 @@ namespace OpenRCT2
         }
     };
 
+    /**
+     * Streamed replays (version 11 onwards) are written as a file header followed by a sequence of individually
+     * compressed segments, so recordings can be written while they are being recorded and played back from any keyframe.
+     */
+    enum class ReplaySegmentType : uint8_t
+    {
+        Info,     // Recording metadata, followed by the keyframe of the starting state.
+        Keyframe, // Park state at a tick, used for seeking.
+        Commands, // Commands and checksums of a range of ticks.
+        End,      // Last tick and the final game state snapshot.
+    };
+
+    struct ReplaySegment
+    {
+        ReplaySegmentType type{};
+        uint32_t tickStart{};
+        uint32_t tickEnd{};
+        uint32_t numCommands{};
+        uint32_t numChecksums{};
+        uint64_t uncompressedSize{};
+        uint64_t compressedSize{};
+        uint64_t offset{}; // Position of the compressed data in the file, not serialised.
+    };
+
+    struct ReplayKeyframe
+    {
+        uint32_t tick{};
+        uint32_t commandIndex{}; // Commands with a lower index are already applied to the park state.
+        OpenRCT2::MemoryStream parkData;
+        OpenRCT2::MemoryStream parkParams;
+    };
+
     struct ReplayRecordFile
     {
         uint32_t magic;
@@ -96,13 +131,26 @@ namespace OpenRCT2
         std::vector<std::pair<uint32_t, EntitiesChecksum>> checksums;
         uint32_t checksumIndex;
         OpenRCT2::MemoryStream gameStateSnapshots;
+
+        // Streamed replays only hold the commands and checksums of the current segment in memory.
+        std::unique_ptr<OpenRCT2::FileStream> fileStream;
+        std::vector<ReplaySegment> segments; // Index of all segments in the file (playback).
+        size_t nextSegmentIndex;             // Next segment to load during playback.
+        uint32_t segmentTickStart;           // First tick of the commands not yet written (recording).
+        uint32_t nextKeyframeTick;           // Tick at which the next keyframe is written (recording).
+        uint32_t commandIndexStart;          // Commands with a lower index are skipped (playback).
+        uint32_t totalCommands;
+        uint32_t totalChecksums;
     };
 
     class ReplayManager final : public IReplayManager
     {
-        static constexpr uint16_t ReplayVersion = 10;
-        static constexpr uint32_t ReplayMagic = 0x5243524F; // ORCR.
-        static constexpr int ReplayCompressionLevel = 9;
+        static constexpr uint16_t ReplayVersion = 11;
+        static constexpr uint16_t ReplayVersionMonolithic = 10; // Last version written as a single compressed blob.
+        static constexpr uint32_t ReplayMagic = 0x5243524F;     // ORCR.
+        static constexpr int ReplayCompressionLevel = 2;        // Segments are compressed on the game thread.
+        static constexpr uint32_t SegmentTicks = 40 * 60;       // Roughly one minute of game time.
+        static constexpr uint32_t KeyframeTicks = 40 * 60 * 5;  // Roughly five minutes of game time.
         static constexpr int NormalRecordingChecksumTicks = 1;
         static constexpr int SilentRecordingChecksumTicks = 40; // Same as network server
 
@@ -147,11 +195,13 @@ namespace OpenRCT2
             auto ga = GameActions::Clone(action);
 
             _currentRecording->commands.emplace(tick, std::move(ga), _commandId++);
+            _currentRecording->totalCommands++;
         }
 
         void AddChecksum(uint32_t tick, EntitiesChecksum&& checksum)
         {
             _currentRecording->checksums.emplace_back(std::make_pair(tick, std::move(checksum)));
+            _currentRecording->totalChecksums++;
         }
 
         // Function runs each Tick.
@@ -170,6 +220,13 @@ namespace OpenRCT2
                 _nextChecksumTick = currentTicks + ChecksumTicksDelta();
             }
 
+            if (_currentRecording != nullptr && !UpdateRecordingStream(currentTicks))
+            {
+                LOG_ERROR("Unable to write to replay file, recording stopped.");
+                StopRecording(true);
+                return;
+            }
+
             if (_mode == ReplayMode::RECORDING)
             {
                 if (currentTicks >= _currentRecording->tickEnd)
@@ -180,6 +237,16 @@ namespace OpenRCT2
             }
             else if (_mode == ReplayMode::PLAYING)
             {
+                try
+                {
+                    LoadCommandSegments(*_currentReplay, currentTicks);
+                }
+                catch (const std::exception& ex)
+                {
+                    LOG_ERROR("Unable to read replay commands: %s", ex.what());
+                    StopPlayback();
+                    return;
+                }
 #ifndef DISABLE_NETWORK
                 // If the network is disabled we will only get a dummy hash which will cause
                 // false positives during replay.
@@ -199,7 +266,7 @@ namespace OpenRCT2
                 ReplayCommands();
 
                 // If we run out of commands we can just stop
-                if (_currentReplay->commands.empty())
+                if (_currentReplay->commands.empty() && _currentReplay->nextSegmentIndex >= _currentReplay->segments.size())
                 {
                     StopPlayback();
                     StopRecording();
@@ -247,6 +314,7 @@ namespace OpenRCT2
                 replayData->tickEnd = k_MaxReplayTicks;
 
             replayData->filePath = name;
+            replayData->commandIndexStart = _commandId;
 
             auto context = GetContext();
             auto& objManager = context->GetObjectManager();
@@ -267,6 +335,35 @@ namespace OpenRCT2
 
             TakeGameStateSnapshot(replayData->gameStateSnapshots);
 
+            replayData->segmentTickStart = currentTicks;
+            replayData->nextKeyframeTick = currentTicks + KeyframeTicks;
+            replayData->totalCommands = 0;
+            replayData->totalChecksums = 0;
+
+            // Write the starting state straight away, only the commands of the current segment are kept in memory.
+            try
+            {
+                replayData->fileStream = std::make_unique<FileStream>(replayData->filePath, FILE_MODE_WRITE);
+
+                DataSerialiser headerDs(true, *replayData->fileStream);
+                headerDs << replayData->magic;
+                headerDs << replayData->version;
+
+                DataSerialiser infoDs(true);
+                SerialiseInfo(infoDs, *replayData);
+                WriteSegment(*replayData, ReplaySegmentType::Info, currentTicks, currentTicks, 0, 0, infoDs.GetStream());
+            }
+            catch (const std::exception& ex)
+            {
+                LOG_ERROR("Unable to write to file '%s': %s", replayData->filePath.c_str(), ex.what());
+                return false;
+            }
+
+            replayData->parkData.Clear();
+            replayData->parkParams.Clear();
+            replayData->cheatData.Clear();
+            replayData->gameStateSnapshots.Clear();
+
             if (_mode != ReplayMode::NORMALISATION)
                 _mode = ReplayMode::RECORDING;
 
@@ -284,7 +381,9 @@ namespace OpenRCT2
 
             if (discard)
             {
+                const auto filePath = _currentRecording->filePath;
                 _currentRecording.reset();
+                File::Delete(filePath);
                 _mode = ReplayMode::NONE;
                 return true;
             }
@@ -300,47 +399,21 @@ namespace OpenRCT2
 
             TakeGameStateSnapshot(_currentRecording->gameStateSnapshots);
 
-            // Serialise Body.
-            DataSerialiser recSerialiser(true);
-            Serialise(recSerialiser, *_currentRecording);
-
-            const auto& stream = recSerialiser.GetStream();
-            unsigned long streamLength = static_cast<unsigned long>(stream.GetLength());
-            unsigned long compressLength = compressBound(streamLength);
-
-            MemoryStream data(compressLength);
-
-            ReplayRecordFile file{ _currentRecording->magic, _currentRecording->version, streamLength, data };
-
-            auto compressBuf = std::make_unique<unsigned char[]>(compressLength);
-            compress2(
-                compressBuf.get(), &compressLength, static_cast<const unsigned char*>(stream.GetData()), stream.GetLength(),
-                ReplayCompressionLevel);
-            file.data.Write(compressBuf.get(), compressLength);
-
-            DataSerialiser fileSerialiser(true);
-            fileSerialiser << file.magic;
-            fileSerialiser << file.version;
-            fileSerialiser << file.uncompressedSize;
-            fileSerialiser << file.data;
-
             bool result = false;
-
-            const std::string& outFile = _currentRecording->filePath;
-
-            FILE* fp = fopen(outFile.c_str(), "wb");
-            if (fp != nullptr)
+            try
             {
-                const auto& fileStream = fileSerialiser.GetStream();
-                fwrite(fileStream.GetData(), 1, fileStream.GetLength(), fp);
-                fclose(fp);
+                WriteCommandSegment(*_currentRecording, currentTicks + 1);
+
+                DataSerialiser endDs(true);
+                endDs << _currentRecording->tickEnd;
+                endDs << _currentRecording->gameStateSnapshots;
+                WriteSegment(*_currentRecording, ReplaySegmentType::End, currentTicks, currentTicks, 0, 0, endDs.GetStream());
 
                 result = true;
             }
-            else
+            catch (const std::exception& ex)
             {
-                LOG_ERROR("Unable to write to file '%s'", outFile.c_str());
-                result = false;
+                LOG_ERROR("Unable to write to file '%s': %s", _currentRecording->filePath.c_str(), ex.what());
             }
 
             // When normalizing the output we don't touch the mode.
@@ -377,14 +450,18 @@ namespace OpenRCT2
                 info.Ticks = GetGameState().CurrentTicks - data->tickStart;
             else if (_mode == ReplayMode::PLAYING)
                 info.Ticks = data->tickEnd - data->tickStart;
-            info.NumCommands = static_cast<uint32_t>(data->commands.size());
-            info.NumChecksums = static_cast<uint32_t>(data->checksums.size());
+            info.NumCommands = data->totalCommands;
+            info.NumChecksums = data->totalChecksums;
 
             return true;
         }
 
         void LoadAndCompareSnapshot(MemoryStream& snapshotStream)
         {
+            // Streamed replays that were not stopped properly have no final snapshot.
+            if (snapshotStream.GetPosition() >= snapshotStream.GetLength())
+                return;
+
             DataSerialiser ds(false, snapshotStream);
 
             IGameStateSnapshots* snapshots = GetContext()->GetGameStateSnapshots();
@@ -437,7 +514,7 @@ namespace OpenRCT2
                 return false;
             }
 
-            if (!LoadReplayDataMap(*replayData))
+            if (!LoadReplayDataMap(replayData->parkData, replayData->parkParams))
             {
                 LOG_ERROR("Unable to load map.");
                 return false;
@@ -447,8 +524,22 @@ namespace OpenRCT2
 
             LoadAndCompareSnapshot(replayData->gameStateSnapshots);
 
+            // Normalisation replays one command per tick, so the commands can not be loaded by tick.
+            const auto loadUntilTick = _mode == ReplayMode::NORMALISATION ? k_MaxReplayTicks : replayData->tickStart;
+            try
+            {
+                LoadCommandSegments(*replayData, loadUntilTick);
+            }
+            catch (const std::exception& ex)
+            {
+                LOG_ERROR("Unable to read replay commands: %s", ex.what());
+                return false;
+            }
+
+            replayData->parkData.Clear();
+            replayData->parkParams.Clear();
+
             _currentReplay = std::move(replayData);
-            _currentReplay->checksumIndex = 0;
             _faultyChecksumIndex = -1;
 
             // Make sure game is not paused.
@@ -460,6 +551,77 @@ namespace OpenRCT2
             return true;
         }
 
+        virtual bool SeekPlayback(uint32_t tick) override
+        {
+            if (_mode != ReplayMode::PLAYING)
+                return false;
+
+            auto& replay = *_currentReplay;
+            if (replay.fileStream == nullptr)
+            {
+                LOG_ERROR("Replay was recorded without keyframes, seeking is not supported.");
+                return false;
+            }
+
+            const auto targetTick = replay.tickStart + tick;
+            if (targetTick > replay.tickEnd)
+            {
+                LOG_ERROR("Tick %u is past the end of the replay.", tick);
+                return false;
+            }
+
+            // Find the nearest keyframe, the info segment holds the starting state.
+            size_t keyframeIndex = replay.segments.size();
+            for (size_t i = 0; i < replay.segments.size(); i++)
+            {
+                const auto& segment = replay.segments[i];
+                if (segment.type != ReplaySegmentType::Info && segment.type != ReplaySegmentType::Keyframe)
+                    continue;
+                if (segment.tickStart > targetTick)
+                    break;
+                keyframeIndex = i;
+            }
+            if (keyframeIndex == replay.segments.size())
+                return false;
+
+            ReplayKeyframe keyframe;
+            try
+            {
+                auto segmentData = ReadSegmentData(replay, replay.segments[keyframeIndex]);
+                DataSerialiser keyframeDs(false, segmentData);
+                SerialiseKeyframe(keyframeDs, keyframe);
+            }
+            catch (const std::exception& ex)
+            {
+                LOG_ERROR("Unable to read keyframe: %s", ex.what());
+                return false;
+            }
+
+            if (!LoadReplayDataMap(keyframe.parkData, keyframe.parkParams))
+            {
+                LOG_ERROR("Unable to load keyframe map.");
+                return false;
+            }
+
+            GetGameState().CurrentTicks = keyframe.tick;
+
+            replay.commands.clear();
+            replay.checksums.clear();
+            replay.checksumIndex = 0;
+            replay.nextSegmentIndex = keyframeIndex + 1;
+            replay.commandIndexStart = keyframe.commandIndex;
+            _faultyChecksumIndex = -1;
+
+            // Replay forward from the keyframe to the requested tick.
+            auto* gameState = GetContext()->GetGameState();
+            while (IsReplaying() && GetGameState().CurrentTicks < targetTick)
+            {
+                gameState->UpdateLogic();
+            }
+
+            return true;
+        }
+
         virtual bool IsPlaybackStateMismatching() const override
         {
             return _faultyChecksumIndex != -1;
@@ -510,6 +672,46 @@ namespace OpenRCT2
             return true;
         }
 
+        virtual bool LoadReplayGameActions(const std::string& file, std::vector<ReplayGameAction>& actions) override
+        {
+            if (_mode != ReplayMode::NONE)
+                return false;
+
+            auto replayData = std::make_unique<ReplayRecordData>();
+
+            if (!ReadReplayData(file, *replayData))
+            {
+                LOG_ERROR("Unable to read replay data.");
+                return false;
+            }
+
+            if (!LoadReplayDataMap(replayData->parkData, replayData->parkParams))
+            {
+                LOG_ERROR("Unable to load map.");
+                return false;
+            }
+
+            GetGameState().CurrentTicks = replayData->tickStart;
+
+            try
+            {
+                LoadCommandSegments(*replayData, k_MaxReplayTicks);
+            }
+            catch (const std::exception& ex)
+            {
+                LOG_ERROR("Unable to read replay commands: %s", ex.what());
+                return false;
+            }
+
+            auto& commands = replayData->commands;
+            while (!commands.empty())
+            {
+                auto node = commands.extract(commands.begin());
+                actions.push_back({ node.value().tick, std::move(node.value().action) });
+            }
+            return true;
+        }
+
     private:
         int ChecksumTicksDelta() const
         {
@@ -523,17 +725,18 @@ namespace OpenRCT2
             }
         }
 
-        bool LoadReplayDataMap(ReplayRecordData& data)
+        bool LoadReplayDataMap(MemoryStream& parkData, MemoryStream& parkParams)
         {
             try
             {
-                data.parkData.SetPosition(0);
+                parkData.SetPosition(0);
+                parkParams.SetPosition(0);
 
                 auto context = GetContext();
                 auto& objManager = context->GetObjectManager();
                 auto importer = ParkImporter::CreateParkFile(context->GetObjectRepository());
 
-                auto loadResult = importer->LoadFromStream(&data.parkData, false);
+                auto loadResult = importer->LoadFromStream(&parkData, false);
                 objManager.LoadObjects(loadResult.RequiredObjects);
 
                 // TODO: Have a separate GameState and exchange once loaded.
@@ -543,7 +746,7 @@ namespace OpenRCT2
                 EntityTweener::Get().Reset();
 
                 // Load all map global variables.
-                DataSerialiser parkParamsDs(false, data.parkParams);
+                DataSerialiser parkParamsDs(false, parkParams);
                 SerialiseParkParameters(parkParamsDs);
 
                 GameLoadInit();
@@ -612,8 +815,6 @@ namespace OpenRCT2
 
         bool ReadReplayData(const std::string& file, ReplayRecordData& data)
         {
-            MemoryStream stream;
-
             std::string fileName = file;
             if (fileName.size() < 5 || fileName.substr(fileName.size() - 5) != ".parkrep")
             {
@@ -623,18 +824,39 @@ namespace OpenRCT2
             std::string outPath = GetContext()->GetPlatformEnvironment()->GetDirectoryPath(DIRBASE::USER, DIRID::REPLAY);
             std::string outFile = Path::Combine(outPath, fileName);
 
-            bool loaded = false;
-            if (ReadReplayFromFile(outFile, stream))
-            {
+            if (File::Exists(outFile))
                 data.filePath = outFile;
-                loaded = true;
+            else if (File::Exists(file))
+                data.filePath = file;
+            else
+                return false;
+
+            try
+            {
+                auto fs = std::make_unique<FileStream>(data.filePath, FILE_MODE_OPEN);
+                DataSerialiser headerDs(false, *fs);
+                headerDs << data.magic;
+                headerDs << data.version;
+                if (data.magic != ReplayMagic)
+                {
+                    LOG_ERROR("Magic does not match %08X, expected: %08X", data.magic, ReplayMagic);
+                    return false;
+                }
+                if (data.version == ReplayVersion)
+                {
+                    data.fileStream = std::move(fs);
+                    return ReadStreamedReplayData(data);
+                }
             }
-            else if (ReadReplayFromFile(file, stream))
+            catch (const std::exception& ex)
             {
-                data.filePath = file;
-                loaded = true;
+                LOG_ERROR("Unable to read replay file '%s': %s", data.filePath.c_str(), ex.what());
+                return false;
             }
-            if (!loaded)
+
+            // Older replays are stored as a single compressed blob.
+            MemoryStream stream;
+            if (!ReadReplayFromFile(data.filePath, stream))
                 return false;
 
             if (!TryDecompress(stream))
@@ -653,9 +875,317 @@ namespace OpenRCT2
             data.cheatData.SetPosition(0);
             data.gameStateSnapshots.SetPosition(0);
 
+            data.totalCommands = static_cast<uint32_t>(data.commands.size());
+            data.totalChecksums = static_cast<uint32_t>(data.checksums.size());
+
             return true;
         }
 
+        /**
+         * Builds the segment index of a streamed replay and reads the info and end segments. Commands are loaded
+         * separately as playback reaches them. Replays that were not stopped properly end at their last complete segment.
+         */
+        bool ReadStreamedReplayData(ReplayRecordData& data)
+        {
+            auto& fs = *data.fileStream;
+            const auto length = fs.GetLength();
+            while (fs.GetPosition() < length)
+            {
+                ReplaySegment segment;
+                try
+                {
+                    DataSerialiser segmentDs(false, fs);
+                    SerialiseSegmentHeader(segmentDs, segment);
+                }
+                catch (const std::exception&)
+                {
+                    LOG_WARNING("Replay '%s' has an incomplete segment header.", data.filePath.c_str());
+                    break;
+                }
+
+                segment.offset = fs.GetPosition();
+                if (segment.compressedSize > length - segment.offset)
+                {
+                    LOG_WARNING("Replay '%s' has an incomplete segment.", data.filePath.c_str());
+                    break;
+                }
+                fs.SetPosition(segment.offset + segment.compressedSize);
+                data.segments.push_back(segment);
+            }
+
+            if (data.segments.empty() || data.segments.front().type != ReplaySegmentType::Info)
+            {
+                LOG_ERROR("Replay '%s' has no info segment.", data.filePath.c_str());
+                return false;
+            }
+
+            try
+            {
+                auto infoData = ReadSegmentData(data, data.segments.front());
+                DataSerialiser infoDs(false, infoData);
+                SerialiseInfo(infoDs, data);
+
+                data.tickEnd = data.segments.back().tickEnd;
+                for (const auto& segment : data.segments)
+                {
+                    data.totalCommands += segment.numCommands;
+                    data.totalChecksums += segment.numChecksums;
+                }
+
+                if (data.segments.back().type == ReplaySegmentType::End)
+                {
+                    auto endData = ReadSegmentData(data, data.segments.back());
+                    DataSerialiser endDs(false, endData);
+                    endDs << data.tickEnd;
+                    endDs << data.gameStateSnapshots;
+                }
+            }
+            catch (const std::exception& ex)
+            {
+                LOG_ERROR("Unable to read replay file '%s': %s", data.filePath.c_str(), ex.what());
+                return false;
+            }
+
+            data.nextSegmentIndex = 1;
+
+            // Reset position of all streams.
+            data.parkData.SetPosition(0);
+            data.parkParams.SetPosition(0);
+            data.cheatData.SetPosition(0);
+            data.gameStateSnapshots.SetPosition(0);
+
+            return true;
+        }
+
+        MemoryStream ReadSegmentData(ReplayRecordData& data, const ReplaySegment& segment)
+        {
+            auto& fs = *data.fileStream;
+            fs.SetPosition(segment.offset);
+
+            auto compressedData = std::make_unique<unsigned char[]>(segment.compressedSize);
+            fs.Read(compressedData.get(), segment.compressedSize);
+
+            // The returned stream takes ownership of the buffer, it outlives this function.
+            std::vector<uint8_t> buff(segment.uncompressedSize);
+            unsigned long outSize = static_cast<unsigned long>(segment.uncompressedSize);
+            auto status = uncompress(
+                buff.data(), &outSize, compressedData.get(), static_cast<unsigned long>(segment.compressedSize));
+            if (status != Z_OK || outSize != segment.uncompressedSize)
+            {
+                throw std::runtime_error("Unable to decompress replay segment.");
+            }
+            return MemoryStream(std::move(buff));
+        }
+
+        /**
+         * Loads the commands and checksums of all segments starting at or before the given tick.
+         */
+        void LoadCommandSegments(ReplayRecordData& data, uint32_t tick)
+        {
+            while (data.nextSegmentIndex < data.segments.size())
+            {
+                const auto& segment = data.segments[data.nextSegmentIndex];
+                if (segment.type == ReplaySegmentType::Commands)
+                {
+                    if (segment.tickStart > tick)
+                        break;
+
+                    ReadCommandSegment(data, segment);
+                }
+                data.nextSegmentIndex++;
+            }
+        }
+
+        void ReadCommandSegment(ReplayRecordData& data, const ReplaySegment& segment)
+        {
+            auto segmentData = ReadSegmentData(data, segment);
+            DataSerialiser serialiser(false, segmentData);
+
+            uint32_t countCommands = 0;
+            serialiser << countCommands;
+            for (uint32_t i = 0; i < countCommands; i++)
+            {
+                ReplayCommand command = {};
+                SerialiseCommand(serialiser, command);
+
+                // Skip commands that are already applied to the keyframe playback started from.
+                if (command.commandIndex >= data.commandIndexStart)
+                {
+                    data.commands.emplace(std::move(command));
+                }
+            }
+
+            // Checksums that were already checked are no longer needed.
+            data.checksums.erase(data.checksums.begin(), data.checksums.begin() + data.checksumIndex);
+            data.checksumIndex = 0;
+
+            uint32_t countChecksums = 0;
+            serialiser << countChecksums;
+            for (uint32_t i = 0; i < countChecksums; i++)
+            {
+                auto& checksum = data.checksums.emplace_back();
+                serialiser << checksum.first;
+                serialiser << checksum.second.raw;
+            }
+        }
+
+        bool UpdateRecordingStream(uint32_t currentTicks)
+        {
+            auto& recording = *_currentRecording;
+            try
+            {
+                if (currentTicks >= recording.segmentTickStart + SegmentTicks || currentTicks >= recording.nextKeyframeTick)
+                {
+                    WriteCommandSegment(recording, currentTicks);
+                }
+                if (currentTicks >= recording.nextKeyframeTick)
+                {
+                    WriteKeyframe(recording, currentTicks);
+                    recording.nextKeyframeTick = currentTicks + KeyframeTicks;
+                }
+            }
+            catch (const std::exception& ex)
+            {
+                LOG_ERROR("Unable to write to file '%s': %s", recording.filePath.c_str(), ex.what());
+                return false;
+            }
+            return true;
+        }
+
+        /**
+         * Writes all recorded commands and checksums before the given tick as a segment and removes them from memory.
+         */
+        void WriteCommandSegment(ReplayRecordData& recording, uint32_t tickEnd)
+        {
+            auto& commands = recording.commands;
+            auto& checksums = recording.checksums;
+            auto commandsEnd = std::find_if(
+                commands.begin(), commands.end(), [tickEnd](const ReplayCommand& command) { return command.tick >= tickEnd; });
+            auto checksumsEnd = std::find_if(checksums.begin(), checksums.end(), [tickEnd](const auto& checksum) {
+                return checksum.first >= tickEnd;
+            });
+
+            auto countCommands = static_cast<uint32_t>(std::distance(commands.begin(), commandsEnd));
+            auto countChecksums = static_cast<uint32_t>(std::distance(checksums.begin(), checksumsEnd));
+            if (countCommands != 0 || countChecksums != 0)
+            {
+                DataSerialiser serialiser(true);
+                serialiser << countCommands;
+                for (auto it = commands.begin(); it != commandsEnd; it++)
+                {
+                    SerialiseCommand(serialiser, const_cast<ReplayCommand&>(*it));
+                }
+                serialiser << countChecksums;
+                for (auto it = checksums.begin(); it != checksumsEnd; it++)
+                {
+                    serialiser << it->first;
+                    serialiser << it->second.raw;
+                }
+
+                WriteSegment(
+                    recording, ReplaySegmentType::Commands, recording.segmentTickStart, tickEnd - 1, countCommands,
+                    countChecksums, serialiser.GetStream());
+
+                commands.erase(commands.begin(), commandsEnd);
+                checksums.erase(checksums.begin(), checksumsEnd);
+            }
+            recording.segmentTickStart = tickEnd;
+        }
+
+        void WriteKeyframe(ReplayRecordData& recording, uint32_t tick)
+        {
+            ReplayKeyframe keyframe;
+            keyframe.tick = tick;
+            keyframe.commandIndex = _commandId;
+
+            auto& objManager = GetContext()->GetObjectManager();
+            auto exporter = std::make_unique<ParkFileExporter>();
+            exporter->ExportObjectsList = objManager.GetPackableObjects();
+            exporter->Export(GetGameState(), keyframe.parkData);
+
+            DataSerialiser parkParamsDs(true, keyframe.parkParams);
+            SerialiseParkParameters(parkParamsDs);
+
+            DataSerialiser keyframeDs(true);
+            SerialiseKeyframe(keyframeDs, keyframe);
+            WriteSegment(recording, ReplaySegmentType::Keyframe, tick, tick, 0, 0, keyframeDs.GetStream());
+        }
+
+        void WriteSegment(
+            ReplayRecordData& recording, ReplaySegmentType type, uint32_t tickStart, uint32_t tickEnd, uint32_t numCommands,
+            uint32_t numChecksums, IStream& stream)
+        {
+            unsigned long streamLength = static_cast<unsigned long>(stream.GetLength());
+            unsigned long compressLength = compressBound(streamLength);
+
+            auto compressBuf = std::make_unique<unsigned char[]>(compressLength);
+            auto status = compress2(
+                compressBuf.get(), &compressLength, static_cast<const unsigned char*>(stream.GetData()), streamLength,
+                ReplayCompressionLevel);
+            if (status != Z_OK)
+            {
+                throw std::runtime_error("Unable to compress replay segment.");
+            }
+
+            ReplaySegment segment;
+            segment.type = type;
+            segment.tickStart = tickStart;
+            segment.tickEnd = tickEnd;
+            segment.numCommands = numCommands;
+            segment.numChecksums = numChecksums;
+            segment.uncompressedSize = streamLength;
+            segment.compressedSize = compressLength;
+
+            auto& fs = *recording.fileStream;
+            DataSerialiser segmentDs(true, fs);
+            SerialiseSegmentHeader(segmentDs, segment);
+            fs.Write(compressBuf.get(), compressLength);
+        }
+
+        void SerialiseSegmentHeader(DataSerialiser& serialiser, ReplaySegment& segment)
+        {
+            serialiser << segment.type;
+            serialiser << segment.tickStart;
+            serialiser << segment.tickEnd;
+            serialiser << segment.numCommands;
+            serialiser << segment.numChecksums;
+            serialiser << segment.uncompressedSize;
+            serialiser << segment.compressedSize;
+        }
+
+        void SerialiseKeyframe(DataSerialiser& serialiser, ReplayKeyframe& keyframe)
+        {
+            serialiser << keyframe.tick;
+            serialiser << keyframe.commandIndex;
+            serialiser << keyframe.parkData;
+            serialiser << keyframe.parkParams;
+        }
+
+        void SerialiseInfo(DataSerialiser& serialiser, ReplayRecordData& data)
+        {
+            // Starts with the same layout as a keyframe so seeking can treat it as one.
+            serialiser << data.tickStart;
+            serialiser << data.commandIndexStart;
+            serialiser << data.parkData;
+            serialiser << data.parkParams;
+
+            serialiser << data.networkId;
+#ifndef DISABLE_NETWORK
+            // NOTE: This does not mean the replay will not function, only a warning.
+            if (data.networkId != NetworkGetVersion())
+            {
+                LOG_WARNING(
+                    "Replay network version mismatch: '%s', expected: '%s'", data.networkId.c_str(),
+                    NetworkGetVersion().c_str());
+            }
+#endif
+
+            serialiser << data.name;
+            serialiser << data.timeRecorded;
+            serialiser << data.cheatData;
+            serialiser << data.gameStateSnapshots;
+        }
+
         bool SerialiseCheats(DataSerialiser& serialiser)
         {
             CheatsSerialise(serialiser);
@@ -718,9 +1248,12 @@ namespace OpenRCT2
 
         bool Compatible(ReplayRecordData& data)
         {
-            return data.version == ReplayVersion;
+            return data.version == ReplayVersionMonolithic;
         }
 
+        /**
+         * Reads replays recorded before streamed recordings were introduced.
+         */
         bool Serialise(DataSerialiser& serialiser, ReplayRecordData& data)
         {
             serialiser << data.magic;
@@ -14,6 +14,7 @@
 #include <memory>
 #include <set>
 #include <string>
+#include <vector>
 
 class GameAction;
 
@@ -32,6 +33,12 @@ namespace OpenRCT2
         std::string FilePath;
     };
 
+    struct ReplayGameAction
+    {
+        uint32_t Tick;
+        std::unique_ptr<GameAction> Action;
+    };
+
     struct IReplayManager
     {
     public:
@@ -59,10 +66,14 @@ namespace OpenRCT2
         virtual bool GetCurrentReplayInfo(ReplayRecordInfo& info) const = 0;
 
         virtual bool StartPlayback(const std::string& file) = 0;
+        virtual bool SeekPlayback(uint32_t tick) = 0;
         virtual bool IsPlaybackStateMismatching() const = 0;
         virtual bool StopPlayback() = 0;
 
         virtual bool NormaliseReplay(const std::string& inputFile, const std::string& outputFile) = 0;
+
+        // Loads the starting park of a replay and returns its game actions without playing them back.
+        virtual bool LoadReplayGameActions(const std::string& file, std::vector<ReplayGameAction>& actions) = 0;
     };
 
     [[nodiscard]] std::unique_ptr<IReplayManager> CreateReplayManager();
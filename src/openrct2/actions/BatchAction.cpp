@@ -0,0 +1,176 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2024 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#include "BatchAction.h"
+
+#include "../Diagnostic.h"
+#include "../localisation/StringIds.h"
+#include "../management/Finance.h"
+
+#include <stdexcept>
+
+void BatchAction::AddAction(GameAction::Ptr&& action)
+{
+    _actions.push_back(std::move(action));
+}
+
+const std::vector<GameAction::Ptr>& BatchAction::GetActions() const
+{
+    return _actions;
+}
+
+bool BatchAction::IsEmpty() const
+{
+    return _actions.empty();
+}
+
+uint16_t BatchAction::GetActionFlags() const
+{
+    auto flags = GameAction::GetActionFlags();
+    if (_actions.empty())
+    {
+        return flags;
+    }
+
+    // The batch may only do what all of its actions may do, but is editor only as soon as one of them is.
+    uint16_t allFlags = GameActions::Flags::AllowWhilePaused | GameActions::Flags::IgnoreForReplays;
+    for (const auto& action : _actions)
+    {
+        const auto actionFlags = action->GetActionFlags();
+        allFlags &= actionFlags;
+        flags |= actionFlags & GameActions::Flags::EditorOnly;
+    }
+    return flags | allFlags;
+}
+
+uint32_t BatchAction::GetCooldownTime() const
+{
+    uint32_t cooldownTime = 0;
+    for (const auto& action : _actions)
+    {
+        cooldownTime += action->GetCooldownTime();
+    }
+    return cooldownTime;
+}
+
+void BatchAction::Serialise(DataSerialiser& stream)
+{
+    GameAction::Serialise(stream);
+
+    auto count = static_cast<uint32_t>(_actions.size());
+    stream << DS_TAG(count);
+
+    if (stream.IsLoading())
+    {
+        if (count > kMaxActions)
+        {
+            throw std::runtime_error("Too many actions in batch.");
+        }
+
+        _actions.clear();
+        _actions.reserve(count);
+        for (uint32_t i = 0; i < count; i++)
+        {
+            GameCommand type{};
+            stream << DS_TAG(type);
+
+            auto action = type != GameCommand::Batch ? GameActions::Create(type) : nullptr;
+            if (action == nullptr)
+            {
+                throw std::runtime_error("Invalid action in batch.");
+            }
+            action->Serialise(stream);
+            _actions.push_back(std::move(action));
+        }
+    }
+    else
+    {
+        for (const auto& action : _actions)
+        {
+            auto type = action->GetType();
+            stream << DS_TAG(type);
+            action->Serialise(stream);
+        }
+    }
+}
+
+void BatchAction::PrepareAction(GameAction& action) const
+{
+    action.SetFlags(GetFlags());
+    action.SetPlayer(GetPlayer());
+}
+
+void BatchAction::AddResult(GameActions::Result& result, const GameActions::Result& actionResult)
+{
+    if (result.Position.IsNull())
+    {
+        result.Position = actionResult.Position;
+    }
+    result.Cost += actionResult.Cost;
+}
+
+GameActions::Result BatchAction::Query() const
+{
+    if (_actions.empty())
+    {
+        return GameActions::Result(GameActions::Status::InvalidParameters, STR_CANT_DO_THIS, STR_NONE);
+    }
+
+    // All actions have to be possible for the batch to be.
+    auto result = GameActions::Result();
+    for (uint32_t i = 0; i < _actions.size(); i++)
+    {
+        auto& action = *_actions[i];
+        PrepareAction(action);
+        auto actionResult = GameActions::QueryNested(&action);
+        if (actionResult.Error != GameActions::Status::Ok)
+        {
+            actionResult.SetData(BatchActionResult{ 0, i });
+            return actionResult;
+        }
+        AddResult(result, actionResult);
+    }
+    result.SetData(BatchActionResult{});
+    return result;
+}
+
+GameActions::Result BatchAction::Execute() const
+{
+    // An action can still fail when an earlier one in the batch took its place. The batch stops there, the actions before
+    // it are not undone.
+    const auto payForActions = FinanceCheckMoneyRequired(GetFlags());
+    auto result = GameActions::Result();
+    uint32_t numExecuted = 0;
+    for (uint32_t i = 0; i < _actions.size(); i++)
+    {
+        auto& action = *_actions[i];
+        PrepareAction(action);
+        auto actionResult = GameActions::ExecuteNested(&action);
+        if (actionResult.Error != GameActions::Status::Ok)
+        {
+            LOG_VERBOSE("Batch stopped at action %u of %u: %s", i, static_cast<uint32_t>(_actions.size()), action.GetName());
+            if (numExecuted == 0)
+            {
+                actionResult.SetData(BatchActionResult{ 0, i });
+                return actionResult;
+            }
+            result.SetData(BatchActionResult{ numExecuted, i });
+            return result;
+        }
+
+        if (payForActions && actionResult.Cost != 0)
+        {
+            FinancePayment(actionResult.Cost, actionResult.Expenditure);
+        }
+        AddResult(result, actionResult);
+        numExecuted++;
+    }
+    result.SetData(BatchActionResult{ numExecuted, std::nullopt });
+    return result;
+}
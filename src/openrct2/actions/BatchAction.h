@@ -0,0 +1,53 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2024 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#pragma once
+
+#include "GameAction.h"
+
+#include <optional>
+#include <vector>
+
+struct BatchActionResult
+{
+    uint32_t NumExecuted{};
+    std::optional<uint32_t> FailedIndex;
+};
+
+/**
+ * Carries many actions as a single one so tools that generate lots of them only send and queue
+ * one. The flags and player of the batch apply to all of its actions, each action is paid for
+ * under its own expenditure type.
+ */
+class BatchAction final : public GameActionBase<GameCommand::Batch>
+{
+public:
+    static constexpr uint32_t kMaxActions = 4096;
+
+private:
+    std::vector<GameAction::Ptr> _actions;
+
+public:
+    BatchAction() = default;
+
+    void AddAction(GameAction::Ptr&& action);
+    const std::vector<GameAction::Ptr>& GetActions() const;
+    bool IsEmpty() const;
+
+    uint16_t GetActionFlags() const override;
+    uint32_t GetCooldownTime() const override;
+
+    void Serialise(DataSerialiser& stream) override;
+    GameActions::Result Query() const override;
+    GameActions::Result Execute() const override;
+
+private:
+    void PrepareAction(GameAction& action) const;
+    static void AddResult(GameActions::Result& result, const GameActions::Result& actionResult);
+};
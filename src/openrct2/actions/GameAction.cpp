@@ -151,6 +151,11 @@ namespace GameActions
                 // Relay this action to all other clients.
                 NetworkSendGameAction(action);
             }
+            else if (NetworkGetMode() == NETWORK_MODE_CLIENT)
+            {
+                // Spectators of a relay replay everything the server sent, whatever the outcome was here.
+                NetworkRelayGameAction(action);
+            }
 
             _actionQueue.erase(_actionQueue.begin());
         }
@@ -373,10 +378,13 @@ namespace GameActions
             if (!topLevel)
                 return result;
 
-            // Update money balance
+            // Update money balance, a result without an expenditure type was paid for by the actions it is made of.
             if (result.Error == GameActions::Status::Ok && FinanceCheckMoneyRequired(flags) && result.Cost != 0)
             {
-                FinancePayment(result.Cost, result.Expenditure);
+                if (result.Expenditure != ExpenditureType::Count)
+                {
+                    FinancePayment(result.Cost, result.Expenditure);
+                }
                 MoneyEffect::Create(result.Cost, result.Position);
             }
 
@@ -13,6 +13,7 @@
 #include "BannerSetColourAction.h"
 #include "BannerSetNameAction.h"
 #include "BannerSetStyleAction.h"
+#include "BatchAction.h"
 #include "CheatSetAction.h"
 #include "ClearAction.h"
 #include "ClimateSetAction.h"
@@ -210,6 +211,7 @@ namespace GameActions
         REGISTER_ACTION(MapChangeSizeAction);
         REGISTER_ACTION(GameSetSpeedAction);
         REGISTER_ACTION(ScenerySetRestrictedAction);
+        REGISTER_ACTION(BatchAction);
 #ifdef ENABLE_SCRIPTING
         REGISTER_ACTION(CustomAction);
 #endif
@@ -118,6 +118,9 @@ namespace CommandLine
     extern const CommandLineCommand SpriteCommands[];
     extern const CommandLineCommand SimulateCommands[];
     extern const CommandLineCommand ParkInfoCommands[];
+#ifndef DISABLE_NETWORK
+    extern const CommandLineCommand LoadTestCommands[];
+#endif
 
     extern const CommandLineExample RootExamples[];
 
@@ -125,5 +128,6 @@ namespace CommandLine
     exitcode_t HandleCommandDefault();
 
     exitcode_t HandleCommandConvert(CommandLineArgEnumerator* enumerator);
+    exitcode_t HandleCommandConvertBatch(CommandLineArgEnumerator* enumerator);
     exitcode_t HandleCommandUri(CommandLineArgEnumerator* enumerator);
 } // namespace CommandLine
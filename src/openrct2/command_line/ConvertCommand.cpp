@@ -14,19 +14,35 @@
 #include "../ParkImporter.h"
 #include "../common.h"
 #include "../core/Console.hpp"
+#include "../core/File.h"
+#include "../core/FileScanner.h"
+#include "../core/FileStream.h"
+#include "../core/JobPool.h"
+#include "../core/MemoryStream.h"
 #include "../core/Path.hpp"
+#include "../core/String.hpp"
 #include "../interface/Window.h"
 #include "../object/ObjectManager.h"
 #include "../park/ParkFile.h"
 #include "../scenario/Scenario.h"
 #include "CommandLine.hpp"
 
+#include <algorithm>
+#include <chrono>
 #include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
 
 using namespace OpenRCT2;
 
 static void WriteConvertFromAndToMessage(FileExtension sourceFileType, FileExtension destinationFileType);
 static u8string GetFileTypeFriendlyName(FileExtension fileType);
+static bool IsConvertibleSourceType(FileExtension fileType);
+static void ConvertPark(
+    IContext& context, const u8string& sourcePath, FileExtension sourceFileType, IStream& source, IStream& destination);
+static std::vector<u8string> GetBatchSourcePaths(const u8string& sourcePath, u8string& sourceBasePath);
 
 exitcode_t CommandLine::HandleCommandConvert(CommandLineArgEnumerator* enumerator)
 {
@@ -66,23 +82,15 @@ exitcode_t CommandLine::HandleCommandConvert(CommandLineArgEnumerator* enumerato
     }
 
     // Validate the source type
-    switch (sourceFileType)
+    if (sourceFileType == FileExtension::PARK)
     {
-        case FileExtension::SC4:
-        case FileExtension::SV4:
-        case FileExtension::SC6:
-        case FileExtension::SV6:
-            break;
-        case FileExtension::PARK:
-            if (destinationFileType == FileExtension::PARK)
-            {
-                Console::Error::WriteLine("File is already an OpenRCT2 saved game or scenario.");
-                return EXITCODE_FAIL;
-            }
-            break;
-        default:
-            Console::Error::WriteLine("Only conversion from .SC4, .SV4, .SC6 or .SV6 is supported.");
-            return EXITCODE_FAIL;
+        Console::Error::WriteLine("File is already an OpenRCT2 saved game or scenario.");
+        return EXITCODE_FAIL;
+    }
+    if (!IsConvertibleSourceType(sourceFileType))
+    {
+        Console::Error::WriteLine("Only conversion from .SC4, .SV4, .SC6 or .SV6 is supported.");
+        return EXITCODE_FAIL;
     }
 
     // Perform conversion
@@ -92,18 +100,14 @@ exitcode_t CommandLine::HandleCommandConvert(CommandLineArgEnumerator* enumerato
     auto context = OpenRCT2::CreateContext();
     context->Initialise();
 
-    auto& objManager = context->GetObjectManager();
-    auto& gameState = GetGameState();
-
     try
     {
-        auto importer = ParkImporter::Create(sourcePath);
-        auto loadResult = importer->Load(sourcePath.c_str());
-
-        objManager.LoadObjects(loadResult.RequiredObjects);
+        auto source = FileStream(sourcePath, FILE_MODE_OPEN);
 
-        // TODO: Have a separate GameState and exchange once loaded.
-        importer->Import(gameState);
+        // Only write the destination once the park has been converted, so a failed import leaves it as it was
+        auto destination = MemoryStream();
+        ConvertPark(*context, sourcePath, sourceFileType, source, destination);
+        File::WriteAllBytes(destinationPath, destination.GetData(), destination.GetLength());
     }
     catch (const std::exception& ex)
     {
@@ -111,21 +115,55 @@ exitcode_t CommandLine::HandleCommandConvert(CommandLineArgEnumerator* enumerato
         return EXITCODE_FAIL;
     }
 
-    if (sourceFileType == FileExtension::SC4 || sourceFileType == FileExtension::SC6)
+    Console::WriteLine("Conversion successful!");
+    return EXITCODE_OK;
+}
+
+namespace
+{
+    struct BatchConvertItem
+    {
+        u8string SourcePath;
+        u8string DestinationPath;
+        FileExtension SourceFileType{};
+        std::vector<uint8_t> SourceData;
+        std::vector<uint8_t> DestinationData;
+        std::string Error;
+    };
+} // namespace
+
+exitcode_t CommandLine::HandleCommandConvertBatch(CommandLineArgEnumerator* enumerator)
+{
+    exitcode_t result = CommandLine::HandleCommandDefault();
+    if (result != EXITCODE_CONTINUE)
     {
-        // We are converting a scenario, so reset the park
-        ScenarioBegin(gameState);
+        return result;
     }
 
-    try
+    // Get the source directory or manifest path
+    const utf8* rawSourcePath;
+    if (!enumerator->TryPopString(&rawSourcePath))
     {
-        auto exporter = std::make_unique<ParkFileExporter>();
+        Console::Error::WriteLine("Expected a source directory or manifest path.");
+        return EXITCODE_FAIL;
+    }
 
-        // HACK remove the main window so it saves the park with the
-        //      correct initial view
-        WindowCloseByClass(WindowClass::MainWindow);
+    // Get the destination directory
+    const utf8* rawDestinationPath;
+    if (!enumerator->TryPopString(&rawDestinationPath))
+    {
+        Console::Error::WriteLine("Expected a destination directory.");
+        return EXITCODE_FAIL;
+    }
 
-        exporter->Export(gameState, destinationPath);
+    const auto sourcePath = Path::GetAbsolute(rawSourcePath);
+    const auto destinationDirectory = Path::GetAbsolute(rawDestinationPath);
+
+    u8string sourceBasePath;
+    std::vector<u8string> sourcePaths;
+    try
+    {
+        sourcePaths = GetBatchSourcePaths(sourcePath, sourceBasePath);
     }
     catch (const std::exception& ex)
     {
@@ -133,8 +171,230 @@ exitcode_t CommandLine::HandleCommandConvert(CommandLineArgEnumerator* enumerato
         return EXITCODE_FAIL;
     }
 
-    Console::WriteLine("Conversion successful!");
-    return EXITCODE_OK;
+    std::vector<BatchConvertItem> items;
+    items.reserve(sourcePaths.size());
+    for (auto& path : sourcePaths)
+    {
+        auto sourceFileType = GetFileExtensionType(path.c_str());
+        if (!IsConvertibleSourceType(sourceFileType))
+        {
+            Console::Error::WriteLine("Skipping '%s', only .SC4, .SV4, .SC6 or .SV6 is supported.", path.c_str());
+            continue;
+        }
+
+        // Keep the directory structure relative to the source, unless the file is outside of it
+        auto relativePath = Path::GetRelative(path, sourceBasePath);
+        if (relativePath.empty() || String::StartsWith(relativePath, ".."))
+        {
+            relativePath = Path::GetFileName(path);
+        }
+
+        auto& item = items.emplace_back();
+        item.DestinationPath = Path::WithExtension(Path::Combine(destinationDirectory, relativePath), ".park");
+        item.SourcePath = std::move(path);
+        item.SourceFileType = sourceFileType;
+    }
+
+    if (items.empty())
+    {
+        Console::Error::WriteLine("No files to convert.");
+        return EXITCODE_FAIL;
+    }
+
+    // The object repository is only loaded once for the whole batch
+    gOpenRCT2Headless = true;
+    auto context = OpenRCT2::CreateContext();
+    context->Initialise();
+
+    Console::WriteLine("Converting %zu files to OpenRCT2 parks.", items.size());
+
+    auto startTime = std::chrono::high_resolution_clock::now();
+
+    // The game state is global so parks have to be imported and exported one at a time on this thread.
+    // Reading the source files and writing the converted parks is done by the job pool, in windows so that
+    // only a bounded number of files is held in memory at once.
+    const size_t windowSize = std::max<size_t>(std::thread::hardware_concurrency(), 1) * 2;
+    size_t numConverted = 0;
+    uint64_t bytesRead = 0;
+    uint64_t bytesWritten = 0;
+    std::mutex statsLock;
+    {
+        JobPool jobPool;
+        for (size_t windowStart = 0; windowStart < items.size(); windowStart += windowSize)
+        {
+            const auto windowEnd = std::min(windowStart + windowSize, items.size());
+            for (size_t i = windowStart; i < windowEnd; i++)
+            {
+                auto& item = items[i];
+                auto writeItem = [&item, &statsLock, &bytesWritten, &numConverted]() {
+                    try
+                    {
+                        Path::CreateDirectory(Path::GetDirectory(item.DestinationPath));
+                        File::WriteAllBytes(item.DestinationPath, item.DestinationData.data(), item.DestinationData.size());
+
+                        std::lock_guard<std::mutex> lock(statsLock);
+                        bytesWritten += item.DestinationData.size();
+                        numConverted++;
+                    }
+                    catch (const std::exception& ex)
+                    {
+                        item.Error = ex.what();
+                    }
+                    item.DestinationData = {};
+                };
+                auto convertItem = [&item, &context, &jobPool, writeItem]() {
+                    if (!item.Error.empty())
+                    {
+                        return;
+                    }
+
+                    try
+                    {
+                        auto source = MemoryStream(item.SourceData.data(), item.SourceData.size());
+                        auto destination = MemoryStream();
+                        ConvertPark(*context, item.SourcePath, item.SourceFileType, source, destination);
+
+                        auto data = static_cast<const uint8_t*>(destination.GetData());
+                        item.DestinationData.assign(data, data + destination.GetLength());
+                        jobPool.AddTask(writeItem);
+                    }
+                    catch (const std::exception& ex)
+                    {
+                        item.Error = ex.what();
+                    }
+                    item.SourceData = {};
+                };
+                auto readItem = [&item, &statsLock, &bytesRead]() {
+                    try
+                    {
+                        item.SourceData = File::ReadAllBytes(item.SourcePath);
+
+                        std::lock_guard<std::mutex> lock(statsLock);
+                        bytesRead += item.SourceData.size();
+                    }
+                    catch (const std::exception& ex)
+                    {
+                        item.Error = ex.what();
+                    }
+                };
+                jobPool.AddTask(readItem, convertItem);
+            }
+
+            jobPool.Join([&]() {
+                Console::WriteFormat(
+                    "File %5zu of %zu, done %3zu%%\r", windowEnd, items.size(), windowEnd * 100 / items.size());
+            });
+        }
+    }
+    Console::WriteLine();
+
+    auto endTime = std::chrono::high_resolution_clock::now();
+    auto duration = std::chrono::duration<double>(endTime - startTime).count();
+
+    for (const auto& item : items)
+    {
+        if (!item.Error.empty())
+        {
+            Console::Error::WriteLine("Failed to convert '%s': %s", item.SourcePath.c_str(), item.Error.c_str());
+        }
+    }
+
+    const auto numFailed = items.size() - numConverted;
+    const auto filesPerSecond = duration > 0 ? numConverted / duration : 0.0;
+    const auto megabytesPerSecond = duration > 0 ? (bytesRead / (1024.0 * 1024.0)) / duration : 0.0;
+    Console::WriteLine(
+        "Converted %zu of %zu files in %.2f seconds (%.1f files/s, %.1f MiB/s read, %.1f MiB written), %zu failed.",
+        numConverted, items.size(), duration, filesPerSecond, megabytesPerSecond, bytesWritten / (1024.0 * 1024.0),
+        numFailed);
+    return numFailed == 0 ? EXITCODE_OK : EXITCODE_FAIL;
+}
+
+static bool IsConvertibleSourceType(FileExtension fileType)
+{
+    switch (fileType)
+    {
+        case FileExtension::SC4:
+        case FileExtension::SV4:
+        case FileExtension::SC6:
+        case FileExtension::SV6:
+            return true;
+        default:
+            return false;
+    }
+}
+
+/**
+ * Imports the park from the source stream into the current game state and exports it as an OpenRCT2 park.
+ */
+static void ConvertPark(
+    IContext& context, const u8string& sourcePath, FileExtension sourceFileType, IStream& source, IStream& destination)
+{
+    auto& objManager = context.GetObjectManager();
+    auto& gameState = GetGameState();
+
+    auto importer = ParkImporter::Create(sourcePath);
+    const bool isScenario = sourceFileType == FileExtension::SC4 || sourceFileType == FileExtension::SC6;
+    auto loadResult = importer->LoadFromStream(&source, isScenario, false, sourcePath);
+
+    objManager.LoadObjects(loadResult.RequiredObjects);
+
+    // TODO: Have a separate GameState and exchange once loaded.
+    importer->Import(gameState);
+
+    if (isScenario)
+    {
+        // We are converting a scenario, so reset the park
+        ScenarioBegin(gameState);
+    }
+
+    auto exporter = std::make_unique<ParkFileExporter>();
+
+    // HACK remove the main window so it saves the park with the
+    //      correct initial view
+    WindowCloseByClass(WindowClass::MainWindow);
+
+    exporter->Export(gameState, destination);
+}
+
+/**
+ * Gets the files to convert from either a directory (searched recursively) or a manifest listing one path per line.
+ * Relative paths in a manifest are relative to the manifest's directory.
+ */
+static std::vector<u8string> GetBatchSourcePaths(const u8string& sourcePath, u8string& sourceBasePath)
+{
+    std::vector<u8string> paths;
+    if (Path::DirectoryExists(sourcePath))
+    {
+        sourceBasePath = sourcePath;
+        auto scanner = Path::ScanDirectory(Path::Combine(sourcePath, u8"*.sc4;*.sv4;*.sc6;*.sv6"), true);
+        while (scanner->Next())
+        {
+            paths.push_back(scanner->GetPath());
+        }
+        std::sort(paths.begin(), paths.end());
+    }
+    else if (File::Exists(sourcePath))
+    {
+        sourceBasePath = Path::GetDirectory(sourcePath);
+        for (const auto& line : File::ReadAllLines(sourcePath))
+        {
+            auto path = String::Trim(line);
+            if (path.empty())
+            {
+                continue;
+            }
+            if (!Path::IsAbsolute(path))
+            {
+                path = Path::Combine(sourceBasePath, path);
+            }
+            paths.push_back(Path::GetAbsolute(path));
+        }
+    }
+    else
+    {
+        throw std::runtime_error("Source directory or manifest does not exist.");
+    }
+    return paths;
 }
 
 static void WriteConvertFromAndToMessage(FileExtension sourceFileType, FileExtension destinationFileType)
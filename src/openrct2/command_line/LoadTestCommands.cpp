@@ -0,0 +1,117 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2024 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#ifndef DISABLE_NETWORK
+
+#    include "../Context.h"
+#    include "../GameState.h"
+#    include "../OpenRCT2.h"
+#    include "../ReplayManager.h"
+#    include "../actions/GameAction.h"
+#    include "../config/Config.h"
+#    include "../core/Console.hpp"
+#    include "../network/NetworkLoadTest.h"
+#    include "../network/network.h"
+#    include "../platform/Platform.h"
+#    include "CommandLine.hpp"
+
+#    include <algorithm>
+#    include <chrono>
+#    include <cstdlib>
+#    include <memory>
+#    include <thread>
+
+using namespace OpenRCT2;
+
+static exitcode_t HandleLoadTest(CommandLineArgEnumerator* argEnumerator);
+
+const CommandLineCommand CommandLine::LoadTestCommands[]{
+    // Main commands
+    DefineCommand("", "<replay> <bots> [actions/s] [seconds]", nullptr, HandleLoadTest), CommandTableEnd
+};
+
+static exitcode_t HandleLoadTest(CommandLineArgEnumerator* argEnumerator)
+{
+    const char** argv = const_cast<const char**>(argEnumerator->GetArguments()) + argEnumerator->GetIndex();
+    int32_t argc = argEnumerator->GetCount() - argEnumerator->GetIndex();
+
+    if (argc < 2)
+    {
+        Console::Error::WriteLine("Missing arguments <replay> <bots>.");
+        return EXITCODE_FAIL;
+    }
+
+    const char* replayPath = argv[0];
+    const auto numBots = static_cast<uint32_t>(atol(argv[1]));
+    const auto actionsPerSecond = argc > 2 ? static_cast<float>(atof(argv[2])) : 1.0f;
+    const auto seconds = argc > 3 ? static_cast<uint32_t>(atol(argv[3])) : 60;
+
+    gOpenRCT2Headless = true;
+
+    std::unique_ptr<IContext> context(CreateContext());
+    if (!context->Initialise())
+    {
+        Console::Error::WriteLine("Context initialization failed.");
+        return EXITCODE_FAIL;
+    }
+
+    // The park is loaded from the replay so its actions apply to the state they were recorded in.
+    std::vector<ReplayGameAction> actions;
+    if (!context->GetReplayManager()->LoadReplayGameActions(replayPath, actions))
+    {
+        Console::Error::WriteLine("Unable to load replay '%s'.", replayPath);
+        return EXITCODE_FAIL;
+    }
+    gScreenFlags = SCREEN_FLAGS_PLAYING;
+
+    // Only for this process, the configuration is not saved.
+    gConfigNetwork.Maxplayers = std::max<int32_t>(gConfigNetwork.Maxplayers, numBots + 1);
+    gConfigNetwork.KnownKeysOnly = false;
+
+    const auto port = gConfigNetwork.DefaultPort;
+    if (!NetworkBeginServer(port, "127.0.0.1"))
+    {
+        Console::Error::WriteLine("Unable to start the server on port %d.", port);
+        return EXITCODE_FAIL;
+    }
+
+    try
+    {
+        NetworkLoadTest loadTest(port, numBots, std::move(actions), actionsPerSecond);
+
+        Console::WriteLine(
+            "Running %u bots at %.1f actions/s each for %u seconds...", numBots, actionsPerSecond, seconds);
+
+        const auto tickInterval = std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+            std::chrono::duration<float>(kGameUpdateTimeMS));
+        const auto endTime = std::chrono::steady_clock::now() + std::chrono::seconds(seconds);
+        for (auto nextTick = std::chrono::steady_clock::now(); nextTick < endTime; nextTick += tickInterval)
+        {
+            const auto tickStart = std::chrono::steady_clock::now();
+            context->GetGameState()->UpdateLogic();
+            const auto tickTime = std::chrono::steady_clock::now() - tickStart;
+
+            loadTest.Update(std::chrono::duration<double, std::milli>(tickTime).count());
+
+            // Keep the normal tick rate, a server that can not keep up falls behind like it would when hosting.
+            std::this_thread::sleep_until(nextTick + tickInterval);
+        }
+
+        loadTest.PrintReport();
+    }
+    catch (const std::exception& e)
+    {
+        Console::Error::WriteLine("Load test failed: %s", e.what());
+        return EXITCODE_FAIL;
+    }
+
+    return EXITCODE_OK;
+}
+
+#endif // DISABLE_NETWORK
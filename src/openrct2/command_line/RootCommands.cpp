@@ -42,9 +42,12 @@ int32_t gNetworkStart = NETWORK_MODE_NONE;
 std::string gNetworkStartHost;
 int32_t gNetworkStartPort = NETWORK_DEFAULT_PORT;
 std::string gNetworkStartAddress;
+bool gNetworkStartRelay = false;
+int32_t gNetworkStartRelayPort = 0;
 
 static uint32_t _port = 0;
 static char* _address = nullptr;
+static char* _relay = nullptr;
 #endif
 
 static bool _help = false;
@@ -74,6 +77,7 @@ static constexpr CommandLineOptionDefinition StandardOptions[]
 #ifndef DISABLE_NETWORK
     { CMDLINE_TYPE_INTEGER, &_port,             NAC, "port",               "port to use for hosting or joining a server"                },
     { CMDLINE_TYPE_STRING,  &_address,          NAC, "address",            "address to listen on when hosting a server"                 },
+    { CMDLINE_TYPE_STRING,  &_relay,            NAC, "relay",              "relay the server at <host[:port]> to spectators"            },
 #endif
     { CMDLINE_TYPE_STRING,  &_password,         NAC, "password",           "password needed to join the server"                         },
     { CMDLINE_TYPE_STRING,  &_userDataPath,     NAC, "user-data-path",     "path to the user data directory (containing config.ini)"    },
@@ -130,6 +134,7 @@ const CommandLineCommand CommandLine::RootCommands[]
 #endif
     DefineCommand("set-rct2", "<path>",                 StandardOptions, HandleCommandSetRCT2),
     DefineCommand("convert",  "<source> <destination>", StandardOptions, CommandLine::HandleCommandConvert),
+    DefineCommand("convert-batch", "<source> <destination>", StandardOptions, CommandLine::HandleCommandConvertBatch),
     DefineCommand("scan-objects", "<path>",             StandardOptions, HandleCommandScanObjects),
     DefineCommand("handle-uri", "openrct2://.../",      StandardOptions, CommandLine::HandleCommandUri),
 
@@ -142,6 +147,9 @@ const CommandLineCommand CommandLine::RootCommands[]
     DefineSubCommand("sprite",          CommandLine::SpriteCommands           ),
     DefineSubCommand("simulate",        CommandLine::SimulateCommands         ),
     DefineSubCommand("parkinfo",        CommandLine::ParkInfoCommands         ),
+#ifndef DISABLE_NETWORK
+    DefineSubCommand("loadtest",        CommandLine::LoadTestCommands         ),
+#endif
     CommandTableEnd
 };
 
@@ -156,6 +164,7 @@ const CommandLineExample CommandLine::RootExamples[]
 #ifndef DISABLE_NETWORK
     { "host ./my_park.sv6 --port 11753 --headless",   "run a headless server for a saved park" },
 #endif
+    { "convert-batch ./saves ./converted",            "convert all legacy parks in a directory" },
     ExampleTableEnd
 };
 // clang-format on
@@ -285,6 +294,27 @@ exitcode_t HandleCommandHost(CommandLineArgEnumerator* enumerator)
         return result;
     }
 
+    if (_relay != nullptr)
+    {
+        // The park comes from the upstream server, spectators connect to --port and --address.
+        std::string upstreamHost = _relay;
+        int32_t upstreamPort = 0;
+        auto colon = upstreamHost.find(':');
+        if (colon != std::string::npos && colon == upstreamHost.rfind(':'))
+        {
+            upstreamPort = atoi(upstreamHost.c_str() + colon + 1);
+            upstreamHost.resize(colon);
+        }
+
+        gNetworkStart = NETWORK_MODE_CLIENT;
+        gNetworkStartHost = upstreamHost;
+        gNetworkStartPort = upstreamPort;
+        gNetworkStartRelay = true;
+        gNetworkStartRelayPort = _port;
+        gNetworkStartAddress = String::ToStd(_address);
+        return EXITCODE_CONTINUE;
+    }
+
     const char* parkUri;
     if (!enumerator->TryPopString(&parkUri))
     {
@@ -207,6 +207,8 @@ namespace Config
 #else
             model->MultiThreading = reader->GetBoolean("multithreading", true);
 #endif // _DEBUG
+            model->LazyLoadImages = reader->GetBoolean("lazy_load_images", true);
+            model->ImageCacheBudget = reader->GetInt32("image_cache_budget", 512);
             model->TrapCursor = reader->GetBoolean("trap_cursor", false);
             model->AutoOpenShops = reader->GetBoolean("auto_open_shops", false);
             model->ScenarioSelectMode = reader->GetInt32("scenario_select_mode", SCENARIO_SELECT_MODE_ORIGIN);
@@ -292,6 +294,8 @@ namespace Config
         writer->WriteFloat("window_scale", model->WindowScale);
         writer->WriteBoolean("show_fps", model->ShowFPS);
         writer->WriteBoolean("multithreading", model->MultiThreading);
+        writer->WriteBoolean("lazy_load_images", model->LazyLoadImages);
+        writer->WriteInt32("image_cache_budget", model->ImageCacheBudget);
         writer->WriteBoolean("trap_cursor", model->TrapCursor);
         writer->WriteBoolean("auto_open_shops", model->AutoOpenShops);
         writer->WriteInt32("scenario_select_mode", model->ScenarioSelectMode);
@@ -569,6 +573,9 @@ namespace Config
             auto model = &gConfigPlugin;
             model->EnableHotReloading = reader->GetBoolean("enable_hot_reloading", false);
             model->AllowedHosts = reader->GetString("allowed_hosts", "");
+            model->HookSoftBudget = reader->GetFloat("hook_soft_budget", 5.0f);
+            model->HookHardBudget = reader->GetFloat("hook_hard_budget", 0.0f);
+            model->MemoryLimit = reader->GetInt32("memory_limit", 0);
         }
     }
 
@@ -578,6 +585,9 @@ namespace Config
         writer->WriteSection("plugin");
         writer->WriteBoolean("enable_hot_reloading", model->EnableHotReloading);
         writer->WriteString("allowed_hosts", model->AllowedHosts);
+        writer->WriteFloat("hook_soft_budget", model->HookSoftBudget);
+        writer->WriteFloat("hook_hard_budget", model->HookHardBudget);
+        writer->WriteInt32("memory_limit", model->MemoryLimit);
     }
 
     static bool SetDefaults()
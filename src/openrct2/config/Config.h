@@ -43,6 +43,8 @@ struct GeneralConfiguration
     bool UseVSync;
     bool ShowFPS;
     bool MultiThreading;
+    bool LazyLoadImages;
+    int32_t ImageCacheBudget;
     bool MinimizeFullscreenFocusLoss;
     bool DisableScreensaver;
 
@@ -219,6 +221,11 @@ struct PluginConfiguration
 {
     bool EnableHotReloading;
     u8string AllowedHosts;
+    // Milliseconds an intransient plugin's hooks may take per tick before a warning or suspending them, 0 to disable.
+    float HookSoftBudget;
+    float HookHardBudget;
+    // Megabytes of the script heap each plugin may keep alive, 0 for no limit.
+    int32_t MemoryLimit;
 };
 
 enum class Sort : int32_t
@@ -11,6 +11,7 @@
 
 #include "../common.h"
 #include "Console.hpp"
+#include "Crypt.h"
 #include "DataSerialiser.h"
 #include "File.h"
 #include "FileScanner.h"
@@ -19,10 +20,14 @@
 #include "Numerics.hpp"
 #include "Path.hpp"
 
+#include <algorithm>
 #include <chrono>
-#include <list>
+#include <cstring>
+#include <optional>
 #include <string>
+#include <string_view>
 #include <tuple>
+#include <unordered_map>
 #include <vector>
 
 template<typename TItem> class FileIndex
@@ -36,18 +41,36 @@ private:
         uint32_t PathChecksum = 0;
     };
 
+    struct FileRecord
+    {
+        std::string Path;
+        uint64_t Size = 0;
+        uint64_t LastModified = 0;
+        // Only known once the file was touched without changing size, 0 until then.
+        uint64_t ContentHash = 0;
+    };
+
     struct ScanResult
     {
         DirectoryStats const Stats;
-        std::vector<std::string> const Files;
+        std::vector<FileRecord> const Files;
 
-        ScanResult(DirectoryStats stats, std::vector<std::string>&& files) noexcept
+        ScanResult(DirectoryStats stats, std::vector<FileRecord>&& files) noexcept
             : Stats(stats)
             , Files(std::move(files))
         {
         }
     };
 
+    /**
+     * A single file known to the index along with the item created from it, if any.
+     */
+    struct IndexEntry
+    {
+        FileRecord File;
+        std::optional<TItem> Item;
+    };
+
     struct FileIndexHeader
     {
         uint32_t HeaderSize = sizeof(FileIndexHeader);
@@ -56,11 +79,11 @@ private:
         uint8_t VersionB = 0;
         uint16_t LanguageId = 0;
         DirectoryStats Stats;
-        uint32_t NumItems = 0;
+        uint32_t NumFiles = 0;
     };
 
     // Index file format version which when incremented forces a rebuild
-    static constexpr uint8_t FILE_INDEX_VERSION = 4;
+    static constexpr uint8_t FILE_INDEX_VERSION = 5;
 
     std::string const _name;
     uint32_t const _magicNumber;
@@ -96,25 +119,27 @@ public:
     virtual ~FileIndex() = default;
 
     /**
-     * Queries and directories and loads the index header. If the index is up to date,
-     * the items are loaded from the index and returned, otherwise the index is rebuilt.
+     * Queries and directories and loads the index. If the index is up to date, the items are
+     * loaded from the index and returned. Otherwise only the files that were added or changed
+     * since the index was written are loaded again, and files that no longer exist are dropped.
      */
     std::vector<TItem> LoadOrBuild(int32_t language) const
     {
-        std::vector<TItem> items;
         auto scanResult = Scan();
         auto readIndexResult = ReadIndexFile(language, scanResult.Stats);
-        if (std::get<0>(readIndexResult))
+        if (!readIndexResult.has_value())
         {
-            // Index was loaded
-            items = std::get<1>(readIndexResult);
+            // Index was not loaded
+            return Build(language, scanResult);
         }
-        else
+
+        auto& [upToDate, indexedEntries] = *readIndexResult;
+        if (upToDate)
         {
-            // Index was not loaded
-            items = Build(language, scanResult);
+            // Directory is the same, use the saved items as-is
+            return GetItems(indexedEntries);
         }
-        return items;
+        return Update(language, scanResult, indexedEntries);
     }
 
     std::vector<TItem> Rebuild(int32_t language) const
@@ -139,7 +164,7 @@ private:
     ScanResult Scan() const
     {
         DirectoryStats stats{};
-        std::vector<std::string> files;
+        std::vector<FileRecord> files;
         for (const auto& directory : SearchPaths)
         {
             auto absoluteDirectory = Path::GetAbsolute(directory);
@@ -159,20 +184,24 @@ private:
                 stats.FileDateModifiedChecksum = Numerics::ror32(stats.FileDateModifiedChecksum, 5);
                 stats.PathChecksum += GetPathChecksum(path);
 
-                files.push_back(std::move(path));
+                FileRecord record;
+                record.Path = std::move(path);
+                record.Size = fileInfo.Size;
+                record.LastModified = fileInfo.LastModified;
+                files.push_back(std::move(record));
             }
         }
         return ScanResult(stats, std::move(files));
     }
 
     void BuildRange(
-        int32_t language, const ScanResult& scanResult, size_t rangeStart, size_t rangeEnd, std::vector<TItem>& items,
-        std::atomic<size_t>& processed, std::mutex& printLock) const
+        int32_t language, std::vector<IndexEntry>& entries, const std::vector<size_t>& pending, size_t rangeStart,
+        size_t rangeEnd, std::atomic<size_t>& processed, std::mutex& printLock) const
     {
-        items.reserve(rangeEnd - rangeStart);
         for (size_t i = rangeStart; i < rangeEnd; i++)
         {
-            const auto& filePath = scanResult.Files.at(i);
+            auto& entry = entries.at(pending.at(i));
+            const auto& filePath = entry.File.Path;
 
             if (_log_levels[EnumValue(DiagnosticLevel::Verbose)])
             {
@@ -180,117 +209,229 @@ private:
                 LOG_VERBOSE("FileIndex:Indexing '%s'", filePath.c_str());
             }
 
-            if (auto item = Create(language, filePath); item.has_value())
+            entry.Item = Create(language, filePath);
+
+            ++processed;
+        }
+    }
+
+    /**
+     * Creates the items for the entries at the given indices using the job pool.
+     */
+    void BuildEntries(int32_t language, std::vector<IndexEntry>& entries, const std::vector<size_t>& pending) const
+    {
+        const size_t totalCount = pending.size();
+        if (totalCount == 0)
+            return;
+
+        JobPool jobPool;
+        std::mutex printLock; // For verbose prints.
+
+        size_t stepSize = 100; // Handpicked, seems to work well with 4/8 cores.
+
+        std::atomic<size_t> processed = ATOMIC_VAR_INIT(0);
+
+        auto reportProgress = [&]() {
+            const size_t completed = processed;
+            Console::WriteFormat("File %5zu of %zu, done %3d%%\r", completed, totalCount, completed * 100 / totalCount);
+        };
+
+        for (size_t rangeStart = 0; rangeStart < totalCount; rangeStart += stepSize)
+        {
+            if (rangeStart + stepSize > totalCount)
             {
-                items.push_back(std::move(item.value()));
+                stepSize = totalCount - rangeStart;
             }
 
-            ++processed;
+            jobPool.AddTask([&, rangeStart, stepSize]() {
+                BuildRange(language, entries, pending, rangeStart, rangeStart + stepSize, processed, printLock);
+            });
+
+            reportProgress();
         }
+
+        jobPool.Join(reportProgress);
     }
 
     std::vector<TItem> Build(int32_t language, const ScanResult& scanResult) const
     {
-        std::vector<TItem> allItems;
         Console::WriteLine("Building %s (%zu items)", _name.c_str(), scanResult.Files.size());
 
         auto startTime = std::chrono::high_resolution_clock::now();
 
-        const size_t totalCount = scanResult.Files.size();
-        if (totalCount > 0)
+        std::vector<IndexEntry> entries;
+        std::vector<size_t> pending;
+        entries.reserve(scanResult.Files.size());
+        pending.reserve(scanResult.Files.size());
+        for (const auto& file : scanResult.Files)
         {
-            JobPool jobPool;
-            std::mutex printLock; // For verbose prints.
+            pending.push_back(entries.size());
+            entries.push_back({ file, std::nullopt });
+        }
+        BuildEntries(language, entries, pending);
 
-            std::list<std::vector<TItem>> containers;
+        WriteIndexFile(language, scanResult.Stats, entries);
 
-            size_t stepSize = 100; // Handpicked, seems to work well with 4/8 cores.
+        auto endTime = std::chrono::high_resolution_clock::now();
+        auto duration = std::chrono::duration<float>(endTime - startTime);
+        Console::WriteLine("Finished building %s in %.2f seconds.", _name.c_str(), duration.count());
 
-            std::atomic<size_t> processed = ATOMIC_VAR_INIT(0);
+        return GetItems(entries);
+    }
 
-            auto reportProgress = [&]() {
-                const size_t completed = processed;
-                Console::WriteFormat("File %5zu of %zu, done %3d%%\r", completed, totalCount, completed * 100 / totalCount);
-            };
+    /**
+     * Brings the index up to date with the scanned files, only creating items for files that
+     * are new or have changed. Files are only hashed if their date modified changed but not their size.
+     */
+    std::vector<TItem> Update(int32_t language, const ScanResult& scanResult, std::vector<IndexEntry>& indexedEntries) const
+    {
+        auto startTime = std::chrono::high_resolution_clock::now();
+
+        std::unordered_map<std::string_view, size_t> indexedPaths;
+        indexedPaths.reserve(indexedEntries.size());
+        for (size_t i = 0; i < indexedEntries.size(); i++)
+        {
+            indexedPaths.emplace(indexedEntries[i].File.Path, i);
+        }
 
-            for (size_t rangeStart = 0; rangeStart < totalCount; rangeStart += stepSize)
+        std::vector<IndexEntry> entries;
+        std::vector<size_t> pending;
+        std::vector<bool> found(indexedEntries.size());
+        size_t numAdded = 0;
+        size_t numChanged = 0;
+        entries.reserve(scanResult.Files.size());
+        for (const auto& file : scanResult.Files)
+        {
+            auto it = indexedPaths.find(file.Path);
+            if (it == indexedPaths.end())
+            {
+                numAdded++;
+            }
+            else
             {
-                if (rangeStart + stepSize > totalCount)
+                found[it->second] = true;
+                auto& indexed = indexedEntries[it->second];
+                if (indexed.File.Size == file.Size && indexed.File.LastModified == file.LastModified)
                 {
-                    stepSize = totalCount - rangeStart;
+                    entries.push_back(std::move(indexed));
+                    continue;
                 }
+                if (indexed.File.Size == file.Size)
+                {
+                    // Files are only hashed when touched, the hash is kept to compare against the next time
+                    const auto contentHash = GetContentHash(file.Path);
+                    if (indexed.File.ContentHash != 0 && indexed.File.ContentHash == contentHash)
+                    {
+                        // File was touched but the contents are the same
+                        indexed.File.LastModified = file.LastModified;
+                        entries.push_back(std::move(indexed));
+                        continue;
+                    }
 
-                auto& items = containers.emplace_back();
-
-                jobPool.AddTask([&, rangeStart, stepSize]() {
-                    BuildRange(language, scanResult, rangeStart, rangeStart + stepSize, items, processed, printLock);
-                });
-
-                reportProgress();
+                    auto changedFile = file;
+                    changedFile.ContentHash = contentHash;
+                    pending.push_back(entries.size());
+                    entries.push_back({ std::move(changedFile), std::nullopt });
+                    numChanged++;
+                    continue;
+                }
+                numChanged++;
             }
+            pending.push_back(entries.size());
+            entries.push_back({ file, std::nullopt });
+        }
 
-            jobPool.Join(reportProgress);
+        const auto numRemoved = static_cast<size_t>(std::count(found.begin(), found.end(), false));
+        Console::WriteLine(
+            "Updating %s (%zu added, %zu changed, %zu removed)", _name.c_str(), numAdded, numChanged, numRemoved);
 
-            for (const auto& itr : containers)
-            {
-                allItems.insert(allItems.end(), itr.begin(), itr.end());
-            }
-        }
+        BuildEntries(language, entries, pending);
 
-        WriteIndexFile(language, scanResult.Stats, allItems);
+        WriteIndexFile(language, scanResult.Stats, entries);
 
         auto endTime = std::chrono::high_resolution_clock::now();
         auto duration = std::chrono::duration<float>(endTime - startTime);
-        Console::WriteLine("Finished building %s in %.2f seconds.", _name.c_str(), duration.count());
+        Console::WriteLine("Finished updating %s in %.2f seconds.", _name.c_str(), duration.count());
 
-        return allItems;
+        return GetItems(entries);
     }
 
-    std::tuple<bool, std::vector<TItem>> ReadIndexFile(int32_t language, const DirectoryStats& stats) const
+    static std::vector<TItem> GetItems(std::vector<IndexEntry>& entries)
     {
-        bool loadedItems = false;
         std::vector<TItem> items;
-        if (File::Exists(_indexPath))
+        items.reserve(entries.size());
+        for (auto& entry : entries)
         {
-            try
+            if (entry.Item.has_value())
             {
-                LOG_VERBOSE("FileIndex:Loading index: '%s'", _indexPath.c_str());
-                auto fs = OpenRCT2::FileStream(_indexPath, OpenRCT2::FILE_MODE_OPEN);
-
-                // Read header, check if we need to re-scan
-                auto header = fs.ReadValue<FileIndexHeader>();
-                if (header.HeaderSize == sizeof(FileIndexHeader) && header.MagicNumber == _magicNumber
-                    && header.VersionA == FILE_INDEX_VERSION && header.VersionB == _version && header.LanguageId == language
-                    && header.Stats.TotalFiles == stats.TotalFiles && header.Stats.TotalFileSize == stats.TotalFileSize
-                    && header.Stats.FileDateModifiedChecksum == stats.FileDateModifiedChecksum
-                    && header.Stats.PathChecksum == stats.PathChecksum)
-                {
-                    items.reserve(header.NumItems);
-                    DataSerialiser ds(false, fs);
-                    // Directory is the same, just read the saved items
-                    for (uint32_t i = 0; i < header.NumItems; i++)
-                    {
-                        TItem item;
-                        Serialise(ds, item);
-                        items.emplace_back(std::move(item));
-                    }
-                    loadedItems = true;
-                }
-                else
-                {
-                    Console::WriteLine("%s out of date", _name.c_str());
-                }
+                items.push_back(std::move(*entry.Item));
+            }
+        }
+        return items;
+    }
+
+    /**
+     * Reads the index file. Returns nothing if the index can not be used at all, otherwise the
+     * indexed entries and whether the directory stats still match the scanned files.
+     */
+    std::optional<std::tuple<bool, std::vector<IndexEntry>>> ReadIndexFile(
+        int32_t language, const DirectoryStats& stats) const
+    {
+        if (!File::Exists(_indexPath))
+        {
+            return std::nullopt;
+        }
+
+        try
+        {
+            LOG_VERBOSE("FileIndex:Loading index: '%s'", _indexPath.c_str());
+            auto fs = OpenRCT2::FileStream(_indexPath, OpenRCT2::FILE_MODE_OPEN);
+
+            // Read header, check if the index is usable
+            auto header = fs.ReadValue<FileIndexHeader>();
+            if (header.HeaderSize != sizeof(FileIndexHeader) || header.MagicNumber != _magicNumber
+                || header.VersionA != FILE_INDEX_VERSION || header.VersionB != _version || header.LanguageId != language)
+            {
+                Console::WriteLine("%s out of date", _name.c_str());
+                return std::nullopt;
             }
-            catch (const std::exception& e)
+
+            const bool upToDate = header.Stats.TotalFiles == stats.TotalFiles
+                && header.Stats.TotalFileSize == stats.TotalFileSize
+                && header.Stats.FileDateModifiedChecksum == stats.FileDateModifiedChecksum
+                && header.Stats.PathChecksum == stats.PathChecksum;
+
+            std::vector<IndexEntry> entries;
+            entries.reserve(header.NumFiles);
+            DataSerialiser ds(false, fs);
+            for (uint32_t i = 0; i < header.NumFiles; i++)
             {
-                Console::Error::WriteLine("Unable to load index: '%s'.", _indexPath.c_str());
-                Console::Error::WriteLine("%s", e.what());
+                IndexEntry entry;
+                bool hasItem = false;
+                ds << entry.File.Path;
+                ds << entry.File.Size;
+                ds << entry.File.LastModified;
+                ds << entry.File.ContentHash;
+                ds << hasItem;
+                if (hasItem)
+                {
+                    TItem item;
+                    Serialise(ds, item);
+                    entry.Item = std::move(item);
+                }
+                entries.push_back(std::move(entry));
             }
+            return std::make_tuple(upToDate, std::move(entries));
         }
-        return std::make_tuple(loadedItems, std::move(items));
+        catch (const std::exception& e)
+        {
+            Console::Error::WriteLine("Unable to load index: '%s'.", _indexPath.c_str());
+            Console::Error::WriteLine("%s", e.what());
+        }
+        return std::nullopt;
     }
 
-    void WriteIndexFile(int32_t language, const DirectoryStats& stats, const std::vector<TItem>& items) const
+    void WriteIndexFile(int32_t language, const DirectoryStats& stats, const std::vector<IndexEntry>& entries) const
     {
         try
         {
@@ -305,14 +446,24 @@ private:
             header.VersionB = _version;
             header.LanguageId = language;
             header.Stats = stats;
-            header.NumItems = static_cast<uint32_t>(items.size());
+            header.NumFiles = static_cast<uint32_t>(entries.size());
             fs.WriteValue(header);
 
             DataSerialiser ds(true, fs);
-            // Write items
-            for (const auto& item : items)
+            // Write a record for each file, followed by its item if one was created
+            for (const auto& entry : entries)
             {
-                Serialise(ds, item);
+                const auto& file = entry.File;
+                const bool hasItem = entry.Item.has_value();
+                ds << file.Path;
+                ds << file.Size;
+                ds << file.LastModified;
+                ds << file.ContentHash;
+                ds << hasItem;
+                if (hasItem)
+                {
+                    Serialise(ds, *entry.Item);
+                }
             }
         }
         catch (const std::exception& e)
@@ -322,6 +473,35 @@ private:
         }
     }
 
+    static uint64_t GetContentHash(const std::string& path)
+    {
+        try
+        {
+            auto fs = OpenRCT2::FileStream(path, OpenRCT2::FILE_MODE_OPEN);
+            auto hashAlgorithm = Crypt::CreateFNV1a();
+
+            uint8_t buffer[16384];
+            uint64_t remaining = fs.GetLength();
+            while (remaining > 0)
+            {
+                auto readLen = static_cast<size_t>(std::min<uint64_t>(remaining, sizeof(buffer)));
+                fs.Read(buffer, readLen);
+                hashAlgorithm->Update(buffer, readLen);
+                remaining -= readLen;
+            }
+
+            auto result = hashAlgorithm->Finish();
+            uint64_t hash;
+            std::memcpy(&hash, result.data(), sizeof(hash));
+            return hash;
+        }
+        catch (const std::exception& e)
+        {
+            LOG_VERBOSE("FileIndex:Unable to hash '%s': %s", path.c_str(), e.what());
+            return 0;
+        }
+    }
+
     static uint32_t GetPathChecksum(const std::string& path)
     {
         uint32_t hash = 0xD8430DED;
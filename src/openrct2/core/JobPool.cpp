@@ -117,7 +117,11 @@ void JobPool::ProcessQueue()
 
             lock.lock();
 
-            _completed.push_back(std::move(taskData));
+            // Nothing is left to do on Join for tasks without a completion, long lived pools never call it.
+            if (taskData.CompletionFn)
+            {
+                _completed.push_back(std::move(taskData));
+            }
 
             _processing--;
             _condComplete.notify_one();
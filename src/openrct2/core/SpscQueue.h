@@ -0,0 +1,83 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2024 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#pragma once
+
+#include <atomic>
+#include <optional>
+#include <utility>
+
+/**
+ * Unbounded lock-free queue for handing items from exactly one producer thread to exactly one consumer thread.
+ */
+template<typename T> class SpscQueue
+{
+private:
+    struct Node
+    {
+        std::optional<T> Value;
+        std::atomic<Node*> Next{ nullptr };
+    };
+
+    // Consumer side, always points to an already consumed (or stub) node.
+    Node* _head;
+    // Producer side.
+    Node* _tail;
+
+public:
+    SpscQueue()
+        : _head(new Node())
+        , _tail(_head)
+    {
+    }
+
+    SpscQueue(const SpscQueue&) = delete;
+    SpscQueue& operator=(const SpscQueue&) = delete;
+
+    ~SpscQueue()
+    {
+        while (_head != nullptr)
+        {
+            auto* next = _head->Next.load(std::memory_order_relaxed);
+            delete _head;
+            _head = next;
+        }
+    }
+
+    // Must only be called from the producer thread.
+    void Push(T&& value)
+    {
+        auto* node = new Node();
+        node->Value.emplace(std::move(value));
+        _tail->Next.store(node, std::memory_order_release);
+        _tail = node;
+    }
+
+    // Must only be called from the consumer thread.
+    bool TryPop(T& value)
+    {
+        auto* next = _head->Next.load(std::memory_order_acquire);
+        if (next == nullptr)
+        {
+            return false;
+        }
+
+        value = std::move(*next->Value);
+        next->Value.reset();
+        delete _head;
+        _head = next;
+        return true;
+    }
+
+    // Must only be called from the consumer thread.
+    bool Empty() const
+    {
+        return _head->Next.load(std::memory_order_acquire) == nullptr;
+    }
+};
@@ -23,7 +23,9 @@
 #include "ScrollingText.h"
 
 #include <algorithm>
+#include <atomic>
 #include <memory>
+#include <mutex>
 #include <stdexcept>
 #include <vector>
 
@@ -188,6 +190,25 @@ static bool _csgLoaded = false;
 
 static G1Element _g1Temp = {};
 static std::vector<G1Element> _imageListElements;
+
+struct LazyImageRange
+{
+    ImageIndex BaseId;
+    uint32_t Count;
+    ILazyImageSource* Source;
+};
+
+// Image list entries whose pixel data is decoded on first use, see GfxSetLazyImageSource.
+static std::mutex _lazyImageMutex;
+static std::vector<LazyImageRange> _lazyImageRanges; // Sorted by BaseId.
+static std::vector<uint8_t> _imageListLazy;
+static std::vector<uint8_t> _imageListReferenced;
+static std::vector<ImageIndex> _lazyLoadedImages;
+static std::vector<ILazyImageSource*> _lazySourcesToRelease;
+static size_t _lazyClockHand = 0;
+static size_t _lazyLoadedBytes = 0;
+// Assigned to images that failed to decode so they are not retried on every draw.
+static uint8_t _lazyImageEmptyData[16]{};
 bool gTinyFontAntiAliased = false;
 
 /**
@@ -692,6 +713,57 @@ void FASTCALL GfxDrawSpriteRawMaskedSoftware(
     MaskFn(width, height, maskSrc, colourSrc, dst, maskWrap, colourWrap, dstWrap);
 }
 
+static LazyImageRange* GfxFindLazyImageRange(ImageIndex imageId)
+{
+    auto it = std::upper_bound(
+        _lazyImageRanges.begin(), _lazyImageRanges.end(), imageId,
+        [](ImageIndex id, const LazyImageRange& range) { return id < range.BaseId; });
+    if (it == _lazyImageRanges.begin())
+        return nullptr;
+
+    --it;
+    if (imageId >= it->BaseId + it->Count)
+        return nullptr;
+    return &*it;
+}
+
+static void GfxLoadLazyImage(size_t idx)
+{
+    std::lock_guard<std::mutex> lock(_lazyImageMutex);
+
+    auto& element = _imageListElements[idx];
+    if (element.offset != nullptr)
+    {
+        // Loaded by another thread while waiting for the lock
+        return;
+    }
+
+    const auto imageId = static_cast<ImageIndex>(idx + SPR_IMAGE_LIST_BEGIN);
+    auto* range = GfxFindLazyImageRange(imageId);
+    if (range == nullptr)
+    {
+        return;
+    }
+
+    auto loaded = element;
+    auto size = range->Source->LoadImageData(imageId - range->BaseId, loaded);
+    if (size == 0 || loaded.offset == nullptr)
+    {
+        element.width = 0;
+        element.height = 0;
+        std::atomic_ref<uint8_t*>(element.offset).store(_lazyImageEmptyData, std::memory_order_release);
+        return;
+    }
+
+    if (std::find(_lazySourcesToRelease.begin(), _lazySourcesToRelease.end(), range->Source) == _lazySourcesToRelease.end())
+    {
+        _lazySourcesToRelease.push_back(range->Source);
+    }
+    _lazyLoadedImages.push_back(imageId);
+    _lazyLoadedBytes += size;
+    std::atomic_ref<uint8_t*>(element.offset).store(loaded.offset, std::memory_order_release);
+}
+
 const G1Element* GfxGetG1Element(const ImageId imageId)
 {
     return GfxGetG1Element(imageId.GetIndex());
@@ -755,7 +827,16 @@ const G1Element* GfxGetG1Element(ImageIndex image_id)
         size_t idx = offset - SPR_IMAGE_LIST_BEGIN;
         if (idx < _imageListElements.size())
         {
-            return &_imageListElements[idx];
+            auto& element = _imageListElements[idx];
+            if (_imageListLazy[idx])
+            {
+                std::atomic_ref<uint8_t>(_imageListReferenced[idx]).store(1, std::memory_order_relaxed);
+                if (std::atomic_ref<uint8_t*>(element.offset).load(std::memory_order_acquire) == nullptr)
+                {
+                    GfxLoadLazyImage(idx);
+                }
+            }
+            return &element;
         }
     }
     return nullptr;
@@ -804,12 +885,137 @@ void GfxSetG1Element(ImageIndex imageId, const G1Element* g1)
                 {
                     _imageListElements.resize(std::max<size_t>(256, _imageListElements.size() * 2));
                 }
+                _imageListLazy.resize(_imageListElements.size());
+                _imageListReferenced.resize(_imageListElements.size());
                 _imageListElements[idx] = *g1;
             }
         }
     }
 }
 
+/**
+ * Registers a source for the pixel data of the given image list range, entries the source reports as lazy are decoded
+ * the first time they are requested. Passing nullptr releases all decoded images and unregisters the range.
+ * Must not be called while drawing.
+ */
+void GfxSetLazyImageSource(ImageIndex baseImageId, uint32_t count, ILazyImageSource* source)
+{
+    std::lock_guard<std::mutex> lock(_lazyImageMutex);
+
+    auto it = std::find_if(_lazyImageRanges.begin(), _lazyImageRanges.end(), [baseImageId](const LazyImageRange& range) {
+        return range.BaseId == baseImageId;
+    });
+    if (it != _lazyImageRanges.end())
+    {
+        const auto range = *it;
+        range.Source->ReleaseLoadCache();
+        _lazySourcesToRelease.erase(
+            std::remove(_lazySourcesToRelease.begin(), _lazySourcesToRelease.end(), range.Source),
+            _lazySourcesToRelease.end());
+
+        for (uint32_t i = 0; i < range.Count; i++)
+        {
+            const auto idx = range.BaseId + i - SPR_IMAGE_LIST_BEGIN;
+            auto& element = _imageListElements[idx];
+            if (!_imageListLazy[idx])
+            {
+                continue;
+            }
+            if (element.offset != nullptr && element.offset != _lazyImageEmptyData)
+            {
+                _lazyLoadedBytes -= range.Source->UnloadImageData(i);
+            }
+            element.offset = nullptr;
+            _imageListLazy[idx] = 0;
+            _imageListReferenced[idx] = 0;
+        }
+        _lazyLoadedImages.erase(
+            std::remove_if(
+                _lazyLoadedImages.begin(), _lazyLoadedImages.end(),
+                [&range](ImageIndex imageId) { return imageId >= range.BaseId && imageId < range.BaseId + range.Count; }),
+            _lazyLoadedImages.end());
+        _lazyImageRanges.erase(it);
+    }
+
+    if (source == nullptr || count == 0)
+    {
+        return;
+    }
+
+    bool anyLazy = false;
+    for (uint32_t i = 0; i < count; i++)
+    {
+        const auto idx = baseImageId + i - SPR_IMAGE_LIST_BEGIN;
+        if (idx < _imageListElements.size() && source->IsImageLazy(i))
+        {
+            _imageListLazy[idx] = 1;
+            anyLazy = true;
+        }
+    }
+    if (anyLazy)
+    {
+        auto insertAt = std::upper_bound(
+            _lazyImageRanges.begin(), _lazyImageRanges.end(), baseImageId,
+            [](ImageIndex id, const LazyImageRange& range) { return id < range.BaseId; });
+        _lazyImageRanges.insert(insertAt, { baseImageId, count, source });
+    }
+}
+
+/**
+ * Releases intermediate decoding data and drops the least recently drawn lazy images until the decoded
+ * images fit within the configured budget. Must not be called while drawing.
+ */
+void GfxTrimLazyImages()
+{
+    std::lock_guard<std::mutex> lock(_lazyImageMutex);
+
+    for (auto* source : _lazySourcesToRelease)
+    {
+        source->ReleaseLoadCache();
+    }
+    _lazySourcesToRelease.clear();
+
+    if (gConfigGeneral.ImageCacheBudget <= 0)
+    {
+        return;
+    }
+
+    // Second chance eviction, images drawn since the hand last passed them survive another round.
+    const auto budget = static_cast<size_t>(gConfigGeneral.ImageCacheBudget) * 1024 * 1024;
+    while (_lazyLoadedBytes > budget && !_lazyLoadedImages.empty())
+    {
+        if (_lazyClockHand >= _lazyLoadedImages.size())
+        {
+            _lazyClockHand = 0;
+        }
+
+        const auto imageId = _lazyLoadedImages[_lazyClockHand];
+        const auto idx = imageId - SPR_IMAGE_LIST_BEGIN;
+        if (_imageListReferenced[idx])
+        {
+            _imageListReferenced[idx] = 0;
+            _lazyClockHand++;
+            continue;
+        }
+
+        auto* range = GfxFindLazyImageRange(imageId);
+        if (range != nullptr)
+        {
+            _lazyLoadedBytes -= range->Source->UnloadImageData(imageId - range->BaseId);
+        }
+        _imageListElements[idx].offset = nullptr;
+
+        _lazyLoadedImages[_lazyClockHand] = _lazyLoadedImages.back();
+        _lazyLoadedImages.pop_back();
+    }
+}
+
+size_t GfxGetLazyImageMemoryUsage()
+{
+    std::lock_guard<std::mutex> lock(_lazyImageMutex);
+    return _lazyLoadedBytes;
+}
+
 bool IsCsgLoaded()
 {
     return _csgLoaded;
@@ -88,6 +88,22 @@ struct G1Element
     int32_t zoomed_offset = 0; // 0x0E
 };
 
+/**
+ * Provides the pixel data of image list entries that are only decoded the first time they are requested.
+ */
+struct ILazyImageSource
+{
+    virtual ~ILazyImageSource() = default;
+
+    virtual bool IsImageLazy(uint32_t index) const abstract;
+    // Decodes the image at index and points element.offset to it, returns the number of bytes held.
+    virtual size_t LoadImageData(uint32_t index, G1Element& element) abstract;
+    // Releases the decoded image at index, returns the number of bytes freed.
+    virtual size_t UnloadImageData(uint32_t index) abstract;
+    // Releases any intermediate data kept around while decoding a batch of images.
+    virtual void ReleaseLoadCache() abstract;
+};
+
 #pragma pack(push, 1)
 struct RCTG1Header
 {
@@ -563,6 +579,9 @@ void GfxUnloadCsg();
 const G1Element* GfxGetG1Element(const ImageId imageId);
 const G1Element* GfxGetG1Element(ImageIndex image_id);
 void GfxSetG1Element(ImageIndex imageId, const G1Element* g1);
+void GfxSetLazyImageSource(ImageIndex baseImageId, uint32_t count, ILazyImageSource* source);
+void GfxTrimLazyImages();
+size_t GfxGetLazyImageMemoryUsage();
 std::optional<Gx> GfxLoadGx(const std::vector<uint8_t>& buffer);
 bool IsCsgLoaded();
 void FASTCALL GfxSpriteToBuffer(DrawPixelInfo& dpi, const DrawSpriteArgs& args);
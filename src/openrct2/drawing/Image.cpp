@@ -186,7 +186,7 @@ static void FreeImageList(uint32_t baseImageId, uint32_t count)
     _freeLists.push_back({ baseImageId, count });
 }
 
-uint32_t GfxObjectAllocateImages(const G1Element* images, uint32_t count)
+uint32_t GfxObjectAllocateImages(const G1Element* images, uint32_t count, ILazyImageSource* lazySource)
 {
     if (count == 0 || gOpenRCT2NoGraphics)
     {
@@ -208,6 +208,11 @@ uint32_t GfxObjectAllocateImages(const G1Element* images, uint32_t count)
         imageId++;
     }
 
+    if (lazySource != nullptr)
+    {
+        GfxSetLazyImageSource(baseImageId, count, lazySource);
+    }
+
     return baseImageId;
 }
 
@@ -215,6 +220,8 @@ void GfxObjectFreeImages(uint32_t baseImageId, uint32_t count)
 {
     if (baseImageId != 0 && baseImageId != INVALID_IMAGE_ID)
     {
+        GfxSetLazyImageSource(baseImageId, count, nullptr);
+
         // Zero the G1 elements so we don't have invalid pointers
         // and data lying about
         for (uint32_t i = 0; i < count; i++)
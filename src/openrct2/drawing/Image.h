@@ -16,6 +16,7 @@
 #include <list>
 
 struct G1Element;
+struct ILazyImageSource;
 
 struct ImageList
 {
@@ -55,7 +56,7 @@ constexpr bool operator!=(const ImageList& lhs, const ImageList& rhs)
     return !(lhs == rhs);
 }
 
-uint32_t GfxObjectAllocateImages(const G1Element* images, uint32_t count);
+uint32_t GfxObjectAllocateImages(const G1Element* images, uint32_t count, ILazyImageSource* lazySource = nullptr);
 void GfxObjectFreeImages(uint32_t baseImageId, uint32_t count);
 void GfxObjectCheckAllImagesFreed();
 size_t ImageListGetUsedCount();
@@ -0,0 +1,213 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2024 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#ifndef DISABLE_NETWORK
+
+#    include "EntityHashTree.h"
+
+#    include "../core/ChecksumStream.h"
+#    include "../core/DataSerialiser.h"
+#    include "../ride/Vehicle.h"
+#    include "EntityList.h"
+#    include "Guest.h"
+#    include "Litter.h"
+#    include "Staff.h"
+
+#    include <cstring>
+
+static constexpr uint64_t HashSeed = 0xcbf29ce484222325ULL;
+static constexpr uint64_t HashPrime = 0x00000100000001B3ULL;
+
+static uint64_t CombineHashes(const uint64_t* values, size_t count)
+{
+    uint64_t hash = HashSeed;
+    for (size_t i = 0; i < count; i++)
+    {
+        hash ^= values[i];
+        hash *= HashPrime;
+    }
+    return hash;
+}
+
+// Only needs to detect changes locally, so the memory is hashed as it is.
+static uint64_t FingerprintMemory(const void* data, size_t size)
+{
+    const auto* bytes = static_cast<const uint8_t*>(data);
+    uint64_t hash = HashSeed;
+    size_t i = 0;
+    for (; i + sizeof(uint64_t) <= size; i += sizeof(uint64_t))
+    {
+        uint64_t word;
+        std::memcpy(&word, bytes + i, sizeof(word));
+        hash ^= word;
+        hash *= HashPrime;
+    }
+    for (; i < size; i++)
+    {
+        hash ^= bytes[i];
+        hash *= HashPrime;
+    }
+    return hash;
+}
+
+// Must be identical on every platform, so it goes through the same serialisation as the network checksum.
+template<typename T> static uint64_t HashEntity(T& entity)
+{
+    std::array<std::byte, 20> checksum{};
+    OpenRCT2::ChecksumStream ms(checksum);
+    DataSerialiser ds(true, ms);
+    entity.Serialise(ds);
+
+    uint64_t hash;
+    std::memcpy(&hash, checksum.data(), sizeof(hash));
+
+    // Zero is reserved for empty slots.
+    return hash != 0 ? hash : 1;
+}
+
+EntityHashTree::EntityHashTree()
+{
+    Reset();
+}
+
+void EntityHashTree::Reset()
+{
+    for (auto& bucket : _buckets)
+    {
+        bucket = std::make_shared<Bucket>();
+    }
+    _dirtyBuckets.assign(NumBuckets, true);
+    _rootDirty = true;
+    _fingerprints.assign(MAX_ENTITIES, 0);
+    _lastSeen.assign(MAX_ENTITIES, 0);
+    _tracked.clear();
+    _generation = 0;
+}
+
+void EntityHashTree::SetLeaf(size_t index, uint64_t value)
+{
+    const auto bucketIndex = index / LeavesPerBucket;
+    auto& bucket = _buckets[bucketIndex];
+    auto& leaf = (*bucket)[index % LeavesPerBucket];
+    if (leaf == value)
+    {
+        return;
+    }
+
+    if (bucket.use_count() > 1)
+    {
+        // Still referenced by a snapshot.
+        bucket = std::make_shared<Bucket>(*bucket);
+    }
+    (*bucket)[index % LeavesPerBucket] = value;
+    _dirtyBuckets[bucketIndex] = true;
+    _rootDirty = true;
+}
+
+template<typename T> void EntityHashTree::UpdateEntities()
+{
+    for (auto* entity : EntityList<T>())
+    {
+        const auto index = entity->Id.ToUnderlying();
+        _lastSeen[index] = _generation;
+        _current.push_back(index);
+
+        const auto fingerprint = FingerprintMemory(entity, sizeof(T));
+        if (fingerprint != _fingerprints[index])
+        {
+            _fingerprints[index] = fingerprint;
+            SetLeaf(index, HashEntity(*entity));
+        }
+    }
+}
+
+void EntityHashTree::Update()
+{
+    _generation++;
+    _current.clear();
+    UpdateEntities<Guest>();
+    UpdateEntities<Staff>();
+    UpdateEntities<Vehicle>();
+    UpdateEntities<Litter>();
+
+    // Clear entities that have been removed since the last update.
+    for (auto index : _tracked)
+    {
+        if (_lastSeen[index] != _generation)
+        {
+            _fingerprints[index] = 0;
+            SetLeaf(index, 0);
+        }
+    }
+    std::swap(_tracked, _current);
+
+    if (!_rootDirty)
+    {
+        return;
+    }
+    for (size_t i = 0; i < NumBuckets; i++)
+    {
+        if (_dirtyBuckets[i])
+        {
+            _bucketHashes[i] = CombineHashes(_buckets[i]->data(), LeavesPerBucket);
+            _dirtyBuckets[i] = false;
+        }
+    }
+    _root = CombineHashes(_bucketHashes.data(), NumBuckets);
+    _rootDirty = false;
+}
+
+uint64_t EntityHashTree::GetRoot() const noexcept
+{
+    return _root;
+}
+
+const EntityHashTree::BucketHashes& EntityHashTree::GetBucketHashes() const noexcept
+{
+    return _bucketHashes;
+}
+
+const EntityHashTree::Bucket& EntityHashTree::GetBucket(size_t index) const
+{
+    return *_buckets[index];
+}
+
+EntityHashTree::Snapshot EntityHashTree::TakeSnapshot(uint32_t tick) const
+{
+    Snapshot snapshot;
+    snapshot.Tick = tick;
+    snapshot.Root = _root;
+    snapshot.Hashes = _bucketHashes;
+    for (size_t i = 0; i < NumBuckets; i++)
+    {
+        snapshot.Buckets[i] = _buckets[i];
+    }
+    return snapshot;
+}
+
+std::vector<size_t> EntityHashTree::FindDifferingBuckets(const BucketHashes& a, const BucketHashes& b)
+{
+    std::vector<size_t> result;
+    for (size_t i = 0; i < NumBuckets; i++)
+    {
+        if (a[i] != b[i])
+        {
+            result.push_back(i);
+        }
+    }
+    return result;
+}
+
+EntityHashTree& GetEntityHashTree()
+{
+    static EntityHashTree tree;
+    return tree;
+}
+
+#endif // DISABLE_NETWORK
@@ -0,0 +1,76 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2024 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#pragma once
+
+#include "../common.h"
+#include "EntityRegistry.h"
+
+#include <array>
+#include <memory>
+#include <vector>
+
+/**
+ * Hashes of the entities that matter for multiplayer synchronisation (guests, staff, vehicles and litter), kept in a
+ * two level tree: one leaf per entity index, grouped into buckets, combined into a single root.
+ *
+ * Entities are only rehashed when their memory changed since the previous update, so the root is cheap enough to
+ * compare every tick. When two roots differ, comparing bucket and then leaf hashes finds the entities that diverged.
+ */
+class EntityHashTree
+{
+public:
+    static constexpr size_t LeavesPerBucket = 64;
+    static constexpr size_t NumBuckets = (MAX_ENTITIES + LeavesPerBucket - 1) / LeavesPerBucket;
+
+    using Bucket = std::array<uint64_t, LeavesPerBucket>;
+    using BucketHashes = std::array<uint64_t, NumBuckets>;
+
+    /**
+     * The state of the tree at a given tick. Buckets are shared with the live tree until they change.
+     */
+    struct Snapshot
+    {
+        uint32_t Tick{};
+        uint64_t Root{};
+        BucketHashes Hashes{};
+        std::array<std::shared_ptr<const Bucket>, NumBuckets> Buckets;
+    };
+
+    EntityHashTree();
+
+    void Reset();
+    void Update();
+
+    uint64_t GetRoot() const noexcept;
+    const BucketHashes& GetBucketHashes() const noexcept;
+    const Bucket& GetBucket(size_t index) const;
+    Snapshot TakeSnapshot(uint32_t tick) const;
+
+    static std::vector<size_t> FindDifferingBuckets(const BucketHashes& a, const BucketHashes& b);
+
+private:
+    std::array<std::shared_ptr<Bucket>, NumBuckets> _buckets;
+    BucketHashes _bucketHashes{};
+    std::vector<bool> _dirtyBuckets;
+    uint64_t _root{};
+    bool _rootDirty = true;
+
+    // Hash of the raw entity memory, used to tell whether an entity has to be rehashed.
+    std::vector<uint64_t> _fingerprints;
+    std::vector<uint32_t> _lastSeen;
+    std::vector<EntityId::UnderlyingType> _tracked;
+    std::vector<EntityId::UnderlyingType> _current;
+    uint32_t _generation{};
+
+    template<typename T> void UpdateEntities();
+    void SetLeaf(size_t index, uint64_t value);
+};
+
+EntityHashTree& GetEntityHashTree();
@@ -27,6 +27,7 @@
 #include "Duck.h"
 #include "EntityTweener.h"
 #include "Fountain.h"
+#include "GuestAggregation.h"
 #include "MoneyEffect.h"
 #include "Particle.h"
 
@@ -212,6 +213,8 @@ static void EntitySpatialInsert(EntityBase* entity, const CoordsXY& newLoc);
  */
 void ResetEntitySpatialIndices()
 {
+    // Entities have been replaced by loading a park or from the network
+    GetGuestAggregation().Invalidate();
     for (auto& vec : gEntitySpatialIndex)
     {
         vec.clear();
@@ -508,6 +511,7 @@ static void FreeEntity(EntityBase& entity)
         guest->SetName({});
         OpenRCT2::RideUse::GetHistory().RemoveHandle(guest->Id);
         OpenRCT2::RideUse::GetTypeHistory().RemoveHandle(guest->Id);
+        GetGuestAggregation().Remove(guest->Id);
     }
 }
 
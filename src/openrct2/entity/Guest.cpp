@@ -21,6 +21,7 @@
 #include "../core/String.hpp"
 #include "../entity/Balloon.h"
 #include "../entity/EntityRegistry.h"
+#include "../entity/GuestAggregation.h"
 #include "../entity/MoneyEffect.h"
 #include "../entity/Particle.h"
 #include "../interface/Window_internal.h"
@@ -679,6 +680,7 @@ void Guest::HandleEasterEggName()
     {
         PeepFlags |= PEEP_FLAGS_LEAVING_PARK;
         PeepFlags &= ~PEEP_FLAGS_PARK_ENTRANCE_CHOSEN;
+        GetGuestAggregation().MarkChanged(*this);
     }
 
     PeepFlags &= ~PEEP_FLAGS_PURPLE;
@@ -1429,6 +1431,7 @@ void Guest::CheckCantFindRide()
         return;
 
     GuestHeadingToRideId = RideId::GetNull();
+    GetGuestAggregation().MarkChanged(*this);
     WindowBase* w = WindowFindByNumber(WindowClass::Peep, Id);
 
     if (w != nullptr)
@@ -1774,6 +1777,7 @@ void Guest::OnExitRide(Ride& ride)
         GuestIsLostCountdown = 200;
         ResetPathfindGoal();
         WindowInvalidateFlags |= PEEP_INVALIDATE_PEEP_ACTION;
+        GetGuestAggregation().MarkChanged(*this);
     }
 
     if (PeepShouldPreferredIntensityIncrease(this))
@@ -2418,6 +2422,7 @@ static void PeepResetRideHeading(Guest* peep)
 {
     peep->GuestHeadingToRideId = RideId::GetNull();
     peep->WindowInvalidateFlags |= PEEP_INVALIDATE_PEEP_ACTION;
+    GetGuestAggregation().MarkChanged(*peep);
 }
 
 static void PeepRideIsTooIntense(Guest* peep, Ride& ride, bool peepAtRide)
@@ -3101,6 +3106,7 @@ static void PeepDecideWhetherToLeavePark(Guest* peep)
 static void PeepLeavePark(Guest* peep)
 {
     peep->GuestHeadingToRideId = RideId::GetNull();
+    GetGuestAggregation().MarkChanged(*peep);
     if (peep->PeepFlags & PEEP_FLAGS_LEAVING_PARK)
     {
         if (peep->GuestIsLostCountdown < 60)
@@ -3225,6 +3231,7 @@ template<typename T> static void PeepHeadForNearestRide(Guest* peep, bool consid
         peep->GuestIsLostCountdown = 200;
         peep->ResetPathfindGoal();
         peep->WindowInvalidateFlags |= PEEP_INVALIDATE_PEEP_ACTION;
+        GetGuestAggregation().MarkChanged(*peep);
         peep->TimeLost = 0;
     }
 }
@@ -3290,6 +3297,7 @@ void Guest::StopPurchaseThought(ride_type_t rideType)
         WindowInvalidateFlags |= PEEP_INVALIDATE_PEEP_THOUGHTS;
         i--;
     }
+    GetGuestAggregation().MarkChanged(*this);
 }
 
 /**
@@ -5711,6 +5719,7 @@ void Guest::UpdateEnteringPark()
 
     OutsideOfPark = false;
     ParkEntryTime = GetGameState().CurrentTicks;
+    GetGuestAggregation().MarkChanged(*this);
     IncrementGuestsInPark();
     DecrementGuestsHeadingForPark();
     auto intent = Intent(INTENT_ACTION_UPDATE_GUEST_COUNT);
@@ -5741,6 +5750,7 @@ void Guest::UpdateLeavingPark()
 
     OutsideOfPark = true;
     DestinationTolerance = 5;
+    GetGuestAggregation().MarkChanged(*this);
     DecrementGuestsInPark();
     auto intent = Intent(INTENT_ACTION_UPDATE_GUEST_COUNT);
     ContextBroadcastIntent(&intent);
@@ -6989,6 +6999,7 @@ void Guest::InsertNewThought(PeepThoughtType thoughtType, uint16_t thoughtArgume
     thought.fresh_timeout = 0;
 
     WindowInvalidateFlags |= PEEP_INVALIDATE_PEEP_THOUGHTS;
+    GetGuestAggregation().MarkChanged(*this);
 }
 
 // clang-format off
@@ -7630,6 +7641,7 @@ void Guest::RemoveRideFromMemory(RideId rideId)
         lastEntry.type = PeepThoughtType::None;
         lastEntry.item = PeepThoughtItemNone;
     }
+    GetGuestAggregation().MarkChanged(*this);
 }
 
 void Guest::Serialise(DataSerialiser& stream)
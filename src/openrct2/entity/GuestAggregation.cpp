@@ -0,0 +1,300 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2024 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#include "GuestAggregation.h"
+
+#include "EntityList.h"
+#include "EntityRegistry.h"
+#include "Guest.h"
+
+// Thoughts older than this are not shown by the guest list and are not counted by awards.
+static constexpr uint8_t MaxFreshness = 5;
+
+static bool IsRideState(PeepState state)
+{
+    switch (state)
+    {
+        case PeepState::Queuing:
+        case PeepState::QueuingFront:
+        case PeepState::EnteringRide:
+        case PeepState::OnRide:
+        case PeepState::LeavingRide:
+        case PeepState::Buying:
+            return true;
+        default:
+            return false;
+    }
+}
+
+static GuestAggregation::Key GetThoughtKey(const Guest& guest)
+{
+    const auto& thought = guest.Thoughts[0];
+    if (thought.type == PeepThoughtType::None || thought.freshness > MaxFreshness)
+    {
+        return GuestAggregation::NoKey;
+    }
+    return (static_cast<GuestAggregation::Key>(thought.type) << 16) | thought.item;
+}
+
+// Made of everything Peep::FormatActionTo uses for guests, so guests with the same key are shown doing the same thing.
+static GuestAggregation::Key GetActionKey(const Guest& guest)
+{
+    uint8_t detail = 0;
+    auto ride = RideId::GetNull();
+    switch (guest.State)
+    {
+        case PeepState::Falling:
+            detail = guest.Action == PeepActionType::Drowning;
+            break;
+        case PeepState::Walking:
+        case PeepState::UsingBin:
+            detail = (guest.PeepFlags & PEEP_FLAGS_LEAVING_PARK) != 0;
+            ride = guest.GuestHeadingToRideId;
+            break;
+        case PeepState::Watching:
+            detail = guest.StandingFlags & 0x1;
+            ride = guest.CurrentRide;
+            break;
+        default:
+            if (IsRideState(guest.State))
+            {
+                ride = guest.CurrentRide;
+            }
+            break;
+    }
+    return (static_cast<GuestAggregation::Key>(guest.State) << 24) | (static_cast<GuestAggregation::Key>(detail) << 16)
+        | ride.ToUnderlying();
+}
+
+void GuestAggregation::Invalidate()
+{
+    _valid = false;
+}
+
+void GuestAggregation::MarkChanged(const Guest& guest)
+{
+    if (!_valid)
+    {
+        return;
+    }
+
+    const auto index = guest.Id.ToUnderlying();
+    if (index >= _entries.size())
+    {
+        _entries.resize(index + 1);
+    }
+    if (!_entries[index].Changed)
+    {
+        _entries[index].Changed = true;
+        _changed.push_back(guest.Id);
+    }
+}
+
+void GuestAggregation::Update(const Guest& guest)
+{
+    if (!_valid)
+    {
+        return;
+    }
+
+    const auto index = guest.Id.ToUnderlying();
+    if (index >= _entries.size())
+    {
+        _entries.resize(index + 1);
+    }
+
+    const auto inPark = !guest.OutsideOfPark;
+    if (_entries[index].InPark != inPark)
+    {
+        _entries[index].InPark = inPark;
+        if (inPark)
+            _numGuests++;
+        else
+            _numGuests--;
+    }
+
+    for (size_t i = 0; i < NumKinds; i++)
+    {
+        const auto kind = static_cast<GuestAggregationKind>(i);
+        const auto key = inPark ? GetKey(kind, guest) : NoKey;
+        if (key != _entries[index].Keys[i])
+        {
+            SetKey(kind, guest.Id, key);
+        }
+    }
+}
+
+void GuestAggregation::Remove(EntityId id)
+{
+    const auto index = id.ToUnderlying();
+    if (!_valid || index >= _entries.size())
+    {
+        return;
+    }
+
+    for (size_t i = 0; i < NumKinds; i++)
+    {
+        SetKey(static_cast<GuestAggregationKind>(i), id, NoKey);
+    }
+    if (_entries[index].InPark)
+    {
+        _entries[index].InPark = false;
+        _numGuests--;
+    }
+}
+
+const std::vector<GuestAggregation::Group>& GuestAggregation::GetGroups(GuestAggregationKind kind)
+{
+    Validate();
+    return _groups[static_cast<size_t>(kind)].List;
+}
+
+const GuestAggregation::Group* GuestAggregation::GetGroup(GuestAggregationKind kind, Key key)
+{
+    Validate();
+    const auto& groups = _groups[static_cast<size_t>(kind)];
+    auto it = groups.Lookup.find(key);
+    return it != groups.Lookup.end() ? &groups.List[it->second] : nullptr;
+}
+
+GuestAggregation::Key GuestAggregation::GetKey(GuestAggregationKind kind, EntityId id)
+{
+    Validate();
+    const auto index = id.ToUnderlying();
+    return index < _entries.size() ? _entries[index].Keys[static_cast<size_t>(kind)] : NoKey;
+}
+
+uint32_t GuestAggregation::GetNumGuests()
+{
+    Validate();
+    return _numGuests;
+}
+
+uint32_t GuestAggregation::GetNumGuestsThinking(PeepThoughtType type)
+{
+    Validate();
+    return _numGuestsThinking[static_cast<uint8_t>(type)];
+}
+
+GuestAggregation::Key GuestAggregation::GetKey(GuestAggregationKind kind, const Guest& guest)
+{
+    switch (kind)
+    {
+        case GuestAggregationKind::Thought:
+            return GetThoughtKey(guest);
+        case GuestAggregationKind::Action:
+            return GetActionKey(guest);
+        case GuestAggregationKind::Ride:
+            return IsRideState(guest.State) && !guest.CurrentRide.IsNull() ? guest.CurrentRide.ToUnderlying() : NoKey;
+        case GuestAggregationKind::State:
+            return static_cast<Key>(guest.State);
+        default:
+            return NoKey;
+    }
+}
+
+void GuestAggregation::Validate()
+{
+    if (_valid)
+    {
+        // Guests freed since they were marked have already been removed.
+        for (auto id : _changed)
+        {
+            _entries[id.ToUnderlying()].Changed = false;
+            auto* guest = GetEntity<Guest>(id);
+            if (guest != nullptr)
+            {
+                Update(*guest);
+            }
+        }
+        _changed.clear();
+        return;
+    }
+
+    _entries.clear();
+    _changed.clear();
+    for (auto& groups : _groups)
+    {
+        groups.List.clear();
+        groups.Lookup.clear();
+    }
+    _numGuestsThinking.fill(0);
+    _numGuests = 0;
+
+    _valid = true;
+    for (auto* guest : EntityList<Guest>())
+    {
+        Update(*guest);
+    }
+}
+
+// Groups and their members are removed by moving the last one in their place.
+void GuestAggregation::SetKey(GuestAggregationKind kind, EntityId id, Key key)
+{
+    const auto kindIndex = static_cast<size_t>(kind);
+    auto& groups = _groups[kindIndex];
+    auto& entry = _entries[id.ToUnderlying()];
+
+    const auto oldKey = entry.Keys[kindIndex];
+    if (oldKey == key)
+    {
+        return;
+    }
+
+    if (oldKey != NoKey)
+    {
+        const auto groupIndex = groups.Lookup.at(oldKey);
+        auto& guests = groups.List[groupIndex].Guests;
+        const auto position = entry.Positions[kindIndex];
+        const auto last = guests.back();
+        guests[position] = last;
+        _entries[last.ToUnderlying()].Positions[kindIndex] = position;
+        guests.pop_back();
+
+        if (guests.empty())
+        {
+            if (groupIndex != groups.List.size() - 1)
+            {
+                groups.List[groupIndex] = std::move(groups.List.back());
+                groups.Lookup[groups.List[groupIndex].GroupKey] = groupIndex;
+            }
+            groups.List.pop_back();
+            groups.Lookup.erase(oldKey);
+        }
+
+        if (kind == GuestAggregationKind::Thought)
+        {
+            _numGuestsThinking[oldKey >> 16]--;
+        }
+    }
+
+    entry.Keys[kindIndex] = key;
+    if (key != NoKey)
+    {
+        auto [it, added] = groups.Lookup.try_emplace(key, groups.List.size());
+        if (added)
+        {
+            groups.List.push_back({ key, {} });
+        }
+        auto& guests = groups.List[it->second].Guests;
+        entry.Positions[kindIndex] = static_cast<uint32_t>(guests.size());
+        guests.push_back(id);
+
+        if (kind == GuestAggregationKind::Thought)
+        {
+            _numGuestsThinking[key >> 16]++;
+        }
+    }
+}
+
+GuestAggregation& GetGuestAggregation()
+{
+    static GuestAggregation aggregation;
+    return aggregation;
+}
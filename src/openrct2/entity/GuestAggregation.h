@@ -0,0 +1,103 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2024 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#pragma once
+
+#include "../Identifiers.h"
+#include "../common.h"
+
+#include <array>
+#include <limits>
+#include <unordered_map>
+#include <vector>
+
+struct Guest;
+enum class PeepThoughtType : uint8_t;
+
+enum class GuestAggregationKind : uint8_t
+{
+    // Most recent thought, while it is fresh enough to be shown.
+    Thought,
+    // What the guest list shows the guest doing, which includes the ride for most states.
+    Action,
+    // Ride the guest is queuing for, on or buying from.
+    Ride,
+    State,
+    Count,
+};
+
+/**
+ * Guests in the park grouped by their thought, action, ride and state. Guests move between groups as they change, so
+ * counts and members of a group can be looked up without going through every guest.
+ *
+ * Guests mark themselves as changed where the fields the keys are made of change: their state, the ride they are
+ * heading to, leaving the park and their thoughts. Only the guests marked since it was last used are keyed again, so
+ * keeping it up to date does not cost anything for guests that stay the same. Loading a park or replacing entities
+ * invalidates it and it is built again the next time it is used.
+ */
+class GuestAggregation
+{
+public:
+    using Key = uint64_t;
+    static constexpr Key NoKey = std::numeric_limits<Key>::max();
+    static constexpr size_t NumKinds = static_cast<size_t>(GuestAggregationKind::Count);
+
+    struct Group
+    {
+        Key GroupKey{};
+        // In no particular order.
+        std::vector<EntityId> Guests;
+    };
+
+    void Invalidate();
+    void MarkChanged(const Guest& guest);
+    void Remove(EntityId id);
+
+    // Groups of a kind in no particular order, groups without guests are left out.
+    const std::vector<Group>& GetGroups(GuestAggregationKind kind);
+    const Group* GetGroup(GuestAggregationKind kind, Key key);
+    Key GetKey(GuestAggregationKind kind, EntityId id);
+    uint32_t GetNumGuests();
+    uint32_t GetNumGuestsThinking(PeepThoughtType type);
+
+    static Key GetKey(GuestAggregationKind kind, const Guest& guest);
+
+private:
+    struct Entry
+    {
+        bool InPark{};
+        bool Changed{};
+        std::array<Key, NumKinds> Keys;
+        std::array<uint32_t, NumKinds> Positions{};
+
+        Entry()
+        {
+            Keys.fill(NoKey);
+        }
+    };
+
+    struct Groups
+    {
+        std::vector<Group> List;
+        std::unordered_map<Key, size_t> Lookup;
+    };
+
+    bool _valid{};
+    std::vector<Entry> _entries;
+    std::vector<EntityId> _changed;
+    std::array<Groups, NumKinds> _groups;
+    std::array<uint32_t, 256> _numGuestsThinking{};
+    uint32_t _numGuests{};
+
+    void Validate();
+    void Update(const Guest& guest);
+    void SetKey(GuestAggregationKind kind, EntityId id, Key key);
+};
+
+GuestAggregation& GetGuestAggregation();
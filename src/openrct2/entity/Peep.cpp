@@ -25,6 +25,7 @@
 #include "../entity/Balloon.h"
 #include "../entity/EntityRegistry.h"
 #include "../entity/EntityTweener.h"
+#include "../entity/GuestAggregation.h"
 #include "../interface/Window_internal.h"
 #include "../localisation/Formatter.h"
 #include "../localisation/Formatting.h"
@@ -570,6 +571,7 @@ void PeepWindowStateUpdate(Peep* peep)
 
         WindowInvalidateByNumber(WindowClass::Peep, peep->Id);
         WindowInvalidateByClass(WindowClass::GuestList);
+        GetGuestAggregation().MarkChanged(*peep->As<Guest>());
     }
     else
     {
@@ -897,6 +899,7 @@ static void GuestUpdateThoughts(Guest* peep)
     // a holding zone. Before it becomes fresh.
     int32_t add_fresh = 1;
     int32_t fresh_thought = -1;
+    bool changed = false;
     for (int32_t i = 0; i < PEEP_MAX_THOUGHTS; i++)
     {
         if (peep->Thoughts[i].type == PeepThoughtType::None)
@@ -913,6 +916,7 @@ static void GuestUpdateThoughts(Guest* peep)
                 // Thought is no longer fresh
                 peep->Thoughts[i].freshness++;
                 add_fresh = 1;
+                changed = true;
             }
         }
         else if (peep->Thoughts[i].freshness > 1)
@@ -920,6 +924,7 @@ static void GuestUpdateThoughts(Guest* peep)
             if (++peep->Thoughts[i].fresh_timeout == 0)
             {
                 // When thought is older than ~6900 ticks remove it
+                changed = true;
                 if (++peep->Thoughts[i].freshness >= 28)
                 {
                     peep->WindowInvalidateFlags |= PEEP_INVALIDATE_PEEP_THOUGHTS;
@@ -945,6 +950,11 @@ static void GuestUpdateThoughts(Guest* peep)
     {
         peep->Thoughts[fresh_thought].freshness = 1;
         peep->WindowInvalidateFlags |= PEEP_INVALIDATE_PEEP_THOUGHTS;
+        changed = true;
+    }
+    if (changed)
+    {
+        GetGuestAggregation().MarkChanged(*peep);
     }
 }
 
@@ -29,7 +29,9 @@
 #include "../actions/StaffSetCostumeAction.h"
 #include "../config/Config.h"
 #include "../core/Console.hpp"
+#include "../core/File.h"
 #include "../core/Guard.hpp"
+#include "../core/Json.hpp"
 #include "../core/Path.hpp"
 #include "../core/String.hpp"
 #include "../drawing/Drawing.h"
@@ -79,6 +81,10 @@
 #    include "../drawing/TTF.h"
 #endif
 
+#ifdef ENABLE_SCRIPTING
+#    include "../scripting/ScriptEngine.h"
+#endif
+
 using namespace OpenRCT2;
 
 using arguments_t = std::vector<std::string>;
@@ -1706,6 +1712,38 @@ static int32_t ConsoleCommandReplayStop(InteractiveConsole& console, const argum
     return 0;
 }
 
+static int32_t ConsoleCommandReplaySeek(InteractiveConsole& console, const arguments_t& argv)
+{
+    if (NetworkGetMode() != NETWORK_MODE_NONE)
+    {
+        console.WriteFormatLine("This command is currently not supported in multiplayer mode.");
+        return 0;
+    }
+
+    if (argv.size() < 1)
+    {
+        console.WriteFormatLine("Parameters required <tick>");
+        return 0;
+    }
+
+    auto* replayManager = OpenRCT2::GetContext()->GetReplayManager();
+    if (!replayManager->IsReplaying())
+    {
+        console.WriteFormatLine("Replay currently not playing");
+        return 0;
+    }
+
+    uint32_t tick = atol(argv[0].c_str());
+    if (replayManager->SeekPlayback(tick))
+    {
+        console.WriteFormatLine("Replay seeked to tick %u", tick);
+        return 1;
+    }
+
+    console.WriteFormatLine("Unable to seek to tick %u", tick);
+    return 0;
+}
+
 static int32_t ConsoleCommandReplayNormalise(InteractiveConsole& console, const arguments_t& argv)
 {
     if (NetworkGetMode() != NETWORK_MODE_NONE)
@@ -1877,6 +1915,41 @@ static int32_t ConsoleCommandAddNewsItem([[maybe_unused]] InteractiveConsole& co
     return 0;
 }
 
+static int32_t ConsoleCommandNetworkStats(InteractiveConsole& console, [[maybe_unused]] const arguments_t& argv)
+{
+    if (NetworkGetMode() == NETWORK_MODE_NONE)
+    {
+        console.WriteFormatLine("This command only works in multiplayer mode.");
+        return 0;
+    }
+
+    const auto telemetry = NetworkGetTelemetryAsJson();
+
+    console.WriteFormatLine("%-22s %12s %8s %12s %8s", "Command", "Bytes sent", "Packets", "Bytes recv", "Packets");
+    for (const auto& item : telemetry.at("commands").items())
+    {
+        const auto& stats = item.value();
+        console.WriteFormatLine(
+            "%-22s %12llu %8u %12llu %8u", item.key().c_str(), stats.at("bytesSent").get<unsigned long long>(),
+            stats.at("packetsSent").get<uint32_t>(), stats.at("bytesReceived").get<unsigned long long>(),
+            stats.at("packetsReceived").get<uint32_t>());
+    }
+
+    console.WriteLine("");
+    console.WriteFormatLine(
+        "%-20s %-22s %6s %6s %6s %6s %6s", "Player", "Address", "Queue", "Peak", "RTT50", "RTT95", "RTT99");
+    for (const auto& connection : telemetry.at("connections"))
+    {
+        const auto name = connection.contains("player") ? connection["player"]["name"].get<std::string>() : "-";
+        const auto& rtt = connection.at("rtt");
+        console.WriteFormatLine(
+            "%-20s %-22s %6u %6u %6u %6u %6u", name.c_str(), connection.at("address").get<std::string>().c_str(),
+            connection.at("queueDepth").get<uint32_t>(), connection.at("queueHighWater").get<uint32_t>(),
+            rtt.at("p50").get<uint32_t>(), rtt.at("p95").get<uint32_t>(), rtt.at("p99").get<uint32_t>());
+    }
+    return 0;
+}
+
 static int32_t ConsoleCommandProfilerReset(
     [[maybe_unused]] InteractiveConsole& console, [[maybe_unused]] const arguments_t& argv)
 {
@@ -1928,6 +2001,136 @@ static int32_t ConsoleCommandProfilerStop(
     return 0;
 }
 
+#ifdef ENABLE_SCRIPTING
+static int32_t ConsoleCommandPluginStats(InteractiveConsole& console, const arguments_t& argv)
+{
+    auto& scriptEngine = GetContext()->GetScriptEngine();
+    if (argv.size() >= 1 && argv[0] == "reset")
+    {
+        for (const auto& plugin : scriptEngine.GetPlugins())
+        {
+            auto& profile = plugin->GetHookProfile();
+            profile.Hooks = {};
+            profile.OverBudgetTicks = 0;
+        }
+        return 0;
+    }
+
+    console.WriteFormatLine("%-24s %-22s %8s %10s %9s %9s", "Plugin", "Hook", "Calls", "Total ms", "Mean ms", "Max ms");
+    for (const auto& plugin : scriptEngine.GetPlugins())
+    {
+        const auto& name = plugin->GetMetadata().Name;
+        const auto& profile = plugin->GetHookProfile();
+        for (size_t i = 0; i < profile.Hooks.size(); i++)
+        {
+            const auto& stats = profile.Hooks[i];
+            if (stats.CallCount == 0)
+            {
+                continue;
+            }
+
+            const auto hookName = OpenRCT2::Scripting::GetHookName(static_cast<OpenRCT2::Scripting::HOOK_TYPE>(i));
+            console.WriteFormatLine(
+                "%-24s %-22s %8u %10.2f %9.3f %9.3f", name.c_str(), std::string(hookName).c_str(), stats.CallCount,
+                stats.TotalTime / 1000.0, stats.TotalTime / 1000.0 / stats.CallCount, stats.MaxTime / 1000.0);
+        }
+        if (profile.OverBudgetTicks > 0 || profile.Suspended)
+        {
+            console.WriteFormatLine(
+                "%-24s over budget in %u ticks%s", name.c_str(), profile.OverBudgetTicks,
+                profile.Suspended ? ", hooks suspended" : "");
+        }
+    }
+    return 0;
+}
+
+static int32_t ConsoleCommandPluginResume(InteractiveConsole& console, const arguments_t& argv)
+{
+    if (argv.size() < 1)
+    {
+        console.WriteLineError("Missing argument: <plugin name>");
+        return 1;
+    }
+
+    for (const auto& plugin : GetContext()->GetScriptEngine().GetPlugins())
+    {
+        if (plugin->GetMetadata().Name == argv[0])
+        {
+            plugin->GetHookProfile().Suspended = false;
+            console.WriteFormatLine("Resumed hooks of %s", argv[0].c_str());
+            return 0;
+        }
+    }
+    console.WriteLineError("No plugin with that name.");
+    return 1;
+}
+
+static int32_t ConsoleCommandPluginMemory(InteractiveConsole& console, const arguments_t& argv)
+{
+    using namespace OpenRCT2::Scripting;
+
+    auto& scriptEngine = GetContext()->GetScriptEngine();
+    const auto& allocator = scriptEngine.GetHeapAllocator();
+    auto writeStats = [&console](const char* name, const DukHeapStats& stats) {
+        console.WriteFormatLine(
+            "%-24s %10.1f %10.1f %12llu %10u %10.1f %8u", name, stats.LiveBytes / 1024.0, stats.PeakBytes / 1024.0,
+            static_cast<unsigned long long>(stats.Allocations), stats.AllocationRate, stats.AllocatedBytesRate / 1024.0,
+            stats.FailedAllocations);
+    };
+
+    console.WriteFormatLine(
+        "%-24s %10s %10s %12s %10s %10s %8s", "Plugin", "Live KiB", "Peak KiB", "Allocs", "Allocs/s", "KiB/s", "Failed");
+    writeStats("(none)", allocator.GetStats(DUK_HEAP_OWNER_NONE));
+    for (const auto& plugin : scriptEngine.GetPlugins())
+    {
+        writeStats(plugin->GetMetadata().Name.c_str(), allocator.GetStats(plugin->GetHeapOwner()));
+    }
+
+    const auto pooled = allocator.GetPooledAllocations();
+    const auto total = pooled + allocator.GetSystemAllocations();
+    console.WriteFormatLine(
+        "%.1f%% of allocations pooled, %zu KiB reserved for pools", total == 0 ? 0.0 : pooled * 100.0 / total,
+        allocator.GetReservedBytes() / 1024);
+    return 0;
+}
+
+static int32_t ConsoleCommandPluginStorage(InteractiveConsole& console, const arguments_t& argv)
+{
+    if (argv.size() < 3 || (argv[0] != "export" && argv[0] != "import") || (argv[1] != "shared" && argv[1] != "park"))
+    {
+        console.WriteLineError("Need arguments: <export|import> <shared|park> <path>");
+        return 1;
+    }
+
+    auto& scriptEngine = GetContext()->GetScriptEngine();
+    const auto isShared = argv[1] == "shared";
+    const auto& path = argv[2];
+    try
+    {
+        if (argv[0] == "export")
+        {
+            auto json = isShared ? scriptEngine.GetSharedStorageAsJSON() : scriptEngine.GetParkStorageAsJSON();
+            File::WriteAllBytes(path, json.data(), json.size());
+        }
+        else
+        {
+            auto json = File::ReadAllText(path);
+            if (!(isShared ? scriptEngine.SetSharedStorageFromJSON(json) : scriptEngine.SetParkStorageFromJSON(json)))
+            {
+                console.WriteLineError("The file does not contain a JSON object.");
+                return 1;
+            }
+        }
+    }
+    catch (const std::exception& e)
+    {
+        console.WriteLineError(e.what());
+        return 1;
+    }
+    return 0;
+}
+#endif
+
 static int32_t ConsoleSpawnBalloon(InteractiveConsole& console, const arguments_t& argv)
 {
     if (argv.size() < 3)
@@ -2048,15 +2251,27 @@ static constexpr ConsoleCommand console_command_table[] = {
     { "replay_stoprecord", ConsoleCommandReplayStopRecord, "Stops recording a new replay.", "replay_stoprecord" },
     { "replay_start", ConsoleCommandReplayStart, "Starts a replay", "replay_start <name>" },
     { "replay_stop", ConsoleCommandReplayStop, "Stops the replay", "replay_stop" },
+    { "replay_seek", ConsoleCommandReplaySeek, "Seeks the replay to a tick from its start", "replay_seek <tick>" },
     { "replay_normalise", ConsoleCommandReplayNormalise, "Normalises the replay to remove all gaps",
       "replay_normalise <input file> <output file>" },
     { "mp_desync", ConsoleCommandMpDesync, "Forces a multiplayer desync",
       "ConsoleCommandMpDesync [desync_type, 0 = Random t-shirt color on random guest, 1 = Remove random guest ]" },
+    { "network_stats", ConsoleCommandNetworkStats, "Shows the network traffic per command and connection.",
+      "network_stats" },
     { "profiler_reset", ConsoleCommandProfilerReset, "Resets the profiler data.", "profiler_reset" },
     { "profiler_start", ConsoleCommandProfilerStart, "Starts the profiler.", "profiler_start" },
     { "profiler_stop", ConsoleCommandProfilerStop, "Stops the profiler.", "profiler_stop [<output file>]" },
     { "profiler_exportcsv", ConsoleCommandProfilerExportCSV, "Exports the current profiler data.",
       "profiler_exportcsv <output file>" },
+#ifdef ENABLE_SCRIPTING
+    { "plugin_stats", ConsoleCommandPluginStats, "Shows the time spent in the hooks of each plugin.",
+      "plugin_stats [reset]" },
+    { "plugin_resume", ConsoleCommandPluginResume, "Resumes the hooks of a plugin suspended for going over budget.",
+      "plugin_resume <plugin name>" },
+    { "plugin_memory", ConsoleCommandPluginMemory, "Shows the script heap memory used by each plugin.", "plugin_memory" },
+    { "plugin_storage", ConsoleCommandPluginStorage, "Exports plugin storage to or imports it from a JSON file.",
+      "plugin_storage <export|import> <shared|park> <path>" },
+#endif
 };
 
 static int32_t ConsoleCommandWindows(InteractiveConsole& console, [[maybe_unused]] const arguments_t& argv)
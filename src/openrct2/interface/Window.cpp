@@ -36,15 +36,28 @@
 
 #include <algorithm>
 #include <cmath>
+#include <deque>
 #include <functional>
 #include <iterator>
 #include <list>
+#include <unordered_map>
+#include <vector>
 
 using namespace OpenRCT2;
 
 std::list<std::shared_ptr<WindowBase>> g_window_list;
 WindowBase* gWindowAudioExclusive;
 
+// Windows by class and by class and number, in the order of g_window_list. Built again when first used after the list
+// changed. Windows closed since then are still in it, so users have to skip dead windows.
+static bool _windowIndexValid;
+static std::unordered_map<WindowClass, std::vector<WindowBase*>> _windowsByClass;
+static std::unordered_map<uint32_t, WindowBase*> _windowsByNumber;
+
+// A buffer for each level of nested WindowVisitEach calls, reused so visiting does not allocate.
+static std::deque<std::vector<WindowBase*>> _windowVisitBuffers;
+static size_t _windowVisitDepth;
+
 WidgetIdentifier gCurrentTextBox = { { WindowClass::Null, 0 }, 0 };
 WindowCloseModifier gLastCloseModifier = { { WindowClass::Null, 0 }, CloseWindowModifier::None };
 u8string gTextBoxInput;
@@ -96,14 +109,79 @@ std::list<std::shared_ptr<WindowBase>>::iterator WindowGetIterator(const WindowB
     });
 }
 
+static uint32_t GetWindowNumberKey(WindowClass cls, rct_windownumber number)
+{
+    return (static_cast<uint32_t>(cls) << 16) | number;
+}
+
+void WindowListChanged()
+{
+    _windowIndexValid = false;
+}
+
+static void WindowUpdateIndex()
+{
+    if (_windowIndexValid)
+        return;
+
+    // The vectors are kept, so references to them stay valid while the index is built again
+    for (auto& [cls, windows] : _windowsByClass)
+    {
+        windows.clear();
+    }
+    _windowsByNumber.clear();
+    for (auto& w : g_window_list)
+    {
+        if (w->flags & WF_DEAD)
+            continue;
+        _windowsByClass[w->classification].push_back(w.get());
+        _windowsByNumber.try_emplace(GetWindowNumberKey(w->classification, w->number), w.get());
+    }
+    _windowIndexValid = true;
+}
+
+static const std::vector<WindowBase*>* WindowGetByClass(WindowClass cls)
+{
+    WindowUpdateIndex();
+    auto it = _windowsByClass.find(cls);
+    return it != _windowsByClass.end() ? &it->second : nullptr;
+}
+
+/**
+ * Windows are only removed from g_window_list by WindowFlushDead, which waits for visits to finish, so the windows can
+ * be visited without holding a reference to them even when they are closed by the function. Windows opened by the
+ * function are not visited.
+ */
 void WindowVisitEach(std::function<void(WindowBase*)> func)
 {
-    auto windowList = g_window_list;
-    for (auto& w : windowList)
+    if (_windowVisitBuffers.size() <= _windowVisitDepth)
+    {
+        _windowVisitBuffers.emplace_back();
+    }
+    auto& windows = _windowVisitBuffers[_windowVisitDepth];
+    windows.clear();
+    for (auto& w : g_window_list)
+    {
+        windows.push_back(w.get());
+    }
+
+    struct VisitScope
+    {
+        VisitScope()
+        {
+            _windowVisitDepth++;
+        }
+        ~VisitScope()
+        {
+            _windowVisitDepth--;
+        }
+    } scope;
+
+    for (auto* w : windows)
     {
         if (w->flags & WF_DEAD)
             continue;
-        func(w.get());
+        func(w);
     }
 }
 
@@ -231,8 +309,15 @@ void WindowClose(WindowBase& w)
 
 void WindowFlushDead()
 {
+    // Windows that are being visited have to stay alive until the visit is over
+    if (_windowVisitDepth > 0)
+        return;
+
     // Remove all windows in g_window_list that have the WF_DEAD flag
-    g_window_list.remove_if([](auto&& w) -> bool { return w->flags & WF_DEAD; });
+    if (g_window_list.remove_if([](auto&& w) -> bool { return w->flags & WF_DEAD; }) > 0)
+    {
+        WindowListChanged();
+    }
 }
 
 template<typename TPred> static void WindowCloseByCondition(TPred pred, uint32_t flags = WindowCloseFlags::None)
@@ -289,13 +374,13 @@ void WindowCloseByNumber(WindowClass cls, EntityId number)
  */
 WindowBase* WindowFindByClass(WindowClass cls)
 {
-    for (auto& w : g_window_list)
+    auto* windows = WindowGetByClass(cls);
+    if (windows != nullptr)
     {
-        if (w->flags & WF_DEAD)
-            continue;
-        if (w->classification == cls)
+        for (auto* w : *windows)
         {
-            return w.get();
+            if (!(w->flags & WF_DEAD))
+                return w;
         }
     }
     return nullptr;
@@ -310,13 +395,26 @@ WindowBase* WindowFindByClass(WindowClass cls)
  */
 WindowBase* WindowFindByNumber(WindowClass cls, rct_windownumber number)
 {
-    for (auto& w : g_window_list)
+    WindowUpdateIndex();
+    auto it = _windowsByNumber.find(GetWindowNumberKey(cls, number));
+    if (it != _windowsByNumber.end())
     {
-        if (w->flags & WF_DEAD)
-            continue;
-        if (w->classification == cls && w->number == number)
+        auto* w = it->second;
+        if (!(w->flags & WF_DEAD) && w->number == number)
+            return w;
+    }
+
+    // Windows can be given their number after the index was built, so look through the windows of the class as well
+    auto* windows = WindowGetByClass(cls);
+    if (windows != nullptr)
+    {
+        for (auto* w : *windows)
         {
-            return w.get();
+            if (!(w->flags & WF_DEAD) && w->number == number)
+            {
+                _windowsByNumber[GetWindowNumberKey(cls, number)] = w;
+                return w;
+            }
         }
     }
     return nullptr;
@@ -461,22 +559,6 @@ WidgetIndex WindowFindWidgetFromPoint(WindowBase& w, const ScreenCoordsXY& scree
     return widget_index;
 }
 
-/**
- * Invalidates the specified window.
- *  rct2: 0x006EB13A
- *
- * @param window The window to invalidate (esi).
- */
-template<typename TPred> static void WindowInvalidateByCondition(TPred pred)
-{
-    WindowVisitEach([pred](WindowBase* w) {
-        if (pred(w))
-        {
-            w->Invalidate();
-        }
-    });
-}
-
 /**
  * Invalidates all windows with the specified window class.
  *  rct2: 0x006EC3AC
@@ -484,7 +566,15 @@ template<typename TPred> static void WindowInvalidateByCondition(TPred pred)
  */
 void WindowInvalidateByClass(WindowClass cls)
 {
-    WindowInvalidateByCondition([cls](WindowBase* w) -> bool { return w->classification == cls; });
+    auto* windows = WindowGetByClass(cls);
+    if (windows == nullptr)
+        return;
+
+    for (auto* w : *windows)
+    {
+        if (!(w->flags & WF_DEAD))
+            w->Invalidate();
+    }
 }
 
 /**
@@ -493,8 +583,16 @@ void WindowInvalidateByClass(WindowClass cls)
  */
 void WindowInvalidateByNumber(WindowClass cls, rct_windownumber number)
 {
-    WindowInvalidateByCondition(
-        [cls, number](WindowBase* w) -> bool { return w->classification == cls && w->number == number; });
+    // All windows with the number have to be invalidated, so the windows of the class are gone through
+    auto* windows = WindowGetByClass(cls);
+    if (windows == nullptr)
+        return;
+
+    for (auto* w : *windows)
+    {
+        if (!(w->flags & WF_DEAD) && w->number == number)
+            w->Invalidate();
+    }
 }
 
 // TODO: Use variant for this once the window framework is done.
@@ -664,6 +762,7 @@ WindowBase* WindowBringToFront(WindowBase& w)
             }
 
             g_window_list.splice(itDestPos, g_window_list, itSourcePos);
+            WindowListChanged();
             w.Invalidate();
 
             if (w.windowPos.x + w.width < 20)
@@ -793,16 +892,7 @@ void WindowPushOthersBelow(WindowBase& w1)
  */
 WindowBase* WindowGetMain()
 {
-    for (auto& w : g_window_list)
-    {
-        if (w->flags & WF_DEAD)
-            continue;
-        if (w->classification == WindowClass::MainWindow)
-        {
-            return w.get();
-        }
-    }
-    return nullptr;
+    return WindowFindByClass(WindowClass::MainWindow);
 }
 
 /**
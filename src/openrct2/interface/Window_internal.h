@@ -179,3 +179,6 @@ struct WindowBase
 
 // rct2: 0x01420078
 extern std::list<std::shared_ptr<WindowBase>> g_window_list;
+
+// Has to be called after windows are added to, removed from or moved within g_window_list.
+void WindowListChanged();
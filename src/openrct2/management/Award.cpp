@@ -12,6 +12,7 @@
 #include "../GameState.h"
 #include "../config/Config.h"
 #include "../entity/Guest.h"
+#include "../entity/GuestAggregation.h"
 #include "../interface/Window.h"
 #include "../localisation/Localisation.h"
 #include "../localisation/StringIds.h"
@@ -23,6 +24,7 @@
 #include "NewsItem.h"
 
 #include <algorithm>
+#include <initializer_list>
 
 using namespace OpenRCT2;
 
@@ -83,6 +85,23 @@ bool AwardIsPositive(AwardType type)
 
 #pragma region Award checks
 
+/** Guests in the park whose most recent thought is fresh and of one of the given types. */
+static uint32_t GetNumGuestsThinking(std::initializer_list<PeepThoughtType> types)
+{
+    auto& guestAggregation = GetGuestAggregation();
+    uint32_t count = 0;
+    for (auto type : types)
+    {
+        count += guestAggregation.GetNumGuestsThinking(type);
+    }
+    return count;
+}
+
+static uint32_t GetNumGuestsThinkingUntidy()
+{
+    return GetNumGuestsThinking({ PeepThoughtType::BadLitter, PeepThoughtType::PathDisgusting, PeepThoughtType::Vandalism });
+}
+
 /** More than 1/16 of the total guests must be thinking untidy thoughts. */
 static bool AwardIsDeservedMostUntidy(int32_t activeAwardTypes)
 {
@@ -93,22 +112,7 @@ static bool AwardIsDeservedMostUntidy(int32_t activeAwardTypes)
     if (activeAwardTypes & EnumToFlag(AwardType::MostTidy))
         return false;
 
-    uint32_t negativeCount = 0;
-    for (auto peep : EntityList<Guest>())
-    {
-        if (peep->OutsideOfPark)
-            continue;
-
-        const auto& thought = std::get<0>(peep->Thoughts);
-        if (thought.freshness > 5)
-            continue;
-
-        if (thought.type == PeepThoughtType::BadLitter || thought.type == PeepThoughtType::PathDisgusting
-            || thought.type == PeepThoughtType::Vandalism)
-        {
-            negativeCount++;
-        }
-    }
+    const auto negativeCount = GetNumGuestsThinkingUntidy();
 
     return (negativeCount > GetGameState().NumGuestsInPark / 16);
 }
@@ -121,26 +125,8 @@ static bool AwardIsDeservedMostTidy(int32_t activeAwardTypes)
     if (activeAwardTypes & EnumToFlag(AwardType::MostDisappointing))
         return false;
 
-    uint32_t positiveCount = 0;
-    uint32_t negativeCount = 0;
-    for (auto peep : EntityList<Guest>())
-    {
-        if (peep->OutsideOfPark)
-            continue;
-
-        const auto& thought = std::get<0>(peep->Thoughts);
-        if (thought.freshness > 5)
-            continue;
-
-        if (thought.type == PeepThoughtType::VeryClean)
-            positiveCount++;
-
-        if (thought.type == PeepThoughtType::BadLitter || thought.type == PeepThoughtType::PathDisgusting
-            || thought.type == PeepThoughtType::Vandalism)
-        {
-            negativeCount++;
-        }
-    }
+    const auto positiveCount = GetNumGuestsThinking({ PeepThoughtType::VeryClean });
+    const auto negativeCount = GetNumGuestsThinkingUntidy();
 
     return (negativeCount <= 5 && positiveCount > GetGameState().NumGuestsInPark / 64);
 }
@@ -203,27 +189,8 @@ static bool AwardIsDeservedMostBeautiful(int32_t activeAwardTypes)
     if (activeAwardTypes & EnumToFlag(AwardType::MostDisappointing))
         return false;
 
-    uint32_t positiveCount = 0;
-    uint32_t negativeCount = 0;
-    auto list = EntityList<Guest>();
-    for (auto peep : list)
-    {
-        if (peep->OutsideOfPark)
-            continue;
-
-        const auto& thought = std::get<0>(peep->Thoughts);
-        if (thought.freshness > 5)
-            continue;
-
-        if (thought.type == PeepThoughtType::Scenery)
-            positiveCount++;
-
-        if (thought.type == PeepThoughtType::BadLitter || thought.type == PeepThoughtType::PathDisgusting
-            || thought.type == PeepThoughtType::Vandalism)
-        {
-            negativeCount++;
-        }
-    }
+    const auto positiveCount = GetNumGuestsThinking({ PeepThoughtType::Scenery });
+    const auto negativeCount = GetNumGuestsThinkingUntidy();
 
     return (negativeCount <= 15 && positiveCount > GetGameState().NumGuestsInPark / 128);
 }
@@ -249,16 +216,7 @@ static bool AwardIsDeservedWorstValue(int32_t activeAwardTypes)
 /** No more than 2 people who think the vandalism is bad and no crashes. */
 static bool AwardIsDeservedSafest([[maybe_unused]] int32_t activeAwardTypes)
 {
-    auto peepsWhoDislikeVandalism = 0;
-    for (auto peep : EntityList<Guest>())
-    {
-        if (peep->OutsideOfPark)
-            continue;
-
-        const auto& thought = std::get<0>(peep->Thoughts);
-        if (thought.freshness <= 5 && thought.type == PeepThoughtType::Vandalism)
-            peepsWhoDislikeVandalism++;
-    }
+    const auto peepsWhoDislikeVandalism = GetNumGuestsThinking({ PeepThoughtType::Vandalism });
 
     if (peepsWhoDislikeVandalism > 2)
         return false;
@@ -319,16 +277,7 @@ static bool AwardIsDeservedBestFood(int32_t activeAwardTypes)
         return false;
 
     // Count hungry peeps
-    auto hungryPeeps = 0;
-    for (auto peep : EntityList<Guest>())
-    {
-        if (peep->OutsideOfPark)
-            continue;
-
-        const auto& thought = std::get<0>(peep->Thoughts);
-        if (thought.freshness <= 5 && thought.type == PeepThoughtType::Hungry)
-            hungryPeeps++;
-    }
+    const auto hungryPeeps = GetNumGuestsThinking({ PeepThoughtType::Hungry });
     return (hungryPeeps <= 12);
 }
 
@@ -364,16 +313,7 @@ static bool AwardIsDeservedWorstFood(int32_t activeAwardTypes)
         return false;
 
     // Count hungry peeps
-    auto hungryPeeps = 0;
-    for (auto peep : EntityList<Guest>())
-    {
-        if (peep->OutsideOfPark)
-            continue;
-
-        const auto& thought = std::get<0>(peep->Thoughts);
-        if (thought.freshness <= 5 && thought.type == PeepThoughtType::Hungry)
-            hungryPeeps++;
-    }
+    const auto hungryPeeps = GetNumGuestsThinking({ PeepThoughtType::Hungry });
     return (hungryPeeps > 15);
 }
 
@@ -396,16 +336,7 @@ static bool AwardIsDeservedBestToilets([[maybe_unused]] int32_t activeAwardTypes
         return false;
 
     // Count number of guests who are thinking they need the toilet
-    auto guestsWhoNeedToilet = 0;
-    for (auto peep : EntityList<Guest>())
-    {
-        if (peep->OutsideOfPark)
-            continue;
-
-        const auto& thought = std::get<0>(peep->Thoughts);
-        if (thought.freshness <= 5 && thought.type == PeepThoughtType::Toilet)
-            guestsWhoNeedToilet++;
-    }
+    const auto guestsWhoNeedToilet = GetNumGuestsThinking({ PeepThoughtType::Toilet });
     return (guestsWhoNeedToilet <= 16);
 }
 
@@ -527,18 +458,8 @@ static bool AwardIsDeservedMostDazzlingRideColours(int32_t activeAwardTypes)
 /** At least 10 peeps and more than 1/64 of total guests are lost or can't find something. */
 static bool AwardIsDeservedMostConfusingLayout([[maybe_unused]] int32_t activeAwardTypes)
 {
-    uint32_t peepsCounted = 0;
-    uint32_t peepsLost = 0;
-    for (auto peep : EntityList<Guest>())
-    {
-        if (peep->OutsideOfPark)
-            continue;
-
-        peepsCounted++;
-        const auto& thought = std::get<0>(peep->Thoughts);
-        if (thought.freshness <= 5 && (thought.type == PeepThoughtType::Lost || thought.type == PeepThoughtType::CantFind))
-            peepsLost++;
-    }
+    const auto peepsCounted = GetGuestAggregation().GetNumGuests();
+    const auto peepsLost = GetNumGuestsThinking({ PeepThoughtType::Lost, PeepThoughtType::CantFind });
 
     return (peepsLost >= 10 && peepsLost >= peepsCounted / 64);
 }
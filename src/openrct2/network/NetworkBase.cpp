@@ -46,7 +46,7 @@ using namespace OpenRCT2;
 // It is used for making sure only compatible builds get connected, even within
 // single OpenRCT2 version.
 
-#define NETWORK_STREAM_VERSION "0"
+#define NETWORK_STREAM_VERSION "4"
 
 #define NETWORK_STREAM_ID OPENRCT2_VERSION "-" NETWORK_STREAM_VERSION
 
@@ -59,6 +59,40 @@ static int32_t _pickup_peep_old_x = LOCATION_NULL;
 // with uint16_t and needs some spare room for other data in the packet.
 static constexpr uint32_t CHUNK_SIZE = 1024 * 63;
 
+// How much map data can be on its way to a client before waiting for it to acknowledge the chunks.
+static constexpr uint32_t MAP_TRANSFER_WINDOW = CHUNK_SIZE * 4;
+
+// Different sets of requested objects produce different maps, keep a few for clients joining at once.
+static constexpr size_t MAP_DATA_CACHE_SIZE = 4;
+
+// How long a map is kept after its download stalled, for the client to reconnect and resume it.
+static constexpr uint32_t MAP_RESUME_TIMEOUT = 60000;
+
+// Ticks of entity hashes kept for desynchronised clients, roughly three seconds.
+static constexpr size_t ENTITY_HASH_HISTORY_SIZE = 128;
+
+// Limits the reply to a desynchronised client, a broken simulation can otherwise differ in every bucket.
+static constexpr size_t MAX_ENTITY_HASH_BUCKETS = 16;
+
+// Limits what a desynchronised client gets in one round, the rest is sent in the following rounds.
+static constexpr size_t RESYNC_MAX_REGIONS = 64;
+static constexpr size_t RESYNC_MAX_ENTITY_BUCKETS = 16;
+
+// Rounds before giving up, a round takes at least a round trip to the server.
+static constexpr uint32_t RESYNC_MAX_ROUNDS = 8;
+
+// Ticks to wait for the server to reply to a round.
+static constexpr uint32_t RESYNC_TIMEOUT = 400;
+
+// Ticks the server waits between replies to the same client, capturing the hashes goes over the whole map.
+static constexpr uint32_t RESYNC_SERVER_MIN_INTERVAL = 10;
+
+// Desynchronising again this many ticks after a resync means it did not cover what differs, so it is not tried again.
+static constexpr uint32_t RESYNC_MIN_INTERVAL = 1200;
+
+// How often the traffic counters are written to the server log.
+static constexpr uint32_t TELEMETRY_LOG_INTERVAL = 60000;
+
 // If data is sent fast enough it would halt the entire server, process only a maximum amount.
 // This limit is per connection, the current value was determined by tests with fuzzing.
 static constexpr uint32_t MaxPacketsPerUpdate = 100;
@@ -66,9 +100,11 @@ static constexpr uint32_t MaxPacketsPerUpdate = 100;
 #    include "../Cheats.h"
 #    include "../ParkImporter.h"
 #    include "../Version.h"
+#    include "../actions/BatchAction.h"
 #    include "../actions/GameAction.h"
 #    include "../config/Config.h"
 #    include "../core/Console.hpp"
+#    include "../core/Crypt.h"
 #    include "../core/FileStream.h"
 #    include "../core/MemoryStream.h"
 #    include "../core/Path.hpp"
@@ -98,6 +134,7 @@ static constexpr uint32_t MaxPacketsPerUpdate = 100;
 #    include <cmath>
 #    include <fstream>
 #    include <functional>
+#    include <limits>
 #    include <list>
 #    include <map>
 #    include <memory>
@@ -140,6 +177,9 @@ NetworkBase::NetworkBase(OpenRCT2::IContext& context)
     client_command_handlers[NetworkCommand::ScriptsHeader] = &NetworkBase::Client_Handle_SCRIPTS_HEADER;
     client_command_handlers[NetworkCommand::ScriptsData] = &NetworkBase::Client_Handle_SCRIPTS_DATA;
     client_command_handlers[NetworkCommand::GameState] = &NetworkBase::Client_Handle_GAMESTATE;
+    client_command_handlers[NetworkCommand::EntityHashes] = &NetworkBase::Client_Handle_ENTITYHASHES;
+    client_command_handlers[NetworkCommand::Resync] = &NetworkBase::Client_Handle_RESYNC;
+    client_command_handlers[NetworkCommand::ResyncData] = &NetworkBase::Client_Handle_RESYNCDATA;
 
     server_command_handlers[NetworkCommand::Auth] = &NetworkBase::ServerHandleAuth;
     server_command_handlers[NetworkCommand::Chat] = &NetworkBase::ServerHandleChat;
@@ -150,6 +190,21 @@ NetworkBase::NetworkBase(OpenRCT2::IContext& context)
     server_command_handlers[NetworkCommand::MapRequest] = &NetworkBase::ServerHandleMapRequest;
     server_command_handlers[NetworkCommand::RequestGameState] = &NetworkBase::ServerHandleRequestGamestate;
     server_command_handlers[NetworkCommand::Heartbeat] = &NetworkBase::ServerHandleHeartbeat;
+    server_command_handlers[NetworkCommand::MapAck] = &NetworkBase::ServerHandleMapAck;
+    server_command_handlers[NetworkCommand::RequestEntityHashes] = &NetworkBase::ServerHandleRequestEntityHashes;
+    server_command_handlers[NetworkCommand::RequestResync] = &NetworkBase::ServerHandleRequestResync;
+
+    relay_command_handlers[NetworkCommand::Auth] = &NetworkBase::RelayHandleAuth;
+    relay_command_handlers[NetworkCommand::GameAction] = &NetworkBase::RelayHandleGameAction;
+    relay_command_handlers[NetworkCommand::Chat] = &NetworkBase::RelayHandleChat;
+    relay_command_handlers[NetworkCommand::Ping] = &NetworkBase::ServerHandlePing;
+    relay_command_handlers[NetworkCommand::GameInfo] = &NetworkBase::ServerHandleGameInfo;
+    relay_command_handlers[NetworkCommand::Token] = &NetworkBase::ServerHandleToken;
+    relay_command_handlers[NetworkCommand::MapRequest] = &NetworkBase::ServerHandleMapRequest;
+    relay_command_handlers[NetworkCommand::Heartbeat] = &NetworkBase::ServerHandleHeartbeat;
+    relay_command_handlers[NetworkCommand::MapAck] = &NetworkBase::ServerHandleMapAck;
+    relay_command_handlers[NetworkCommand::RequestEntityHashes] = &NetworkBase::ServerHandleRequestEntityHashes;
+    relay_command_handlers[NetworkCommand::RequestResync] = &NetworkBase::ServerHandleRequestResync;
 
     _chat_log_fs << std::unitbuf;
     _server_log_fs << std::unitbuf;
@@ -179,7 +234,14 @@ void NetworkBase::Reconnect()
         _requireReconnect = true;
         return;
     }
-    BeginClient(_host, _port);
+    if (_relay)
+    {
+        BeginRelay(_host, _port, listening_port, _relayAddress);
+    }
+    else
+    {
+        BeginClient(_host, _port);
+    }
 }
 
 void NetworkBase::Close()
@@ -207,6 +269,13 @@ void NetworkBase::Close()
         _serverTickData.clear();
         _pendingPlayerLists.clear();
         _pendingPlayerInfo.clear();
+        _mapDataCache.clear();
+        _mapTransferSnapshots.clear();
+        _entityHashHistory.clear();
+        _desyncEntityHashes.reset();
+        _resync = {};
+        _lastResyncTick.reset();
+        _mapDownload.inProgress = false;
 
 #    ifdef ENABLE_SCRIPTING
         auto& scriptEngine = GetContext().GetScriptEngine();
@@ -219,29 +288,45 @@ void NetworkBase::Close()
     }
 }
 
-void NetworkBase::DecayCooldown(NetworkPlayer* player)
+void NetworkBase::DecayCooldown(std::unordered_map<GameCommand, int32_t>& cooldownTime)
 {
-    if (player == nullptr)
-        return; // No valid connection yet.
-
-    for (auto it = std::begin(player->CooldownTime); it != std::end(player->CooldownTime);)
+    for (auto it = std::begin(cooldownTime); it != std::end(cooldownTime);)
     {
         it->second -= _currentDeltaTime;
         if (it->second <= 0)
-            it = player->CooldownTime.erase(it);
+            it = cooldownTime.erase(it);
         else
             it++;
     }
 }
 
+void NetworkBase::ChargeCooldown(
+    std::unordered_map<GameCommand, int32_t>& cooldownTime, const std::vector<const GameAction*>& actions)
+{
+    // Each action of a batch is charged, so it is limited as much as sending them one by one.
+    for (const auto* action : actions)
+    {
+        const auto actionCooldown = static_cast<int32_t>(action->GetCooldownTime());
+        if (actionCooldown > 0)
+        {
+            cooldownTime[action->GetType()] += actionCooldown;
+        }
+    }
+}
+
 void NetworkBase::CloseConnection()
 {
     if (mode == NETWORK_MODE_CLIENT)
     {
         _serverConnection.reset();
+
+        // Stop listening for spectators, the relay settings are kept for reconnecting.
+        _ioThread.reset();
+        _listenSocket.reset();
     }
     else if (mode == NETWORK_MODE_SERVER)
     {
+        _ioThread.reset();
         _listenSocket.reset();
         _advertiser.reset();
     }
@@ -263,6 +348,7 @@ bool NetworkBase::BeginClient(const std::string& host, uint16_t port)
         return false;
 
     mode = NETWORK_MODE_CLIENT;
+    _relay = false;
 
     LOG_INFO("Connecting to %s:%u", host.c_str(), port);
     _host = host;
@@ -376,6 +462,15 @@ bool NetworkBase::BeginServer(uint16_t port, const std::string& address)
         return false;
     }
 
+    try
+    {
+        _ioThread = std::make_unique<NetworkIoThread>(*_listenSocket);
+    }
+    catch (const std::exception& ex)
+    {
+        LOG_WARNING("Unable to start network I/O thread, polling connections instead: %s", ex.what());
+    }
+
     ServerName = gConfigNetwork.ServerName;
     ServerDescription = gConfigNetwork.ServerDescription;
     ServerGreeting = gConfigNetwork.ServerGreeting;
@@ -413,6 +508,7 @@ bool NetworkBase::BeginServer(uint16_t port, const std::string& address)
     listening_port = port;
     _serverState.gamestateSnapshotsEnabled = gConfigNetwork.DesyncDebugging;
     _advertiser = CreateServerAdvertiser(listening_port);
+    GetEntityHashTree().Reset();
 
     GameLoadScripts();
     GameNotifyMapChanged();
@@ -420,11 +516,55 @@ bool NetworkBase::BeginServer(uint16_t port, const std::string& address)
     return true;
 }
 
+bool NetworkBase::BeginRelay(const std::string& host, uint16_t port, uint16_t listenPort, const std::string& listenAddress)
+{
+    if (!BeginClient(host, port))
+        return false;
+
+    LOG_VERBOSE("Begin listening for spectators");
+
+    _listenSocket = CreateTcpSocket();
+    try
+    {
+        _listenSocket->Listen(listenAddress, listenPort);
+    }
+    catch (const std::exception& ex)
+    {
+        Console::Error::WriteLine(ex.what());
+        Close();
+        return false;
+    }
+
+    try
+    {
+        _ioThread = std::make_unique<NetworkIoThread>(*_listenSocket);
+    }
+    catch (const std::exception& ex)
+    {
+        LOG_WARNING("Unable to start network I/O thread, polling connections instead: %s", ex.what());
+    }
+
+    _userManager.Load();
+
+    _relay = true;
+    _relayAddress = listenAddress;
+    listening_port = listenPort;
+
+    auto* szAddress = listenAddress.empty() ? "*" : listenAddress.c_str();
+    Console::WriteLine("Relaying %s:%u to spectators on %s:%hu", host.c_str(), port, szAddress, listenPort);
+    return true;
+}
+
 int32_t NetworkBase::GetMode() const noexcept
 {
     return mode;
 }
 
+bool NetworkBase::IsRelay() const noexcept
+{
+    return mode == NETWORK_MODE_CLIENT && _relay;
+}
+
 int32_t NetworkBase::GetStatus() const noexcept
 {
     return status;
@@ -482,6 +622,10 @@ void NetworkBase::Update()
             break;
         case NETWORK_MODE_CLIENT:
             UpdateClient();
+            if (IsRelay())
+            {
+                UpdateRelay();
+            }
             break;
     }
 
@@ -503,7 +647,7 @@ void NetworkBase::Flush()
     {
         _serverConnection->SendQueuedPackets();
     }
-    else
+    if (GetMode() == NETWORK_MODE_SERVER || IsRelay())
     {
         for (auto& it : client_connection_list)
         {
@@ -524,9 +668,9 @@ void NetworkBase::UpdateServer()
         {
             connection->Disconnect();
         }
-        else
+        else if (connection->Player != nullptr)
         {
-            DecayCooldown(connection->Player);
+            DecayCooldown(connection->Player->CooldownTime);
         }
     }
 
@@ -537,15 +681,44 @@ void NetworkBase::UpdateServer()
         ServerSendPingList();
     }
 
+    if (gConfigNetwork.LogServerActions && ticks > _lastTelemetryLogTime + TELEMETRY_LOG_INTERVAL)
+    {
+        _lastTelemetryLogTime = ticks;
+        AppendServerLog("Telemetry: " + GetTelemetryAsJson().dump());
+    }
+
+    UpdateMapTransferSnapshots();
+
     if (_advertiser != nullptr)
     {
         _advertiser->Update();
     }
 
-    std::unique_ptr<ITcpSocket> tcpSocket = _listenSocket->Accept();
-    if (tcpSocket != nullptr)
+    AcceptClients();
+}
+
+void NetworkBase::UpdateRelay()
+{
+    for (auto& connection : client_connection_list)
     {
-        AddClient(std::move(tcpSocket));
+        // This can be called multiple times before the connection is removed.
+        if (!connection->IsValid())
+            continue;
+
+        if (!ProcessConnection(*connection))
+        {
+            connection->Disconnect();
+        }
+        else
+        {
+            DecayCooldown(connection->CooldownTime);
+        }
+    }
+
+    // Spectators are left waiting until there is a park to send them.
+    if (_clientMapLoaded)
+    {
+        AcceptClients();
     }
 }
 
@@ -729,6 +902,8 @@ const char* NetworkBase::FormatChat(NetworkPlayer* fromplayer, const char* text)
 
 void NetworkBase::SendPacketToClients(const NetworkPacket& packet, bool front, bool gameCmd) const
 {
+    // Serialise once, every connection queues the same buffer.
+    const NetworkOutboundPacket outboundPacket(packet);
     for (auto& client_connection : client_connection_list)
     {
         if (gameCmd)
@@ -742,10 +917,25 @@ void NetworkBase::SendPacketToClients(const NetworkPacket& packet, bool front, b
                 continue;
             }
         }
-        client_connection->QueuePacket(packet, front);
+        client_connection->QueuePacket(outboundPacket, front);
     }
 }
 
+void NetworkBase::RelaySendPacket(const NetworkPacket& packet) const
+{
+    if (IsRelay())
+    {
+        SendPacketToClients(packet);
+    }
+}
+
+size_t NetworkBase::GetNumRelayClients() const
+{
+    return std::count_if(client_connection_list.begin(), client_connection_list.end(), [](const auto& connection) {
+        return connection->AuthStatus == NetworkAuth::Ok;
+    });
+}
+
 bool NetworkBase::CheckSRAND(uint32_t tick, uint32_t srand0)
 {
     // We have to wait for the map to be loaded first, ticks may match current loaded map.
@@ -765,13 +955,16 @@ bool NetworkBase::CheckSRAND(uint32_t tick, uint32_t srand0)
         return false;
     }
 
-    if (!storedTick.spriteHash.empty())
+    if (storedTick.hasEntitiesHash)
     {
-        EntitiesChecksum checksum = GetAllEntitiesChecksum();
-        std::string clientSpriteHash = checksum.ToString();
-        if (clientSpriteHash != storedTick.spriteHash)
+        auto& hashTree = GetEntityHashTree();
+        hashTree.Update();
+        if (hashTree.GetRoot() != storedTick.entitiesHash)
         {
-            LOG_INFO("Sprite hash mismatch, client = %s, server = %s", clientSpriteHash.c_str(), storedTick.spriteHash.c_str());
+            LOG_INFO(
+                "Entity hash mismatch, client = %016llX, server = %016llX",
+                static_cast<unsigned long long>(hashTree.GetRoot()), static_cast<unsigned long long>(storedTick.entitiesHash));
+            _desyncEntityHashes = hashTree.TakeSnapshot(tick);
             return false;
         }
     }
@@ -788,6 +981,11 @@ bool NetworkBase::CheckDesynchronizaton()
 {
     const auto currentTicks = GetGameState().CurrentTicks;
 
+    if (GetMode() == NETWORK_MODE_CLIENT && _resync.active)
+    {
+        UpdateResync(currentTicks);
+    }
+
     // Check synchronisation
     if (GetMode() == NETWORK_MODE_CLIENT && _serverState.state != NetworkServerStatus::Desynced
         && !CheckSRAND(currentTicks, ScenarioRandState().s0))
@@ -795,16 +993,9 @@ bool NetworkBase::CheckDesynchronizaton()
         _serverState.state = NetworkServerStatus::Desynced;
         _serverState.desyncTick = currentTicks;
 
-        char str_desync[256];
-        FormatStringLegacy(str_desync, 256, STR_MULTIPLAYER_DESYNC, nullptr);
-
-        auto intent = Intent(WindowClass::NetworkStatus);
-        intent.PutExtra(INTENT_EXTRA_MESSAGE, std::string{ str_desync });
-        ContextOpenIntent(&intent);
-
-        if (!gConfigNetwork.StayConnected)
+        if (!BeginResync())
         {
-            Close();
+            ReportDesynchronisation();
         }
 
         return true;
@@ -813,8 +1004,130 @@ bool NetworkBase::CheckDesynchronizaton()
     return false;
 }
 
+void NetworkBase::ReportDesynchronisation()
+{
+    char str_desync[256];
+    FormatStringLegacy(str_desync, 256, STR_MULTIPLAYER_DESYNC, nullptr);
+
+    auto intent = Intent(WindowClass::NetworkStatus);
+    intent.PutExtra(INTENT_EXTRA_MESSAGE, std::string{ str_desync });
+    ContextOpenIntent(&intent);
+
+    if (!gConfigNetwork.StayConnected)
+    {
+        Close();
+    }
+}
+
+bool NetworkBase::BeginResync()
+{
+    const auto currentTicks = GetGameState().CurrentTicks;
+    if (_lastResyncTick.has_value() && currentTicks - *_lastResyncTick < RESYNC_MIN_INTERVAL)
+    {
+        LOG_INFO("Desynchronised again %u ticks after the last resync", currentTicks - *_lastResyncTick);
+        return false;
+    }
+
+    LOG_INFO("Resynchronising from tick %u", currentTicks);
+    _resync = {};
+    _resync.active = true;
+
+    // The first round only asks for the hashes of the server.
+    _resync.requestTick = currentTicks;
+    Client_Send_RequestResync(currentTicks, {});
+    return true;
+}
+
+void NetworkBase::UpdateResync(uint32_t currentTicks)
+{
+    if (!_resync.hashes.has_value())
+    {
+        if (currentTicks - _resync.requestTick > RESYNC_TIMEOUT)
+        {
+            FailResync("the server did not reply");
+        }
+        return;
+    }
+
+    const auto& serverHashes = *_resync.hashes;
+    if (serverHashes.Tick > currentTicks)
+    {
+        return;
+    }
+    if (serverHashes.Tick < currentTicks || _resync.pendingData > 0)
+    {
+        FailResync("the data did not arrive in time");
+        return;
+    }
+
+    try
+    {
+        NetworkResyncApply(_resync.data);
+    }
+    catch (const std::exception& e)
+    {
+        FailResync(e.what());
+        return;
+    }
+    ScenarioRandSeed(serverHashes.Srand0, serverHashes.Srand1);
+
+    auto& hashTree = GetEntityHashTree();
+    hashTree.Update();
+    const auto localHashes = NetworkResyncHashes::Capture(currentTicks);
+
+    if (localHashes.Regions.size() != serverHashes.Regions.size())
+    {
+        FailResync("the map size differs");
+        return;
+    }
+
+    NetworkResyncRequest request;
+    request.Regions = NetworkResyncFindDifferences(
+        localHashes.Regions.data(), localHashes.Regions.size(), serverHashes.Regions.data(), serverHashes.Regions.size());
+    request.EntityBuckets = NetworkResyncFindDifferences(
+        localHashes.Entities.data(), localHashes.Entities.size(), serverHashes.Entities.data(),
+        serverHashes.Entities.size());
+
+    if (request.Regions.empty() && request.EntityBuckets.empty())
+    {
+        LOG_INFO("Resynchronised at tick %u after %u rounds", currentTicks, _resync.round + 1);
+        _serverState.state = NetworkServerStatus::Ok;
+        _resync = {};
+        _lastResyncTick = currentTicks;
+        return;
+    }
+
+    if (++_resync.round >= RESYNC_MAX_ROUNDS)
+    {
+        FailResync("the state kept differing");
+        return;
+    }
+
+    LOG_VERBOSE(
+        "Resync round %u: %zu regions and %zu entity buckets differ", _resync.round, request.Regions.size(),
+        request.EntityBuckets.size());
+    _resync.hashes.reset();
+    _resync.data = {};
+    _resync.requestTick = currentTicks;
+    Client_Send_RequestResync(currentTicks, request);
+}
+
+void NetworkBase::FailResync(const char* reason)
+{
+    LOG_INFO("Unable to resynchronise: %s", reason);
+    _resync = {};
+    ReportDesynchronisation();
+}
+
 void NetworkBase::RequestStateSnapshot()
 {
+    if (_desyncEntityHashes.has_value() && _desyncEntityHashes->Tick == _serverState.desyncTick)
+    {
+        LOG_INFO("Requesting entity hashes for tick %u", _serverState.desyncTick);
+        Client_Send_RequestEntityHashes(*_desyncEntityHashes);
+        return;
+    }
+
     LOG_INFO("Requesting game state for tick %u", _serverState.desyncTick);
 
     Client_Send_RequestGameState(_serverState.desyncTick);
@@ -1198,6 +1511,37 @@ void NetworkBase::Client_Send_RequestGameState(uint32_t tick)
     _serverConnection->QueuePacket(std::move(packet));
 }
 
+void NetworkBase::Client_Send_RequestEntityHashes(const EntityHashTree::Snapshot& snapshot)
+{
+    LOG_VERBOSE("Requesting entity hashes from server for tick %u", snapshot.Tick);
+
+    NetworkPacket packet(NetworkCommand::RequestEntityHashes);
+    packet << snapshot.Tick;
+    for (auto hash : snapshot.Hashes)
+    {
+        packet << hash;
+    }
+    _serverConnection->QueuePacket(std::move(packet));
+}
+
+void NetworkBase::Client_Send_RequestResync(uint32_t tick, const NetworkResyncRequest& request)
+{
+    LOG_VERBOSE("Requesting resync from server at tick %u", tick);
+
+    NetworkPacket packet(NetworkCommand::RequestResync);
+    packet << tick << static_cast<uint32_t>(request.Regions.size());
+    for (auto region : request.Regions)
+    {
+        packet << region;
+    }
+    packet << static_cast<uint32_t>(request.EntityBuckets.size());
+    for (auto bucket : request.EntityBuckets)
+    {
+        packet << bucket;
+    }
+    _serverConnection->QueuePacket(std::move(packet));
+}
+
 void NetworkBase::Client_Send_TOKEN()
 {
     LOG_VERBOSE("requesting token");
@@ -1241,6 +1585,23 @@ void NetworkBase::Client_Send_MAPREQUEST(const std::vector<ObjectEntryDescriptor
             packet.WriteString(name);
         }
     }
+
+    // Ask to continue an interrupted download, the server only does so if it still has the same map.
+    if (_mapDownload.received > 0 && _mapDownload.received < _mapDownload.size)
+    {
+        packet << _mapDownload.hash << _mapDownload.received;
+    }
+    else
+    {
+        packet << static_cast<uint64_t>(0) << static_cast<uint32_t>(0);
+    }
+    _serverConnection->QueuePacket(std::move(packet));
+}
+
+void NetworkBase::Client_Send_MAPACK(uint64_t hash, uint32_t received)
+{
+    NetworkPacket packet(NetworkCommand::MapAck);
+    packet << hash << received;
     _serverConnection->QueuePacket(std::move(packet));
 }
 
@@ -1301,7 +1662,15 @@ void NetworkBase::ServerSendScripts(NetworkConnection& connection)
     auto& scriptEngine = GetContext().GetScriptEngine();
 
     // Get remote plugin list.
-    const auto remotePlugins = scriptEngine.GetRemotePlugins();
+    auto remotePlugins = scriptEngine.GetRemotePlugins();
+    if (IsRelay())
+    {
+        // Only pass on the plugins received from the upstream server, they are the ones without a file.
+        remotePlugins.erase(
+            std::remove_if(
+                remotePlugins.begin(), remotePlugins.end(), [](const auto& plugin) { return plugin->HasPath(); }),
+            remotePlugins.end());
+    }
     LOG_VERBOSE("Server sends %zu scripts", remotePlugins.size());
 
     // Build the data contents for each plugin.
@@ -1374,6 +1743,61 @@ NetworkStats NetworkBase::GetStats() const
     return stats;
 }
 
+json_t NetworkBase::GetTelemetryAsJson() const
+{
+    NetworkCommandStatsList commands{};
+    json_t connections = json_t::array();
+
+    auto addConnection = [&](const NetworkConnection& connection) {
+        const auto& telemetry = connection.Telemetry;
+        uint64_t bytesSent = 0;
+        uint64_t bytesReceived = 0;
+        for (size_t i = 0; i < commands.size(); i++)
+        {
+            const auto& stats = telemetry.Commands[i];
+            commands[i].BytesSent += stats.BytesSent;
+            commands[i].BytesReceived += stats.BytesReceived;
+            commands[i].PacketsSent += stats.PacketsSent;
+            commands[i].PacketsReceived += stats.PacketsReceived;
+            bytesSent += stats.BytesSent;
+            bytesReceived += stats.BytesReceived;
+        }
+
+        const auto* hostName = connection.Socket->GetHostName();
+        json_t jsonConnection = {
+            { "address", hostName != nullptr ? hostName : "" },
+            { "bytesSent", bytesSent },
+            { "bytesReceived", bytesReceived },
+            { "queueDepth", connection.GetQueuedPacketCount() },
+            { "queueHighWater", telemetry.QueueHighWater },
+            { "socketWrites", telemetry.SocketWrites },
+            { "syscallsSaved", telemetry.GetSyscallsSaved() },
+            { "rtt", telemetry.Rtt.ToJson() },
+        };
+        if (connection.Player != nullptr)
+        {
+            jsonConnection["player"] = { { "id", connection.Player->Id }, { "name", connection.Player->Name } };
+        }
+        connections.push_back(std::move(jsonConnection));
+    };
+
+    // The server connection is gone once the client was closed or disconnected.
+    if (mode == NETWORK_MODE_CLIENT && _serverConnection != nullptr)
+    {
+        addConnection(*_serverConnection);
+    }
+    for (const auto& connection : client_connection_list)
+    {
+        addConnection(*connection);
+    }
+
+    return {
+        { "tick", GetGameState().CurrentTicks },
+        { "commands", NetworkCommandStatsToJson(commands) },
+        { "connections", std::move(connections) },
+    };
+}
+
 void NetworkBase::ServerSendAuth(NetworkConnection& connection)
 {
     uint8_t new_playerid = 0;
@@ -1381,6 +1805,11 @@ void NetworkBase::ServerSendAuth(NetworkConnection& connection)
     {
         new_playerid = connection.Player->Id;
     }
+    else if (IsRelay())
+    {
+        // Spectators of a relay act through the player of the relay.
+        new_playerid = player_id;
+    }
     NetworkPacket packet(NetworkCommand::Auth);
     packet << static_cast<uint32_t>(connection.AuthStatus) << new_playerid;
     if (connection.AuthStatus == NetworkAuth::BadVersion)
@@ -1394,7 +1823,7 @@ void NetworkBase::ServerSendAuth(NetworkConnection& connection)
     }
 }
 
-void NetworkBase::ServerSendMap(NetworkConnection* connection)
+void NetworkBase::ServerSendMap(NetworkConnection* connection, uint64_t resumeHash, uint32_t resumeOffset)
 {
     std::vector<const ObjectRepositoryItem*> objects;
     if (connection != nullptr)
@@ -1408,10 +1837,38 @@ void NetworkBase::ServerSendMap(NetworkConnection* connection)
         auto& context = GetContext();
         auto& objManager = context.GetObjectManager();
         objects = objManager.GetPackableObjects();
+
+        // The park has been replaced, nothing serialised before applies any more.
+        _mapDataCache.clear();
+        _mapTransferSnapshots.clear();
+    }
+
+    if (connection != nullptr && resumeHash != 0)
+    {
+        // Resume with the map the client was downloading even if the park has moved on since, followed by the game
+        // actions it missed. The client then catches up with the server like any client that has just joined.
+        auto it = _mapTransferSnapshots.find(resumeHash);
+        if (it != _mapTransferSnapshots.end())
+        {
+            auto sortedObjects = objects;
+            std::sort(sortedObjects.begin(), sortedObjects.end());
+            const auto& snapshot = it->second;
+            if (snapshot.Data->Objects == sortedObjects && resumeOffset < snapshot.Data->Size
+                && resumeOffset % CHUNK_SIZE == 0)
+            {
+                LOG_VERBOSE("Resuming map transfer at %u of %u bytes", resumeOffset, snapshot.Data->Size);
+                StartMapTransfer(*connection, snapshot.Data, resumeOffset);
+                for (const auto& gameAction : snapshot.GameActions)
+                {
+                    connection->QueuePacket(gameAction);
+                }
+                return;
+            }
+        }
     }
 
-    auto header = SaveForNetwork(objects);
-    if (header.empty())
+    auto mapData = GetMapData(objects);
+    if (mapData == nullptr)
     {
         if (connection != nullptr)
         {
@@ -1420,24 +1877,144 @@ void NetworkBase::ServerSendMap(NetworkConnection* connection)
         }
         return;
     }
-    size_t chunksize = CHUNK_SIZE;
-    for (size_t i = 0; i < header.size(); i += chunksize)
+
+    if (connection != nullptr)
     {
-        size_t datasize = std::min(chunksize, header.size() - i);
-        NetworkPacket packet(NetworkCommand::Map);
-        packet << static_cast<uint32_t>(header.size()) << static_cast<uint32_t>(i);
-        packet.Write(&header[i], datasize);
-        if (connection != nullptr)
+        StartMapTransfer(*connection, std::move(mapData), 0);
+    }
+    else
+    {
+        for (auto& clientConnection : client_connection_list)
+        {
+            if (clientConnection->AuthStatus == NetworkAuth::Ok)
+            {
+                StartMapTransfer(*clientConnection, mapData, 0);
+            }
+        }
+    }
+}
+
+void NetworkBase::StartMapTransfer(
+    NetworkConnection& connection, std::shared_ptr<const NetworkMapData> mapData, uint32_t offset)
+{
+    auto& snapshot = _mapTransferSnapshots[mapData->Hash];
+    if (snapshot.Data == nullptr)
+    {
+        snapshot.Data = mapData;
+    }
+    snapshot.LastActivity = Platform::GetTicks();
+
+    connection.MapTransfer.Data = std::move(mapData);
+    connection.MapTransfer.BytesSent = offset;
+    connection.MapTransfer.BytesAcknowledged = offset;
+    ServerSendMapChunks(connection);
+}
+
+void NetworkBase::ServerSendMapChunks(NetworkConnection& connection)
+{
+    auto& transfer = connection.MapTransfer;
+    if (transfer.Data == nullptr)
+    {
+        return;
+    }
+
+    // Only keep a few chunks in flight rather than queuing the whole map at once, the rest is sent as the client
+    // acknowledges what it has received.
+    const auto& mapData = *transfer.Data;
+    while (transfer.BytesSent < mapData.Size && transfer.BytesSent - transfer.BytesAcknowledged < MAP_TRANSFER_WINDOW)
+    {
+        connection.QueuePacket(mapData.Chunks[transfer.BytesSent / CHUNK_SIZE]);
+        transfer.BytesSent = std::min(transfer.BytesSent + CHUNK_SIZE, mapData.Size);
+    }
+
+    if (transfer.BytesAcknowledged >= mapData.Size)
+    {
+        const auto hash = mapData.Hash;
+        transfer = {};
+
+        auto it = _mapTransferSnapshots.find(hash);
+        if (it != _mapTransferSnapshots.end() && !IsMapTransferInProgress(*it->second.Data))
+        {
+            _mapTransferSnapshots.erase(it);
+        }
+    }
+}
+
+bool NetworkBase::IsMapTransferInProgress(const NetworkMapData& mapData) const
+{
+    return std::any_of(client_connection_list.begin(), client_connection_list.end(), [&mapData](const auto& connection) {
+        return connection->MapTransfer.Data.get() == &mapData;
+    });
+}
+
+void NetworkBase::UpdateMapTransferSnapshots()
+{
+    const auto ticks = Platform::GetTicks();
+    for (auto it = _mapTransferSnapshots.begin(); it != _mapTransferSnapshots.end();)
+    {
+        auto& snapshot = it->second;
+        if (IsMapTransferInProgress(*snapshot.Data))
+        {
+            snapshot.LastActivity = ticks;
+        }
+        if (ticks - snapshot.LastActivity > MAP_RESUME_TIMEOUT)
         {
-            connection->QueuePacket(std::move(packet));
+            it = _mapTransferSnapshots.erase(it);
         }
         else
         {
-            SendPacketToClients(packet);
+            it++;
         }
     }
 }
 
+std::shared_ptr<const NetworkMapData> NetworkBase::GetMapData(const std::vector<const ObjectRepositoryItem*>& objects)
+{
+    const auto currentTicks = GetGameState().CurrentTicks;
+    if (!_mapDataCache.empty() && _mapDataCache.front()->Tick != currentTicks)
+    {
+        _mapDataCache.clear();
+    }
+
+    auto sortedObjects = objects;
+    std::sort(sortedObjects.begin(), sortedObjects.end());
+    for (const auto& cachedMapData : _mapDataCache)
+    {
+        if (cachedMapData->Objects == sortedObjects)
+        {
+            return cachedMapData;
+        }
+    }
+
+    auto data = SaveForNetwork(objects);
+    if (data.empty())
+    {
+        return nullptr;
+    }
+
+    auto mapData = std::make_shared<NetworkMapData>();
+    mapData->Tick = currentTicks;
+    const auto hash = Crypt::FNV1a(data.data(), data.size());
+    std::memcpy(&mapData->Hash, hash.data(), sizeof(mapData->Hash));
+    mapData->Size = static_cast<uint32_t>(data.size());
+    mapData->Objects = std::move(sortedObjects);
+    for (size_t i = 0; i < data.size(); i += CHUNK_SIZE)
+    {
+        size_t datasize = std::min<size_t>(CHUNK_SIZE, data.size() - i);
+        NetworkPacket packet(NetworkCommand::Map);
+        packet << mapData->Size << static_cast<uint32_t>(i) << mapData->Hash;
+        packet.Write(&data[i], datasize);
+        mapData->Chunks.emplace_back(packet);
+    }
+
+    if (_mapDataCache.size() >= MAP_DATA_CACHE_SIZE)
+    {
+        _mapDataCache.erase(_mapDataCache.begin());
+    }
+    _mapDataCache.push_back(mapData);
+    return mapData;
+}
+
 std::vector<uint8_t> NetworkBase::SaveForNetwork(const std::vector<const ObjectRepositoryItem*>& objects) const
 {
     std::vector<uint8_t> result;
@@ -1515,33 +2092,120 @@ void NetworkBase::ServerSendGameAction(const GameAction* action)
     packet << GetGameState().CurrentTicks << action->GetType() << stream;
 
     SendPacketToClients(packet);
+
+    // The park has changed without the tick advancing.
+    _mapDataCache.clear();
+    if (!_mapTransferSnapshots.empty())
+    {
+        const NetworkOutboundPacket outboundPacket(packet);
+        for (auto& [hash, snapshot] : _mapTransferSnapshots)
+        {
+            snapshot.GameActions.push_back(outboundPacket);
+        }
+    }
 }
 
 void NetworkBase::ServerSendTick()
 {
-    NetworkPacket packet(NetworkCommand::Tick);
-    packet << GetGameState().CurrentTicks << ScenarioRandState().s0;
-    uint32_t flags = 0;
-    // Simple counter which limits how often a sprite checksum gets sent.
-    // This can get somewhat expensive, so we don't want to push it every tick in release,
-    // but debug version can check more often.
-    static int32_t checksum_counter = 0;
-    checksum_counter++;
-    if (checksum_counter >= 100)
+    if (!_mapDataCache.empty() && _mapDataCache.front()->Tick != GetGameState().CurrentTicks)
     {
-        checksum_counter = 0;
-        flags |= NETWORK_TICK_FLAG_CHECKSUMS;
+        _mapDataCache.clear();
     }
+
+    NetworkPacket packet(NetworkCommand::Tick);
+    packet << GetGameState().CurrentTicks << ScenarioRandState().s0;
+    // Only entities that changed since the last tick are rehashed, so the checksum can be sent every tick.
+    auto& hashTree = GetEntityHashTree();
+    hashTree.Update();
+
+    uint32_t flags = NETWORK_TICK_FLAG_CHECKSUMS;
     // Send flags always, so we can understand packet structure on the other end,
     // and allow for some expansion.
     packet << flags;
     if (flags & NETWORK_TICK_FLAG_CHECKSUMS)
     {
-        EntitiesChecksum checksum = GetAllEntitiesChecksum();
-        packet.WriteString(checksum.ToString());
+        packet << hashTree.GetRoot();
     }
 
     SendPacketToClients(packet);
+
+    // The tick is sent repeatedly while paused.
+    if (!_entityHashHistory.empty() && _entityHashHistory.back().Tick == GetGameState().CurrentTicks)
+    {
+        _entityHashHistory.pop_back();
+    }
+    else if (_entityHashHistory.size() >= ENTITY_HASH_HISTORY_SIZE)
+    {
+        _entityHashHistory.pop_front();
+    }
+    _entityHashHistory.push_back(hashTree.TakeSnapshot(GetGameState().CurrentTicks));
+
+    ServerSendResyncs();
+}
+
+void NetworkBase::ServerSendResyncs()
+{
+    const auto currentTicks = GetGameState().CurrentTicks;
+    std::optional<NetworkResyncHashes> hashes;
+    for (auto& connection : client_connection_list)
+    {
+        if (!connection->PendingResync.has_value())
+        {
+            continue;
+        }
+        // Too early, the request stays pending until it is this connection's turn again.
+        if (connection->LastResyncTick.has_value() && currentTicks - *connection->LastResyncTick < RESYNC_SERVER_MIN_INTERVAL)
+        {
+            continue;
+        }
+        connection->LastResyncTick = currentTicks;
+        const auto request = std::move(*connection->PendingResync);
+        connection->PendingResync.reset();
+
+        // Shared by all clients resynchronising at this tick.
+        if (!hashes.has_value())
+        {
+            hashes = NetworkResyncHashes::Capture(currentTicks);
+        }
+
+        std::vector<NetworkPacket> dataPackets;
+        auto addPacket = [&dataPackets](NetworkPacket&& packet) {
+            // A region too large for a single packet is left out, the client gives up when it keeps differing.
+            if (packet.Data.size() + sizeof(NetworkCommand) <= std::numeric_limits<uint16_t>::max())
+            {
+                dataPackets.push_back(std::move(packet));
+            }
+        };
+        for (auto region : request.Regions)
+        {
+            if (region < hashes->Regions.size())
+            {
+                NetworkPacket packet(NetworkCommand::ResyncData);
+                packet << currentTicks << static_cast<uint8_t>(0) << region;
+                NetworkResyncWriteRegion(packet, region);
+                addPacket(std::move(packet));
+            }
+        }
+        for (auto bucket : request.EntityBuckets)
+        {
+            if (bucket < EntityHashTree::NumBuckets)
+            {
+                NetworkPacket packet(NetworkCommand::ResyncData);
+                packet << currentTicks << static_cast<uint8_t>(1) << bucket;
+                NetworkResyncWriteEntityBucket(packet, bucket);
+                addPacket(std::move(packet));
+            }
+        }
+
+        NetworkPacket packet(NetworkCommand::Resync);
+        hashes->Write(packet);
+        packet << static_cast<uint32_t>(dataPackets.size());
+        connection->QueuePacket(std::move(packet));
+        for (auto& dataPacket : dataPackets)
+        {
+            connection->QueuePacket(std::move(dataPacket));
+        }
+    }
 }
 
 void NetworkBase::ServerSendPlayerInfo(int32_t playerId)
@@ -1725,7 +2389,17 @@ bool NetworkBase::ProcessConnection(NetworkConnection& connection)
 
 void NetworkBase::ProcessPacket(NetworkConnection& connection, NetworkPacket& packet)
 {
-    const auto& handlerList = GetMode() == NETWORK_MODE_SERVER ? server_command_handlers : client_command_handlers;
+    auto* handlers = &client_command_handlers;
+    if (GetMode() == NETWORK_MODE_SERVER)
+    {
+        handlers = &server_command_handlers;
+    }
+    else if (&connection != _serverConnection.get())
+    {
+        // Spectator connected to this relay.
+        handlers = &relay_command_handlers;
+    }
+    const auto& handlerList = *handlers;
 
     auto it = handlerList.find(packet.GetCommand());
     if (it != handlerList.end())
@@ -1756,6 +2430,10 @@ void NetworkBase::ProcessPending()
     }
     else if (GetMode() == NETWORK_MODE_CLIENT)
     {
+        if (IsRelay())
+        {
+            ProcessDisconnectedClients();
+        }
         ProcessPlayerInfo();
     }
     ProcessPlayerList();
@@ -1851,6 +2529,7 @@ void NetworkBase::ProcessPlayerList()
     {
         // As client we have to keep things in order so the update is tick bound.
         // Commands/Actions reference players and so this list needs to be in sync with those.
+        bool listChanged = false;
         auto itPending = _pendingPlayerLists.begin();
         while (itPending != _pendingPlayerLists.end())
         {
@@ -1920,6 +2599,13 @@ void NetworkBase::ProcessPlayerList()
 
             _pendingPlayerLists.erase(itPending);
             itPending = _pendingPlayerLists.begin();
+            listChanged = true;
+        }
+
+        // Spectators of a relay receive the list once it applies to the relay's own tick.
+        if (listChanged && IsRelay())
+        {
+            ServerSendPlayerList();
         }
     }
 }
@@ -1941,6 +2627,11 @@ void NetworkBase::ProcessPlayerInfo()
             player->LastActionCoord = networkedInfo.LastActionCoord;
             player->MoneySpent = networkedInfo.MoneySpent;
             player->CommandsRan = networkedInfo.CommandsRan;
+
+            if (IsRelay())
+            {
+                ServerSendPlayerInfo(player->Id);
+            }
         }
     }
     _pendingPlayerInfo.erase(currentTicks);
@@ -1959,6 +2650,11 @@ void NetworkBase::ProcessDisconnectedClients()
         }
 
         // Make sure to send all remaining packets out before disconnecting.
+        if (connection->IoChannel != nullptr)
+        {
+            _ioThread->RemoveConnection(connection->IoChannel);
+            connection->IoChannel.reset();
+        }
         connection->SendQueuedPackets();
         connection->Socket->Disconnect();
 
@@ -1979,10 +2675,33 @@ void NetworkBase::AddClient(std::unique_ptr<ITcpSocket>&& socket)
     // Store connection
     auto connection = std::make_unique<NetworkConnection>();
     connection->Socket = std::move(socket);
+    if (_ioThread != nullptr)
+    {
+        connection->IoChannel = _ioThread->AddConnection(*connection->Socket);
+    }
 
     client_connection_list.push_back(std::move(connection));
 }
 
+void NetworkBase::AcceptClients()
+{
+    if (_ioThread != nullptr)
+    {
+        while (auto tcpSocket = _ioThread->Accept())
+        {
+            AddClient(std::move(tcpSocket));
+        }
+    }
+    else
+    {
+        std::unique_ptr<ITcpSocket> tcpSocket = _listenSocket->Accept();
+        if (tcpSocket != nullptr)
+        {
+            AddClient(std::move(tcpSocket));
+        }
+    }
+}
+
 void NetworkBase::ServerClientDisconnected(std::unique_ptr<NetworkConnection>& connection)
 {
     NetworkPlayer* connection_player = connection->Player;
@@ -2236,6 +2955,101 @@ void NetworkBase::ServerHandleRequestGamestate(NetworkConnection& connection, Ne
     }
 }
 
+void NetworkBase::ServerHandleRequestEntityHashes(NetworkConnection& connection, NetworkPacket& packet)
+{
+    uint32_t tick;
+    packet >> tick;
+
+    EntityHashTree::BucketHashes clientHashes{};
+    for (auto& hash : clientHashes)
+    {
+        packet >> hash;
+    }
+
+    auto it = std::find_if(
+        _entityHashHistory.begin(), _entityHashHistory.end(), [tick](const auto& snapshot) { return snapshot.Tick == tick; });
+
+    NetworkPacket reply(NetworkCommand::EntityHashes);
+    reply << tick;
+    if (it == _entityHashHistory.end())
+    {
+        LOG_VERBOSE("No entity hashes stored for tick %u", tick);
+        reply << static_cast<uint8_t>(0);
+        connection.QueuePacket(std::move(reply));
+        return;
+    }
+
+    auto buckets = EntityHashTree::FindDifferingBuckets(it->Hashes, clientHashes);
+    if (buckets.size() > MAX_ENTITY_HASH_BUCKETS)
+    {
+        buckets.resize(MAX_ENTITY_HASH_BUCKETS);
+    }
+
+    reply << static_cast<uint8_t>(1) << static_cast<uint16_t>(buckets.size());
+    for (auto bucketIndex : buckets)
+    {
+        reply << static_cast<uint16_t>(bucketIndex);
+        for (auto leaf : *it->Buckets[bucketIndex])
+        {
+            reply << leaf;
+        }
+    }
+    connection.QueuePacket(std::move(reply));
+}
+
+void NetworkBase::ServerHandleRequestResync(NetworkConnection& connection, NetworkPacket& packet)
+{
+    if (connection.PendingResync.has_value())
+    {
+        LOG_VERBOSE("Client %s requested a resync before the last one was sent", connection.Socket->GetHostName());
+        return;
+    }
+
+    uint32_t tick;
+    uint32_t numRegions;
+    packet >> tick >> numRegions;
+    if (numRegions > NetworkResyncGetNumRegions() || numRegions > packet.BytesRemaining() / sizeof(uint32_t))
+    {
+        LOG_INFO("Client %s requested a resync of %u regions", connection.Socket->GetHostName(), numRegions);
+        connection.Disconnect();
+        return;
+    }
+
+    NetworkResyncRequest request;
+    for (uint32_t i = 0; i < numRegions; i++)
+    {
+        uint32_t region;
+        packet >> region;
+        if (request.Regions.size() < RESYNC_MAX_REGIONS)
+        {
+            request.Regions.push_back(region);
+        }
+    }
+
+    uint32_t numBuckets;
+    packet >> numBuckets;
+    if (numBuckets > EntityHashTree::NumBuckets || numBuckets > packet.BytesRemaining() / sizeof(uint32_t))
+    {
+        LOG_INFO("Client %s requested a resync of %u entity buckets", connection.Socket->GetHostName(), numBuckets);
+        connection.Disconnect();
+        return;
+    }
+    for (uint32_t i = 0; i < numBuckets; i++)
+    {
+        uint32_t bucket;
+        packet >> bucket;
+        if (request.EntityBuckets.size() < RESYNC_MAX_ENTITY_BUCKETS)
+        {
+            request.EntityBuckets.push_back(bucket);
+        }
+    }
+
+    LOG_VERBOSE(
+        "Client %s requested a resync at tick %u with %u regions and %u entity buckets", connection.Socket->GetHostName(),
+        tick, numRegions, numBuckets);
+    connection.PendingResync = std::move(request);
+}
+
 void NetworkBase::ServerHandleHeartbeat(NetworkConnection& connection, NetworkPacket& packet)
 {
     LOG_VERBOSE("Client %s heartbeat", connection.Socket->GetHostName());
@@ -2530,6 +3344,147 @@ void NetworkBase::Client_Handle_GAMESTATE(NetworkConnection& connection, Network
     }
 }
 
+void NetworkBase::Client_Handle_ENTITYHASHES([[maybe_unused]] NetworkConnection& connection, NetworkPacket& packet)
+{
+    uint32_t tick;
+    uint8_t found;
+    packet >> tick >> found;
+
+    if (!_desyncEntityHashes.has_value() || _desyncEntityHashes->Tick != tick)
+    {
+        return;
+    }
+    const auto clientHashes = std::move(*_desyncEntityHashes);
+    _desyncEntityHashes.reset();
+
+    std::string report;
+    if (found != 0)
+    {
+        uint16_t numBuckets;
+        packet >> numBuckets;
+        for (uint16_t i = 0; i < numBuckets; i++)
+        {
+            uint16_t bucketIndex;
+            packet >> bucketIndex;
+            EntityHashTree::Bucket serverLeaves{};
+            for (auto& leaf : serverLeaves)
+            {
+                packet >> leaf;
+            }
+            if (bucketIndex >= EntityHashTree::NumBuckets)
+            {
+                continue;
+            }
+
+            const auto& clientLeaves = *clientHashes.Buckets[bucketIndex];
+            for (size_t j = 0; j < EntityHashTree::LeavesPerBucket; j++)
+            {
+                if (clientLeaves[j] == serverLeaves[j])
+                {
+                    continue;
+                }
+
+                const auto entityIndex = bucketIndex * EntityHashTree::LeavesPerBucket + j;
+                const auto* entity = TryGetEntity(EntityId::FromUnderlying(static_cast<EntityId::UnderlyingType>(entityIndex)));
+                char line[128];
+                snprintf(
+                    line, sizeof(line), "Entity %u (type %d): client = %016llX, server = %016llX",
+                    static_cast<uint32_t>(entityIndex), entity != nullptr ? static_cast<int32_t>(entity->Type) : -1,
+                    static_cast<unsigned long long>(clientLeaves[j]), static_cast<unsigned long long>(serverLeaves[j]));
+                LOG_INFO("Desync at tick %u: %s", tick, line);
+                report += line;
+                report += '\n';
+            }
+        }
+    }
+
+    if (report.empty())
+    {
+        // The server no longer has the hashes or the desync is not in the entities, compare the full game state instead.
+        Client_Send_RequestGameState(tick);
+        return;
+    }
+
+    std::string outputPath = GetContext().GetPlatformEnvironment()->GetDirectoryPath(DIRBASE::USER, DIRID::LOG_DESYNCS);
+    Path::CreateDirectory(outputPath);
+
+    char uniqueFileName[128] = {};
+    snprintf(
+        uniqueFileName, sizeof(uniqueFileName), "desync_%llu_%u.txt",
+        static_cast<long long unsigned>(Platform::GetDatetimeNowUTC()), tick);
+
+    std::string outputFile = Path::Combine(outputPath, uniqueFileName);
+    try
+    {
+        File::WriteAllBytes(outputFile, report.data(), report.size());
+    }
+    catch (const std::exception& e)
+    {
+        LOG_ERROR("Unable to write desync report: %s", e.what());
+        return;
+    }
+    LOG_INFO("Wrote desync report to '%s'", outputFile.c_str());
+
+    // Nothing to tell the player about once the state has been fixed.
+    if (_resync.active || _serverState.state != NetworkServerStatus::Desynced)
+    {
+        return;
+    }
+
+    auto ft = Formatter();
+    ft.Add<char*>(uniqueFileName);
+
+    char str_desync[1024];
+    FormatStringLegacy(str_desync, sizeof(str_desync), STR_DESYNC_REPORT, ft.Data());
+
+    auto intent = Intent(WindowClass::NetworkStatus);
+    intent.PutExtra(INTENT_EXTRA_MESSAGE, std::string{ str_desync });
+    ContextOpenIntent(&intent);
+}
+
+void NetworkBase::Client_Handle_RESYNC([[maybe_unused]] NetworkConnection& connection, NetworkPacket& packet)
+{
+    NetworkResyncHashes hashes;
+    hashes.Read(packet);
+
+    uint32_t numData;
+    packet >> numData;
+
+    if (!_resync.active)
+    {
+        return;
+    }
+    _resync.hashes = std::move(hashes);
+    _resync.data = {};
+    _resync.pendingData = numData;
+}
+
+void NetworkBase::Client_Handle_RESYNCDATA([[maybe_unused]] NetworkConnection& connection, NetworkPacket& packet)
+{
+    uint32_t tick;
+    uint8_t isEntities;
+    uint32_t index;
+    packet >> tick >> isEntities >> index;
+
+    if (!_resync.active || !_resync.hashes.has_value() || _resync.hashes->Tick != tick || _resync.pendingData == 0)
+    {
+        return;
+    }
+
+    if (isEntities != 0)
+    {
+        if (index < EntityHashTree::NumBuckets)
+        {
+            _resync.data.EntityBuckets[index] = NetworkResyncReadEntityBucket(packet);
+        }
+    }
+    else
+    {
+        _resync.data.Regions[index] = NetworkResyncReadRegion(packet, index);
+    }
+    _resync.pendingData--;
+}
+
 void NetworkBase::ServerHandleMapRequest(NetworkConnection& connection, NetworkPacket& packet)
 {
     uint32_t size;
@@ -2567,84 +3522,112 @@ void NetworkBase::ServerHandleMapRequest(NetworkConnection& connection, NetworkP
         }
     }
 
-    auto player_name = connection.Player->Name.c_str();
-    ServerSendMap(&connection);
-    ServerSendEventPlayerJoined(player_name);
+    uint64_t resumeHash{};
+    uint32_t resumeOffset{};
+    packet >> resumeHash >> resumeOffset;
+
+    ServerSendMap(&connection, resumeHash, resumeOffset);
+    // Spectators of a relay have no player to announce.
+    if (connection.Player != nullptr)
+    {
+        ServerSendEventPlayerJoined(connection.Player->Name.c_str());
+    }
     ServerSendGroupList(connection);
 }
 
-void NetworkBase::ServerHandleAuth(NetworkConnection& connection, NetworkPacket& packet)
+void NetworkBase::ServerHandleMapAck(NetworkConnection& connection, NetworkPacket& packet)
 {
-    if (connection.AuthStatus != NetworkAuth::Ok)
+    uint64_t hash;
+    uint32_t received;
+    packet >> hash >> received;
+
+    auto& transfer = connection.MapTransfer;
+    if (transfer.Data == nullptr || transfer.Data->Hash != hash)
     {
-        auto* hostName = connection.Socket->GetHostName();
-        auto gameversion = packet.ReadString();
-        auto name = packet.ReadString();
-        auto password = packet.ReadString();
-        auto pubkey = packet.ReadString();
-        uint32_t sigsize;
-        packet >> sigsize;
-        if (pubkey.empty())
-        {
-            connection.AuthStatus = NetworkAuth::VerificationFailure;
-        }
-        else
+        return;
+    }
+    transfer.BytesAcknowledged = std::clamp(received, transfer.BytesAcknowledged, transfer.BytesSent);
+    ServerSendMapChunks(connection);
+}
+
+void NetworkBase::ServerVerifySignature(NetworkConnection& connection, std::string_view pubkey, NetworkPacket& packet)
+{
+    auto* hostName = connection.Socket->GetHostName();
+    uint32_t sigsize;
+    packet >> sigsize;
+    if (pubkey.empty())
+    {
+        connection.AuthStatus = NetworkAuth::VerificationFailure;
+    }
+    else
+    {
+        try
         {
-            try
-            {
-                // RSA technically supports keys up to 65536 bits, so this is the
-                // maximum signature size for now.
-                constexpr auto MaxRSASignatureSizeInBytes = 8192;
+            // RSA technically supports keys up to 65536 bits, so this is the
+            // maximum signature size for now.
+            constexpr auto MaxRSASignatureSizeInBytes = 8192;
 
-                if (sigsize == 0 || sigsize > MaxRSASignatureSizeInBytes)
-                {
-                    throw std::runtime_error("Invalid signature size");
-                }
+            if (sigsize == 0 || sigsize > MaxRSASignatureSizeInBytes)
+            {
+                throw std::runtime_error("Invalid signature size");
+            }
 
-                std::vector<uint8_t> signature;
-                signature.resize(sigsize);
+            std::vector<uint8_t> signature;
+            signature.resize(sigsize);
 
-                const uint8_t* signatureData = packet.Read(sigsize);
-                if (signatureData == nullptr)
-                {
-                    throw std::runtime_error("Failed to read packet.");
-                }
+            const uint8_t* signatureData = packet.Read(sigsize);
+            if (signatureData == nullptr)
+            {
+                throw std::runtime_error("Failed to read packet.");
+            }
 
-                std::memcpy(signature.data(), signatureData, sigsize);
+            std::memcpy(signature.data(), signatureData, sigsize);
 
-                auto ms = MemoryStream(pubkey.data(), pubkey.size());
-                if (!connection.Key.LoadPublic(&ms))
-                {
-                    throw std::runtime_error("Failed to load public key.");
-                }
+            auto ms = MemoryStream(pubkey.data(), pubkey.size());
+            if (!connection.Key.LoadPublic(&ms))
+            {
+                throw std::runtime_error("Failed to load public key.");
+            }
 
-                bool verified = connection.Key.Verify(connection.Challenge.data(), connection.Challenge.size(), signature);
-                const std::string hash = connection.Key.PublicKeyHash();
-                if (verified)
+            bool verified = connection.Key.Verify(connection.Challenge.data(), connection.Challenge.size(), signature);
+            const std::string hash = connection.Key.PublicKeyHash();
+            if (verified)
+            {
+                LOG_VERBOSE("Connection %s: Signature verification ok. Hash %s", hostName, hash.c_str());
+                if (gConfigNetwork.KnownKeysOnly && _userManager.GetUserByHash(hash) == nullptr)
                 {
-                    LOG_VERBOSE("Connection %s: Signature verification ok. Hash %s", hostName, hash.c_str());
-                    if (gConfigNetwork.KnownKeysOnly && _userManager.GetUserByHash(hash) == nullptr)
-                    {
-                        LOG_VERBOSE("Connection %s: Hash %s, not known", hostName, hash.c_str());
-                        connection.AuthStatus = NetworkAuth::UnknownKeyDisallowed;
-                    }
-                    else
-                    {
-                        connection.AuthStatus = NetworkAuth::Verified;
-                    }
+                    LOG_VERBOSE("Connection %s: Hash %s, not known", hostName, hash.c_str());
+                    connection.AuthStatus = NetworkAuth::UnknownKeyDisallowed;
                 }
                 else
                 {
-                    connection.AuthStatus = NetworkAuth::VerificationFailure;
-                    LOG_VERBOSE("Connection %s: Signature verification failed!", hostName);
+                    connection.AuthStatus = NetworkAuth::Verified;
                 }
             }
-            catch (const std::exception&)
+            else
             {
                 connection.AuthStatus = NetworkAuth::VerificationFailure;
-                LOG_VERBOSE("Connection %s: Signature verification failed, invalid data!", hostName);
+                LOG_VERBOSE("Connection %s: Signature verification failed!", hostName);
             }
         }
+        catch (const std::exception&)
+        {
+            connection.AuthStatus = NetworkAuth::VerificationFailure;
+            LOG_VERBOSE("Connection %s: Signature verification failed, invalid data!", hostName);
+        }
+    }
+}
+
+void NetworkBase::ServerHandleAuth(NetworkConnection& connection, NetworkPacket& packet)
+{
+    if (connection.AuthStatus != NetworkAuth::Ok)
+    {
+        auto* hostName = connection.Socket->GetHostName();
+        auto gameversion = packet.ReadString();
+        auto name = packet.ReadString();
+        auto password = packet.ReadString();
+        auto pubkey = packet.ReadString();
+        ServerVerifySignature(connection, pubkey, packet);
 
         bool passwordless = false;
         if (connection.AuthStatus == NetworkAuth::Verified)
@@ -2703,24 +3686,156 @@ void NetworkBase::ServerHandleAuth(NetworkConnection& connection, NetworkPacket&
     }
 }
 
+void NetworkBase::RelayHandleAuth(NetworkConnection& connection, NetworkPacket& packet)
+{
+    if (connection.AuthStatus == NetworkAuth::Ok)
+        return;
+
+    auto* hostName = connection.Socket->GetHostName();
+    auto gameversion = packet.ReadString();
+    auto name = packet.ReadString();
+    auto password = packet.ReadString();
+    auto pubkey = packet.ReadString();
+    ServerVerifySignature(connection, pubkey, packet);
+
+    if (gameversion != NetworkGetVersion())
+    {
+        connection.AuthStatus = NetworkAuth::BadVersion;
+        LOG_INFO("Connection %s: Bad version.", hostName);
+    }
+    else if (name.empty())
+    {
+        connection.AuthStatus = NetworkAuth::BadName;
+        LOG_INFO("Connection %s: Bad name.", hostName);
+    }
+    else if (password.empty() && !_password.empty())
+    {
+        connection.AuthStatus = NetworkAuth::RequirePassword;
+        LOG_INFO("Connection %s: Requires password.", hostName);
+    }
+    else if (!password.empty() && _password != password)
+    {
+        connection.AuthStatus = NetworkAuth::BadPassword;
+        LOG_INFO("Connection %s: Bad password.", hostName);
+    }
+    else if (GetNumRelayClients() >= static_cast<size_t>(gConfigNetwork.Maxplayers))
+    {
+        connection.AuthStatus = NetworkAuth::Full;
+        LOG_INFO("Connection %s: Relay is full.", hostName);
+    }
+    else if (connection.AuthStatus == NetworkAuth::Verified)
+    {
+        // Spectators do not get a player of their own, the upstream server only knows the relay.
+        connection.AuthStatus = NetworkAuth::Ok;
+        LOG_INFO("Connection %s: Spectator %s joined.", hostName, std::string(name).c_str());
+
+        auto& objManager = GetContext().GetObjectManager();
+        ServerSendObjectsList(connection, objManager.GetPackableObjects());
+        ServerSendScripts(connection);
+    }
+
+    ServerSendAuth(connection);
+}
+
+void NetworkBase::RelayHandleChat([[maybe_unused]] NetworkConnection& connection, NetworkPacket& packet)
+{
+    auto text = packet.ReadString();
+    if (text.empty())
+        return;
+
+    // Spectators chat as the player of the relay, the upstream server sends the message back to everyone.
+    const auto* player = GetPlayerByID(player_id);
+    const auto* group = player != nullptr ? GetGroupByID(player->Group) : nullptr;
+    if (group == nullptr || !group->CanPerformAction(NetworkPermission::Chat))
+    {
+        return;
+    }
+
+    NetworkPacket forwardPacket(NetworkCommand::Chat);
+    forwardPacket.WriteString(text);
+    _serverConnection->QueuePacket(std::move(forwardPacket));
+}
+
+void NetworkBase::RelayHandleGameAction(NetworkConnection& connection, NetworkPacket& packet)
+{
+    uint32_t tick;
+    GameCommand actionType;
+    packet >> tick >> actionType;
+
+    // Read to be checked like the server checks its clients, it is still forwarded as it was received.
+    const size_t size = packet.Header.Size - packet.BytesRead;
+    const auto* data = packet.Read(size);
+
+    GameAction::Ptr ga = GameActions::Create(actionType);
+    if (ga == nullptr)
+    {
+        LOG_ERROR("Received unregistered game action type: 0x%08X from a spectator", actionType);
+        return;
+    }
+
+    DataSerialiser stream(false);
+    stream.GetStream().WriteArray(data, size);
+    stream.GetStream().SetPosition(0);
+    ga->Serialise(stream);
+
+    std::vector<const GameAction*> actions;
+    if (actionType == GameCommand::Batch)
+    {
+        for (const auto& action : static_cast<const BatchAction&>(*ga).GetActions())
+        {
+            actions.push_back(action.get());
+        }
+    }
+    else
+    {
+        actions.push_back(ga.get());
+    }
+
+    for (const auto* action : actions)
+    {
+        if (!ServerCanPerformGameAction(connection, action->GetType()))
+        {
+            return;
+        }
+    }
+    ChargeCooldown(connection.CooldownTime, actions);
+
+    // The upstream server executes it and sends it back to the relay.
+    NetworkPacket forwardPacket(NetworkCommand::GameAction);
+    forwardPacket << GetGameState().CurrentTicks << actionType;
+    forwardPacket.Write(data, size);
+    _serverConnection->QueuePacket(std::move(forwardPacket));
+}
+
 void NetworkBase::Client_Handle_MAP([[maybe_unused]] NetworkConnection& connection, NetworkPacket& packet)
 {
     uint32_t size, offset;
-    packet >> size >> offset;
+    uint64_t hash;
+    packet >> size >> offset >> hash;
     int32_t chunksize = static_cast<int32_t>(packet.Header.Size - packet.BytesRead);
-    if (chunksize <= 0)
+    if (chunksize <= 0 || offset + chunksize > size)
     {
         return;
     }
-    if (offset == 0)
+    if (offset != 0 && (hash != _mapDownload.hash || offset != _mapDownload.received))
+    {
+        LOG_WARNING("Received map data that does not continue the current download.");
+        return;
+    }
+    if (offset == 0 || !_mapDownload.inProgress)
     {
-        // Start of a new map load, clear the queue now as we have to buffer them
+        // Start of a new (or resumed) map load, clear the queue now as we have to buffer them
         // until the map is fully loaded.
         GameActions::ClearQueue();
         GameActions::SuspendQueue();
 
         _serverTickData.clear();
+        _desyncEntityHashes.reset();
         _clientMapLoaded = false;
+
+        _mapDownload.hash = hash;
+        _mapDownload.size = size;
+        _mapDownload.inProgress = true;
     }
     if (size > chunk_buffer.size())
     {
@@ -2739,8 +3854,12 @@ void NetworkBase::Client_Handle_MAP([[maybe_unused]] NetworkConnection& connecti
     ContextOpenIntent(&intent);
 
     std::memcpy(&chunk_buffer[offset], const_cast<void*>(static_cast<const void*>(packet.Read(chunksize))), chunksize);
+    _mapDownload.received = offset + chunksize;
+    Client_Send_MAPACK(hash, _mapDownload.received);
     if (offset + chunksize == size)
     {
+        _mapDownload = {};
+
         // Allow queue processing of game actions again.
         GameActions::ResumeQueue();
 
@@ -2760,7 +3879,10 @@ void NetworkBase::Client_Handle_MAP([[maybe_unused]] NetworkConnection& connecti
             _serverState.tick = GetGameState().CurrentTicks;
             // WindowNetworkStatusOpen("Loaded new map from network");
             _serverState.state = NetworkServerStatus::Ok;
+            _resync = {};
+            _lastResyncTick.reset();
             _clientMapLoaded = true;
+            GetEntityHashTree().Reset();
             gFirstTimeSaving = true;
 
             // Notify user he is now online and which shortcut key enables chat
@@ -2773,6 +3895,12 @@ void NetworkBase::Client_Handle_MAP([[maybe_unused]] NetworkConnection& connecti
             // Given that during map load game actions are buffered we have to process the
             // player list first to have valid players for the queued game actions.
             ProcessPlayerList();
+
+            if (IsRelay())
+            {
+                // Spectators follow the relay onto the new park.
+                ServerSendMap();
+            }
         }
         else
         {
@@ -2837,6 +3965,8 @@ bool NetworkBase::SaveMap(IStream* stream, const std::vector<const ObjectReposit
 
 void NetworkBase::Client_Handle_CHAT([[maybe_unused]] NetworkConnection& connection, NetworkPacket& packet)
 {
+    RelaySendPacket(packet);
+
     auto text = packet.ReadString();
     if (!text.empty())
     {
@@ -2946,64 +4076,80 @@ void NetworkBase::Client_Handle_GAME_ACTION([[maybe_unused]] NetworkConnection&
     GameActions::Enqueue(std::move(action), tick);
 }
 
-void NetworkBase::ServerHandleGameAction(NetworkConnection& connection, NetworkPacket& packet)
+bool NetworkBase::ServerCanPerformGameAction(NetworkConnection& connection, GameCommand actionType)
 {
-    uint32_t tick;
-    GameCommand actionType;
+    // Don't let clients send pause or quit
+    if (actionType == GameCommand::TogglePause || actionType == GameCommand::LoadOrQuit)
+    {
+        return false;
+    }
 
+    // Spectators of a relay act as the player of the relay, so they are limited to what its group may do.
     NetworkPlayer* player = connection.Player;
-    if (player == nullptr)
+    if (player == nullptr && IsRelay())
     {
-        return;
+        player = GetPlayerByID(player_id);
     }
-
-    packet >> tick >> actionType;
-
-    // Don't let clients send pause or quit
-    if (actionType == GameCommand::TogglePause || actionType == GameCommand::LoadOrQuit)
+    if (player == nullptr)
     {
-        return;
+        return false;
     }
 
     if (actionType != GameCommand::Custom)
     {
         // Check if player's group permission allows command to run
-        NetworkGroup* group = GetGroupByID(connection.Player->Group);
+        NetworkGroup* group = GetGroupByID(player->Group);
         if (group == nullptr || group->CanPerformCommand(actionType) == false)
         {
             ServerSendShowError(connection, STR_CANT_DO_THIS, STR_PERMISSION_DENIED);
-            return;
+            return false;
         }
     }
 
-    // Create and enqueue the action.
-    GameAction::Ptr ga = GameActions::Create(actionType);
-    if (ga == nullptr)
-    {
-        LOG_ERROR(
-            "Received unregistered game action type: 0x%08X from player: (%d) %s", actionType, connection.Player->Id,
-            connection.Player->Name.c_str());
-        return;
-    }
-
     // Player who is hosting is not affected by cooldowns.
     if ((player->Flags & NETWORK_PLAYER_FLAG_ISSERVER) == 0)
     {
-        auto cooldownIt = player->CooldownTime.find(actionType);
-        if (cooldownIt != std::end(player->CooldownTime))
+        const auto& cooldownTime = connection.Player != nullptr ? player->CooldownTime : connection.CooldownTime;
+        auto cooldownIt = cooldownTime.find(actionType);
+        if (cooldownIt != std::end(cooldownTime))
         {
             if (cooldownIt->second > 0)
             {
                 ServerSendShowError(connection, STR_CANT_DO_THIS, STR_NETWORK_ACTION_RATE_LIMIT_MESSAGE);
-                return;
+                return false;
             }
         }
+    }
+    return true;
+}
 
-        uint32_t cooldownTime = ga->GetCooldownTime();
-        if (cooldownTime > 0)
-        {
-            player->CooldownTime[actionType] = cooldownTime;
-        }
+void NetworkBase::ServerHandleGameAction(NetworkConnection& connection, NetworkPacket& packet)
+{
+    uint32_t tick;
+    GameCommand actionType;
+
+    NetworkPlayer* player = connection.Player;
+    if (player == nullptr)
+    {
+        return;
+    }
+
+    packet >> tick >> actionType;
+
+    // A batch is checked by the actions it carries once they are read.
+    if (actionType != GameCommand::Batch && !ServerCanPerformGameAction(connection, actionType))
+    {
+        return;
+    }
+
+    // Create and enqueue the action.
+    GameAction::Ptr ga = GameActions::Create(actionType);
+    if (ga == nullptr)
+    {
+        LOG_ERROR(
+            "Received unregistered game action type: 0x%08X from player: (%d) %s", actionType, connection.Player->Id,
+            connection.Player->Name.c_str());
+        return;
     }
 
     DataSerialiser stream(false);
@@ -3015,6 +4161,29 @@ void NetworkBase::ServerHandleGameAction(NetworkConnection& connection, NetworkP
     // Set player to sender, should be 0 if sent from client.
     ga->SetPlayer(NetworkPlayerId_t{ connection.Player->Id });
 
+    std::vector<const GameAction*> actions;
+    if (actionType == GameCommand::Batch)
+    {
+        for (const auto& action : static_cast<const BatchAction&>(*ga).GetActions())
+        {
+            if (!ServerCanPerformGameAction(connection, action->GetType()))
+            {
+                return;
+            }
+            actions.push_back(action.get());
+        }
+    }
+    else
+    {
+        actions.push_back(ga.get());
+    }
+
+    // Cooldowns start after all actions of a batch were checked.
+    if ((player->Flags & NETWORK_PLAYER_FLAG_ISSERVER) == 0)
+    {
+        ChargeCooldown(player->CooldownTime, actions);
+    }
+
     GameActions::Enqueue(std::move(ga), tick);
 }
 
@@ -3032,11 +4201,8 @@ void NetworkBase::Client_Handle_TICK([[maybe_unused]] NetworkConnection& connect
 
     if (flags & NETWORK_TICK_FLAG_CHECKSUMS)
     {
-        auto text = packet.ReadString();
-        if (!text.empty())
-        {
-            tickData.spriteHash = text;
-        }
+        packet >> tickData.entitiesHash;
+        tickData.hasEntitiesHash = true;
     }
 
     // Don't let the history grow too much.
@@ -3090,6 +4256,7 @@ void NetworkBase::ServerHandlePing(NetworkConnection& connection, [[maybe_unused
     {
         ping = 0;
     }
+    connection.Telemetry.Rtt.Add(ping);
     if (connection.Player != nullptr)
     {
         connection.Player->Ping = ping;
@@ -3099,6 +4266,8 @@ void NetworkBase::ServerHandlePing(NetworkConnection& connection, [[maybe_unused
 
 void NetworkBase::Client_Handle_PINGLIST([[maybe_unused]] NetworkConnection& connection, NetworkPacket& packet)
 {
+    RelaySendPacket(packet);
+
     uint8_t size;
     packet >> size;
     for (uint32_t i = 0; i < size; i++)
@@ -3148,10 +4317,23 @@ void NetworkBase::Client_Handle_GROUPLIST([[maybe_unused]] NetworkConnection& co
         auto newgroup = std::make_unique<NetworkGroup>(group);
         group_list.push_back(std::move(newgroup));
     }
+
+    if (IsRelay())
+    {
+        for (auto& clientConnection : client_connection_list)
+        {
+            if (clientConnection->AuthStatus == NetworkAuth::Ok)
+            {
+                ServerSendGroupList(*clientConnection);
+            }
+        }
+    }
 }
 
 void NetworkBase::Client_Handle_EVENT([[maybe_unused]] NetworkConnection& connection, NetworkPacket& packet)
 {
+    RelaySendPacket(packet);
+
     uint16_t eventType;
     packet >> eventType;
     switch (eventType)
@@ -3280,6 +4462,15 @@ void NetworkSendTick()
     OpenRCT2::GetContext()->GetNetwork().ServerSendTick();
 }
 
+void NetworkRelayTick()
+{
+    auto& network = OpenRCT2::GetContext()->GetNetwork();
+    if (network.IsRelay())
+    {
+        network.ServerSendTick();
+    }
+}
+
 NetworkAuth NetworkGetAuthstatus()
 {
     return OpenRCT2::GetContext()->GetNetwork().GetAuthStatus();
@@ -3906,6 +5097,15 @@ void NetworkSendGameAction(const GameAction* action)
     }
 }
 
+void NetworkRelayGameAction(const GameAction* action)
+{
+    auto& network = OpenRCT2::GetContext()->GetNetwork();
+    if (network.IsRelay())
+    {
+        network.ServerSendGameAction(action);
+    }
+}
+
 void NetworkSendPassword(const std::string& password)
 {
     auto& network = OpenRCT2::GetContext()->GetNetwork();
@@ -4028,6 +5228,12 @@ json_t NetworkGetServerInfoAsJson()
     auto& network = OpenRCT2::GetContext()->GetNetwork();
     return network.GetServerInfoAsJson();
 }
+
+json_t NetworkGetTelemetryAsJson()
+{
+    auto& network = OpenRCT2::GetContext()->GetNetwork();
+    return network.GetTelemetryAsJson();
+}
 #else
 int32_t NetworkGetMode()
 {
@@ -4051,6 +5257,9 @@ void NetworkFlush()
 void NetworkSendTick()
 {
 }
+void NetworkRelayTick()
+{
+}
 bool NetworkIsDesynchronised()
 {
     return false;
@@ -4069,6 +5278,9 @@ void NetworkRequestGamestateSnapshot()
 void NetworkSendGameAction(const GameAction* action)
 {
 }
+void NetworkRelayGameAction(const GameAction* action)
+{
+}
 void NetworkUpdate()
 {
 }
@@ -4295,4 +5507,8 @@ json_t NetworkGetServerInfoAsJson()
 {
     return {};
 }
+json_t NetworkGetTelemetryAsJson()
+{
+    return {};
+}
 #endif /* DISABLE_NETWORK */
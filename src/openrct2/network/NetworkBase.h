@@ -2,16 +2,22 @@
 
 #include "../System.hpp"
 #include "../actions/GameAction.h"
+#include "../entity/EntityHashTree.h"
 #include "../object/Object.h"
 #include "NetworkConnection.h"
 #include "NetworkGroup.h"
+#include "NetworkIoThread.h"
 #include "NetworkPlayer.h"
+#include "NetworkResync.h"
 #include "NetworkServerAdvertiser.h"
 #include "NetworkTypes.h"
 #include "NetworkUser.h"
 
+#include <deque>
 #include <fstream>
 #include <memory>
+#include <optional>
+#include <vector>
 
 #ifndef DISABLE_NETWORK
 
@@ -28,6 +34,7 @@ public:
 public: // Uncategorized
     bool BeginServer(uint16_t port, const std::string& address);
     bool BeginClient(const std::string& host, uint16_t port);
+    bool BeginRelay(const std::string& host, uint16_t port, uint16_t listenPort, const std::string& listenAddress);
 
 public: // Common
     bool Init();
@@ -52,6 +59,7 @@ public: // Common
     void AppendChatLog(std::string_view s);
     void CloseChatLog();
     NetworkStats GetStats() const;
+    json_t GetTelemetryAsJson() const;
     json_t GetServerInfoAsJson() const;
     bool ProcessConnection(NetworkConnection& connection);
     void CloseConnection();
@@ -70,8 +78,11 @@ public: // Server
     void BeginServerLog();
     void AppendServerLog(const std::string& s);
     void CloseServerLog();
-    void DecayCooldown(NetworkPlayer* player);
+    void DecayCooldown(std::unordered_map<GameCommand, int32_t>& cooldownTime);
+    static void ChargeCooldown(
+        std::unordered_map<GameCommand, int32_t>& cooldownTime, const std::vector<const GameAction*>& actions);
     void AddClient(std::unique_ptr<ITcpSocket>&& socket);
+    void AcceptClients();
     std::string GetMasterServerUrl();
     std::string GenerateAdvertiseKey();
     void SetupDefaultGroups();
@@ -80,12 +91,17 @@ public: // Server
     void ServerClientDisconnected(std::unique_ptr<NetworkConnection>& connection);
     bool SaveMap(OpenRCT2::IStream* stream, const std::vector<const ObjectRepositoryItem*>& objects) const;
     std::vector<uint8_t> SaveForNetwork(const std::vector<const ObjectRepositoryItem*>& objects) const;
+    std::shared_ptr<const NetworkMapData> GetMapData(const std::vector<const ObjectRepositoryItem*>& objects);
+    void StartMapTransfer(NetworkConnection& connection, std::shared_ptr<const NetworkMapData> mapData, uint32_t offset);
+    bool IsMapTransferInProgress(const NetworkMapData& mapData) const;
+    void UpdateMapTransferSnapshots();
     std::string MakePlayerNameUnique(const std::string& name);
 
     // Packet dispatchers.
     void ServerSendAuth(NetworkConnection& connection);
     void ServerSendToken(NetworkConnection& connection);
-    void ServerSendMap(NetworkConnection* connection = nullptr);
+    void ServerSendMap(NetworkConnection* connection = nullptr, uint64_t resumeHash = 0, uint32_t resumeOffset = 0);
+    void ServerSendMapChunks(NetworkConnection& connection);
     void ServerSendChat(const char* text, const std::vector<uint8_t>& playerIds = {});
     void ServerSendGameAction(const GameAction* action);
     void ServerSendTick();
@@ -101,22 +117,29 @@ public: // Server
     void ServerSendEventPlayerDisconnected(const char* playerName, const char* reason);
     void ServerSendObjectsList(NetworkConnection& connection, const std::vector<const ObjectRepositoryItem*>& objects) const;
     void ServerSendScripts(NetworkConnection& connection);
+    void ServerSendResyncs();
 
     // Handlers
     void ServerHandleRequestGamestate(NetworkConnection& connection, NetworkPacket& packet);
     void ServerHandleHeartbeat(NetworkConnection& connection, NetworkPacket& packet);
     void ServerHandleAuth(NetworkConnection& connection, NetworkPacket& packet);
+    void ServerVerifySignature(NetworkConnection& connection, std::string_view pubkey, NetworkPacket& packet);
     void ServerClientJoined(std::string_view name, const std::string& keyhash, NetworkConnection& connection);
     void ServerHandleChat(NetworkConnection& connection, NetworkPacket& packet);
+    bool ServerCanPerformGameAction(NetworkConnection& connection, GameCommand actionType);
     void ServerHandleGameAction(NetworkConnection& connection, NetworkPacket& packet);
     void ServerHandlePing(NetworkConnection& connection, NetworkPacket& packet);
     void ServerHandleGameInfo(NetworkConnection& connection, NetworkPacket& packet);
     void ServerHandleToken(NetworkConnection& connection, NetworkPacket& packet);
     void ServerHandleMapRequest(NetworkConnection& connection, NetworkPacket& packet);
+    void ServerHandleMapAck(NetworkConnection& connection, NetworkPacket& packet);
+    void ServerHandleRequestEntityHashes(NetworkConnection& connection, NetworkPacket& packet);
+    void ServerHandleRequestResync(NetworkConnection& connection, NetworkPacket& packet);
 
 public: // Client
     void Reconnect();
     int32_t GetMode() const noexcept;
+    bool IsRelay() const noexcept;
     NetworkAuth GetAuthStatus();
     int32_t GetStatus() const noexcept;
     uint8_t GetPlayerID() const noexcept;
@@ -126,6 +149,10 @@ public: // Client
     void SendPacketToClients(const NetworkPacket& packet, bool front = false, bool gameCmd = false) const;
     bool CheckSRAND(uint32_t tick, uint32_t srand0);
     bool CheckDesynchronizaton();
+    void ReportDesynchronisation();
+    bool BeginResync();
+    void UpdateResync(uint32_t currentTicks);
+    void FailResync(const char* reason);
     void RequestStateSnapshot();
     bool IsDesynchronised() const noexcept;
     NetworkServerState GetServerState() const noexcept;
@@ -135,6 +162,8 @@ public: // Client
 
     // Packet dispatchers.
     void Client_Send_RequestGameState(uint32_t tick);
+    void Client_Send_RequestEntityHashes(const EntityHashTree::Snapshot& snapshot);
+    void Client_Send_RequestResync(uint32_t tick, const NetworkResyncRequest& request);
     void Client_Send_TOKEN();
     void Client_Send_AUTH(
         const std::string& name, const std::string& password, const std::string& pubkey, const std::vector<uint8_t>& signature);
@@ -143,6 +172,7 @@ public: // Client
     void Client_Send_PING();
     void Client_Send_GAMEINFO();
     void Client_Send_MAPREQUEST(const std::vector<ObjectEntryDescriptor>& objects);
+    void Client_Send_MAPACK(uint64_t hash, uint32_t received);
     void Client_Send_HEARTBEAT(NetworkConnection& connection) const;
 
     // Handlers.
@@ -165,12 +195,25 @@ public: // Client
     void Client_Handle_SCRIPTS_HEADER(NetworkConnection& connection, NetworkPacket& packet);
     void Client_Handle_SCRIPTS_DATA(NetworkConnection& connection, NetworkPacket& packet);
     void Client_Handle_GAMESTATE(NetworkConnection& connection, NetworkPacket& packet);
+    void Client_Handle_ENTITYHASHES(NetworkConnection& connection, NetworkPacket& packet);
+    void Client_Handle_RESYNC(NetworkConnection& connection, NetworkPacket& packet);
+    void Client_Handle_RESYNCDATA(NetworkConnection& connection, NetworkPacket& packet);
 
     std::vector<uint8_t> _challenge;
     std::map<uint32_t, GameAction::Callback_t> _gameActionCallbacks;
     NetworkKey _key;
     NetworkUserManager _userManager;
 
+public: // Relay
+    void UpdateRelay();
+    size_t GetNumRelayClients() const;
+    void RelaySendPacket(const NetworkPacket& packet) const;
+
+    // Handlers.
+    void RelayHandleAuth(NetworkConnection& connection, NetworkPacket& packet);
+    void RelayHandleChat(NetworkConnection& connection, NetworkPacket& packet);
+    void RelayHandleGameAction(NetworkConnection& connection, NetworkPacket& packet);
+
 public: // Public common
     std::string ServerName;
     std::string ServerDescription;
@@ -199,11 +242,27 @@ private: // Server Data
     std::unique_ptr<ITcpSocket> _listenSocket;
     std::unique_ptr<INetworkServerAdvertiser> _advertiser;
     std::list<std::unique_ptr<NetworkConnection>> client_connection_list;
+    // Declared after the sockets it services so it is stopped before they are destroyed.
+    std::unique_ptr<NetworkIoThread> _ioThread;
     std::string _serverLogPath;
     std::string _serverLogFilenameFormat = "%Y%m%d-%H%M%S.txt";
     std::ofstream _server_log_fs;
     uint16_t listening_port = 0;
+    uint32_t _lastTelemetryLogTime = 0;
     bool _playerListInvalidated = false;
+    // Maps serialised for the current tick, reused when several clients join at once.
+    std::vector<std::shared_ptr<const NetworkMapData>> _mapDataCache;
+    // Maps clients are downloading, kept by hash until their transfer finishes so a reconnecting client can resume.
+    struct MapTransferSnapshot
+    {
+        std::shared_ptr<const NetworkMapData> Data;
+        // Game actions run since the map was serialised, a resuming client has missed them.
+        std::vector<NetworkOutboundPacket> GameActions;
+        uint32_t LastActivity{};
+    };
+    std::map<uint64_t, MapTransferSnapshot> _mapTransferSnapshots;
+    // Entity hashes of the most recent ticks, used to tell desynchronised clients which entities differ.
+    std::deque<EntityHashTree::Snapshot> _entityHashHistory;
 
 private: // Client Data
     struct PlayerListUpdate
@@ -215,7 +274,28 @@ private: // Client Data
     {
         uint32_t srand0;
         uint32_t tick;
-        std::string spriteHash;
+        uint64_t entitiesHash{};
+        bool hasEntitiesHash{};
+    };
+
+    // Kept across reconnects so an interrupted download can be resumed.
+    struct MapDownload
+    {
+        uint64_t hash{};
+        uint32_t size{};
+        uint32_t received{};
+        bool inProgress{};
+    };
+
+    // Rounds of asking the server for the parts of the game state that differ, until nothing does.
+    struct ResyncState
+    {
+        std::optional<NetworkResyncHashes> hashes;
+        NetworkResyncData data;
+        uint32_t pendingData{};
+        uint32_t requestTick{};
+        uint32_t round{};
+        bool active{};
     };
 
     struct ServerScriptsData
@@ -230,6 +310,11 @@ private: // Client Data
     std::map<uint32_t, PlayerListUpdate> _pendingPlayerLists;
     std::multimap<uint32_t, NetworkPlayer> _pendingPlayerInfo;
     std::map<uint32_t, ServerTickData> _serverTickData;
+    // Entity hashes at the tick the client desynchronised.
+    std::optional<EntityHashTree::Snapshot> _desyncEntityHashes;
+    ResyncState _resync;
+    std::optional<uint32_t> _lastResyncTick;
+    MapDownload _mapDownload;
     std::vector<ObjectEntryDescriptor> _missingObjects;
     std::string _host;
     std::string _chatLogPath;
@@ -248,6 +333,12 @@ private: // Client Data
     bool _requireReconnect = false;
     bool _clientMapLoaded = false;
     ServerScriptsData _serverScriptsData{};
+
+private: // Relay Data
+    // Handlers for the spectators of a relay, the connection to the upstream server uses the client handlers.
+    std::unordered_map<NetworkCommand, CommandHandler> relay_command_handlers;
+    std::string _relayAddress;
+    bool _relay = false;
 };
 
 #endif // DISABLE_NETWORK
@@ -15,6 +15,7 @@
 #    include "../localisation/Formatting.h"
 #    include "../localisation/Localisation.h"
 #    include "../platform/Platform.h"
+#    include "NetworkIoThread.h"
 #    include "Socket.h"
 #    include "network.h"
 
@@ -27,25 +28,51 @@ NetworkConnection::NetworkConnection() noexcept
 }
 
 NetworkReadPacket NetworkConnection::ReadPacket()
+{
+    if (IoChannel != nullptr)
+    {
+        RecordIoChannelStats();
+
+        // Check before popping, all packets received before the disconnect are queued by then.
+        const bool disconnected = IoChannel->IsDisconnected();
+        if (IoChannel->TryPopPacket(InboundPacket))
+        {
+            _lastPacketTime = Platform::GetTicks();
+            RecordPacketStats(InboundPacket.GetCommand(), InboundPacket.BytesTransferred, false);
+            return NetworkReadPacket::Success;
+        }
+        return disconnected ? NetworkReadPacket::Disconnected : NetworkReadPacket::NoData;
+    }
+
+    auto status = ReadPacketFromSocket(*Socket, InboundPacket);
+    if (status == NetworkReadPacket::Success)
+    {
+        _lastPacketTime = Platform::GetTicks();
+        RecordPacketStats(InboundPacket.GetCommand(), InboundPacket.BytesTransferred, false);
+    }
+    return status;
+}
+
+NetworkReadPacket NetworkConnection::ReadPacketFromSocket(ITcpSocket& socket, NetworkPacket& packet)
 {
     size_t bytesRead = 0;
 
     // Read packet header.
-    auto& header = InboundPacket.Header;
-    if (InboundPacket.BytesTransferred < sizeof(InboundPacket.Header))
+    auto& header = packet.Header;
+    if (packet.BytesTransferred < sizeof(packet.Header))
     {
-        const size_t missingLength = sizeof(header) - InboundPacket.BytesTransferred;
+        const size_t missingLength = sizeof(header) - packet.BytesTransferred;
 
-        uint8_t* buffer = reinterpret_cast<uint8_t*>(&InboundPacket.Header);
+        uint8_t* buffer = reinterpret_cast<uint8_t*>(&packet.Header);
 
-        NetworkReadPacket status = Socket->ReceiveData(buffer, missingLength, &bytesRead);
+        NetworkReadPacket status = socket.ReceiveData(buffer, missingLength, &bytesRead);
         if (status != NetworkReadPacket::Success)
         {
             return status;
         }
 
-        InboundPacket.BytesTransferred += bytesRead;
-        if (InboundPacket.BytesTransferred < sizeof(InboundPacket.Header))
+        packet.BytesTransferred += bytesRead;
+        if (packet.BytesTransferred < sizeof(packet.Header))
         {
             // If still not enough data for header, keep waiting.
             return NetworkReadPacket::MoreData;
@@ -65,29 +92,25 @@ NetworkReadPacket NetworkConnection::ReadPacket()
     // Read packet body.
     {
         // NOTE: BytesTransfered includes the header length, this will not underflow.
-        const size_t missingLength = header.Size - (InboundPacket.BytesTransferred - sizeof(header));
+        const size_t missingLength = header.Size - (packet.BytesTransferred - sizeof(header));
 
         uint8_t buffer[NetworkBufferSize];
 
         if (missingLength > 0)
         {
-            NetworkReadPacket status = Socket->ReceiveData(buffer, std::min(missingLength, NetworkBufferSize), &bytesRead);
+            NetworkReadPacket status = socket.ReceiveData(buffer, std::min(missingLength, NetworkBufferSize), &bytesRead);
             if (status != NetworkReadPacket::Success)
             {
                 return status;
             }
 
-            InboundPacket.BytesTransferred += bytesRead;
-            InboundPacket.Write(buffer, bytesRead);
+            packet.BytesTransferred += bytesRead;
+            packet.Write(buffer, bytesRead);
         }
 
-        if (InboundPacket.Data.size() == header.Size)
+        if (packet.Data.size() == header.Size)
         {
             // Received complete packet.
-            _lastPacketTime = Platform::GetTicks();
-
-            RecordPacketStats(InboundPacket, false);
-
             return NetworkReadPacket::Success;
         }
     }
@@ -95,42 +118,66 @@ NetworkReadPacket NetworkConnection::ReadPacket()
     return NetworkReadPacket::MoreData;
 }
 
-bool NetworkConnection::SendPacket(NetworkPacket& packet)
+size_t NetworkConnection::WritePacketsToSocket(
+    ITcpSocket& socket, std::deque<NetworkOutboundPacket>& packets, uint32_t& numWrites)
 {
-    auto header = packet.Header;
-
-    std::vector<uint8_t> buffer;
-    buffer.reserve(sizeof(header) + header.Size);
-
-    // NOTE: For compatibility reasons for the master server we need to add sizeof(Header.Id) to the size.
-    // Previously the Id field was not part of the header rather part of the body.
-    header.Size += sizeof(header.Id);
-    header.Size = Convert::HostToNetwork(header.Size);
-    header.Id = ByteSwapBE(header.Id);
+    size_t numSent = 0;
+    while (numSent < packets.size())
+    {
+        // Gather the unsent parts of the next packets so they go out with a single system call.
+        SocketBuffer buffers[MAX_SEND_BUFFERS];
+        size_t numBuffers = 0;
+        size_t totalSize = 0;
+        for (size_t i = numSent; i < packets.size() && numBuffers < MAX_SEND_BUFFERS; i++)
+        {
+            const auto& packet = packets[i];
+            buffers[numBuffers++] = { packet.GetRemainingData(), packet.GetRemainingSize() };
+            totalSize += packet.GetRemainingSize();
+        }
 
-    buffer.insert(buffer.end(), reinterpret_cast<uint8_t*>(&header), reinterpret_cast<uint8_t*>(&header) + sizeof(header));
-    buffer.insert(buffer.end(), packet.Data.begin(), packet.Data.end());
+        const size_t sent = socket.SendData(buffers, numBuffers);
+        numWrites++;
+        for (size_t remaining = sent; remaining > 0;)
+        {
+            auto& packet = packets[numSent];
+            const size_t written = std::min(remaining, packet.GetRemainingSize());
+            packet.BytesTransferred += written;
+            remaining -= written;
+            if (packet.GetRemainingSize() == 0)
+            {
+                numSent++;
+            }
+        }
 
-    size_t bufferSize = buffer.size() - packet.BytesTransferred;
-    size_t sent = Socket->SendData(buffer.data() + packet.BytesTransferred, bufferSize);
-    if (sent > 0)
-    {
-        packet.BytesTransferred += sent;
+        if (sent < totalSize)
+        {
+            // Socket can not take any more for now.
+            break;
+        }
     }
+    return numSent;
+}
 
-    bool sendComplete = packet.BytesTransferred == buffer.size();
-    if (sendComplete)
-    {
-        RecordPacketStats(packet, true);
-    }
-    return sendComplete;
+void NetworkConnection::QueuePacket(const NetworkPacket& packet, bool front)
+{
+    QueuePacket(NetworkOutboundPacket(packet), front);
 }
 
-void NetworkConnection::QueuePacket(NetworkPacket&& packet, bool front)
+void NetworkConnection::QueuePacket(NetworkOutboundPacket packet, bool front)
 {
     if (AuthStatus == NetworkAuth::Ok || !packet.CommandRequiresAuth())
     {
-        packet.Header.Size = static_cast<uint16_t>(packet.Data.size());
+        if (IoChannel != nullptr)
+        {
+            IoChannel->QueuePacket(std::move(packet), front);
+            Telemetry.RecordQueueDepth(IoChannel->GetQueuedCount());
+            if (front)
+            {
+                IoChannel->Flush();
+            }
+            return;
+        }
+
         if (front)
         {
             // If the first packet was already partially sent add new packet to second position
@@ -149,6 +196,11 @@ void NetworkConnection::QueuePacket(NetworkPacket&& packet, bool front)
         {
             _outboundPackets.push_back(std::move(packet));
         }
+        Telemetry.RecordQueueDepth(_outboundPackets.size());
+        if (front)
+        {
+            SendQueuedPackets();
+        }
     }
 }
 
@@ -164,10 +216,30 @@ bool NetworkConnection::IsValid() const
 
 void NetworkConnection::SendQueuedPackets()
 {
-    while (!_outboundPackets.empty() && SendPacket(_outboundPackets.front()))
+    if (IoChannel != nullptr)
+    {
+        IoChannel->Flush();
+        return;
+    }
+    if (_outboundPackets.empty())
     {
+        return;
+    }
+
+    uint32_t numWrites = 0;
+    const size_t numSent = WritePacketsToSocket(*Socket, _outboundPackets, numWrites);
+    for (size_t i = 0; i < numSent; i++)
+    {
+        const auto& packet = _outboundPackets.front();
+        RecordPacketStats(packet.GetCommand(), packet.BytesTransferred, true);
         _outboundPackets.pop_front();
     }
+    Telemetry.RecordWrites(static_cast<uint32_t>(numSent), numWrites);
+}
+
+size_t NetworkConnection::GetQueuedPacketCount() const noexcept
+{
+    return IoChannel != nullptr ? IoChannel->GetQueuedCount() : _outboundPackets.size();
 }
 
 void NetworkConnection::ResetLastPacketTime() noexcept
@@ -203,33 +275,62 @@ void NetworkConnection::SetLastDisconnectReason(const StringId string_id, void*
     SetLastDisconnectReason(buffer);
 }
 
-void NetworkConnection::RecordPacketStats(const NetworkPacket& packet, bool sending)
+NetworkStatisticsGroup NetworkConnection::GetStatisticsGroup(NetworkCommand command) noexcept
 {
-    uint32_t packetSize = static_cast<uint32_t>(packet.BytesTransferred);
-    NetworkStatisticsGroup trafficGroup;
-
-    switch (packet.GetCommand())
+    switch (command)
     {
         case NetworkCommand::GameAction:
-            trafficGroup = NetworkStatisticsGroup::Commands;
-            break;
+            return NetworkStatisticsGroup::Commands;
         case NetworkCommand::Map:
-            trafficGroup = NetworkStatisticsGroup::MapData;
-            break;
+            return NetworkStatisticsGroup::MapData;
         default:
-            trafficGroup = NetworkStatisticsGroup::Base;
-            break;
+            return NetworkStatisticsGroup::Base;
+    }
+}
+
+void NetworkConnection::RecordIoChannelStats()
+{
+    NetworkCommandStatsList sent;
+    uint32_t numWrites = 0;
+    if (!IoChannel->TakeSent(sent, numWrites))
+    {
+        return;
+    }
+
+    uint32_t numSent = 0;
+    for (size_t i = 0; i < sent.size(); i++)
+    {
+        numSent += sent[i].PacketsSent;
+        if (sent[i].PacketsSent == 0)
+        {
+            continue;
+        }
+
+        const auto command = static_cast<NetworkCommand>(i);
+        const auto group = GetStatisticsGroup(command);
+        Stats.bytesSent[EnumValue(group)] += sent[i].BytesSent;
+        Stats.bytesSent[EnumValue(NetworkStatisticsGroup::Total)] += sent[i].BytesSent;
+        Telemetry.RecordSent(command, sent[i].BytesSent, sent[i].PacketsSent);
     }
+    Telemetry.RecordWrites(numSent, numWrites);
+}
+
+void NetworkConnection::RecordPacketStats(NetworkCommand command, size_t size, bool sending)
+{
+    uint32_t packetSize = static_cast<uint32_t>(size);
+    NetworkStatisticsGroup trafficGroup = GetStatisticsGroup(command);
 
     if (sending)
     {
         Stats.bytesSent[EnumValue(trafficGroup)] += packetSize;
         Stats.bytesSent[EnumValue(NetworkStatisticsGroup::Total)] += packetSize;
+        Telemetry.RecordSent(command, packetSize);
     }
     else
     {
         Stats.bytesReceived[EnumValue(trafficGroup)] += packetSize;
         Stats.bytesReceived[EnumValue(NetworkStatisticsGroup::Total)] += packetSize;
+        Telemetry.RecordReceived(command, packetSize);
     }
 }
 
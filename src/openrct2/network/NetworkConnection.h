@@ -13,17 +13,42 @@
 #    include "../common.h"
 #    include "NetworkKey.h"
 #    include "NetworkPacket.h"
+#    include "NetworkResync.h"
+#    include "NetworkTelemetry.h"
 #    include "NetworkTypes.h"
 #    include "Socket.h"
 
 #    include <deque>
 #    include <memory>
+#    include <optional>
 #    include <string_view>
+#    include <unordered_map>
 #    include <vector>
 
+class NetworkIoChannel;
+enum class GameCommand : int32_t;
 class NetworkPlayer;
 struct ObjectRepositoryItem;
 
+/**
+ * A serialised map split into packets ready to be sent, shared between all clients downloading it.
+ */
+struct NetworkMapData
+{
+    uint32_t Tick{};
+    uint64_t Hash{};
+    uint32_t Size{};
+    std::vector<const ObjectRepositoryItem*> Objects;
+    std::vector<NetworkOutboundPacket> Chunks;
+};
+
+struct NetworkMapTransfer
+{
+    std::shared_ptr<const NetworkMapData> Data;
+    uint32_t BytesSent{};
+    uint32_t BytesAcknowledged{};
+};
+
 class NetworkConnection final
 {
 public:
@@ -31,22 +56,29 @@ public:
     NetworkPacket InboundPacket;
     NetworkAuth AuthStatus = NetworkAuth::None;
     NetworkStats Stats = {};
+    NetworkTelemetry Telemetry;
     NetworkPlayer* Player = nullptr;
     uint32_t PingTime = 0;
     NetworkKey Key;
     std::vector<uint8_t> Challenge;
     std::vector<const ObjectRepositoryItem*> RequestedObjects;
+    NetworkMapTransfer MapTransfer;
+    // Sent at the start of the next tick so the data matches the hashes sent with it.
+    std::optional<NetworkResyncRequest> PendingResync;
+    std::optional<uint32_t> LastResyncTick;
+    // Cooldowns of a relay spectator, it has no player of its own to keep them.
+    std::unordered_map<GameCommand, int32_t> CooldownTime;
     bool ShouldDisconnect = false;
+    // Set when the socket is serviced by the network I/O thread instead of being polled from Update.
+    std::shared_ptr<NetworkIoChannel> IoChannel;
 
     NetworkConnection() noexcept;
 
     NetworkReadPacket ReadPacket();
-    void QueuePacket(NetworkPacket&& packet, bool front = false);
-    void QueuePacket(const NetworkPacket& packet, bool front = false)
-    {
-        auto copy = packet;
-        return QueuePacket(std::move(copy), front);
-    }
+    // Packets are held back until SendQueuedPackets at the end of the tick so they share system calls, packets put at the
+    // front are urgent and written straight away.
+    void QueuePacket(const NetworkPacket& packet, bool front = false);
+    void QueuePacket(NetworkOutboundPacket packet, bool front = false);
 
     // This will not immediately disconnect the client. The disconnect
     // will happen post-tick.
@@ -54,6 +86,7 @@ public:
 
     bool IsValid() const;
     void SendQueuedPackets();
+    size_t GetQueuedPacketCount() const noexcept;
     void ResetLastPacketTime() noexcept;
     bool ReceivedPacketRecently() const noexcept;
 
@@ -61,13 +94,20 @@ public:
     void SetLastDisconnectReason(std::string_view src);
     void SetLastDisconnectReason(const StringId string_id, void* args = nullptr);
 
+    static NetworkReadPacket ReadPacketFromSocket(ITcpSocket& socket, NetworkPacket& packet);
+    // Writes as much of the queued packets as the socket accepts, returns how many at the front were sent completely.
+    // Adds the number of system calls made to numWrites.
+    static size_t WritePacketsToSocket(
+        ITcpSocket& socket, std::deque<NetworkOutboundPacket>& packets, uint32_t& numWrites);
+    static NetworkStatisticsGroup GetStatisticsGroup(NetworkCommand command) noexcept;
+
 private:
-    std::deque<NetworkPacket> _outboundPackets;
+    std::deque<NetworkOutboundPacket> _outboundPackets;
     uint32_t _lastPacketTime = 0;
     std::string _lastDisconnectReason;
 
-    void RecordPacketStats(const NetworkPacket& packet, bool sending);
-    bool SendPacket(NetworkPacket& packet);
+    void RecordPacketStats(NetworkCommand command, size_t size, bool sending);
+    void RecordIoChannelStats();
 };
 
 #endif // DISABLE_NETWORK
@@ -0,0 +1,482 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2024 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#ifndef DISABLE_NETWORK
+
+#    include "NetworkIoThread.h"
+
+#    include "../Diagnostic.h"
+#    include "NetworkConnection.h"
+
+#    include <algorithm>
+#    include <chrono>
+
+// Stop reading from a connection when the game thread falls this far behind, resume at half of it.
+static constexpr uint32_t MaxQueuedInboundPackets = 1000;
+static constexpr int32_t PausedPollIntervalMs = 10;
+static constexpr int32_t MaxReadsPerEvent = 64;
+// How long to stop watching the listen socket after accept fails, e.g. when out of file descriptors.
+static constexpr int32_t AcceptRetryIntervalMs = 250;
+
+NetworkIoChannel::NetworkIoChannel(NetworkIoThread& owner, ITcpSocket& socket)
+    : _owner(owner)
+    , _socket(socket)
+{
+}
+
+void NetworkIoChannel::QueuePacket(NetworkOutboundPacket&& packet, bool front)
+{
+    _queuedCount.fetch_add(1, std::memory_order_relaxed);
+    _outbound.Push({ std::move(packet), front });
+    _flushPending = true;
+}
+
+void NetworkIoChannel::Flush()
+{
+    if (!_flushPending)
+    {
+        return;
+    }
+
+    _flushPending = false;
+    if (!_sendScheduled.exchange(true, std::memory_order_acq_rel))
+    {
+        _owner._scheduledChannels.Push(shared_from_this());
+        _owner.Wake();
+    }
+}
+
+bool NetworkIoChannel::TryPopPacket(NetworkPacket& packet)
+{
+    if (!_inbound.TryPop(packet))
+    {
+        return false;
+    }
+    _inboundCount.fetch_sub(1, std::memory_order_relaxed);
+    return true;
+}
+
+bool NetworkIoChannel::IsDisconnected() const noexcept
+{
+    return _disconnected.load(std::memory_order_acquire);
+}
+
+bool NetworkIoChannel::TakeSent(NetworkCommandStatsList& sent, uint32_t& numWrites) noexcept
+{
+    if (!_sentPending.exchange(false, std::memory_order_acquire))
+    {
+        return false;
+    }
+
+    numWrites = _socketWrites.exchange(0, std::memory_order_relaxed);
+    for (size_t i = 0; i < sent.size(); i++)
+    {
+        sent[i].BytesSent = _bytesSent[i].exchange(0, std::memory_order_relaxed);
+        sent[i].PacketsSent = _packetsSent[i].exchange(0, std::memory_order_relaxed);
+    }
+    return true;
+}
+
+uint32_t NetworkIoChannel::GetQueuedCount() const noexcept
+{
+    return _queuedCount.load(std::memory_order_relaxed);
+}
+
+NetworkIoThread::NetworkIoThread(ITcpSocket& listenSocket)
+    : _poller(CreateSocketPoller())
+    , _listenSocket(listenSocket)
+{
+    _poller->Add(_listenSocket, &_listenSocket);
+    _thread = std::thread([this]() { Run(); });
+}
+
+NetworkIoThread::~NetworkIoThread()
+{
+    _stop.store(true, std::memory_order_release);
+    _poller->Wake();
+    if (_thread.joinable())
+    {
+        _thread.join();
+    }
+}
+
+std::shared_ptr<NetworkIoChannel> NetworkIoThread::AddConnection(ITcpSocket& socket)
+{
+    auto channel = std::make_shared<NetworkIoChannel>(*this, socket);
+    {
+        std::lock_guard<std::mutex> lock(_commandMutex);
+        _addedChannels.push_back(channel);
+        _commandsIssued++;
+    }
+    Wake();
+    return channel;
+}
+
+void NetworkIoThread::RemoveConnection(const std::shared_ptr<NetworkIoChannel>& channel)
+{
+    uint64_t ticket;
+    {
+        std::lock_guard<std::mutex> lock(_commandMutex);
+        _removedChannels.push_back(channel);
+        ticket = ++_commandsIssued;
+    }
+    Wake();
+
+    std::unique_lock<std::mutex> lock(_commandMutex);
+    _commandsProcessed.wait(lock, [this, ticket]() { return _commandsCompleted >= ticket; });
+}
+
+std::unique_ptr<ITcpSocket> NetworkIoThread::Accept()
+{
+    std::unique_ptr<ITcpSocket> socket;
+    if (_acceptedSockets.TryPop(socket))
+    {
+        return socket;
+    }
+    return nullptr;
+}
+
+void NetworkIoThread::Wake()
+{
+    if (!_wakePending.exchange(true, std::memory_order_acq_rel))
+    {
+        _poller->Wake();
+    }
+}
+
+void NetworkIoThread::Run()
+{
+    while (!_stop.load(std::memory_order_acquire))
+    {
+        // While reading is paused for a connection check back regularly for the game thread to catch up.
+        int32_t timeoutMs = _numReadPaused > 0 ? PausedPollIntervalMs : -1;
+        if (_acceptPaused)
+        {
+            timeoutMs = timeoutMs == -1 ? AcceptRetryIntervalMs : std::min(timeoutMs, AcceptRetryIntervalMs);
+        }
+        _poller->Wait(_events, timeoutMs);
+
+        // Events must be handled before removing connections, the game thread may free them straight after.
+        ProcessEvents();
+
+        _wakePending.exchange(false, std::memory_order_acq_rel);
+        ProcessCommands();
+        ProcessScheduledChannels();
+        if (_numReadPaused > 0)
+        {
+            ResumePausedChannels();
+        }
+        if (_acceptPaused && std::chrono::steady_clock::now() >= _acceptResumeTime)
+        {
+            SetAcceptPaused(false);
+        }
+    }
+}
+
+void NetworkIoThread::ProcessCommands()
+{
+    std::vector<std::shared_ptr<NetworkIoChannel>> added;
+    std::vector<std::shared_ptr<NetworkIoChannel>> removed;
+    uint64_t issued;
+    {
+        std::lock_guard<std::mutex> lock(_commandMutex);
+        if (_commandsIssued == _commandsCompleted)
+        {
+            return;
+        }
+        added.swap(_addedChannels);
+        removed.swap(_removedChannels);
+        issued = _commandsIssued;
+    }
+
+    for (auto& channel : added)
+    {
+        try
+        {
+            _poller->Add(channel->_socket, channel.get());
+            channel->_state = NetworkIoChannel::State::Registered;
+            if (channel->_wantWrite)
+            {
+                _poller->Modify(channel->_socket, channel.get(), true, true);
+            }
+            _channels.push_back(channel);
+        }
+        catch (const std::exception& e)
+        {
+            LOG_ERROR("Unable to watch connection: %s", e.what());
+            CloseChannel(*channel);
+        }
+    }
+
+    for (auto& channel : removed)
+    {
+        // Send out what was queued before the connection was removed.
+        DrainOutbound(*channel);
+        WritePackets(*channel);
+        CloseChannel(*channel);
+        _channels.erase(std::remove(_channels.begin(), _channels.end(), channel), _channels.end());
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(_commandMutex);
+        _commandsCompleted = issued;
+    }
+    _commandsProcessed.notify_all();
+}
+
+void NetworkIoThread::ProcessScheduledChannels()
+{
+    std::shared_ptr<NetworkIoChannel> channel;
+    while (_scheduledChannels.TryPop(channel))
+    {
+        // Clear before draining so packets queued from now on schedule the channel again.
+        channel->_sendScheduled.exchange(false, std::memory_order_acq_rel);
+        DrainOutbound(*channel);
+        WritePackets(*channel);
+    }
+}
+
+void NetworkIoThread::ProcessEvents()
+{
+    for (const auto& ev : _events)
+    {
+        if (ev.UserData == &_listenSocket)
+        {
+            AcceptSockets();
+            continue;
+        }
+
+        auto& channel = *static_cast<NetworkIoChannel*>(ev.UserData);
+        if (channel._state != NetworkIoChannel::State::Registered)
+        {
+            continue;
+        }
+
+        if ((ev.Readable || ev.Closed) && !channel._readPaused)
+        {
+            ReadPackets(channel);
+        }
+        if (ev.Writable)
+        {
+            WritePackets(channel);
+        }
+        if (ev.Closed)
+        {
+            CloseChannel(channel);
+        }
+    }
+    _events.clear();
+}
+
+void NetworkIoThread::ResumePausedChannels()
+{
+    for (auto& channel : _channels)
+    {
+        if (channel->_readPaused
+            && channel->_inboundCount.load(std::memory_order_relaxed) < MaxQueuedInboundPackets / 2)
+        {
+            UpdateInterest(*channel, true, channel->_wantWrite);
+            ReadPackets(*channel);
+        }
+    }
+}
+
+void NetworkIoThread::AcceptSockets()
+{
+    size_t numAccepted = 0;
+    try
+    {
+        while (auto socket = _listenSocket.Accept())
+        {
+            _acceptedSockets.Push(std::move(socket));
+            numAccepted++;
+        }
+    }
+    catch (const std::exception& e)
+    {
+        LOG_ERROR("Failed to accept client: %s", e.what());
+    }
+
+    // The listen socket was readable but nothing could be accepted, the pending connection stays queued so the
+    // socket would be reported readable again straight away. Give it a rest instead of spinning.
+    if (numAccepted == 0)
+    {
+        SetAcceptPaused(true);
+    }
+}
+
+void NetworkIoThread::SetAcceptPaused(bool paused)
+{
+    try
+    {
+        _poller->Modify(_listenSocket, &_listenSocket, !paused, false);
+    }
+    catch (const std::exception& e)
+    {
+        LOG_ERROR("Unable to watch listen socket: %s", e.what());
+    }
+    _acceptPaused = paused;
+    if (paused)
+    {
+        _acceptResumeTime = std::chrono::steady_clock::now() + std::chrono::milliseconds(AcceptRetryIntervalMs);
+    }
+}
+
+void NetworkIoThread::ReadPackets(NetworkIoChannel& channel)
+{
+    try
+    {
+        for (int32_t i = 0; i < MaxReadsPerEvent && channel._state != NetworkIoChannel::State::Closed; i++)
+        {
+            switch (NetworkConnection::ReadPacketFromSocket(channel._socket, channel._readPacket))
+            {
+                case NetworkReadPacket::Success:
+                    channel._inbound.Push(std::move(channel._readPacket));
+                    channel._readPacket = NetworkPacket();
+                    if (channel._inboundCount.fetch_add(1, std::memory_order_relaxed) + 1 >= MaxQueuedInboundPackets)
+                    {
+                        UpdateInterest(channel, false, channel._wantWrite);
+                        return;
+                    }
+                    break;
+                case NetworkReadPacket::MoreData:
+                    break;
+                case NetworkReadPacket::NoData:
+                    return;
+                case NetworkReadPacket::Disconnected:
+                    CloseChannel(channel);
+                    return;
+            }
+        }
+    }
+    catch (const std::exception&)
+    {
+        CloseChannel(channel);
+    }
+}
+
+void NetworkIoThread::WritePackets(NetworkIoChannel& channel)
+{
+    if (channel._state == NetworkIoChannel::State::Closed)
+    {
+        return;
+    }
+
+    try
+    {
+        auto& pending = channel._pending;
+        uint32_t numWrites = 0;
+        const size_t numSent = pending.empty() ? 0
+                                               : NetworkConnection::WritePacketsToSocket(channel._socket, pending, numWrites);
+        channel._socketWrites.fetch_add(numWrites, std::memory_order_relaxed);
+        for (size_t i = 0; i < numSent; i++)
+        {
+            const auto& packet = pending.front();
+            const auto command = EnumValue(packet.GetCommand());
+            if (command < channel._bytesSent.size())
+            {
+                channel._bytesSent[command].fetch_add(packet.BytesTransferred, std::memory_order_relaxed);
+                channel._packetsSent[command].fetch_add(1, std::memory_order_relaxed);
+            }
+            pending.pop_front();
+        }
+        if (numSent > 0)
+        {
+            channel._queuedCount.fetch_sub(static_cast<uint32_t>(numSent), std::memory_order_relaxed);
+            channel._sentPending.store(true, std::memory_order_release);
+        }
+    }
+    catch (const std::exception&)
+    {
+        CloseChannel(channel);
+        return;
+    }
+
+    UpdateInterest(channel, !channel._readPaused, !channel._pending.empty());
+}
+
+void NetworkIoThread::DrainOutbound(NetworkIoChannel& channel)
+{
+    NetworkIoChannel::OutboundPacket outbound;
+    while (channel._outbound.TryPop(outbound))
+    {
+        if (channel._state == NetworkIoChannel::State::Closed)
+        {
+            channel._queuedCount.fetch_sub(1, std::memory_order_relaxed);
+            continue;
+        }
+
+        auto& pending = channel._pending;
+        if (!outbound.Front)
+        {
+            pending.push_back(std::move(outbound.Packet));
+        }
+        else if (!pending.empty() && pending.front().BytesTransferred > 0)
+        {
+            // If the first packet was already partially sent add new packet to second position
+            pending.insert(pending.begin() + 1, std::move(outbound.Packet));
+        }
+        else
+        {
+            pending.push_front(std::move(outbound.Packet));
+        }
+    }
+}
+
+void NetworkIoThread::UpdateInterest(NetworkIoChannel& channel, bool read, bool write)
+{
+    if (read == !channel._readPaused && write == channel._wantWrite)
+    {
+        return;
+    }
+
+    if (channel._state == NetworkIoChannel::State::Registered)
+    {
+        try
+        {
+            _poller->Modify(channel._socket, &channel, read, write);
+        }
+        catch (const std::exception& e)
+        {
+            LOG_ERROR("Unable to watch connection: %s", e.what());
+            CloseChannel(channel);
+            return;
+        }
+    }
+    if (read == channel._readPaused)
+    {
+        _numReadPaused += read ? -1 : 1;
+    }
+    channel._readPaused = !read;
+    channel._wantWrite = write;
+}
+
+void NetworkIoThread::CloseChannel(NetworkIoChannel& channel)
+{
+    if (channel._state == NetworkIoChannel::State::Closed)
+    {
+        return;
+    }
+
+    if (channel._state == NetworkIoChannel::State::Registered)
+    {
+        _poller->Remove(channel._socket);
+    }
+    if (channel._readPaused)
+    {
+        channel._readPaused = false;
+        _numReadPaused--;
+    }
+    channel._state = NetworkIoChannel::State::Closed;
+    channel._queuedCount.fetch_sub(static_cast<uint32_t>(channel._pending.size()), std::memory_order_relaxed);
+    channel._pending.clear();
+    channel._disconnected.store(true, std::memory_order_release);
+}
+
+#endif // DISABLE_NETWORK
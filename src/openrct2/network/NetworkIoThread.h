@@ -0,0 +1,153 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2024 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#pragma once
+
+#ifndef DISABLE_NETWORK
+
+#    include "../core/SpscQueue.h"
+#    include "NetworkPacket.h"
+#    include "NetworkTelemetry.h"
+#    include "NetworkTypes.h"
+#    include "Socket.h"
+
+#    include <array>
+#    include <atomic>
+#    include <chrono>
+#    include <condition_variable>
+#    include <deque>
+#    include <memory>
+#    include <mutex>
+#    include <thread>
+#    include <vector>
+
+class NetworkIoThread;
+
+/**
+ * A connection serviced by the network I/O thread. The public methods are for the game thread, everything else is
+ * only touched by the I/O thread.
+ */
+class NetworkIoChannel final : public std::enable_shared_from_this<NetworkIoChannel>
+{
+public:
+    NetworkIoChannel(NetworkIoThread& owner, ITcpSocket& socket);
+
+    // Queued packets are only handed to the I/O thread by Flush, so everything queued during a tick is written together.
+    void QueuePacket(NetworkOutboundPacket&& packet, bool front);
+    void Flush();
+    bool TryPopPacket(NetworkPacket& packet);
+    bool IsDisconnected() const noexcept;
+    // Fills in what has been sent and the number of system calls it took since the last call, returns false if nothing
+    // was sent.
+    bool TakeSent(NetworkCommandStatsList& sent, uint32_t& numWrites) noexcept;
+    // Packets queued but not yet completely written to the socket.
+    uint32_t GetQueuedCount() const noexcept;
+
+private:
+    friend class NetworkIoThread;
+
+    enum class State
+    {
+        Pending,
+        Registered,
+        Closed,
+    };
+
+    struct OutboundPacket
+    {
+        NetworkOutboundPacket Packet;
+        bool Front{};
+    };
+
+    NetworkIoThread& _owner;
+    ITcpSocket& _socket;
+
+    // I/O thread -> game thread
+    SpscQueue<NetworkPacket> _inbound;
+    std::atomic<uint32_t> _inboundCount{};
+    std::atomic<bool> _disconnected{};
+    std::array<std::atomic<uint64_t>, EnumValue(NetworkCommand::Max)> _bytesSent{};
+    std::array<std::atomic<uint32_t>, EnumValue(NetworkCommand::Max)> _packetsSent{};
+    std::atomic<uint32_t> _socketWrites{};
+    std::atomic<bool> _sentPending{};
+    std::atomic<uint32_t> _queuedCount{};
+
+    // Game thread -> I/O thread
+    SpscQueue<OutboundPacket> _outbound;
+    std::atomic<bool> _sendScheduled{};
+
+    // Game thread only
+    bool _flushPending = false;
+
+    // I/O thread only
+    State _state = State::Pending;
+    NetworkPacket _readPacket;
+    std::deque<NetworkOutboundPacket> _pending;
+    bool _readPaused = false;
+    bool _wantWrite = false;
+};
+
+/**
+ * Accepts, reads, frames and writes packets for all server connections on a dedicated thread, waking up on socket
+ * activity (epoll, or poll where unavailable) rather than polling every connection each tick.
+ */
+class NetworkIoThread final
+{
+public:
+    explicit NetworkIoThread(ITcpSocket& listenSocket);
+    ~NetworkIoThread();
+
+    std::shared_ptr<NetworkIoChannel> AddConnection(ITcpSocket& socket);
+    // Writes out what is still queued and waits until the I/O thread no longer uses the socket.
+    void RemoveConnection(const std::shared_ptr<NetworkIoChannel>& channel);
+    std::unique_ptr<ITcpSocket> Accept();
+
+private:
+    friend class NetworkIoChannel;
+
+    std::unique_ptr<ISocketPoller> _poller;
+    ITcpSocket& _listenSocket;
+    std::thread _thread;
+    std::atomic<bool> _stop{};
+    std::atomic<bool> _wakePending{};
+
+    // Adding and removing connections, guarded by _commandMutex.
+    std::mutex _commandMutex;
+    std::condition_variable _commandsProcessed;
+    std::vector<std::shared_ptr<NetworkIoChannel>> _addedChannels;
+    std::vector<std::shared_ptr<NetworkIoChannel>> _removedChannels;
+    uint64_t _commandsIssued = 0;
+    uint64_t _commandsCompleted = 0;
+
+    SpscQueue<std::shared_ptr<NetworkIoChannel>> _scheduledChannels;
+    SpscQueue<std::unique_ptr<ITcpSocket>> _acceptedSockets;
+
+    // I/O thread only
+    std::vector<std::shared_ptr<NetworkIoChannel>> _channels;
+    std::vector<SocketPollEvent> _events;
+    size_t _numReadPaused = 0;
+    bool _acceptPaused = false;
+    std::chrono::steady_clock::time_point _acceptResumeTime;
+
+    void Wake();
+    void Run();
+    void ProcessCommands();
+    void ProcessScheduledChannels();
+    void ProcessEvents();
+    void ResumePausedChannels();
+    void AcceptSockets();
+    void SetAcceptPaused(bool paused);
+    void ReadPackets(NetworkIoChannel& channel);
+    void WritePackets(NetworkIoChannel& channel);
+    void DrainOutbound(NetworkIoChannel& channel);
+    void UpdateInterest(NetworkIoChannel& channel, bool read, bool write);
+    void CloseChannel(NetworkIoChannel& channel);
+};
+
+#endif // DISABLE_NETWORK
@@ -0,0 +1,468 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2024 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#ifndef DISABLE_NETWORK
+
+#    include "NetworkLoadTest.h"
+
+#    include "../Context.h"
+#    include "../Diagnostic.h"
+#    include "../GameState.h"
+#    include "../actions/GameAction.h"
+#    include "../core/Console.hpp"
+#    include "../platform/Platform.h"
+#    include "network.h"
+
+#    include <algorithm>
+#    include <iterator>
+#    include <stdexcept>
+
+// Same limit as the server applies to each of its connections.
+static constexpr uint32_t MaxPacketsPerUpdate = 100;
+static constexpr uint32_t HeartbeatInterval = 3000;
+// Actions the server did not execute within this time are no longer waited for.
+static constexpr uint32_t ActionTimeout = 10000;
+
+NetworkLoadTestBot::NetworkLoadTestBot(
+    std::string name, const NetworkKey& key, std::string publicKey, const std::string& host, uint16_t port)
+    : _name(std::move(name))
+    , _key(key)
+    , _publicKey(std::move(publicKey))
+{
+    _connection.Socket = CreateTcpSocket();
+    _connection.Socket->ConnectAsync(host, port);
+    _connectTime = Platform::GetTicks();
+}
+
+void NetworkLoadTestBot::Update()
+{
+    if (_state == State::Connecting)
+    {
+        switch (_connection.Socket->GetStatus())
+        {
+            case SocketStatus::Resolving:
+            case SocketStatus::Connecting:
+                return;
+            case SocketStatus::Connected:
+                _connection.ResetLastPacketTime();
+                _connection.QueuePacket(NetworkPacket(NetworkCommand::Token));
+                _state = State::Authenticating;
+                break;
+            default:
+            {
+                const char* error = _connection.Socket->GetError();
+                Disconnect(error != nullptr ? error : "unable to connect");
+                return;
+            }
+        }
+    }
+    if (_state == State::Disconnected)
+    {
+        return;
+    }
+
+    try
+    {
+        for (uint32_t i = 0; i < MaxPacketsPerUpdate && _state != State::Disconnected; i++)
+        {
+            auto status = _connection.ReadPacket();
+            if (status == NetworkReadPacket::Disconnected)
+            {
+                Disconnect("connection closed");
+                return;
+            }
+            if (status != NetworkReadPacket::Success)
+            {
+                break;
+            }
+            ProcessPacket(_connection.InboundPacket);
+            _connection.InboundPacket.Clear();
+        }
+        if (_state == State::Disconnected)
+        {
+            return;
+        }
+
+        const auto ticks = Platform::GetTicks();
+        if (_connection.AuthStatus == NetworkAuth::Ok && ticks - _lastHeartbeat >= HeartbeatInterval)
+        {
+            _connection.QueuePacket(NetworkPacket(NetworkCommand::Heartbeat));
+            _lastHeartbeat = ticks;
+        }
+        for (auto it = _pendingActions.begin(); it != _pendingActions.end();)
+        {
+            it = ticks - it->second >= ActionTimeout ? _pendingActions.erase(it) : std::next(it);
+        }
+
+        _connection.SendQueuedPackets();
+    }
+    catch (const std::exception& e)
+    {
+        Disconnect(e.what());
+    }
+}
+
+void NetworkLoadTestBot::SendGameAction(GameAction& action)
+{
+    if (_state != State::Playing)
+    {
+        return;
+    }
+
+    const auto networkId = ++_actionId;
+    action.SetNetworkId(networkId);
+
+    DataSerialiser stream(true);
+    action.Serialise(stream);
+
+    NetworkPacket packet(NetworkCommand::GameAction);
+    packet << _serverTick << action.GetType() << stream;
+    _connection.QueuePacket(std::move(packet));
+
+    _pendingActions[networkId] = Platform::GetTicks();
+    _stats.ActionsSent++;
+}
+
+void NetworkLoadTestBot::UpdateTicksBehind(uint32_t serverTick)
+{
+    if (_state == State::Playing && serverTick > _serverTick)
+    {
+        _stats.MaxTicksBehind = std::max(_stats.MaxTicksBehind, serverTick - _serverTick);
+    }
+}
+
+const std::string& NetworkLoadTestBot::GetName() const noexcept
+{
+    return _name;
+}
+
+NetworkLoadTestBot::State NetworkLoadTestBot::GetState() const noexcept
+{
+    return _state;
+}
+
+const NetworkLoadTestBotStats& NetworkLoadTestBot::GetStats() const noexcept
+{
+    return _stats;
+}
+
+const NetworkStats& NetworkLoadTestBot::GetNetworkStats() const noexcept
+{
+    return _connection.Stats;
+}
+
+void NetworkLoadTestBot::ProcessPacket(NetworkPacket& packet)
+{
+    switch (packet.GetCommand())
+    {
+        case NetworkCommand::Token:
+            HandleToken(packet);
+            break;
+        case NetworkCommand::Auth:
+            HandleAuth(packet);
+            break;
+        case NetworkCommand::ObjectsList:
+            HandleObjectsList(packet);
+            break;
+        case NetworkCommand::Map:
+            HandleMap(packet);
+            break;
+        case NetworkCommand::Tick:
+            HandleTick(packet);
+            break;
+        case NetworkCommand::GameAction:
+            HandleGameAction(packet);
+            break;
+        case NetworkCommand::Ping:
+            _connection.QueuePacket(NetworkPacket(NetworkCommand::Ping));
+            break;
+        case NetworkCommand::ShowError:
+            _stats.ActionsRejected++;
+            break;
+        case NetworkCommand::DisconnectMessage:
+            Disconnect(std::string(packet.ReadString()).c_str());
+            break;
+        default:
+            break;
+    }
+}
+
+void NetworkLoadTestBot::HandleToken(NetworkPacket& packet)
+{
+    uint32_t challengeSize;
+    packet >> challengeSize;
+    const auto* challenge = packet.Read(challengeSize);
+    if (challenge == nullptr)
+    {
+        Disconnect("invalid challenge");
+        return;
+    }
+
+    std::vector<uint8_t> signature;
+    if (!_key.Sign(challenge, challengeSize, signature))
+    {
+        Disconnect("unable to sign the challenge");
+        return;
+    }
+
+    NetworkPacket reply(NetworkCommand::Auth);
+    reply.WriteString(NetworkGetVersion());
+    reply.WriteString(_name);
+    reply.WriteString("");
+    reply.WriteString(_publicKey);
+    reply << static_cast<uint32_t>(signature.size());
+    reply.Write(signature.data(), signature.size());
+    _connection.AuthStatus = NetworkAuth::Requested;
+    _connection.QueuePacket(std::move(reply));
+}
+
+void NetworkLoadTestBot::HandleAuth(NetworkPacket& packet)
+{
+    uint32_t authStatus;
+    packet >> authStatus >> _playerId;
+    _connection.AuthStatus = static_cast<NetworkAuth>(authStatus);
+    if (_connection.AuthStatus != NetworkAuth::Ok)
+    {
+        Disconnect("authentication failed");
+        return;
+    }
+    _state = State::DownloadingMap;
+}
+
+void NetworkLoadTestBot::HandleObjectsList(NetworkPacket& packet)
+{
+    uint32_t index;
+    uint32_t totalObjects;
+    packet >> index >> totalObjects;
+    if (index + 1 >= totalObjects)
+    {
+        // The bots share the objects of the server.
+        NetworkPacket request(NetworkCommand::MapRequest);
+        request << static_cast<uint32_t>(0) << static_cast<uint64_t>(0) << static_cast<uint32_t>(0);
+        _connection.QueuePacket(std::move(request));
+    }
+}
+
+void NetworkLoadTestBot::HandleMap(NetworkPacket& packet)
+{
+    uint32_t size;
+    uint32_t offset;
+    uint64_t hash;
+    packet >> size >> offset >> hash;
+    const auto chunkSize = static_cast<uint32_t>(packet.Header.Size - packet.BytesRead);
+    if (offset == 0)
+    {
+        _mapHash = hash;
+        _mapReceived = 0;
+    }
+    if (hash != _mapHash || offset != _mapReceived)
+    {
+        return;
+    }
+
+    _mapReceived += chunkSize;
+    NetworkPacket ack(NetworkCommand::MapAck);
+    ack << hash << _mapReceived;
+    _connection.QueuePacket(std::move(ack));
+
+    if (_mapReceived >= size && _state == State::DownloadingMap)
+    {
+        _stats.MapLoadTime = Platform::GetTicks() - _connectTime;
+        _state = State::Playing;
+    }
+}
+
+void NetworkLoadTestBot::HandleTick(NetworkPacket& packet)
+{
+    uint32_t tick;
+    packet >> tick;
+
+    // The tick is sent repeatedly while the server is paused.
+    if (_state == State::Playing && tick != _serverTick && tick != _serverTick + 1)
+    {
+        _stats.TickGaps++;
+    }
+    _serverTick = tick;
+}
+
+void NetworkLoadTestBot::HandleGameAction(NetworkPacket& packet)
+{
+    uint32_t tick;
+    GameCommand actionType;
+    packet >> tick >> actionType;
+
+    auto action = GameActions::Create(actionType);
+    if (action == nullptr)
+    {
+        return;
+    }
+
+    DataSerialiser stream(false);
+    const size_t size = packet.Header.Size - packet.BytesRead;
+    stream.GetStream().WriteArray(packet.Read(size), size);
+    stream.GetStream().SetPosition(0);
+    action->Serialise(stream);
+
+    if (action->GetPlayer().id != _playerId)
+    {
+        return;
+    }
+
+    auto it = _pendingActions.find(action->GetNetworkId());
+    if (it != _pendingActions.end())
+    {
+        const auto latency = Platform::GetTicks() - it->second;
+        _stats.ActionsConfirmed++;
+        _stats.LatencyTotal += latency;
+        _stats.LatencyMax = std::max(_stats.LatencyMax, latency);
+        _pendingActions.erase(it);
+    }
+}
+
+void NetworkLoadTestBot::Disconnect(const char* reason)
+{
+    LOG_WARNING("Bot %s disconnected: %s", _name.c_str(), reason);
+    _state = State::Disconnected;
+    _connection.Socket->Close();
+}
+
+NetworkLoadTest::NetworkLoadTest(
+    uint16_t port, size_t numBots, std::vector<OpenRCT2::ReplayGameAction> actions, float actionsPerSecond)
+    : _actions(std::move(actions))
+    , _nextAction(numBots)
+    , _actionCredit(numBots)
+    , _actionsPerTick(actionsPerSecond / kGameUpdateFPS)
+    , _startTime(Platform::GetTicks())
+{
+    // The server refuses these from clients without telling them.
+    _actions.erase(
+        std::remove_if(
+            _actions.begin(), _actions.end(),
+            [](const OpenRCT2::ReplayGameAction& action) {
+                const auto type = action.Action->GetType();
+                return type == GameCommand::TogglePause || type == GameCommand::LoadOrQuit;
+            }),
+        _actions.end());
+
+    // All bots sign in with the same key, it is only generated once as that is slow.
+    if (!_key.Generate())
+    {
+        throw std::runtime_error("Unable to generate a key for the bots.");
+    }
+    const auto publicKey = _key.PublicKeyString();
+
+    for (size_t i = 0; i < numBots; i++)
+    {
+        _bots.push_back(
+            std::make_unique<NetworkLoadTestBot>("Bot " + std::to_string(i + 1), _key, publicKey, "127.0.0.1", port));
+
+        // Start each bot at a different point of the recording.
+        _nextAction[i] = i * _actions.size() / numBots;
+    }
+}
+
+NetworkLoadTest::~NetworkLoadTest() = default;
+
+void NetworkLoadTest::Update(double tickTimeMs)
+{
+    _tickTimes.push_back(tickTimeMs);
+
+    const auto serverTick = OpenRCT2::GetGameState().CurrentTicks;
+    for (size_t i = 0; i < _bots.size(); i++)
+    {
+        auto& bot = *_bots[i];
+        bot.Update();
+        bot.UpdateTicksBehind(serverTick);
+
+        if (bot.GetState() != NetworkLoadTestBot::State::Playing || _actions.empty())
+        {
+            continue;
+        }
+        for (_actionCredit[i] += _actionsPerTick; _actionCredit[i] >= 1.0f; _actionCredit[i] -= 1.0f)
+        {
+            bot.SendGameAction(*_actions[_nextAction[i]].Action);
+            _nextAction[i] = (_nextAction[i] + 1) % _actions.size();
+        }
+    }
+}
+
+static const char* GetBotStateName(NetworkLoadTestBot::State state)
+{
+    switch (state)
+    {
+        case NetworkLoadTestBot::State::Connecting:
+            return "connecting";
+        case NetworkLoadTestBot::State::Authenticating:
+            return "authenticating";
+        case NetworkLoadTestBot::State::DownloadingMap:
+            return "downloading";
+        case NetworkLoadTestBot::State::Playing:
+            return "playing";
+        case NetworkLoadTestBot::State::Disconnected:
+        default:
+            return "disconnected";
+    }
+}
+
+void NetworkLoadTest::PrintReport() const
+{
+    const double seconds = std::max<uint32_t>(Platform::GetTicks() - _startTime, 1) / 1000.0;
+    constexpr double BudgetMs = 1000.0 / kGameUpdateFPS;
+    constexpr auto Total = EnumValue(NetworkStatisticsGroup::Total);
+
+    if (!_tickTimes.empty())
+    {
+        auto tickTimes = _tickTimes;
+        std::sort(tickTimes.begin(), tickTimes.end());
+        double totalTime = 0;
+        for (auto tickTime : tickTimes)
+        {
+            totalTime += tickTime;
+        }
+        const auto overBudget = tickTimes.end() - std::upper_bound(tickTimes.begin(), tickTimes.end(), BudgetMs);
+
+        Console::WriteLine(
+            "Server tick time: avg %.2f ms, 95%% %.2f ms, 99%% %.2f ms, max %.2f ms, %d of %d ticks over %.0f ms",
+            totalTime / tickTimes.size(), tickTimes[tickTimes.size() * 95 / 100], tickTimes[tickTimes.size() * 99 / 100],
+            tickTimes.back(), static_cast<int32_t>(overBudget), static_cast<int32_t>(tickTimes.size()), BudgetMs);
+    }
+
+    const auto serverStats = NetworkGetStats();
+    Console::WriteLine(
+        "Server bandwidth: sent %.1f KiB/s, received %.1f KiB/s", serverStats.bytesSent[Total] / 1024.0 / seconds,
+        serverStats.bytesReceived[Total] / 1024.0 / seconds);
+
+    Console::WriteLine(
+        "%-8s %-14s %8s %7s %7s %7s %9s %9s %9s %9s %5s %6s", "Bot", "State", "Map ms", "Sent", "Done", "Denied", "Avg ms",
+        "Max ms", "In KiB/s", "Out KiB/s", "Gaps", "Behind");
+    uint32_t numPlaying = 0;
+    uint32_t totalGaps = 0;
+    for (const auto& bot : _bots)
+    {
+        const auto& stats = bot->GetStats();
+        const auto& networkStats = bot->GetNetworkStats();
+        if (bot->GetState() == NetworkLoadTestBot::State::Playing)
+        {
+            numPlaying++;
+        }
+        totalGaps += stats.TickGaps;
+
+        const double avgLatency = stats.ActionsConfirmed > 0 ? static_cast<double>(stats.LatencyTotal) / stats.ActionsConfirmed
+                                                             : 0.0;
+        Console::WriteLine(
+            "%-8s %-14s %8u %7u %7u %7u %9.1f %9u %9.1f %9.1f %5u %6u", bot->GetName().c_str(),
+            GetBotStateName(bot->GetState()), stats.MapLoadTime, stats.ActionsSent, stats.ActionsConfirmed,
+            stats.ActionsRejected, avgLatency, stats.LatencyMax, networkStats.bytesReceived[Total] / 1024.0 / seconds,
+            networkStats.bytesSent[Total] / 1024.0 / seconds, stats.TickGaps, stats.MaxTicksBehind);
+    }
+    Console::WriteLine(
+        "%u of %u bots still playing, %u tick gaps in total", numPlaying, static_cast<uint32_t>(_bots.size()), totalGaps);
+}
+
+#endif // DISABLE_NETWORK
@@ -0,0 +1,117 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2024 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#pragma once
+
+#ifndef DISABLE_NETWORK
+
+#    include "../ReplayManager.h"
+#    include "NetworkConnection.h"
+#    include "NetworkKey.h"
+
+#    include <map>
+#    include <memory>
+#    include <string>
+#    include <vector>
+
+class GameAction;
+
+struct NetworkLoadTestBotStats
+{
+    uint32_t MapLoadTime{}; // Milliseconds from connecting until the map was received.
+    uint32_t ActionsSent{};
+    uint32_t ActionsConfirmed{};
+    uint32_t ActionsRejected{};
+    uint64_t LatencyTotal{};
+    uint32_t LatencyMax{};
+    uint32_t TickGaps{};
+    uint32_t MaxTicksBehind{};
+};
+
+/**
+ * A client that only speaks the network protocol: it authenticates, downloads the map without loading it and sends
+ * game actions, measuring how long the server takes to execute them. It does not simulate the park.
+ */
+class NetworkLoadTestBot final
+{
+public:
+    enum class State
+    {
+        Connecting,
+        Authenticating,
+        DownloadingMap,
+        Playing,
+        Disconnected,
+    };
+
+    NetworkLoadTestBot(
+        std::string name, const NetworkKey& key, std::string publicKey, const std::string& host, uint16_t port);
+
+    void Update();
+    void SendGameAction(GameAction& action);
+    void UpdateTicksBehind(uint32_t serverTick);
+
+    const std::string& GetName() const noexcept;
+    State GetState() const noexcept;
+    const NetworkLoadTestBotStats& GetStats() const noexcept;
+    const NetworkStats& GetNetworkStats() const noexcept;
+
+private:
+    std::string _name;
+    const NetworkKey& _key;
+    std::string _publicKey;
+    NetworkConnection _connection;
+    State _state = State::Connecting;
+    NetworkLoadTestBotStats _stats;
+    uint8_t _playerId = 0;
+    uint32_t _serverTick = 0;
+    uint32_t _connectTime = 0;
+    uint32_t _lastHeartbeat = 0;
+    uint32_t _actionId = 0;
+    uint64_t _mapHash = 0;
+    uint32_t _mapReceived = 0;
+    // Network id of each action sent and when it was sent.
+    std::map<uint32_t, uint32_t> _pendingActions;
+
+    void ProcessPacket(NetworkPacket& packet);
+    void HandleToken(NetworkPacket& packet);
+    void HandleAuth(NetworkPacket& packet);
+    void HandleObjectsList(NetworkPacket& packet);
+    void HandleMap(NetworkPacket& packet);
+    void HandleTick(NetworkPacket& packet);
+    void HandleGameAction(NetworkPacket& packet);
+    void Disconnect(const char* reason);
+};
+
+/**
+ * Connects bots to the server running in this process and makes them replay a recorded stream of game actions.
+ */
+class NetworkLoadTest final
+{
+public:
+    NetworkLoadTest(
+        uint16_t port, size_t numBots, std::vector<OpenRCT2::ReplayGameAction> actions, float actionsPerSecond);
+    ~NetworkLoadTest();
+
+    // Called once per server tick with the time the server took to update.
+    void Update(double tickTimeMs);
+    void PrintReport() const;
+
+private:
+    NetworkKey _key;
+    std::vector<std::unique_ptr<NetworkLoadTestBot>> _bots;
+    std::vector<OpenRCT2::ReplayGameAction> _actions;
+    std::vector<size_t> _nextAction;
+    std::vector<float> _actionCredit;
+    std::vector<double> _tickTimes;
+    float _actionsPerTick;
+    uint32_t _startTime;
+};
+
+#endif // DISABLE_NETWORK
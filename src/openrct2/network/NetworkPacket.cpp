@@ -12,9 +12,29 @@
 #    include "NetworkPacket.h"
 
 #    include "NetworkTypes.h"
+#    include "Socket.h"
 
 #    include <memory>
 
+static bool CommandRequiresAuth(NetworkCommand command) noexcept
+{
+    switch (command)
+    {
+        case NetworkCommand::Ping:
+        case NetworkCommand::Auth:
+        case NetworkCommand::Token:
+        case NetworkCommand::GameInfo:
+        case NetworkCommand::ObjectsList:
+        case NetworkCommand::ScriptsHeader:
+        case NetworkCommand::ScriptsData:
+        case NetworkCommand::MapRequest:
+        case NetworkCommand::Heartbeat:
+            return false;
+        default:
+            return true;
+    }
+}
+
 NetworkPacket::NetworkPacket(NetworkCommand id) noexcept
     : Header{ 0, id }
 {
@@ -44,21 +64,7 @@ void NetworkPacket::Clear() noexcept
 
 bool NetworkPacket::CommandRequiresAuth() const noexcept
 {
-    switch (GetCommand())
-    {
-        case NetworkCommand::Ping:
-        case NetworkCommand::Auth:
-        case NetworkCommand::Token:
-        case NetworkCommand::GameInfo:
-        case NetworkCommand::ObjectsList:
-        case NetworkCommand::ScriptsHeader:
-        case NetworkCommand::ScriptsData:
-        case NetworkCommand::MapRequest:
-        case NetworkCommand::Heartbeat:
-            return false;
-        default:
-            return true;
-    }
+    return ::CommandRequiresAuth(GetCommand());
 }
 
 void NetworkPacket::Write(const void* bytes, size_t size)
@@ -85,6 +91,11 @@ const uint8_t* NetworkPacket::Read(size_t size)
     return data;
 }
 
+size_t NetworkPacket::BytesRemaining() const noexcept
+{
+    return BytesRead < Data.size() ? Data.size() - BytesRead : 0;
+}
+
 std::string_view NetworkPacket::ReadString()
 {
     if (BytesRead >= Data.size())
@@ -108,4 +119,48 @@ std::string_view NetworkPacket::ReadString()
     return std::string_view(str, stringLen);
 }
 
+NetworkOutboundPacket::NetworkOutboundPacket(const NetworkPacket& packet)
+    : Command(packet.GetCommand())
+{
+    PacketHeader header{};
+
+    // NOTE: For compatibility reasons for the master server we need to add sizeof(Header.Id) to the size.
+    // Previously the Id field was not part of the header rather part of the body.
+    header.Size = static_cast<uint16_t>(packet.Data.size() + sizeof(header.Id));
+    header.Size = Convert::HostToNetwork(header.Size);
+    header.Id = ByteSwapBE(packet.Header.Id);
+
+    auto buffer = std::make_shared<std::vector<uint8_t>>();
+    buffer->reserve(sizeof(header) + packet.Data.size());
+    buffer->insert(
+        buffer->end(), reinterpret_cast<const uint8_t*>(&header), reinterpret_cast<const uint8_t*>(&header) + sizeof(header));
+    buffer->insert(buffer->end(), packet.Data.begin(), packet.Data.end());
+    Buffer = std::move(buffer);
+}
+
+NetworkCommand NetworkOutboundPacket::GetCommand() const noexcept
+{
+    return Command;
+}
+
+bool NetworkOutboundPacket::CommandRequiresAuth() const noexcept
+{
+    return ::CommandRequiresAuth(Command);
+}
+
+size_t NetworkOutboundPacket::GetSize() const noexcept
+{
+    return Buffer != nullptr ? Buffer->size() : 0;
+}
+
+const uint8_t* NetworkOutboundPacket::GetRemainingData() const noexcept
+{
+    return Buffer->data() + BytesTransferred;
+}
+
+size_t NetworkOutboundPacket::GetRemainingSize() const noexcept
+{
+    return GetSize() - BytesTransferred;
+}
+
 #endif
@@ -39,6 +39,7 @@ struct NetworkPacket final
     bool CommandRequiresAuth() const noexcept;
 
     const uint8_t* Read(size_t size);
+    size_t BytesRemaining() const noexcept;
     std::string_view ReadString();
 
     void Write(const void* bytes, size_t size);
@@ -79,3 +80,25 @@ public:
     size_t BytesTransferred = 0;
     size_t BytesRead = 0;
 };
+
+/**
+ * A packet serialised for sending, header included. The buffer is never modified once created so it can be shared by
+ * every connection the packet is queued on, broadcasting only copies the payload once.
+ */
+struct NetworkOutboundPacket final
+{
+    NetworkOutboundPacket() noexcept = default;
+    explicit NetworkOutboundPacket(const NetworkPacket& packet);
+
+    NetworkCommand GetCommand() const noexcept;
+    bool CommandRequiresAuth() const noexcept;
+
+    size_t GetSize() const noexcept;
+    const uint8_t* GetRemainingData() const noexcept;
+    size_t GetRemainingSize() const noexcept;
+
+public:
+    NetworkCommand Command = NetworkCommand::Invalid;
+    std::shared_ptr<const std::vector<uint8_t>> Buffer;
+    size_t BytesTransferred = 0;
+};
@@ -0,0 +1,396 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2024 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#ifndef DISABLE_NETWORK
+
+#    include "NetworkResync.h"
+
+#    include "../GameState.h"
+#    include "../core/DataSerialiser.h"
+#    include "../drawing/Drawing.h"
+#    include "../entity/EntityList.h"
+#    include "../entity/EntityRegistry.h"
+#    include "../entity/EntityTweener.h"
+#    include "../entity/Guest.h"
+#    include "../entity/Litter.h"
+#    include "../entity/Staff.h"
+#    include "../ride/Vehicle.h"
+#    include "../scenario/Scenario.h"
+#    include "../world/Map.h"
+#    include "../world/MapAnimation.h"
+#    include "NetworkPacket.h"
+
+#    include <algorithm>
+#    include <cstring>
+#    include <stdexcept>
+
+using namespace OpenRCT2;
+
+static constexpr uint64_t HashSeed = 0xcbf29ce484222325ULL;
+static constexpr uint64_t HashPrime = 0x00000100000001B3ULL;
+
+static int32_t GetRegionsPerRow()
+{
+    return (GetGameState().MapSize.x + RESYNC_REGION_SIZE - 1) / RESYNC_REGION_SIZE;
+}
+
+static int32_t GetRegionsPerColumn()
+{
+    return (GetGameState().MapSize.y + RESYNC_REGION_SIZE - 1) / RESYNC_REGION_SIZE;
+}
+
+static uint32_t GetRegionIndex(const TileCoordsXY& tile)
+{
+    return (tile.y / RESYNC_REGION_SIZE) * GetRegionsPerRow() + tile.x / RESYNC_REGION_SIZE;
+}
+
+template<typename TFunc> static void ForEachTileInRegion(uint32_t region, TFunc&& func)
+{
+    const auto& mapSize = GetGameState().MapSize;
+    const auto left = static_cast<int32_t>(region % GetRegionsPerRow()) * RESYNC_REGION_SIZE;
+    const auto top = static_cast<int32_t>(region / GetRegionsPerRow()) * RESYNC_REGION_SIZE;
+    for (int32_t y = top; y < std::min(top + RESYNC_REGION_SIZE, mapSize.y); y++)
+    {
+        for (int32_t x = left; x < std::min(left + RESYNC_REGION_SIZE, mapSize.x); x++)
+        {
+            func(TileCoordsXY{ x, y });
+        }
+    }
+}
+
+// Ghosts only exist on the client that placed them and are left out, so is the flag that depends on them.
+template<typename TFunc> static void ForEachElementOnTile(const TileCoordsXY& tile, TFunc&& func)
+{
+    const auto* element = MapGetFirstElementAt(tile);
+    if (element == nullptr)
+    {
+        return;
+    }
+    do
+    {
+        if (!element->IsGhost())
+        {
+            auto copy = *element;
+            copy.SetLastForTile(false);
+            func(copy);
+        }
+    } while (!(element++)->IsLastForTile());
+}
+
+static std::vector<uint64_t> HashRegions()
+{
+    std::vector<uint64_t> hashes(NetworkResyncGetNumRegions(), HashSeed);
+    const auto& mapSize = GetGameState().MapSize;
+    for (int32_t y = 0; y < mapSize.y; y++)
+    {
+        for (int32_t x = 0; x < mapSize.x; x++)
+        {
+            const TileCoordsXY tile{ x, y };
+            auto& hash = hashes[GetRegionIndex(tile)];
+            uint64_t numElements = 0;
+            ForEachElementOnTile(tile, [&hash, &numElements](const TileElement& element) {
+                uint64_t words[sizeof(TileElement) / sizeof(uint64_t)];
+                std::memcpy(words, &element, sizeof(words));
+                for (auto word : words)
+                {
+                    hash ^= word;
+                    hash *= HashPrime;
+                }
+                numElements++;
+            });
+            hash ^= numElements;
+            hash *= HashPrime;
+        }
+    }
+    return hashes;
+}
+
+NetworkResyncHashes NetworkResyncHashes::Capture(uint32_t tick)
+{
+    NetworkResyncHashes hashes;
+    hashes.Tick = tick;
+    hashes.Srand0 = ScenarioRandState().s0;
+    hashes.Srand1 = ScenarioRandState().s1;
+    hashes.Regions = HashRegions();
+    hashes.Entities = GetEntityHashTree().GetBucketHashes();
+    return hashes;
+}
+
+void NetworkResyncHashes::Write(NetworkPacket& packet) const
+{
+    packet << Tick << Srand0 << Srand1 << static_cast<uint32_t>(Regions.size());
+    for (auto hash : Regions)
+    {
+        packet << hash;
+    }
+    for (auto hash : Entities)
+    {
+        packet << hash;
+    }
+}
+
+void NetworkResyncHashes::Read(NetworkPacket& packet)
+{
+    uint32_t numRegions{};
+    packet >> Tick >> Srand0 >> Srand1 >> numRegions;
+    if (numRegions > (packet.Header.Size - packet.BytesRead) / sizeof(uint64_t))
+    {
+        throw std::runtime_error("Invalid number of regions.");
+    }
+
+    Regions.resize(numRegions);
+    for (auto& hash : Regions)
+    {
+        packet >> hash;
+    }
+    for (auto& hash : Entities)
+    {
+        packet >> hash;
+    }
+}
+
+bool NetworkResyncData::IsEmpty() const noexcept
+{
+    return Regions.empty() && EntityBuckets.empty();
+}
+
+size_t NetworkResyncGetNumRegions()
+{
+    return static_cast<size_t>(GetRegionsPerRow()) * GetRegionsPerColumn();
+}
+
+void NetworkResyncWriteRegion(NetworkPacket& packet, uint32_t region)
+{
+    std::vector<TileElement> elements;
+    ForEachTileInRegion(region, [&elements](const TileCoordsXY& tile) {
+        const auto numElements = elements.size();
+        ForEachElementOnTile(tile, [&elements](const TileElement& element) { elements.push_back(element); });
+        if (elements.size() != numElements)
+        {
+            elements.back().SetLastForTile(true);
+        }
+    });
+
+    // Tile elements are stored as they are in park files as well.
+    packet << static_cast<uint32_t>(elements.size());
+    packet.Write(elements.data(), elements.size() * sizeof(TileElement));
+}
+
+std::vector<TileElement> NetworkResyncReadRegion(NetworkPacket& packet, uint32_t region)
+{
+    if (region >= NetworkResyncGetNumRegions())
+    {
+        throw std::runtime_error("Invalid region.");
+    }
+
+    uint32_t numElements{};
+    packet >> numElements;
+    const auto* data = packet.Read(numElements * sizeof(TileElement));
+    if (data == nullptr)
+    {
+        throw std::runtime_error("Region data is incomplete.");
+    }
+
+    std::vector<TileElement> elements(numElements);
+    std::memcpy(elements.data(), data, numElements * sizeof(TileElement));
+
+    // Every tile has at least its surface, so there is an element marked last for each.
+    size_t numTiles = 0;
+    ForEachTileInRegion(region, [&numTiles](const TileCoordsXY&) { numTiles++; });
+    const auto numLast = std::count_if(elements.begin(), elements.end(), [](const TileElement& el) {
+        return el.IsLastForTile();
+    });
+    if (static_cast<size_t>(numLast) != numTiles || (!elements.empty() && !elements.back().IsLastForTile()))
+    {
+        throw std::runtime_error("Region data does not match the map.");
+    }
+    return elements;
+}
+
+static bool SerialiseEntity(EntityBase& entity, DataSerialiser& ds)
+{
+    switch (entity.Type)
+    {
+        case EntityType::Guest:
+            entity.As<Guest>()->Serialise(ds);
+            return true;
+        case EntityType::Staff:
+            entity.As<Staff>()->Serialise(ds);
+            return true;
+        case EntityType::Vehicle:
+            entity.As<Vehicle>()->Serialise(ds);
+            return true;
+        case EntityType::Litter:
+            entity.As<Litter>()->Serialise(ds);
+            return true;
+        default:
+            return false;
+    }
+}
+
+static bool IsHashedEntityType(EntityType type)
+{
+    return type == EntityType::Guest || type == EntityType::Staff || type == EntityType::Vehicle
+        || type == EntityType::Litter;
+}
+
+void NetworkResyncWriteEntityBucket(NetworkPacket& packet, uint32_t bucket)
+{
+    // The same entities as the hash tree, everything else is left to the client.
+    DataSerialiser ds(true);
+    const auto first = bucket * EntityHashTree::LeavesPerBucket;
+    for (size_t i = first; i < first + EntityHashTree::LeavesPerBucket; i++)
+    {
+        auto* entity = i < MAX_ENTITIES ? TryGetEntity(EntityId::FromUnderlying(static_cast<EntityId::UnderlyingType>(i)))
+                                        : nullptr;
+        auto type = entity != nullptr && IsHashedEntityType(entity->Type) ? entity->Type : EntityType::Null;
+        ds << type;
+        if (type != EntityType::Null)
+        {
+            SerialiseEntity(*entity, ds);
+        }
+    }
+
+    packet << static_cast<uint32_t>(ds.GetStream().GetLength()) << ds;
+}
+
+std::vector<uint8_t> NetworkResyncReadEntityBucket(NetworkPacket& packet)
+{
+    uint32_t size{};
+    packet >> size;
+    const auto* data = packet.Read(size);
+    if (data == nullptr)
+    {
+        throw std::runtime_error("Entity data is incomplete.");
+    }
+    return std::vector<uint8_t>(data, data + size);
+}
+
+static void ApplyRegions(const std::map<uint32_t, std::vector<TileElement>>& regions)
+{
+    // The tiles of a region come in the same order as the whole map is rebuilt in.
+    std::map<uint32_t, size_t> cursors;
+    const auto& mapSize = GetGameState().MapSize;
+
+    std::vector<TileElement> newElements;
+    newElements.reserve(GetTileElements().size());
+    for (int32_t y = 0; y < MAXIMUM_MAP_SIZE_TECHNICAL; y++)
+    {
+        for (int32_t x = 0; x < MAXIMUM_MAP_SIZE_TECHNICAL; x++)
+        {
+            const TileCoordsXY tile{ x, y };
+            auto it = x < mapSize.x && y < mapSize.y ? regions.find(GetRegionIndex(tile)) : regions.end();
+            if (it != regions.end())
+            {
+                auto& cursor = cursors[it->first];
+                const auto& elements = it->second;
+                do
+                {
+                    newElements.push_back(elements[cursor]);
+                } while (!elements[cursor++].IsLastForTile());
+                continue;
+            }
+
+            const auto* element = MapGetFirstElementAt(tile);
+            do
+            {
+                newElements.push_back(*element);
+            } while (!(element++)->IsLastForTile());
+        }
+    }
+
+    SetTileElements(std::move(newElements));
+    MapAnimationAutoCreate();
+}
+
+static void ApplyEntityBucket(uint32_t bucket, const std::vector<uint8_t>& data)
+{
+    MemoryStream stream(data.data(), data.size());
+    DataSerialiser ds(false, stream);
+
+    const auto first = bucket * EntityHashTree::LeavesPerBucket;
+    for (size_t i = first; i < first + EntityHashTree::LeavesPerBucket && i < MAX_ENTITIES; i++)
+    {
+        const auto id = EntityId::FromUnderlying(static_cast<EntityId::UnderlyingType>(i));
+
+        EntityType type{};
+        ds << type;
+        if (type != EntityType::Null && !IsHashedEntityType(type))
+        {
+            throw std::runtime_error("Invalid entity type.");
+        }
+
+        auto* entity = TryGetEntity(id);
+        if (entity->Type != type && (IsHashedEntityType(entity->Type) || type != EntityType::Null))
+        {
+            if (entity->Type != EntityType::Null)
+            {
+                EntityRemove(entity);
+            }
+            if (type != EntityType::Null)
+            {
+                entity = CreateEntityAt(id, type);
+            }
+        }
+        if (type == EntityType::Null)
+        {
+            continue;
+        }
+        if (entity == nullptr)
+        {
+            throw std::runtime_error("Unable to create entity.");
+        }
+
+        // Names are not part of the entity data and stay as they are on the client.
+        auto* peep = entity->As<Peep>();
+        auto* name = peep != nullptr ? peep->Name : nullptr;
+        SerialiseEntity(*entity, ds);
+        if (peep != nullptr)
+        {
+            peep->Name = name;
+        }
+        entity->Id = id;
+        entity->Type = type;
+    }
+}
+
+void NetworkResyncApply(const NetworkResyncData& data)
+{
+    if (!data.Regions.empty())
+    {
+        ApplyRegions(data.Regions);
+    }
+
+    if (!data.EntityBuckets.empty())
+    {
+        for (const auto& [bucket, bucketData] : data.EntityBuckets)
+        {
+            ApplyEntityBucket(bucket, bucketData);
+        }
+        ResetEntitySpatialIndices();
+        EntityTweener::Get().Reset();
+    }
+
+    GfxInvalidateScreen();
+}
+
+std::vector<uint32_t> NetworkResyncFindDifferences(const uint64_t* a, size_t countA, const uint64_t* b, size_t countB)
+{
+    std::vector<uint32_t> result;
+    for (size_t i = 0; i < std::max(countA, countB); i++)
+    {
+        if (i >= countA || i >= countB || a[i] != b[i])
+        {
+            result.push_back(static_cast<uint32_t>(i));
+        }
+    }
+    return result;
+}
+
+#endif // DISABLE_NETWORK
@@ -0,0 +1,74 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2024 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#pragma once
+
+#ifndef DISABLE_NETWORK
+
+#    include "../entity/EntityHashTree.h"
+#    include "../world/TileElement.h"
+
+#    include <map>
+#    include <vector>
+
+struct NetworkPacket;
+
+// Width and height in tiles of the map regions that are compared and sent on their own.
+static constexpr int32_t RESYNC_REGION_SIZE = 16;
+
+/**
+ * Hashes of the parts of the game state a desynchronised client can get back from the server, taken at the start of a
+ * tick: the random generator, square regions of the tile map and the buckets of the entity hash tree.
+ */
+struct NetworkResyncHashes
+{
+    uint32_t Tick{};
+    uint32_t Srand0{};
+    uint32_t Srand1{};
+    std::vector<uint64_t> Regions;
+    EntityHashTree::BucketHashes Entities{};
+
+    // The entity hash tree has to be up to date for the tick.
+    static NetworkResyncHashes Capture(uint32_t tick);
+
+    void Write(NetworkPacket& packet) const;
+    void Read(NetworkPacket& packet);
+};
+
+/**
+ * What a desynchronised client asks the server to send, the server only sends up to a limit each time.
+ */
+struct NetworkResyncRequest
+{
+    std::vector<uint32_t> Regions;
+    std::vector<uint32_t> EntityBuckets;
+};
+
+/**
+ * Regions and entity buckets sent by the server, they are applied together once the client reaches their tick.
+ */
+struct NetworkResyncData
+{
+    std::map<uint32_t, std::vector<TileElement>> Regions;
+    std::map<uint32_t, std::vector<uint8_t>> EntityBuckets;
+
+    bool IsEmpty() const noexcept;
+};
+
+size_t NetworkResyncGetNumRegions();
+void NetworkResyncWriteRegion(NetworkPacket& packet, uint32_t region);
+std::vector<TileElement> NetworkResyncReadRegion(NetworkPacket& packet, uint32_t region);
+void NetworkResyncWriteEntityBucket(NetworkPacket& packet, uint32_t bucket);
+std::vector<uint8_t> NetworkResyncReadEntityBucket(NetworkPacket& packet);
+void NetworkResyncApply(const NetworkResyncData& data);
+
+// Indices of the entries that differ, hash lists of different lengths differ everywhere.
+std::vector<uint32_t> NetworkResyncFindDifferences(const uint64_t* a, size_t countA, const uint64_t* b, size_t countB);
+
+#endif // DISABLE_NETWORK
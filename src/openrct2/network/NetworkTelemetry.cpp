@@ -0,0 +1,209 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2024 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#ifndef DISABLE_NETWORK
+
+#    include "NetworkTelemetry.h"
+
+#    include "../core/Json.hpp"
+
+#    include <algorithm>
+#    include <cmath>
+
+void NetworkRttHistogram::Add(uint32_t rtt) noexcept
+{
+    const auto it = std::lower_bound(BucketLimits.begin(), BucketLimits.end(), rtt);
+    _counts[std::distance(BucketLimits.begin(), it)]++;
+
+    _min = _count == 0 ? rtt : std::min(_min, rtt);
+    _max = std::max(_max, rtt);
+    _total += rtt;
+    _count++;
+}
+
+uint32_t NetworkRttHistogram::GetCount() const noexcept
+{
+    return _count;
+}
+
+uint32_t NetworkRttHistogram::GetMin() const noexcept
+{
+    return _min;
+}
+
+uint32_t NetworkRttHistogram::GetMax() const noexcept
+{
+    return _max;
+}
+
+uint32_t NetworkRttHistogram::GetMean() const noexcept
+{
+    return _count == 0 ? 0 : static_cast<uint32_t>(_total / _count);
+}
+
+uint32_t NetworkRttHistogram::GetPercentile(float fraction) const noexcept
+{
+    if (_count == 0)
+    {
+        return 0;
+    }
+
+    const auto target = std::max<uint32_t>(1, static_cast<uint32_t>(std::ceil(_count * fraction)));
+    uint32_t seen = 0;
+    for (size_t i = 0; i < BucketLimits.size(); i++)
+    {
+        seen += _counts[i];
+        if (seen >= target)
+        {
+            return std::min(BucketLimits[i], _max);
+        }
+    }
+    return _max;
+}
+
+json_t NetworkRttHistogram::ToJson() const
+{
+    return {
+        { "count", _count },
+        { "min", GetMin() },
+        { "max", GetMax() },
+        { "mean", GetMean() },
+        { "p50", GetPercentile(0.50f) },
+        { "p95", GetPercentile(0.95f) },
+        { "p99", GetPercentile(0.99f) },
+        { "limits", BucketLimits },
+        { "counts", _counts },
+    };
+}
+
+void NetworkTelemetry::RecordSent(NetworkCommand command, uint64_t bytes, uint32_t packets) noexcept
+{
+    if (command < NetworkCommand::Max)
+    {
+        auto& stats = Commands[EnumValue(command)];
+        stats.BytesSent += bytes;
+        stats.PacketsSent += packets;
+    }
+}
+
+void NetworkTelemetry::RecordReceived(NetworkCommand command, uint64_t bytes) noexcept
+{
+    // Commands are not validated before this point.
+    if (command < NetworkCommand::Max)
+    {
+        auto& stats = Commands[EnumValue(command)];
+        stats.BytesReceived += bytes;
+        stats.PacketsReceived++;
+    }
+}
+
+void NetworkTelemetry::RecordQueueDepth(size_t depth) noexcept
+{
+    QueueHighWater = std::max(QueueHighWater, static_cast<uint32_t>(depth));
+}
+
+void NetworkTelemetry::RecordWrites(uint32_t packets, uint32_t writes) noexcept
+{
+    PacketsWritten += packets;
+    SocketWrites += writes;
+}
+
+uint64_t NetworkTelemetry::GetSyscallsSaved() const noexcept
+{
+    // A packet that did not fit takes more than one write.
+    return PacketsWritten > SocketWrites ? PacketsWritten - SocketWrites : 0;
+}
+
+const char* NetworkGetCommandName(NetworkCommand command) noexcept
+{
+    switch (command)
+    {
+        case NetworkCommand::Auth:
+            return "auth";
+        case NetworkCommand::Map:
+            return "map";
+        case NetworkCommand::Chat:
+            return "chat";
+        case NetworkCommand::Tick:
+            return "tick";
+        case NetworkCommand::PlayerList:
+            return "player_list";
+        case NetworkCommand::Ping:
+            return "ping";
+        case NetworkCommand::PingList:
+            return "ping_list";
+        case NetworkCommand::DisconnectMessage:
+            return "disconnect_message";
+        case NetworkCommand::GameInfo:
+            return "game_info";
+        case NetworkCommand::ShowError:
+            return "show_error";
+        case NetworkCommand::GroupList:
+            return "group_list";
+        case NetworkCommand::Event:
+            return "event";
+        case NetworkCommand::Token:
+            return "token";
+        case NetworkCommand::ObjectsList:
+            return "objects_list";
+        case NetworkCommand::MapRequest:
+            return "map_request";
+        case NetworkCommand::GameAction:
+            return "game_action";
+        case NetworkCommand::PlayerInfo:
+            return "player_info";
+        case NetworkCommand::RequestGameState:
+            return "request_game_state";
+        case NetworkCommand::GameState:
+            return "game_state";
+        case NetworkCommand::ScriptsHeader:
+            return "scripts_header";
+        case NetworkCommand::ScriptsData:
+            return "scripts_data";
+        case NetworkCommand::Heartbeat:
+            return "heartbeat";
+        case NetworkCommand::MapAck:
+            return "map_ack";
+        case NetworkCommand::RequestEntityHashes:
+            return "request_entity_hashes";
+        case NetworkCommand::EntityHashes:
+            return "entity_hashes";
+        case NetworkCommand::RequestResync:
+            return "request_resync";
+        case NetworkCommand::Resync:
+            return "resync";
+        case NetworkCommand::ResyncData:
+            return "resync_data";
+        default:
+            return "unknown";
+    }
+}
+
+json_t NetworkCommandStatsToJson(const NetworkCommandStatsList& commands)
+{
+    json_t result = json_t::object();
+    for (size_t i = 0; i < commands.size(); i++)
+    {
+        const auto& stats = commands[i];
+        if (stats.PacketsSent == 0 && stats.PacketsReceived == 0)
+        {
+            continue;
+        }
+
+        result[NetworkGetCommandName(static_cast<NetworkCommand>(i))] = {
+            { "bytesSent", stats.BytesSent },
+            { "bytesReceived", stats.BytesReceived },
+            { "packetsSent", stats.PacketsSent },
+            { "packetsReceived", stats.PacketsReceived },
+        };
+    }
+    return result;
+}
+
+#endif // DISABLE_NETWORK
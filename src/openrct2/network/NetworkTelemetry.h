@@ -0,0 +1,80 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2024 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#pragma once
+
+#ifndef DISABLE_NETWORK
+
+#    include "../core/JsonFwd.hpp"
+#    include "NetworkTypes.h"
+
+#    include <array>
+
+struct NetworkCommandStats
+{
+    uint64_t BytesSent{};
+    uint64_t BytesReceived{};
+    uint32_t PacketsSent{};
+    uint32_t PacketsReceived{};
+};
+
+using NetworkCommandStatsList = std::array<NetworkCommandStats, EnumValue(NetworkCommand::Max)>;
+
+/**
+ * Counts round trip times into buckets that double in width.
+ */
+class NetworkRttHistogram final
+{
+public:
+    // Upper bound in milliseconds of each bucket, one more bucket takes everything above the last.
+    static constexpr std::array<uint32_t, 8> BucketLimits = { 25, 50, 100, 200, 400, 800, 1600, 3200 };
+    static constexpr size_t NumBuckets = BucketLimits.size() + 1;
+
+    void Add(uint32_t rtt) noexcept;
+    uint32_t GetCount() const noexcept;
+    uint32_t GetMin() const noexcept;
+    uint32_t GetMax() const noexcept;
+    uint32_t GetMean() const noexcept;
+    // Upper bound of the bucket the given fraction of the samples falls within.
+    uint32_t GetPercentile(float fraction) const noexcept;
+    json_t ToJson() const;
+
+private:
+    std::array<uint32_t, NumBuckets> _counts{};
+    uint32_t _count{};
+    uint32_t _min{};
+    uint32_t _max{};
+    uint64_t _total{};
+};
+
+/**
+ * Traffic counters of a single connection, broken down by command.
+ */
+struct NetworkTelemetry
+{
+    NetworkCommandStatsList Commands{};
+    uint32_t QueueHighWater{};
+    // Packets written to the socket and the system calls it took.
+    uint64_t PacketsWritten{};
+    uint64_t SocketWrites{};
+    NetworkRttHistogram Rtt;
+
+    void RecordSent(NetworkCommand command, uint64_t bytes, uint32_t packets = 1) noexcept;
+    void RecordReceived(NetworkCommand command, uint64_t bytes) noexcept;
+    void RecordQueueDepth(size_t depth) noexcept;
+    void RecordWrites(uint32_t packets, uint32_t writes) noexcept;
+    // System calls saved compared to writing each packet on its own.
+    uint64_t GetSyscallsSaved() const noexcept;
+};
+
+const char* NetworkGetCommandName(NetworkCommand command) noexcept;
+// Only commands that have seen any traffic are included, keyed by their name.
+json_t NetworkCommandStatsToJson(const NetworkCommandStatsList& commands);
+
+#endif // DISABLE_NETWORK
@@ -84,6 +84,12 @@ enum class NetworkCommand : uint32_t
     ScriptsHeader,
     ScriptsData,
     Heartbeat,
+    MapAck,
+    RequestEntityHashes,
+    EntityHashes,
+    RequestResync,
+    Resync,
+    ResyncData,
     Max,
     Invalid = static_cast<uint32_t>(-1),
 };
@@ -49,10 +49,12 @@
     #include <netdb.h>
     #include <netinet/in.h>
     #include <netinet/tcp.h>
+    #include <poll.h>
     #include <sys/ioctl.h>
     #include <sys/select.h>
     #include <sys/socket.h>
     #include <sys/time.h>
+    #include <sys/uio.h>
     #include <unistd.h>
     #include "../common.h"
     using SOCKET = int32_t;
@@ -62,6 +64,8 @@
     #define closesocket close
     #define ioctlsocket ioctl
     #if defined(__linux__)
+        #include <sys/epoll.h>
+        #include <sys/eventfd.h>
         #define FLAG_NO_PIPE MSG_NOSIGNAL
     #else
         #define FLAG_NO_PIPE 0
@@ -572,6 +576,62 @@ public:
         return totalSent;
     }
 
+    size_t SendData(const SocketBuffer* buffers, size_t count) override
+    {
+        if (_status != SocketStatus::Connected)
+        {
+            throw std::runtime_error("Socket not connected.");
+        }
+
+        size_t totalSent = 0;
+        while (count > 0)
+        {
+            const size_t batchCount = std::min(count, MAX_SEND_BUFFERS);
+            size_t batchSize = 0;
+#    ifdef _WIN32
+            WSABUF batch[MAX_SEND_BUFFERS];
+            for (size_t i = 0; i < batchCount; i++)
+            {
+                batch[i].buf = const_cast<char*>(static_cast<const char*>(buffers[i].Data));
+                batch[i].len = static_cast<ULONG>(buffers[i].Size);
+                batchSize += buffers[i].Size;
+            }
+
+            DWORD sentBytes = 0;
+            if (WSASend(_socket, batch, static_cast<DWORD>(batchCount), &sentBytes, 0, nullptr, nullptr) == SOCKET_ERROR)
+            {
+                return totalSent;
+            }
+#    else
+            iovec batch[MAX_SEND_BUFFERS];
+            for (size_t i = 0; i < batchCount; i++)
+            {
+                batch[i].iov_base = const_cast<void*>(buffers[i].Data);
+                batch[i].iov_len = buffers[i].Size;
+                batchSize += buffers[i].Size;
+            }
+
+            msghdr message{};
+            message.msg_iov = batch;
+            message.msg_iovlen = batchCount;
+            ssize_t sentBytes = sendmsg(_socket, &message, FLAG_NO_PIPE);
+            if (sentBytes == SOCKET_ERROR)
+            {
+                return totalSent;
+            }
+#    endif
+            totalSent += sentBytes;
+            if (static_cast<size_t>(sentBytes) < batchSize)
+            {
+                // Send buffer is full, the rest has to wait.
+                return totalSent;
+            }
+            buffers += batchCount;
+            count -= batchCount;
+        }
+        return totalSent;
+    }
+
     NetworkReadPacket ReceiveData(void* buffer, size_t size, size_t* sizeReceived) override
     {
         if (_status != SocketStatus::Connected)
@@ -632,6 +692,11 @@ public:
         return _ipAddress;
     }
 
+    SOCKET GetHandle() const noexcept
+    {
+        return _socket;
+    }
+
 private:
     void CloseSocket()
     {
@@ -862,6 +927,272 @@ private:
     }
 };
 
+static SOCKET GetTcpSocketHandle(const ITcpSocket& socket)
+{
+    auto tcpSocket = dynamic_cast<const TcpSocket*>(&socket);
+    if (tcpSocket == nullptr || tcpSocket->GetHandle() == INVALID_SOCKET)
+    {
+        throw std::runtime_error("Socket can not be polled.");
+    }
+    return tcpSocket->GetHandle();
+}
+
+#    ifdef _WIN32
+using PollDescriptor = WSAPOLLFD;
+#        define POLL_SOCKETS WSAPoll
+#    else
+using PollDescriptor = pollfd;
+#        define POLL_SOCKETS poll
+#    endif
+
+class PollSocketPoller final : public ISocketPoller, protected Socket
+{
+private:
+    // Index 0 is the wake socket.
+    std::vector<PollDescriptor> _descriptors;
+    std::vector<void*> _userData;
+    SOCKET _wakeSocket = INVALID_SOCKET;
+
+public:
+    PollSocketPoller()
+    {
+        if (!InitialiseWSA())
+        {
+            throw SocketException("Unable to initialise sockets.");
+        }
+
+        // A datagram socket connected to itself, sending to it interrupts a poll in progress
+        sockaddr_in address{};
+        address.sin_family = AF_INET;
+        address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+        socklen_t addressLen = sizeof(address);
+        _wakeSocket = socket(AF_INET, SOCK_DGRAM, IPPROTO_UDP);
+        if (_wakeSocket == INVALID_SOCKET || bind(_wakeSocket, reinterpret_cast<sockaddr*>(&address), addressLen) != 0
+            || getsockname(_wakeSocket, reinterpret_cast<sockaddr*>(&address), &addressLen) != 0
+            || connect(_wakeSocket, reinterpret_cast<sockaddr*>(&address), addressLen) != 0
+            || !SetNonBlocking(_wakeSocket, true))
+        {
+            if (_wakeSocket != INVALID_SOCKET)
+            {
+                closesocket(_wakeSocket);
+            }
+            throw SocketException("Unable to create wake socket.");
+        }
+
+        _descriptors.push_back({ _wakeSocket, POLLIN, 0 });
+        _userData.push_back(nullptr);
+    }
+
+    ~PollSocketPoller() override
+    {
+        closesocket(_wakeSocket);
+    }
+
+    void Add(ITcpSocket& socket, void* userData) override
+    {
+        _descriptors.push_back({ GetTcpSocketHandle(socket), POLLIN, 0 });
+        _userData.push_back(userData);
+    }
+
+    void Modify(ITcpSocket& socket, void* userData, bool read, bool write) override
+    {
+        auto index = FindDescriptor(GetTcpSocketHandle(socket));
+        if (index != 0)
+        {
+            short events = 0;
+            if (read)
+            {
+                events |= POLLIN;
+            }
+            if (write)
+            {
+                events |= POLLOUT;
+            }
+            _descriptors[index].events = events;
+            _userData[index] = userData;
+        }
+    }
+
+    void Remove(ITcpSocket& socket) override
+    {
+        auto index = FindDescriptor(GetTcpSocketHandle(socket));
+        if (index != 0)
+        {
+            _descriptors[index] = _descriptors.back();
+            _descriptors.pop_back();
+            _userData[index] = _userData.back();
+            _userData.pop_back();
+        }
+    }
+
+    void Wait(std::vector<SocketPollEvent>& events, int32_t timeoutMs) override
+    {
+        events.clear();
+        auto count = POLL_SOCKETS(_descriptors.data(), static_cast<uint32_t>(_descriptors.size()), timeoutMs);
+        if (count <= 0)
+        {
+            return;
+        }
+
+        for (size_t i = 0; i < _descriptors.size(); i++)
+        {
+            const auto revents = _descriptors[i].revents;
+            if (revents == 0)
+            {
+                continue;
+            }
+
+            if (i == 0)
+            {
+                char buffer[64];
+                while (recv(_wakeSocket, buffer, sizeof(buffer), 0) > 0)
+                {
+                }
+                continue;
+            }
+
+            events.push_back({ _userData[i], (revents & (POLLIN | POLLHUP)) != 0, (revents & POLLOUT) != 0,
+                               (revents & (POLLERR | POLLNVAL)) != 0 });
+        }
+    }
+
+    void Wake() override
+    {
+        char value = 0;
+        send(_wakeSocket, &value, sizeof(value), FLAG_NO_PIPE);
+    }
+
+private:
+    size_t FindDescriptor(SOCKET handle) const
+    {
+        for (size_t i = 1; i < _descriptors.size(); i++)
+        {
+            if (_descriptors[i].fd == handle)
+            {
+                return i;
+            }
+        }
+        return 0;
+    }
+};
+
+#    ifdef __linux__
+class EpollSocketPoller final : public ISocketPoller
+{
+private:
+    int _epoll = -1;
+    int _wakeFd = -1;
+    std::vector<epoll_event> _events;
+
+public:
+    EpollSocketPoller()
+    {
+        _epoll = epoll_create1(EPOLL_CLOEXEC);
+        if (_epoll == -1)
+        {
+            throw SocketException("Unable to create epoll instance.");
+        }
+
+        _wakeFd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+        epoll_event ev{};
+        ev.events = EPOLLIN;
+        ev.data.ptr = nullptr;
+        if (_wakeFd == -1 || epoll_ctl(_epoll, EPOLL_CTL_ADD, _wakeFd, &ev) != 0)
+        {
+            if (_wakeFd != -1)
+            {
+                close(_wakeFd);
+            }
+            close(_epoll);
+            throw SocketException("Unable to create wake event.");
+        }
+
+        _events.resize(256);
+    }
+
+    ~EpollSocketPoller() override
+    {
+        close(_wakeFd);
+        close(_epoll);
+    }
+
+    void Add(ITcpSocket& socket, void* userData) override
+    {
+        epoll_event ev{};
+        ev.events = EPOLLIN | EPOLLRDHUP;
+        ev.data.ptr = userData;
+        if (epoll_ctl(_epoll, EPOLL_CTL_ADD, GetTcpSocketHandle(socket), &ev) != 0)
+        {
+            throw SocketException("Unable to add socket to epoll instance.");
+        }
+    }
+
+    void Modify(ITcpSocket& socket, void* userData, bool read, bool write) override
+    {
+        epoll_event ev{};
+        if (read)
+        {
+            ev.events |= EPOLLIN | EPOLLRDHUP;
+        }
+        if (write)
+        {
+            ev.events |= EPOLLOUT;
+        }
+        ev.data.ptr = userData;
+        if (epoll_ctl(_epoll, EPOLL_CTL_MOD, GetTcpSocketHandle(socket), &ev) != 0)
+        {
+            throw SocketException("Unable to modify socket in epoll instance.");
+        }
+    }
+
+    void Remove(ITcpSocket& socket) override
+    {
+        epoll_event ev{};
+        epoll_ctl(_epoll, EPOLL_CTL_DEL, GetTcpSocketHandle(socket), &ev);
+    }
+
+    void Wait(std::vector<SocketPollEvent>& events, int32_t timeoutMs) override
+    {
+        events.clear();
+        auto count = epoll_wait(_epoll, _events.data(), static_cast<int>(_events.size()), timeoutMs);
+        for (int i = 0; i < count; i++)
+        {
+            const auto& ev = _events[i];
+            if (ev.data.ptr == nullptr)
+            {
+                uint64_t value;
+                [[maybe_unused]] auto result = read(_wakeFd, &value, sizeof(value));
+                continue;
+            }
+
+            events.push_back({ ev.data.ptr, (ev.events & (EPOLLIN | EPOLLRDHUP)) != 0, (ev.events & EPOLLOUT) != 0,
+                               (ev.events & (EPOLLERR | EPOLLHUP)) != 0 });
+        }
+    }
+
+    void Wake() override
+    {
+        uint64_t value = 1;
+        [[maybe_unused]] auto result = write(_wakeFd, &value, sizeof(value));
+    }
+};
+#    endif
+
+std::unique_ptr<ISocketPoller> CreateSocketPoller()
+{
+#    ifdef __linux__
+    try
+    {
+        return std::make_unique<EpollSocketPoller>();
+    }
+    catch (const std::exception& e)
+    {
+        LOG_WARNING("%s Falling back to poll.", e.what());
+    }
+#    endif
+    return std::make_unique<PollSocketPoller>();
+}
+
 std::unique_ptr<ITcpSocket> CreateTcpSocket()
 {
     InitialiseWSA();
@@ -45,6 +45,18 @@ struct INetworkEndpoint
     virtual std::string GetHostname() const abstract;
 };
 
+/**
+ * A buffer to be sent as part of a gathered write.
+ */
+struct SocketBuffer
+{
+    const void* Data;
+    size_t Size;
+};
+
+// Most buffers sent with a single system call, matches the smallest IOV_MAX allowed by POSIX.
+constexpr size_t MAX_SEND_BUFFERS = 16;
+
 /**
  * Represents a TCP socket / connection or listener.
  */
@@ -66,6 +78,8 @@ public:
     virtual void ConnectAsync(const std::string& address, uint16_t port) abstract;
 
     virtual size_t SendData(const void* buffer, size_t size) abstract;
+    // Sends the buffers back to back with as few system calls as possible, returns the total number of bytes sent.
+    virtual size_t SendData(const SocketBuffer* buffers, size_t count) abstract;
     virtual NetworkReadPacket ReceiveData(void* buffer, size_t size, size_t* sizeReceived) abstract;
 
     virtual void SetNoDelay(bool noDelay) abstract;
@@ -98,9 +112,35 @@ public:
     virtual void Close() abstract;
 };
 
+struct SocketPollEvent
+{
+    void* UserData;
+    bool Readable;
+    bool Writable;
+    bool Closed;
+};
+
+/**
+ * Waits for activity on a set of TCP sockets. Only Wake may be called from a thread other than the one waiting.
+ */
+struct ISocketPoller
+{
+public:
+    virtual ~ISocketPoller() = default;
+
+    virtual void Add(ITcpSocket& socket, void* userData) abstract;
+    virtual void Modify(ITcpSocket& socket, void* userData, bool read, bool write) abstract;
+    virtual void Remove(ITcpSocket& socket) abstract;
+
+    // Blocks until a socket is ready, Wake is called or the timeout (-1 for none) expires.
+    virtual void Wait(std::vector<SocketPollEvent>& events, int32_t timeoutMs) abstract;
+    virtual void Wake() abstract;
+};
+
 [[nodiscard]] std::unique_ptr<ITcpSocket> CreateTcpSocket();
 [[nodiscard]] std::unique_ptr<IUdpSocket> CreateUdpSocket();
 [[nodiscard]] std::vector<std::unique_ptr<INetworkEndpoint>> GetBroadcastAddresses();
+[[nodiscard]] std::unique_ptr<ISocketPoller> CreateSocketPoller();
 
 namespace Convert
 {
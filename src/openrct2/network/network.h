@@ -47,6 +47,7 @@ bool NetworkIsDesynchronised();
 bool NetworkCheckDesynchronisation();
 void NetworkRequestGamestateSnapshot();
 void NetworkSendTick();
+void NetworkRelayTick();
 bool NetworkGamestateSnapshotsEnabled();
 void NetworkUpdate();
 void NetworkProcessPending();
@@ -98,6 +99,7 @@ void NetworkSetPickupPeepOldX(uint8_t playerid, int32_t x);
 
 void NetworkSendChat(const char* text, const std::vector<uint8_t>& playerIds = {});
 void NetworkSendGameAction(const GameAction* action);
+void NetworkRelayGameAction(const GameAction* action);
 void NetworkSendPassword(const std::string& password);
 
 void NetworkSetPassword(const char* password);
@@ -116,3 +118,4 @@ void NetworkAppendServerLog(const utf8* text);
 [[nodiscard]] NetworkStats NetworkGetStats();
 [[nodiscard]] NetworkServerState NetworkGetServerState();
 [[nodiscard]] json_t NetworkGetServerInfoAsJson();
+[[nodiscard]] json_t NetworkGetTelemetryAsJson();
@@ -12,6 +12,7 @@
 #include "../Context.h"
 #include "../OpenRCT2.h"
 #include "../PlatformEnvironment.h"
+#include "../config/Config.h"
 #include "../core/File.h"
 #include "../core/FileScanner.h"
 #include "../core/IStream.hpp"
@@ -24,7 +25,9 @@
 #include "ObjectFactory.h"
 
 #include <algorithm>
+#include <cstring>
 #include <memory>
+#include <optional>
 #include <stdexcept>
 
 using namespace OpenRCT2;
@@ -32,10 +35,39 @@ using namespace OpenRCT2::Drawing;
 
 static thread_local std::map<u8string, std::unique_ptr<Object>> _objDataCache = {};
 
+struct ImageTable::LazySource
+{
+    std::string Path;
+    std::vector<uint8_t> Data;
+    IMAGE_FORMAT Format{};
+    uint32_t Width{};
+    uint32_t Height{};
+    // Paletted or greyscale, these are read with one byte per pixel.
+    bool Paletted{};
+
+    // Kept while a batch of images is decoded from the same source, released by ReleaseLoadCache.
+    std::optional<Image> Decoded;
+};
+
+struct ImageTable::LazyImage
+{
+    LazySource* Source{};
+    int16_t SrcX{};
+    int16_t SrcY{};
+    int16_t SrcWidth{};
+    int16_t SrcHeight{};
+    int16_t X{};
+    int16_t Y{};
+    ImageImporter::Palette Palette{};
+    ImageImporter::ImportFlags Flags{};
+    std::vector<uint8_t> Data;
+};
+
 struct ImageTable::RequiredImage
 {
     G1Element g1{};
     std::unique_ptr<RequiredImage> next_zoom;
+    std::unique_ptr<LazyImage> lazy;
 
     bool HasData() const
     {
@@ -237,6 +269,82 @@ std::vector<std::unique_ptr<ImageTable::RequiredImage>> ImageTable::ParseImages(
     return result;
 }
 
+std::unique_ptr<ImageTable::RequiredImage> ImageTable::ParseLazyImage(IReadObjectContext* context, json_t& el)
+{
+    Guard::Assert(el.is_object(), "ImageTable::ParseLazyImage expects parameter el to be object");
+
+    auto path = Json::GetString(el["path"]);
+    auto x = Json::GetNumber<int16_t>(el["x"]);
+    auto y = Json::GetNumber<int16_t>(el["y"]);
+    auto srcX = Json::GetNumber<int16_t>(el["srcX"]);
+    auto srcY = Json::GetNumber<int16_t>(el["srcY"]);
+    auto srcWidth = Json::GetNumber<int16_t>(el["srcWidth"]);
+    auto srcHeight = Json::GetNumber<int16_t>(el["srcHeight"]);
+    auto raw = Json::GetString(el["format"]) == "raw";
+    auto keepPalette = Json::GetString(el["palette"]) == "keep";
+    auto zoomOffset = Json::GetNumber<int32_t>(el["zoom"]);
+
+    auto result = std::make_unique<RequiredImage>();
+    auto logError = [&](const char* error) {
+        auto msg = String::StdFormat("Unable to load image '%s': %s", path.c_str(), error);
+        context->LogWarning(ObjectError::BadImageTable, msg.c_str());
+    };
+
+    auto itSource = std::find_if(_lazySources.begin(), _lazySources.end(), [&path](const std::unique_ptr<LazySource>& item) {
+        return item->Path == path;
+    });
+    if (itSource == _lazySources.end())
+    {
+        logError("Unable to find image in image source list.");
+        return result;
+    }
+    auto* source = itSource->get();
+
+    if (srcWidth == 0)
+        srcWidth = source->Width;
+
+    if (srcHeight == 0)
+        srcHeight = source->Height;
+
+    // Validate what the importer would reject up front so errors are still reported while loading the object
+    if (srcWidth > 256 || srcHeight > 256)
+    {
+        logError("Only images 256x256 or less are supported.");
+        return result;
+    }
+    if (keepPalette && !source->Paletted)
+    {
+        logError("Image is not paletted, it has bit depth of 32");
+        return result;
+    }
+    // A source is decoded once, so all images cut from it have to agree on keeping its palette.
+    if (source->Format != (keepPalette ? IMAGE_FORMAT::PNG : IMAGE_FORMAT::PNG_32))
+    {
+        logError("Image is used both with and without keeping its palette.");
+        return result;
+    }
+
+    auto lazy = std::make_unique<LazyImage>();
+    lazy->Source = source;
+    lazy->SrcX = srcX;
+    lazy->SrcY = srcY;
+    lazy->SrcWidth = srcWidth;
+    lazy->SrcHeight = srcHeight;
+    lazy->X = x;
+    lazy->Y = y;
+    lazy->Palette = keepPalette ? ImageImporter::Palette::KeepIndices : ImageImporter::Palette::OpenRCT2;
+    lazy->Flags = raw ? ImageImporter::ImportFlags::None : ImageImporter::ImportFlags::RLE;
+
+    result->g1.width = srcWidth;
+    result->g1.height = srcHeight;
+    result->g1.x_offset = x;
+    result->g1.y_offset = y;
+    result->g1.flags = raw ? G1_FLAG_HAS_TRANSPARENCY : G1_FLAG_RLE_COMPRESSION;
+    result->g1.zoomed_offset = zoomOffset;
+    result->lazy = std::move(lazy);
+    return result;
+}
+
 std::vector<std::unique_ptr<ImageTable::RequiredImage>> ImageTable::LoadImageArchiveImages(
     IReadObjectContext* context, const std::string& path, const std::vector<int32_t>& range)
 {
@@ -426,6 +534,8 @@ std::string ImageTable::FindLegacyObject(const std::string& name)
     return objectPath;
 }
 
+ImageTable::ImageTable() = default;
+
 ImageTable::~ImageTable()
 {
     if (_data == nullptr)
@@ -531,6 +641,58 @@ std::vector<std::pair<std::string, Image>> ImageTable::GetImageSources(IReadObje
     return result;
 }
 
+static bool TryReadPngHeader(const std::vector<uint8_t>& data, uint32_t& width, uint32_t& height, bool& paletted)
+{
+    static constexpr uint8_t kPngSignature[] = { 0x89, 'P', 'N', 'G', '\r', '\n', 0x1A, '\n' };
+    static constexpr uint8_t kPngColourTypeGreyscale = 0;
+    static constexpr uint8_t kPngColourTypePalette = 3;
+    if (data.size() < 26 || std::memcmp(data.data(), kPngSignature, sizeof(kPngSignature)) != 0
+        || std::memcmp(data.data() + 12, "IHDR", 4) != 0)
+    {
+        return false;
+    }
+
+    auto readUInt32 = [&data](size_t offset) {
+        return (static_cast<uint32_t>(data[offset]) << 24) | (static_cast<uint32_t>(data[offset + 1]) << 16)
+            | (static_cast<uint32_t>(data[offset + 2]) << 8) | static_cast<uint32_t>(data[offset + 3]);
+    };
+    width = readUInt32(16);
+    height = readUInt32(20);
+    paletted = data[25] == kPngColourTypePalette || data[25] == kPngColourTypeGreyscale;
+    return true;
+}
+
+void ImageTable::AddLazySources(IReadObjectContext* context, json_t& jsonImages)
+{
+    for (auto& jsonImage : jsonImages)
+    {
+        if (!jsonImage.is_object())
+            continue;
+
+        auto path = Json::GetString(jsonImage["path"]);
+        auto keepPalette = Json::GetString(jsonImage["palette"]) == "keep";
+        auto itSource = std::find_if(
+            _lazySources.begin(), _lazySources.end(),
+            [&path](const std::unique_ptr<LazySource>& item) { return item->Path == path; });
+        if (itSource != _lazySources.end())
+            continue;
+
+        auto source = std::make_unique<LazySource>();
+        source->Data = context->GetData(path);
+        source->Format = keepPalette ? IMAGE_FORMAT::PNG : IMAGE_FORMAT::PNG_32;
+        if (!TryReadPngHeader(source->Data, source->Width, source->Height, source->Paletted))
+        {
+            // Size can not be read from the header, decode it now which also reports broken images like an eager load
+            auto image = Imaging::ReadFromBuffer(source->Data, source->Format);
+            source->Width = image.Width;
+            source->Height = image.Height;
+            source->Paletted = keepPalette;
+        }
+        source->Path = std::move(path);
+        _lazySources.push_back(std::move(source));
+    }
+}
+
 bool ImageTable::ReadJson(IReadObjectContext* context, json_t& root)
 {
     Guard::Assert(root.is_object(), "ImageTable::ReadJson expects parameter root to be object");
@@ -548,7 +710,18 @@ bool ImageTable::ReadJson(IReadObjectContext* context, json_t& root)
             usesFallbackSprites = true;
         }
 
-        auto imageSources = GetImageSources(context, jsonImages);
+        // Images cut from PNG sources are decoded the first time they are drawn, headless instances (e.g. sprite
+        // export) need the pixel data in the table straight away.
+        const bool lazyLoad = gConfigGeneral.LazyLoadImages && !gOpenRCT2Headless;
+        std::vector<std::pair<std::string, Image>> imageSources;
+        if (lazyLoad)
+        {
+            AddLazySources(context, jsonImages);
+        }
+        else
+        {
+            imageSources = GetImageSources(context, jsonImages);
+        }
 
         for (auto& jsonImage : jsonImages)
         {
@@ -559,6 +732,10 @@ bool ImageTable::ReadJson(IReadObjectContext* context, json_t& root)
                 allImages.insert(
                     allImages.end(), std::make_move_iterator(images.begin()), std::make_move_iterator(images.end()));
             }
+            else if (jsonImage.is_object() && lazyLoad)
+            {
+                allImages.push_back(ParseLazyImage(context, jsonImage));
+            }
             else if (jsonImage.is_object())
             {
                 auto images = ParseImages(context, imageSources, jsonImage);
@@ -571,6 +748,13 @@ bool ImageTable::ReadJson(IReadObjectContext* context, json_t& root)
         auto imagesStartIndex = GetCount();
         for (const auto& img : allImages)
         {
+            if (img->lazy != nullptr)
+            {
+                _lazyImages.resize(_entries.size());
+                _lazyImages.push_back(std::move(img->lazy));
+                _entries.push_back(img->g1);
+                continue;
+            }
             const auto& g1 = img->g1;
             AddImage(&g1);
         }
@@ -623,3 +807,60 @@ void ImageTable::AddImage(const G1Element* g1)
     }
     _entries.push_back(std::move(newg1));
 }
+
+bool ImageTable::IsImageLazy(uint32_t index) const
+{
+    return index < _lazyImages.size() && _lazyImages[index] != nullptr;
+}
+
+size_t ImageTable::LoadImageData(uint32_t index, G1Element& element)
+{
+    if (!IsImageLazy(index))
+    {
+        return 0;
+    }
+
+    auto& lazy = *_lazyImages[index];
+    auto& source = *lazy.Source;
+    try
+    {
+        if (!source.Decoded.has_value())
+        {
+            source.Decoded = Imaging::ReadFromBuffer(source.Data, source.Format);
+        }
+
+        ImageImporter importer;
+        auto importResult = importer.Import(
+            *source.Decoded, lazy.SrcX, lazy.SrcY, lazy.SrcWidth, lazy.SrcHeight, lazy.X, lazy.Y, lazy.Palette, lazy.Flags);
+        lazy.Data = std::move(importResult.Buffer);
+    }
+    catch (const std::exception& e)
+    {
+        LOG_WARNING("Unable to load image '%s': %s", source.Path.c_str(), e.what());
+        return 0;
+    }
+
+    element.offset = lazy.Data.data();
+    return lazy.Data.size();
+}
+
+size_t ImageTable::UnloadImageData(uint32_t index)
+{
+    if (!IsImageLazy(index))
+    {
+        return 0;
+    }
+
+    auto& data = _lazyImages[index]->Data;
+    auto size = data.size();
+    data = {};
+    return size;
+}
+
+void ImageTable::ReleaseLoadCache()
+{
+    for (auto& source : _lazySources)
+    {
+        source->Decoded.reset();
+    }
+}
@@ -23,17 +23,26 @@ namespace OpenRCT2
     struct IStream;
 }
 
-class ImageTable
+class ImageTable final : public ILazyImageSource
 {
 private:
     std::unique_ptr<uint8_t[]> _data;
     std::vector<G1Element> _entries;
 
+    /**
+     * Images from PNG sources are only decoded when first drawn, see ILazyImageSource.
+     */
+    struct LazySource;
+    struct LazyImage;
+    std::vector<std::unique_ptr<LazySource>> _lazySources;
+    std::vector<std::unique_ptr<LazyImage>> _lazyImages;
+
     /**
      * Container for a G1 image, additional information and RAII. Used by ReadJson
      */
     struct RequiredImage;
     [[nodiscard]] std::vector<std::pair<std::string, Image>> GetImageSources(IReadObjectContext* context, json_t& jsonImages);
+    void AddLazySources(IReadObjectContext* context, json_t& jsonImages);
     [[nodiscard]] static std::vector<std::unique_ptr<ImageTable::RequiredImage>> ParseImages(
         IReadObjectContext* context, std::string s);
     /**
@@ -41,6 +50,7 @@ private:
      */
     [[nodiscard]] static std::vector<std::unique_ptr<ImageTable::RequiredImage>> ParseImages(
         IReadObjectContext* context, std::vector<std::pair<std::string, Image>>& imageSources, json_t& el);
+    [[nodiscard]] std::unique_ptr<ImageTable::RequiredImage> ParseLazyImage(IReadObjectContext* context, json_t& el);
     [[nodiscard]] static std::vector<std::unique_ptr<ImageTable::RequiredImage>> LoadObjectImages(
         IReadObjectContext* context, const std::string& name, const std::vector<int32_t>& range);
     [[nodiscard]] static std::vector<int32_t> ParseRange(std::string s);
@@ -49,10 +59,10 @@ private:
         IReadObjectContext* context, const std::string& path, const std::vector<int32_t>& range = {});
 
 public:
-    ImageTable() = default;
+    ImageTable();
     ImageTable(const ImageTable&) = delete;
     ImageTable& operator=(const ImageTable&) = delete;
-    ~ImageTable();
+    ~ImageTable() override;
 
     void Read(IReadObjectContext* context, OpenRCT2::IStream* stream);
     /**
@@ -68,4 +78,13 @@ public:
         return static_cast<uint32_t>(_entries.size());
     }
     void AddImage(const G1Element* g1);
+
+    bool HasLazyImages() const
+    {
+        return !_lazySources.empty();
+    }
+    bool IsImageLazy(uint32_t index) const override;
+    size_t LoadImageData(uint32_t index, G1Element& element) override;
+    size_t UnloadImageData(uint32_t index) override;
+    void ReleaseLoadCache() override;
 };
@@ -209,7 +209,9 @@ ImageIndex Object::LoadImages()
 {
     if (_baseImageId == ImageIndexUndefined)
     {
-        _baseImageId = GfxObjectAllocateImages(GetImageTable().GetImages(), GetImageTable().GetCount());
+        auto& imageTable = GetImageTable();
+        _baseImageId = GfxObjectAllocateImages(
+            imageTable.GetImages(), imageTable.GetCount(), imageTable.HasLazyImages() ? &imageTable : nullptr);
     }
     return _baseImageId;
 }
@@ -92,6 +92,7 @@ namespace OpenRCT2
         constexpr uint32_t CHEATS               = 0x36;
         constexpr uint32_t RESTRICTED_OBJECTS   = 0x37;
         constexpr uint32_t PLUGIN_STORAGE       = 0x38;
+        constexpr uint32_t PLUGIN_STORAGE_DATA  = 0x39;
         constexpr uint32_t PACKED_OBJECTS       = 0x80;
         // clang-format on
     }; // namespace ParkFileChunkType
@@ -659,25 +660,47 @@ namespace OpenRCT2
             if (os.GetMode() == OrcaStream::Mode::WRITING)
             {
 #ifdef ENABLE_SCRIPTING
-                // Dump the plugin storage to JSON (stored in park)
-                auto& scriptEngine = GetContext()->GetScriptEngine();
-                park.PluginStorage = scriptEngine.GetParkStorageAsJSON();
+                // Records of values that have not been set since the park was loaded are written as they were read
+                auto& parkStorage = GetContext()->GetScriptEngine().GetParkStorage();
+                park.PluginStorage = {};
+                park.PluginStorageData = parkStorage.IsEmpty() ? std::vector<uint8_t>() : parkStorage.Write();
 #endif
-                if (park.PluginStorage.empty() || park.PluginStorage == "{}")
-                {
-                    // Don't write the chunk if there is no plugin storage
-                    return;
-                }
+            }
+            else
+            {
+                park.PluginStorage = {};
+                park.PluginStorageData = {};
             }
 
-            os.ReadWriteChunk(
-                ParkFileChunkType::PLUGIN_STORAGE, [&park](OrcaStream::ChunkStream& cs) { cs.ReadWrite(park.PluginStorage); });
+            // Parks saved by older versions have their storage as JSON
+            if (os.GetMode() == OrcaStream::Mode::READING || !(park.PluginStorage.empty() || park.PluginStorage == "{}"))
+            {
+                os.ReadWriteChunk(ParkFileChunkType::PLUGIN_STORAGE, [&park](OrcaStream::ChunkStream& cs) {
+                    cs.ReadWrite(park.PluginStorage);
+                });
+            }
+            if (os.GetMode() == OrcaStream::Mode::READING || !park.PluginStorageData.empty())
+            {
+                os.ReadWriteChunk(ParkFileChunkType::PLUGIN_STORAGE_DATA, [&park](OrcaStream::ChunkStream& cs) {
+                    auto size = static_cast<uint32_t>(park.PluginStorageData.size());
+                    cs.ReadWrite(size);
+                    park.PluginStorageData.resize(size);
+                    cs.ReadWrite(park.PluginStorageData.data(), size);
+                });
+            }
 
             if (os.GetMode() == OrcaStream::Mode::READING)
             {
 #ifdef ENABLE_SCRIPTING
                 auto& scriptEngine = GetContext()->GetScriptEngine();
-                scriptEngine.SetParkStorageFromJSON(park.PluginStorage);
+                if (!park.PluginStorageData.empty())
+                {
+                    scriptEngine.GetParkStorage().Read(park.PluginStorageData.data(), park.PluginStorageData.size());
+                }
+                else if (!park.PluginStorage.empty())
+                {
+                    scriptEngine.SetParkStorageFromJSON(park.PluginStorage);
+                }
 #endif
             }
         }
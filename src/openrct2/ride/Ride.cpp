@@ -62,6 +62,7 @@
 #include "../world/MapAnimation.h"
 #include "../world/Park.h"
 #include "../world/Scenery.h"
+#include "../world/TileChangeJournal.h"
 #include "../world/TileElementsView.h"
 #include "CableLift.h"
 #include "RideAudio.h"
@@ -5703,6 +5704,7 @@ void RideClearLeftoverEntrances(const Ride& ride)
                     continue;
 
                 TileElementRemove(entrance->as<TileElement>());
+                GetTileChangeJournal().MarkTile(tilePos);
             }
         }
     }
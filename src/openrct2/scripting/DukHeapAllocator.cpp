@@ -0,0 +1,312 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2024 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#ifdef ENABLE_SCRIPTING
+
+#    include "DukHeapAllocator.h"
+
+#    include "../platform/Platform.h"
+
+#    include <algorithm>
+#    include <cstdlib>
+#    include <cstring>
+#    include <limits>
+#    include <stdexcept>
+
+using namespace OpenRCT2::Scripting;
+
+// Precedes every allocation, keeps the returned memory aligned as malloc would.
+struct alignas(std::max_align_t) DukHeapBlockHeader
+{
+    uint32_t Size;
+    DukHeapOwner Owner;
+    uint8_t SizeClass;
+};
+
+static constexpr uint8_t SYSTEM_SIZE_CLASS = std::numeric_limits<uint8_t>::max();
+
+static DukHeapBlockHeader* GetHeader(void* ptr)
+{
+    return static_cast<DukHeapBlockHeader*>(ptr) - 1;
+}
+
+DukHeapAllocator::DukHeapAllocator()
+    : _owners(1)
+{
+}
+
+DukHeapOwner DukHeapAllocator::AddOwner()
+{
+    auto it = std::find_if(_removedOwners.begin(), _removedOwners.end(), [this](DukHeapOwner owner) {
+        return _owners[owner].LiveBytes == 0;
+    });
+    if (it != _removedOwners.end())
+    {
+        const auto owner = *it;
+        _removedOwners.erase(it);
+        _owners[owner] = {};
+        return owner;
+    }
+
+    if (_owners.size() > std::numeric_limits<DukHeapOwner>::max())
+    {
+        throw std::runtime_error("Too many plugins for the script heap.");
+    }
+    _owners.emplace_back();
+    return static_cast<DukHeapOwner>(_owners.size() - 1);
+}
+
+void DukHeapAllocator::RemoveOwner(DukHeapOwner owner)
+{
+    if (owner == DUK_HEAP_OWNER_NONE)
+    {
+        return;
+    }
+    if (_currentOwner == owner)
+    {
+        _currentOwner = DUK_HEAP_OWNER_NONE;
+    }
+    _removedOwners.push_back(owner);
+}
+
+void DukHeapAllocator::SetOwner(DukHeapOwner owner) noexcept
+{
+    _currentOwner = owner;
+}
+
+const DukHeapStats& DukHeapAllocator::GetStats(DukHeapOwner owner) const
+{
+    return _owners[owner];
+}
+
+void DukHeapAllocator::SetLimit(uint64_t limit) noexcept
+{
+    _limit = limit;
+}
+
+void DukHeapAllocator::Update()
+{
+    const auto now = Platform::GetTicks();
+    const auto elapsed = now - _lastRateUpdate;
+    if (elapsed < 1000)
+    {
+        return;
+    }
+
+    _lastRateUpdate = now;
+    for (auto& stats : _owners)
+    {
+        stats.AllocationRate = static_cast<uint32_t>((stats.Allocations - stats.LastAllocations) * 1000 / elapsed);
+        stats.AllocatedBytesRate = (stats.AllocatedBytes - stats.LastAllocatedBytes) * 1000 / elapsed;
+        stats.LastAllocations = stats.Allocations;
+        stats.LastAllocatedBytes = stats.AllocatedBytes;
+    }
+}
+
+void DukHeapAllocator::SetInterrupt(const std::atomic_bool* interrupt) noexcept
+{
+    _interrupt = interrupt;
+}
+
+bool DukHeapAllocator::IsInterrupted() const noexcept
+{
+    return _interrupt != nullptr && *_interrupt;
+}
+
+size_t DukHeapAllocator::GetReservedBytes() const noexcept
+{
+    return _chunks.size() * ChunkSize;
+}
+
+uint64_t DukHeapAllocator::GetPooledAllocations() const noexcept
+{
+    return _pooledAllocations;
+}
+
+uint64_t DukHeapAllocator::GetSystemAllocations() const noexcept
+{
+    return _systemAllocations;
+}
+
+void* DukHeapAllocator::Alloc(void* udata, size_t size)
+{
+    auto allocator = static_cast<DukHeapAllocator*>(udata);
+    auto owner = allocator->_currentOwner;
+    if (allocator->IsOverLimit(owner, size))
+    {
+        allocator->_owners[owner].FailedAllocations++;
+        return nullptr;
+    }
+    return allocator->Allocate(size, owner);
+}
+
+void* DukHeapAllocator::Realloc(void* udata, void* ptr, size_t size)
+{
+    return static_cast<DukHeapAllocator*>(udata)->Reallocate(ptr, size);
+}
+
+void DukHeapAllocator::Free(void* udata, void* ptr)
+{
+    static_cast<DukHeapAllocator*>(udata)->Release(ptr);
+}
+
+void* DukHeapAllocator::Allocate(size_t size, DukHeapOwner owner)
+{
+    if (size == 0 || size > std::numeric_limits<uint32_t>::max())
+    {
+        return nullptr;
+    }
+
+    DukHeapBlockHeader* header{};
+    auto sizeClass = GetSizeClass(size);
+    if (sizeClass < SizeClasses.size())
+    {
+        header = static_cast<DukHeapBlockHeader*>(AllocateBlock(sizeClass));
+        _pooledAllocations++;
+    }
+    else
+    {
+        header = static_cast<DukHeapBlockHeader*>(std::malloc(sizeof(DukHeapBlockHeader) + size));
+        if (header == nullptr)
+        {
+            return nullptr;
+        }
+        sizeClass = SYSTEM_SIZE_CLASS;
+        _systemAllocations++;
+    }
+    header->Size = static_cast<uint32_t>(size);
+    header->Owner = owner;
+    header->SizeClass = static_cast<uint8_t>(sizeClass);
+
+    auto& stats = _owners[owner];
+    stats.LiveBytes += size;
+    stats.PeakBytes = std::max(stats.PeakBytes, stats.LiveBytes);
+    stats.Allocations++;
+    stats.AllocatedBytes += size;
+    return header + 1;
+}
+
+void DukHeapAllocator::Release(void* ptr)
+{
+    if (ptr == nullptr)
+    {
+        return;
+    }
+
+    auto header = GetHeader(ptr);
+    _owners[header->Owner].LiveBytes -= header->Size;
+    const auto sizeClass = header->SizeClass;
+    if (sizeClass == SYSTEM_SIZE_CLASS)
+    {
+        std::free(header);
+    }
+    else
+    {
+        // The block's link overwrites the header.
+        auto block = reinterpret_cast<FreeBlock*>(header);
+        block->Next = _freeBlocks[sizeClass];
+        _freeBlocks[sizeClass] = block;
+    }
+}
+
+void* DukHeapAllocator::Reallocate(void* ptr, size_t size)
+{
+    if (ptr == nullptr)
+    {
+        return Alloc(this, size);
+    }
+    if (size == 0)
+    {
+        Release(ptr);
+        return nullptr;
+    }
+
+    // The memory stays with whoever allocated it first.
+    auto header = GetHeader(ptr);
+    auto owner = header->Owner;
+    auto& stats = _owners[owner];
+    if (size > header->Size && IsOverLimit(owner, size - header->Size))
+    {
+        stats.FailedAllocations++;
+        return nullptr;
+    }
+
+    // Blocks are big enough for anything in their size class.
+    if (header->SizeClass != SYSTEM_SIZE_CLASS && size <= SizeClasses[header->SizeClass])
+    {
+        stats.LiveBytes = stats.LiveBytes - header->Size + size;
+        stats.PeakBytes = std::max(stats.PeakBytes, stats.LiveBytes);
+        header->Size = static_cast<uint32_t>(size);
+        return ptr;
+    }
+
+    auto newPtr = Allocate(size, owner);
+    if (newPtr != nullptr)
+    {
+        std::memcpy(newPtr, ptr, std::min<size_t>(header->Size, size));
+        Release(ptr);
+    }
+    return newPtr;
+}
+
+void* DukHeapAllocator::AllocateBlock(size_t sizeClass)
+{
+    if (_freeBlocks[sizeClass] == nullptr)
+    {
+        AddChunk(sizeClass);
+    }
+    auto block = _freeBlocks[sizeClass];
+    _freeBlocks[sizeClass] = block->Next;
+    return block;
+}
+
+void DukHeapAllocator::AddChunk(size_t sizeClass)
+{
+    // Chunks are kept until the heap is gone, the blocks are reused for the same size class.
+    auto& chunk = _chunks.emplace_back(std::make_unique<std::byte[]>(ChunkSize));
+    const auto blockSize = sizeof(DukHeapBlockHeader) + SizeClasses[sizeClass];
+    for (size_t offset = 0; offset + blockSize <= ChunkSize; offset += blockSize)
+    {
+        auto block = reinterpret_cast<FreeBlock*>(chunk.get() + offset);
+        block->Next = _freeBlocks[sizeClass];
+        _freeBlocks[sizeClass] = block;
+    }
+}
+
+bool DukHeapAllocator::IsOverLimit(DukHeapOwner owner, size_t size) noexcept
+{
+    if (owner == DUK_HEAP_OWNER_NONE || _limit == 0)
+    {
+        return false;
+    }
+
+    auto& stats = _owners[owner];
+    if (stats.LiveBytes + size <= _limit)
+    {
+        stats.OverLimit = false;
+        return false;
+    }
+
+    // Going over the limit fails once so Duktape collects garbage and retries, after that the allocations that still
+    // do not fit have the headroom.
+    if (!stats.OverLimit)
+    {
+        stats.OverLimit = true;
+        return true;
+    }
+    return stats.LiveBytes + size > _limit + LimitHeadroom;
+}
+
+size_t DukHeapAllocator::GetSizeClass(size_t size) noexcept
+{
+    auto it = std::lower_bound(SizeClasses.begin(), SizeClasses.end(), size);
+    return std::distance(SizeClasses.begin(), it);
+}
+
+#endif
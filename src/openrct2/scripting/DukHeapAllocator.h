@@ -0,0 +1,121 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2024 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#pragma once
+
+#ifdef ENABLE_SCRIPTING
+
+#    include <array>
+#    include <atomic>
+#    include <cstddef>
+#    include <cstdint>
+#    include <memory>
+#    include <vector>
+
+namespace OpenRCT2::Scripting
+{
+    using DukHeapOwner = uint16_t;
+
+    // Allocations made outside of any plugin, e.g. by the engine or the console.
+    static constexpr DukHeapOwner DUK_HEAP_OWNER_NONE = 0;
+
+    struct DukHeapStats
+    {
+        uint64_t LiveBytes{};
+        uint64_t PeakBytes{};
+        uint64_t Allocations{};
+        uint64_t AllocatedBytes{};
+        uint32_t FailedAllocations{};
+
+        // Measured over the last second.
+        uint32_t AllocationRate{};
+        uint64_t AllocatedBytesRate{};
+
+        uint64_t LastAllocations{};
+        uint64_t LastAllocatedBytes{};
+        // Set by the first allocation over the limit, until the plugin is back under it.
+        bool OverLimit{};
+    };
+
+    /**
+     * Allocator for the Duktape heap. Small allocations, which are most of them, come from pools of fixed size blocks
+     * instead of malloc. Every allocation is attributed to the plugin running at the time, which can be limited in how
+     * much memory it keeps alive.
+     *
+     * The first allocation that would take a plugin over its limit fails, so Duktape collects garbage and tries again.
+     * Allocations after that succeed as long as they stay within LimitHeadroom above the limit, so a plugin that keeps
+     * going over its limit can keep up to the limit plus LimitHeadroom alive.
+     */
+    class DukHeapAllocator
+    {
+    public:
+        static constexpr std::array<uint32_t, 10> SizeClasses = { 16, 32, 48, 64, 96, 128, 192, 256, 384, 512 };
+        // What a plugin may go over its limit by once an allocation over it has failed.
+        static constexpr uint64_t LimitHeadroom = 64 * 1024;
+
+    private:
+        static constexpr size_t ChunkSize = 64 * 1024;
+
+        struct FreeBlock
+        {
+            FreeBlock* Next;
+        };
+
+        std::array<FreeBlock*, SizeClasses.size()> _freeBlocks{};
+        std::vector<std::unique_ptr<std::byte[]>> _chunks;
+        std::vector<DukHeapStats> _owners;
+        // Owners whose plugin has gone, reused once the memory attributed to them has been freed.
+        std::vector<DukHeapOwner> _removedOwners;
+        DukHeapOwner _currentOwner = DUK_HEAP_OWNER_NONE;
+        // Bytes each plugin may keep alive, 0 for no limit.
+        uint64_t _limit{};
+        uint32_t _lastRateUpdate{};
+        uint64_t _pooledAllocations{};
+        uint64_t _systemAllocations{};
+        const std::atomic_bool* _interrupt{};
+
+    public:
+        DukHeapAllocator();
+        DukHeapAllocator(const DukHeapAllocator&) = delete;
+        DukHeapAllocator& operator=(const DukHeapAllocator&) = delete;
+
+        DukHeapOwner AddOwner();
+        // Memory a plugin left behind can still be freed after it has gone, its owner is only reused once it all is.
+        void RemoveOwner(DukHeapOwner owner);
+        void SetOwner(DukHeapOwner owner) noexcept;
+        const DukHeapStats& GetStats(DukHeapOwner owner) const;
+        void SetLimit(uint64_t limit) noexcept;
+        // Updates the allocation rates once a second.
+        void Update();
+
+        // Scripts running on the heap are stopped once the flag is set, checked from the execution timeout check.
+        void SetInterrupt(const std::atomic_bool* interrupt) noexcept;
+        bool IsInterrupted() const noexcept;
+
+        size_t GetReservedBytes() const noexcept;
+        uint64_t GetPooledAllocations() const noexcept;
+        uint64_t GetSystemAllocations() const noexcept;
+
+        // For duk_create_heap, the allocator is the heap's user data.
+        static void* Alloc(void* udata, size_t size);
+        static void* Realloc(void* udata, void* ptr, size_t size);
+        static void Free(void* udata, void* ptr);
+
+    private:
+        void* Allocate(size_t size, DukHeapOwner owner);
+        void Release(void* ptr);
+        void* Reallocate(void* ptr, size_t size);
+        void* AllocateBlock(size_t sizeClass);
+        void AddChunk(size_t sizeClass);
+        bool IsOverLimit(DukHeapOwner owner, size_t size) noexcept;
+        static size_t GetSizeClass(size_t size) noexcept;
+    };
+} // namespace OpenRCT2::Scripting
+
+#endif
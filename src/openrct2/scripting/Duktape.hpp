@@ -17,10 +17,12 @@
 #    include "../world/Map.h"
 
 #    include <cstdio>
+#    include <cstring>
 #    include <dukglue/dukglue.h>
 #    include <duktape.h>
 #    include <optional>
 #    include <stdexcept>
+#    include <vector>
 
 namespace OpenRCT2::Scripting
 {
@@ -257,6 +259,54 @@ namespace OpenRCT2::Scripting
         return std::nullopt;
     }
 
+    inline duk_ret_t duk_cbor_encode_wrapper(duk_context* ctx, void*)
+    {
+        duk_cbor_encode(ctx, -1, 0);
+        return 1;
+    }
+
+    inline duk_ret_t duk_cbor_decode_wrapper(duk_context* ctx, void*)
+    {
+        duk_cbor_decode(ctx, -1, 0);
+        return 1;
+    }
+
+    /**
+     * Copies of values that can be decoded in another heap, buffers are kept as they are unlike with JSON. Functions are
+     * encoded as empty objects.
+     */
+    inline bool DuktapeTryEncodeCbor(duk_context* ctx, duk_idx_t idx, std::vector<uint8_t>& data)
+    {
+        duk_dup(ctx, idx);
+        if (duk_safe_call(ctx, duk_cbor_encode_wrapper, nullptr, 1, 1) != DUK_EXEC_SUCCESS)
+        {
+            duk_pop(ctx);
+            return false;
+        }
+
+        duk_size_t size{};
+        auto buffer = static_cast<const uint8_t*>(duk_get_buffer_data(ctx, -1, &size));
+        data.assign(buffer, buffer + size);
+        duk_pop(ctx);
+        return true;
+    }
+
+    // Pushes the decoded value on success.
+    inline bool DuktapeTryDecodeCbor(duk_context* ctx, const uint8_t* data, size_t size)
+    {
+        auto buffer = duk_push_fixed_buffer(ctx, size);
+        if (size != 0)
+        {
+            std::memcpy(buffer, data, size);
+        }
+        if (duk_safe_call(ctx, duk_cbor_decode_wrapper, nullptr, 1, 1) != DUK_EXEC_SUCCESS)
+        {
+            duk_pop(ctx);
+            return false;
+        }
+        return true;
+    }
+
     std::string ProcessString(const DukValue& value);
 
     template<typename T> DukValue ToDuk(duk_context* ctx, const T& value) = delete;
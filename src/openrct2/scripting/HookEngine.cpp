@@ -11,13 +11,22 @@
 
 #    include "HookEngine.h"
 
+#    include "../actions/CustomAction.h"
+#    include "../config/Config.h"
 #    include "../core/EnumMap.hpp"
+#    include "../core/String.hpp"
+#    include "../platform/Platform.h"
 #    include "ScriptEngine.h"
 
+#    include <chrono>
 #    include <unordered_map>
 
+using namespace OpenRCT2;
 using namespace OpenRCT2::Scripting;
 
+// Milliseconds between two warnings about the same plugin going over the soft budget.
+static constexpr uint32_t BUDGET_WARNING_INTERVAL = 10000;
+
 static const EnumMap<HOOK_TYPE> HooksLookupTable({
     { "action.query", HOOK_TYPE::ACTION_QUERY },
     { "action.execute", HOOK_TYPE::ACTION_EXECUTE },
@@ -42,6 +51,12 @@ HOOK_TYPE OpenRCT2::Scripting::GetHookType(const std::string& name)
     return (result != HooksLookupTable.end()) ? result->second : HOOK_TYPE::UNDEFINED;
 }
 
+std::string_view OpenRCT2::Scripting::GetHookName(HOOK_TYPE type)
+{
+    auto result = HooksLookupTable.find(type);
+    return (result != HooksLookupTable.end()) ? result->first : std::string_view();
+}
+
 HookEngine::HookEngine(ScriptEngine& scriptEngine)
     : _scriptEngine(scriptEngine)
 {
@@ -52,11 +67,36 @@ HookEngine::HookEngine(ScriptEngine& scriptEngine)
     }
 }
 
-uint32_t HookEngine::Subscribe(HOOK_TYPE type, std::shared_ptr<Plugin> owner, const DukValue& function)
+bool ActionHookFilter::Matches(const GameAction& action) const
+{
+    const auto type = action.GetType();
+    if (!Actions.empty() || !CustomActions.empty())
+    {
+        const auto matchesType = std::find(Actions.begin(), Actions.end(), type) != Actions.end();
+        const auto matchesCustom = type == GameCommand::Custom && !CustomActions.empty()
+            && std::find(CustomActions.begin(), CustomActions.end(), static_cast<const CustomAction&>(action).GetId())
+                != CustomActions.end();
+        if (!matchesType && !matchesCustom)
+        {
+            return false;
+        }
+    }
+
+    if (!Players.empty() && std::find(Players.begin(), Players.end(), action.GetPlayer()) == Players.end())
+    {
+        return false;
+    }
+
+    const auto flags = action.GetFlags();
+    return (flags & Flags) == Flags && (flags & ExcludedFlags) == 0;
+}
+
+uint32_t HookEngine::Subscribe(
+    HOOK_TYPE type, std::shared_ptr<Plugin> owner, const DukValue& function, std::optional<ActionHookFilter> filter)
 {
     auto& hookList = GetHookList(type);
     auto cookie = _nextCookie++;
-    hookList.Hooks.emplace_back(cookie, owner, function);
+    hookList.Hooks.emplace_back(cookie, owner, function, std::move(filter));
     return cookie;
 }
 
@@ -99,6 +139,14 @@ bool HookEngine::HasSubscriptions(HOOK_TYPE type) const
     return !hookList.Hooks.empty();
 }
 
+bool HookEngine::HasSubscriptions(HOOK_TYPE type, const GameAction& action) const
+{
+    auto& hookList = GetHookList(type);
+    return std::any_of(hookList.Hooks.begin(), hookList.Hooks.end(), [&action](const Hook& hook) {
+        return !hook.Filter || hook.Filter->Matches(action);
+    });
+}
+
 bool HookEngine::IsValidHookForPlugin(HOOK_TYPE type, Plugin& plugin) const
 {
     if (type == HOOK_TYPE::MAP_CHANGED && plugin.GetMetadata().Type != PluginType::Intransient)
@@ -113,7 +161,7 @@ void HookEngine::Call(HOOK_TYPE type, bool isGameStateMutable)
     auto& hookList = GetHookList(type);
     for (auto& hook : hookList.Hooks)
     {
-        _scriptEngine.ExecutePluginCall(hook.Owner, hook.Function, {}, isGameStateMutable);
+        CallHook(type, hook, {}, isGameStateMutable);
     }
 }
 
@@ -122,7 +170,19 @@ void HookEngine::Call(HOOK_TYPE type, const DukValue& arg, bool isGameStateMutab
     auto& hookList = GetHookList(type);
     for (auto& hook : hookList.Hooks)
     {
-        _scriptEngine.ExecutePluginCall(hook.Owner, hook.Function, { arg }, isGameStateMutable);
+        CallHook(type, hook, { arg }, isGameStateMutable);
+    }
+}
+
+void HookEngine::Call(HOOK_TYPE type, const GameAction& action, const DukValue& arg, bool isGameStateMutable)
+{
+    auto& hookList = GetHookList(type);
+    for (auto& hook : hookList.Hooks)
+    {
+        if (!hook.Filter || hook.Filter->Matches(action))
+        {
+            CallHook(type, hook, { arg }, isGameStateMutable);
+        }
     }
 }
 
@@ -132,6 +192,11 @@ void HookEngine::Call(
     auto& hookList = GetHookList(type);
     for (auto& hook : hookList.Hooks)
     {
+        if (hook.Owner->GetHookProfile().Suspended)
+        {
+            continue;
+        }
+
         auto ctx = _scriptEngine.GetContext();
 
         // Convert key/value pairs into an object
@@ -157,7 +222,7 @@ void HookEngine::Call(
 
         std::vector<DukValue> dukArgs;
         dukArgs.push_back(DukValue::take_from_stack(ctx));
-        _scriptEngine.ExecutePluginCall(hook.Owner, hook.Function, dukArgs, isGameStateMutable);
+        CallHook(type, hook, dukArgs, isGameStateMutable);
     }
 }
 
@@ -173,4 +238,81 @@ const HookList& HookEngine::GetHookList(HOOK_TYPE type) const
     return _hookMap[index];
 }
 
+void HookEngine::CallHook(HOOK_TYPE type, const Hook& hook, const std::vector<DukValue>& args, bool isGameStateMutable)
+{
+    // The hook may unsubscribe itself while it runs.
+    auto owner = hook.Owner;
+    auto& profile = owner->GetHookProfile();
+    if (profile.Suspended)
+    {
+        return;
+    }
+
+    // Hooks of other plugins run from within this one, e.g. by executing an action, are not counted against it.
+    const auto outerNestedTime = std::exchange(_nestedTime, 0);
+    const auto startTime = std::chrono::steady_clock::now();
+    _scriptEngine.ExecutePluginCall(owner, hook.Function, args, isGameStateMutable);
+    const auto elapsed = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - startTime);
+    const auto totalTime = static_cast<uint64_t>(elapsed.count());
+    const auto time = totalTime - std::min(_nestedTime, totalTime);
+    _nestedTime = outerNestedTime + totalTime;
+
+    auto& stats = profile.Hooks[static_cast<size_t>(type)];
+    stats.CallCount++;
+    stats.TotalTime += time;
+    stats.MaxTime = std::max(stats.MaxTime, time);
+    UpdateBudget(owner, time);
+}
+
+void HookEngine::BeginBudgetWindow()
+{
+    _budgetWindow++;
+}
+
+void HookEngine::UpdateBudget(const std::shared_ptr<Plugin>& plugin, uint64_t time)
+{
+    auto& profile = plugin->GetHookProfile();
+    if (profile.BudgetWindow != _budgetWindow)
+    {
+        profile.BudgetWindow = _budgetWindow;
+        profile.BudgetTime = 0;
+    }
+    const auto previousTime = profile.BudgetTime;
+    profile.BudgetTime += time;
+
+    // Skipping the hooks of other plugins could make the game state differ between server and clients.
+    if (plugin->IsTransient())
+    {
+        return;
+    }
+
+    const auto hardBudget = static_cast<uint64_t>(gConfigPlugin.HookHardBudget * 1000.0f);
+    if (hardBudget > 0 && profile.BudgetTime > hardBudget)
+    {
+        profile.Suspended = true;
+        _scriptEngine.LogPluginInfo(
+            plugin,
+            String::StdFormat(
+                "Hooks suspended after taking %.1f ms in one tick, use plugin_resume to resume them.",
+                profile.BudgetTime / 1000.0));
+        return;
+    }
+
+    const auto softBudget = static_cast<uint64_t>(gConfigPlugin.HookSoftBudget * 1000.0f);
+    if (softBudget > 0 && previousTime <= softBudget && profile.BudgetTime > softBudget)
+    {
+        profile.OverBudgetTicks++;
+        const auto now = Platform::GetTicks();
+        if (profile.OverBudgetTicks == 1 || now - profile.LastWarningTime >= BUDGET_WARNING_INTERVAL)
+        {
+            profile.LastWarningTime = now;
+            _scriptEngine.LogPluginInfo(
+                plugin,
+                String::StdFormat(
+                    "Hooks took %.1f ms in one tick, over the budget of %.1f ms (%u ticks so far).",
+                    profile.BudgetTime / 1000.0, softBudget / 1000.0, profile.OverBudgetTicks));
+        }
+    }
+}
+
 #endif
@@ -16,10 +16,15 @@
 
 #    include <any>
 #    include <memory>
+#    include <optional>
 #    include <string>
+#    include <string_view>
 #    include <tuple>
 #    include <vector>
 
+class GameAction;
+enum class GameCommand : int32_t;
+
 namespace OpenRCT2::Scripting
 {
     class ScriptEngine;
@@ -48,18 +53,47 @@ namespace OpenRCT2::Scripting
     };
     constexpr size_t NUM_HOOK_TYPES = static_cast<size_t>(HOOK_TYPE::COUNT);
     HOOK_TYPE GetHookType(const std::string& name);
+    std::string_view GetHookName(HOOK_TYPE type);
+
+    // Calls of one plugin's hooks of one type, times are in microseconds.
+    struct HookCallStats
+    {
+        uint32_t CallCount{};
+        uint64_t TotalTime{};
+        uint64_t MaxTime{};
+    };
+
+    /**
+     * Narrows down the actions an action hook is called for, checked before any arguments are created for the hook.
+     * Empty lists match everything.
+     */
+    struct ActionHookFilter
+    {
+        std::vector<GameCommand> Actions;
+        // Identifiers of custom actions, they all share the same command.
+        std::vector<std::string> CustomActions;
+        std::vector<int32_t> Players;
+        // Flags the action must all have and flags it must not have any of.
+        uint32_t Flags{};
+        uint32_t ExcludedFlags{};
+
+        bool Matches(const GameAction& action) const;
+    };
 
     struct Hook
     {
         uint32_t Cookie;
         std::shared_ptr<Plugin> Owner;
         DukValue Function;
+        std::optional<ActionHookFilter> Filter;
 
         Hook() = default;
-        Hook(uint32_t cookie, std::shared_ptr<Plugin> owner, const DukValue& function)
+        Hook(uint32_t cookie, std::shared_ptr<Plugin> owner, const DukValue& function,
+             std::optional<ActionHookFilter> filter = std::nullopt)
             : Cookie(cookie)
             , Owner(owner)
             , Function(function)
+            , Filter(std::move(filter))
         {
         }
     };
@@ -80,24 +114,38 @@ namespace OpenRCT2::Scripting
         ScriptEngine& _scriptEngine;
         std::vector<HookList> _hookMap;
         uint32_t _nextCookie = 1;
+        // Time spent in hooks called from within the hook currently running.
+        uint64_t _nestedTime{};
+        // Budgets are measured per update rather than per game tick, hooks keep running while the game is paused.
+        uint32_t _budgetWindow{};
 
     public:
         HookEngine(ScriptEngine& scriptEngine);
         HookEngine(const HookEngine&) = delete;
-        uint32_t Subscribe(HOOK_TYPE type, std::shared_ptr<Plugin> owner, const DukValue& function);
+        uint32_t Subscribe(
+            HOOK_TYPE type, std::shared_ptr<Plugin> owner, const DukValue& function,
+            std::optional<ActionHookFilter> filter = std::nullopt);
         void Unsubscribe(HOOK_TYPE type, uint32_t cookie);
         void UnsubscribeAll(std::shared_ptr<const Plugin> owner);
         void UnsubscribeAll();
         bool HasSubscriptions(HOOK_TYPE type) const;
+        // Whether any hook of the type would be called for the action.
+        bool HasSubscriptions(HOOK_TYPE type, const GameAction& action) const;
         bool IsValidHookForPlugin(HOOK_TYPE type, Plugin& plugin) const;
         void Call(HOOK_TYPE type, bool isGameStateMutable);
         void Call(HOOK_TYPE type, const DukValue& arg, bool isGameStateMutable);
+        // Only calls the hooks whose filter matches the action.
+        void Call(HOOK_TYPE type, const GameAction& action, const DukValue& arg, bool isGameStateMutable);
         void Call(
             HOOK_TYPE type, const std::initializer_list<std::pair<std::string_view, std::any>>& args, bool isGameStateMutable);
+        // Starts measuring hook time against the budgets anew, called once per update.
+        void BeginBudgetWindow();
 
     private:
         HookList& GetHookList(HOOK_TYPE type);
         const HookList& GetHookList(HOOK_TYPE type) const;
+        void CallHook(HOOK_TYPE type, const Hook& hook, const std::vector<DukValue>& args, bool isGameStateMutable);
+        void UpdateBudget(const std::shared_ptr<Plugin>& plugin, uint64_t time);
     };
 } // namespace OpenRCT2::Scripting
 
@@ -11,24 +11,76 @@
 
 #    include "Plugin.h"
 
+#    include "../Context.h"
 #    include "../Diagnostic.h"
 #    include "../OpenRCT2.h"
+#    include "../PlatformEnvironment.h"
+#    include "../Version.h"
+#    include "../core/Crypt.h"
 #    include "../core/File.h"
+#    include "../core/Path.hpp"
+#    include "../core/String.hpp"
 #    include "Duktape.hpp"
 #    include "ScriptEngine.h"
 
 #    include <algorithm>
+#    include <cstring>
 #    include <fstream>
 #    include <memory>
 
+using namespace OpenRCT2;
 using namespace OpenRCT2::Scripting;
 
-Plugin::Plugin(duk_context* context, std::string_view path)
+static constexpr uint32_t CACHE_MAGIC = 0x43424A53; // SJBC
+static constexpr uint32_t CACHE_VERSION = 1;
+
+struct PluginCacheHeader
+{
+    uint32_t Magic{};
+    uint32_t Version{};
+    // Hash of the wrapped source and the build, the cached function is stale if either changed.
+    Crypt::FNV1aAlgorithm::Result SourceHash{};
+    // Guards against loading a truncated or damaged dump, which Duktape does not validate.
+    Crypt::FNV1aAlgorithm::Result DataHash{};
+    uint64_t DataSize{};
+};
+static_assert(sizeof(PluginCacheHeader) == 32);
+
+static Crypt::FNV1aAlgorithm::Result GetCacheSourceHash(std::string_view code)
+{
+    // Dumped bytecode is specific to the Duktape build and platform.
+    const uint32_t duktapeVersion = DUK_VERSION;
+    const uint32_t pointerSize = sizeof(void*);
+    return Crypt::CreateFNV1a()
+        ->Update(gVersionInfoFull, std::strlen(gVersionInfoFull))
+        ->Update(&duktapeVersion, sizeof(duktapeVersion))
+        ->Update(&pointerSize, sizeof(pointerSize))
+        ->Update(code.data(), code.size())
+        ->Finish();
+}
+
+static duk_ret_t LoadFunctionWrapper(duk_context* ctx, void*)
+{
+    duk_load_function(ctx);
+    return 1;
+}
+
+Plugin::Plugin(duk_context* context, std::string_view path, DukHeapAllocator* heapAllocator)
     : _context(context)
     , _path(path)
+    , _heapAllocator(heapAllocator)
+    , _heapOwner(heapAllocator != nullptr ? heapAllocator->AddOwner() : DUK_HEAP_OWNER_NONE)
 {
 }
 
+Plugin::~Plugin()
+{
+    if (_heapAllocator != nullptr)
+    {
+        _heapAllocator->RemoveOwner(_heapOwner);
+    }
+}
+
 void Plugin::SetCode(std::string_view code)
 {
     _code = code;
@@ -51,21 +103,34 @@ void Plugin::Load()
     // so that if the script modifies them, they are not modified for other scripts.
 
     // clang-format off
-    auto code = _code;
-    code =
-        "     (function(" + projectedVariables + ") {"
+    auto code =
+        "     function(" + projectedVariables + ") {"
         "         var __metadata__ = null;"
         "         var registerPlugin = function(m) { __metadata__ = m };"
         "         (function(__metadata__) {"
-                      + code +
+                      + _code +
         "         })();"
         "         return __metadata__;"
-        "     })(" + projectedVariables + ");";
+        "     }";
     // clang-format on
 
-    auto flags = DUK_COMPILE_EVAL | DUK_COMPILE_SAFE | DUK_COMPILE_NOSOURCE | DUK_COMPILE_NOFILENAME;
-    auto result = duk_eval_raw(_context, code.c_str(), code.size(), flags);
-    if (result != DUK_ERR_NONE)
+    if (!LoadFunctionFromCache(code))
+    {
+        if (duk_pcompile_lstring(_context, DUK_COMPILE_FUNCTION, code.c_str(), code.size()) != DUK_EXEC_SUCCESS)
+        {
+            auto val = std::string(duk_safe_to_string(_context, -1));
+            duk_pop(_context);
+            throw std::runtime_error("Failed to load plug-in script: " + val);
+        }
+        SaveFunctionToCache(code);
+    }
+
+    const auto variables = String::Split(projectedVariables, ",");
+    for (const auto& variable : variables)
+    {
+        duk_get_global_lstring(_context, variable.c_str(), variable.size());
+    }
+    if (duk_pcall(_context, static_cast<duk_idx_t>(variables.size())) != DUK_EXEC_SUCCESS)
     {
         auto val = std::string(duk_safe_to_string(_context, -1));
         duk_pop(_context);
@@ -90,6 +155,7 @@ void Plugin::Start()
     }
 
     _hasStarted = true;
+    _hookProfile = {};
 
     mainFunc.push();
     auto result = duk_pcall(_context, 0);
@@ -140,6 +206,104 @@ void Plugin::LoadCodeFromFile()
     _code = File::ReadAllText(_path);
 }
 
+bool Plugin::LoadFunctionFromCache(std::string_view code)
+{
+    const auto path = GetCachePath();
+    if (path.empty() || !File::Exists(path))
+    {
+        return false;
+    }
+
+    try
+    {
+        const auto data = File::ReadAllBytes(path);
+        PluginCacheHeader header;
+        if (data.size() < sizeof(header))
+        {
+            return false;
+        }
+        std::memcpy(&header, data.data(), sizeof(header));
+
+        const auto* dump = data.data() + sizeof(header);
+        const auto dumpSize = data.size() - sizeof(header);
+        if (header.Magic != CACHE_MAGIC || header.Version != CACHE_VERSION || header.DataSize != dumpSize
+            || header.SourceHash != GetCacheSourceHash(code) || header.DataHash != Crypt::FNV1a(dump, dumpSize))
+        {
+            return false;
+        }
+
+        auto buffer = duk_push_fixed_buffer(_context, dumpSize);
+        std::memcpy(buffer, dump, dumpSize);
+        if (duk_safe_call(_context, LoadFunctionWrapper, nullptr, 1, 1) != DUK_EXEC_SUCCESS)
+        {
+            LOG_WARNING("Unable to load cached plugin code for %s: %s", _path.c_str(), duk_safe_to_string(_context, -1));
+            duk_pop(_context);
+            return false;
+        }
+        return true;
+    }
+    catch (const std::exception& e)
+    {
+        LOG_WARNING("Unable to read cached plugin code for %s: %s", _path.c_str(), e.what());
+        return false;
+    }
+}
+
+void Plugin::SaveFunctionToCache(std::string_view code)
+{
+    const auto path = GetCachePath();
+    if (path.empty())
+    {
+        return;
+    }
+
+    duk_dup_top(_context);
+    duk_dump_function(_context);
+    duk_size_t dumpSize{};
+    const auto* dump = static_cast<const uint8_t*>(duk_get_buffer(_context, -1, &dumpSize));
+
+    PluginCacheHeader header;
+    header.Magic = CACHE_MAGIC;
+    header.Version = CACHE_VERSION;
+    header.SourceHash = GetCacheSourceHash(code);
+    header.DataHash = Crypt::FNV1a(dump, dumpSize);
+    header.DataSize = dumpSize;
+
+    std::vector<uint8_t> data(sizeof(header) + dumpSize);
+    std::memcpy(data.data(), &header, sizeof(header));
+    std::memcpy(data.data() + sizeof(header), dump, dumpSize);
+    duk_pop(_context);
+
+    try
+    {
+        Path::CreateDirectory(Path::GetDirectory(path));
+        File::WriteAllBytes(path, data.data(), data.size());
+    }
+    catch (const std::exception& e)
+    {
+        LOG_WARNING("Unable to cache plugin code for %s: %s", _path.c_str(), e.what());
+    }
+}
+
+std::string Plugin::GetCachePath() const
+{
+    // Only plugins loaded from disk are cached, one file per plugin so that old versions are replaced.
+    auto context = GetContext();
+    if (_path.empty() || context == nullptr)
+    {
+        return {};
+    }
+
+    const auto pathHash = Crypt::FNV1a(_path.data(), _path.size());
+    std::string fileName;
+    for (auto b : pathHash)
+    {
+        fileName += String::StdFormat("%02x", b);
+    }
+    auto directory = context->GetPlatformEnvironment()->GetDirectoryPath(DIRBASE::CACHE);
+    return Path::Combine(directory, u8"plugin", fileName + u8".bc");
+}
+
 static std::string TryGetString(const DukValue& value, const std::string& message)
 {
     if (value.type() != DukValue::Type::STRING)
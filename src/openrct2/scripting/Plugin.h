@@ -11,8 +11,11 @@
 
 #ifdef ENABLE_SCRIPTING
 
+#    include "DukHeapAllocator.h"
 #    include "Duktape.hpp"
+#    include "HookEngine.h"
 
+#    include <array>
 #    include <memory>
 #    include <string>
 #    include <string_view>
@@ -52,12 +55,27 @@ namespace OpenRCT2::Scripting
         DukValue Main;
     };
 
+    struct PluginHookProfile
+    {
+        std::array<HookCallStats, NUM_HOOK_TYPES> Hooks{};
+
+        // Time in microseconds spent in hooks during BudgetWindow, checked against the configured budgets.
+        uint32_t BudgetWindow{};
+        uint64_t BudgetTime{};
+        uint32_t OverBudgetTicks{};
+        uint32_t LastWarningTime{};
+        bool Suspended{};
+    };
+
     class Plugin
     {
     private:
         duk_context* _context{};
         std::string _path;
         PluginMetadata _metadata{};
+        PluginHookProfile _hookProfile{};
+        DukHeapAllocator* _heapAllocator{};
+        DukHeapOwner _heapOwner = DUK_HEAP_OWNER_NONE;
         std::string _code;
         bool _hasLoaded{};
         bool _hasStarted{};
@@ -84,6 +102,21 @@ namespace OpenRCT2::Scripting
             return _code;
         }
 
+        PluginHookProfile& GetHookProfile()
+        {
+            return _hookProfile;
+        }
+
+        const PluginHookProfile& GetHookProfile() const
+        {
+            return _hookProfile;
+        }
+
+        DukHeapOwner GetHeapOwner() const
+        {
+            return _heapOwner;
+        }
+
         bool HasStarted() const
         {
             return _hasStarted;
@@ -102,9 +135,11 @@ namespace OpenRCT2::Scripting
         int32_t GetTargetAPIVersion() const;
 
         Plugin() = default;
-        Plugin(duk_context* context, std::string_view path);
+        // The plugin's allocations are attributed to an owner of the given allocator for as long as it exists.
+        Plugin(duk_context* context, std::string_view path, DukHeapAllocator* heapAllocator = nullptr);
         Plugin(const Plugin&) = delete;
         Plugin(Plugin&&) = delete;
+        ~Plugin();
 
         void SetCode(std::string_view code);
         void Load();
@@ -119,6 +154,11 @@ namespace OpenRCT2::Scripting
 
     private:
         void LoadCodeFromFile();
+        // Pushes the function compiled from the wrapped code if the cache has it.
+        bool LoadFunctionFromCache(std::string_view code);
+        // Caches the compiled function on top of the stack.
+        void SaveFunctionToCache(std::string_view code);
+        std::string GetCachePath() const;
 
         static PluginMetadata GetMetadata(const DukValue& dukMetadata);
         static PluginType ParsePluginType(std::string_view type);
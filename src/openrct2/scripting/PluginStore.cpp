@@ -0,0 +1,433 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2024 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#ifdef ENABLE_SCRIPTING
+
+#    include "PluginStore.h"
+
+#    include "../core/Console.hpp"
+#    include "../core/IStream.hpp"
+#    include "../core/MemoryStream.h"
+
+#    include <algorithm>
+
+using namespace OpenRCT2;
+using namespace OpenRCT2::Scripting;
+
+static constexpr uint32_t PLUGIN_STORE_MAGIC = 0x52545350; // PSTR
+static constexpr uint16_t PLUGIN_STORE_VERSION = 1;
+
+// Depth at which values imported from JSON are split into records, which is where plugins usually set them.
+static constexpr size_t PLUGIN_STORE_IMPORT_DEPTH = 2;
+
+enum class PluginStoreRecordType : uint8_t
+{
+    Put = 1,
+    Delete = 2,
+};
+
+using Path = PluginStore::Path;
+
+static bool IsDescendant(const Path& path, const Path& ancestor)
+{
+    return path.size() > ancestor.size() && std::equal(ancestor.begin(), ancestor.end(), path.begin());
+}
+
+static const Path& GetPath(const Path& path)
+{
+    return path;
+}
+
+template<typename T> static const Path& GetPath(const std::pair<const Path, T>& entry)
+{
+    return entry.first;
+}
+
+// Descendants always sort directly after the path itself.
+template<typename TContainer> static void EraseDescendants(TContainer& container, const Path& path)
+{
+    auto it = container.upper_bound(path);
+    while (it != container.end() && IsDescendant(GetPath(*it), path))
+    {
+        it = container.erase(it);
+    }
+}
+
+// Pushes the value at the path, or undefined if there is none.
+static bool PushValue(duk_context* ctx, const DukValue& root, const Path& path)
+{
+    root.push();
+    for (const auto& segment : path)
+    {
+        if (!duk_is_object(ctx, -1))
+        {
+            duk_pop(ctx);
+            duk_push_undefined(ctx);
+            return false;
+        }
+        duk_get_prop_lstring(ctx, -1, segment.data(), segment.size());
+        duk_remove(ctx, -2);
+    }
+    return !duk_is_undefined(ctx, -1);
+}
+
+// Puts the value on top of the stack at the path, creating the objects along the way.
+static void PutValue(duk_context* ctx, const DukValue& root, const Path& path)
+{
+    root.push();
+    for (size_t i = 0; i < path.size() - 1; i++)
+    {
+        const auto& segment = path[i];
+        duk_get_prop_lstring(ctx, -1, segment.data(), segment.size());
+        if (!duk_is_object(ctx, -1))
+        {
+            duk_pop(ctx);
+            duk_push_object(ctx);
+            duk_dup(ctx, -1);
+            duk_put_prop_lstring(ctx, -3, segment.data(), segment.size());
+        }
+        duk_remove(ctx, -2);
+    }
+    duk_swap(ctx, -1, -2);
+    duk_put_prop_lstring(ctx, -2, path.back().data(), path.back().size());
+    duk_pop(ctx);
+}
+
+static void DeleteValue(duk_context* ctx, const DukValue& root, const Path& path)
+{
+    auto parent = Path(path.begin(), path.end() - 1);
+    PushValue(ctx, root, parent);
+    if (duk_is_object(ctx, -1))
+    {
+        duk_del_prop_lstring(ctx, -1, path.back().data(), path.back().size());
+    }
+    duk_pop(ctx);
+}
+
+static void WriteRecord(MemoryStream& stream, PluginStoreRecordType type, const Path& path, const std::vector<uint8_t>* data)
+{
+    stream.WriteValue<uint8_t>(static_cast<uint8_t>(type));
+    stream.WriteValue<uint16_t>(static_cast<uint16_t>(path.size()));
+    for (const auto& segment : path)
+    {
+        stream.WriteValue<uint32_t>(static_cast<uint32_t>(segment.size()));
+        stream.Write(segment.data(), segment.size());
+    }
+    if (data != nullptr)
+    {
+        stream.WriteValue<uint32_t>(static_cast<uint32_t>(data->size()));
+        stream.Write(data->data(), data->size());
+    }
+}
+
+static std::vector<uint8_t> GetStreamData(const MemoryStream& stream)
+{
+    auto data = static_cast<const uint8_t*>(stream.GetData());
+    return std::vector<uint8_t>(data, data + stream.GetLength());
+}
+
+// Lengths are checked against what is left so a damaged file does not cause huge allocations.
+static uint32_t ReadLength(MemoryStream& stream)
+{
+    auto length = stream.ReadValue<uint32_t>();
+    if (length > stream.GetLength() - stream.GetPosition())
+    {
+        throw IOException("Attempted to read past end of stream.");
+    }
+    return length;
+}
+
+PluginStore::PluginStore(duk_context* ctx)
+    : _context(ctx)
+{
+}
+
+const DukValue& PluginStore::GetRoot() const
+{
+    return _root;
+}
+
+bool PluginStore::IsEmpty() const
+{
+    return _records.empty();
+}
+
+void PluginStore::Clear()
+{
+    duk_push_object(_context);
+    _root = DukValue::take_from_stack(_context);
+    _records.clear();
+    _changes.clear();
+}
+
+void PluginStore::MarkChanged(const Path& path)
+{
+    // A value within a record changed, the whole record has to be encoded again.
+    auto ancestor = FindAncestorRecord(path);
+    if (ancestor != _records.end())
+    {
+        ancestor->second.Dirty = true;
+        _changes.insert(ancestor->first);
+        return;
+    }
+
+    EraseDescendants(_records, path);
+    EraseDescendants(_changes, path);
+
+    auto exists = PushValue(_context, _root, path);
+    duk_pop(_context);
+    if (exists)
+    {
+        _records[path].Dirty = true;
+    }
+    else
+    {
+        _records.erase(path);
+    }
+    _changes.insert(path);
+}
+
+void PluginStore::MarkHandedOut(const Path& path)
+{
+    auto ancestor = FindAncestorRecord(path);
+    if (ancestor != _records.end())
+    {
+        ancestor->second.HandedOut = true;
+        return;
+    }
+
+    // The value itself or the records within it.
+    for (auto it = _records.lower_bound(path); it != _records.end() && (it->first == path || IsDescendant(it->first, path));
+         it++)
+    {
+        it->second.HandedOut = true;
+    }
+}
+
+bool PluginStore::HasChanges() const
+{
+    return !_changes.empty();
+}
+
+std::vector<uint8_t> PluginStore::Write()
+{
+    EncodeRecords();
+
+    MemoryStream stream;
+    stream.WriteValue<uint32_t>(PLUGIN_STORE_MAGIC);
+    stream.WriteValue<uint16_t>(PLUGIN_STORE_VERSION);
+    for (const auto& [path, record] : _records)
+    {
+        WriteRecord(stream, PluginStoreRecordType::Put, path, &record.Data);
+    }
+    _changes.clear();
+    return GetStreamData(stream);
+}
+
+std::vector<uint8_t> PluginStore::WriteChanges()
+{
+    EncodeRecords();
+
+    // Changed paths are written in order, so a path is always written before the paths within it.
+    MemoryStream stream;
+    for (const auto& path : _changes)
+    {
+        auto it = _records.find(path);
+        if (it != _records.end())
+        {
+            WriteRecord(stream, PluginStoreRecordType::Put, path, &it->second.Data);
+        }
+        else
+        {
+            WriteRecord(stream, PluginStoreRecordType::Delete, path, nullptr);
+        }
+    }
+    _changes.clear();
+    return GetStreamData(stream);
+}
+
+PluginStoreReadResult PluginStore::Read(const void* data, size_t size)
+{
+    Clear();
+
+    auto result = PluginStoreReadResult::Complete;
+    MemoryStream stream(data, size);
+    try
+    {
+        auto magic = stream.ReadValue<uint32_t>();
+        auto version = stream.ReadValue<uint16_t>();
+        if (magic != PLUGIN_STORE_MAGIC || version != PLUGIN_STORE_VERSION)
+        {
+            return PluginStoreReadResult::Failed;
+        }
+
+        while (stream.GetPosition() < stream.GetLength())
+        {
+            auto type = static_cast<PluginStoreRecordType>(stream.ReadValue<uint8_t>());
+            Path path(stream.ReadValue<uint16_t>());
+            for (auto& segment : path)
+            {
+                segment.resize(ReadLength(stream));
+                stream.Read(segment.data(), segment.size());
+            }
+            if (path.empty())
+            {
+                result = PluginStoreReadResult::Incomplete;
+                break;
+            }
+
+            if (type == PluginStoreRecordType::Put)
+            {
+                std::vector<uint8_t> value(ReadLength(stream));
+                stream.Read(value.data(), value.size());
+                ApplyPut(path, std::move(value));
+            }
+            else if (type == PluginStoreRecordType::Delete)
+            {
+                ApplyDelete(path);
+            }
+            else
+            {
+                result = PluginStoreReadResult::Incomplete;
+                break;
+            }
+        }
+    }
+    catch (const IOException&)
+    {
+        if (stream.GetPosition() < sizeof(PLUGIN_STORE_MAGIC) + sizeof(PLUGIN_STORE_VERSION))
+        {
+            return PluginStoreReadResult::Failed;
+        }
+        result = PluginStoreReadResult::Incomplete;
+    }
+    _changes.clear();
+    return result;
+}
+
+std::string PluginStore::ToJson() const
+{
+    _root.push();
+    auto json = std::string(duk_json_encode(_context, -1));
+    duk_pop(_context);
+    return json;
+}
+
+bool PluginStore::FromJson(std::string_view json)
+{
+    auto result = DuktapeTryParseJson(_context, json);
+    if (!result || result->type() != DukValue::Type::OBJECT || result->is_array())
+    {
+        return false;
+    }
+
+    Clear();
+    _root = std::move(*result);
+    Path path;
+    ImportRecords(_root, path);
+    return true;
+}
+
+std::map<Path, PluginStore::Record>::iterator PluginStore::FindAncestorRecord(const Path& path)
+{
+    for (size_t i = 1; i < path.size(); i++)
+    {
+        auto it = _records.find(Path(path.begin(), path.begin() + i));
+        if (it != _records.end())
+        {
+            return it;
+        }
+    }
+    return _records.end();
+}
+
+void PluginStore::EncodeRecords()
+{
+    std::vector<uint8_t> data;
+    for (auto& [path, record] : _records)
+    {
+        if (!record.Dirty && !record.HandedOut)
+        {
+            continue;
+        }
+
+        PushValue(_context, _root, path);
+        if (!DuktapeTryEncodeCbor(_context, -1, data))
+        {
+            Console::Error::WriteLine("Unable to encode plugin storage value.");
+        }
+        else if (record.Data != data)
+        {
+            // Values handed out are only known to have changed once encoded.
+            record.Data.swap(data);
+            _changes.insert(path);
+        }
+        duk_pop(_context);
+        record.Dirty = false;
+    }
+}
+
+void PluginStore::ImportRecords(const DukValue& value, Path& path)
+{
+    value.push();
+    duk_enum(_context, -1, DUK_ENUM_OWN_PROPERTIES_ONLY);
+    while (duk_next(_context, -1, 1))
+    {
+        duk_size_t keyLength{};
+        auto key = duk_get_lstring(_context, -2, &keyLength);
+        path.emplace_back(key, keyLength);
+        if (path.size() < PLUGIN_STORE_IMPORT_DEPTH && duk_is_object(_context, -1) && !duk_is_array(_context, -1))
+        {
+            auto child = DukValue::take_from_stack(_context);
+            ImportRecords(child, path);
+        }
+        else
+        {
+            _records[path].Dirty = true;
+            duk_pop(_context);
+        }
+        path.pop_back();
+        duk_pop(_context);
+    }
+    duk_pop_2(_context);
+}
+
+void PluginStore::ApplyPut(const Path& path, std::vector<uint8_t>&& data)
+{
+    if (!DuktapeTryDecodeCbor(_context, data.data(), data.size()))
+    {
+        return;
+    }
+    PutValue(_context, _root, path);
+
+    auto ancestor = FindAncestorRecord(path);
+    if (ancestor != _records.end())
+    {
+        ancestor->second.Dirty = true;
+        return;
+    }
+    EraseDescendants(_records, path);
+    _records[path] = { std::move(data), false };
+}
+
+void PluginStore::ApplyDelete(const Path& path)
+{
+    DeleteValue(_context, _root, path);
+
+    auto ancestor = FindAncestorRecord(path);
+    if (ancestor != _records.end())
+    {
+        ancestor->second.Dirty = true;
+        return;
+    }
+    EraseDescendants(_records, path);
+    _records.erase(path);
+}
+
+#endif
@@ -0,0 +1,92 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2024 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#pragma once
+
+#ifdef ENABLE_SCRIPTING
+
+#    include "Duktape.hpp"
+
+#    include <map>
+#    include <set>
+#    include <string>
+#    include <string_view>
+#    include <vector>
+
+namespace OpenRCT2::Scripting
+{
+    enum class PluginStoreReadResult : uint8_t
+    {
+        Failed,
+        Complete,
+        // Reading stopped at a record that was cut short or damaged, the records before it were read.
+        Incomplete,
+    };
+
+    /**
+     * Plugin storage kept as an object in the script heap, along with the values that were set stored as records of
+     * CBOR keyed by their path. A record is only encoded again after its value has been set, or on every write once a
+     * script holds a reference it can change in place, so storage can be written without encoding the values that did
+     * not change, either all of it or just the records that changed since the last write which can be appended to what
+     * was written before. JSON is kept for importing and exporting.
+     */
+    class PluginStore
+    {
+    public:
+        using Path = std::vector<std::string>;
+
+    private:
+        struct Record
+        {
+            std::vector<uint8_t> Data;
+            bool Dirty{};
+            // A script holds a reference to the value or a part of it, it is encoded on every write from now on.
+            bool HandedOut{};
+        };
+
+        duk_context* _context{};
+        DukValue _root;
+        std::map<Path, Record> _records;
+        std::set<Path> _changes;
+
+    public:
+        explicit PluginStore(duk_context* ctx);
+
+        const DukValue& GetRoot() const;
+        bool IsEmpty() const;
+        void Clear();
+
+        // Has to be called after the value at the given path has been set or deleted.
+        void MarkChanged(const Path& path);
+        // Has to be called when an object or array at the given path is handed out to a script that can change it in
+        // place, the records holding it are then checked for changes on every write.
+        void MarkHandedOut(const Path& path);
+        bool HasChanges() const;
+
+        // All records, starting with the header.
+        std::vector<uint8_t> Write();
+        // Records that changed since the last write, to be appended to it.
+        std::vector<uint8_t> WriteChanges();
+        // Replaces the storage. Reading stops at a record cut short at the end as it was never completely written, the
+        // storage then has to be written in full before changes can be appended to it again.
+        PluginStoreReadResult Read(const void* data, size_t size);
+
+        std::string ToJson() const;
+        bool FromJson(std::string_view json);
+
+    private:
+        std::map<Path, Record>::iterator FindAncestorRecord(const Path& path);
+        void EncodeRecords();
+        void ImportRecords(const DukValue& value, Path& path);
+        void ApplyPut(const Path& path, std::vector<uint8_t>&& data);
+        void ApplyDelete(const Path& path);
+    };
+} // namespace OpenRCT2::Scripting
+
+#endif
@@ -0,0 +1,209 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2024 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#ifdef ENABLE_SCRIPTING
+
+#    include "PluginWorker.h"
+
+#    include <utility>
+
+using namespace OpenRCT2::Scripting;
+
+static constexpr const char* WORKER_STASH_KEY = "worker";
+
+PluginWorker::PluginWorker(std::string code)
+    : _code(std::move(code))
+{
+}
+
+PluginWorker::~PluginWorker()
+{
+    if (_context != nullptr)
+    {
+        duk_destroy_heap(_context);
+    }
+}
+
+bool PluginWorker::Post(std::vector<std::vector<uint8_t>>&& messages)
+{
+    if (messages.empty() || IsTerminated())
+    {
+        return false;
+    }
+
+    std::lock_guard lock(_mutex);
+    for (auto& message : messages)
+    {
+        _inbox.push_back(std::move(message));
+    }
+    if (_scheduled)
+    {
+        return false;
+    }
+    _scheduled = true;
+    return true;
+}
+
+std::vector<PluginWorkerMessage> PluginWorker::TakeMessages()
+{
+    std::lock_guard lock(_mutex);
+    return std::exchange(_outbox, {});
+}
+
+void PluginWorker::Terminate()
+{
+    _terminated = true;
+}
+
+bool PluginWorker::IsTerminated() const
+{
+    return _terminated;
+}
+
+void PluginWorker::Run()
+{
+    if (_context == nullptr && !IsTerminated())
+    {
+        Start();
+    }
+
+    while (true)
+    {
+        std::vector<uint8_t> message;
+        {
+            std::lock_guard lock(_mutex);
+            if (_inbox.empty() || IsTerminated())
+            {
+                _scheduled = false;
+                return;
+            }
+            message = std::move(_inbox.front());
+            _inbox.pop_front();
+        }
+        HandleMessage(message);
+    }
+}
+
+void PluginWorker::Start()
+{
+    // Terminating the worker interrupts its script through the allocator.
+    _heapAllocator.SetInterrupt(&_terminated);
+    _context = duk_create_heap(
+        DukHeapAllocator::Alloc, DukHeapAllocator::Realloc, DukHeapAllocator::Free, &_heapAllocator, nullptr);
+    if (_context == nullptr)
+    {
+        PushMessage({ PluginWorkerMessage::Kind::Error, {}, "Unable to initialise duktape context." });
+        Terminate();
+        return;
+    }
+
+    auto ctx = _context;
+    duk_push_global_stash(ctx);
+    duk_push_pointer(ctx, this);
+    duk_put_prop_string(ctx, -2, WORKER_STASH_KEY);
+    duk_pop(ctx);
+
+    // The only globals besides the built-ins, none of them reach the game.
+    duk_push_global_object(ctx);
+    duk_push_c_function(ctx, PostMessageNative, 1);
+    duk_put_prop_string(ctx, -2, "postMessage");
+    duk_push_object(ctx);
+    duk_push_c_function(ctx, ConsoleLogNative, DUK_VARARGS);
+    duk_put_prop_string(ctx, -2, "log");
+    duk_put_prop_string(ctx, -2, "console");
+    duk_pop(ctx);
+
+    if (duk_peval_lstring(ctx, _code.data(), _code.size()) != DUK_EXEC_SUCCESS)
+    {
+        PushError("Unable to run worker script: ");
+    }
+    duk_pop(ctx);
+
+    // Only needed to start the worker.
+    _code = {};
+}
+
+void PluginWorker::HandleMessage(const std::vector<uint8_t>& message)
+{
+    auto ctx = _context;
+    if (ctx == nullptr)
+    {
+        return;
+    }
+
+    duk_get_global_string(ctx, "onmessage");
+    if (!duk_is_function(ctx, -1))
+    {
+        duk_pop(ctx);
+        return;
+    }
+
+    if (!DuktapeTryDecodeCbor(ctx, message.data(), message.size()))
+    {
+        PushMessage({ PluginWorkerMessage::Kind::Error, {}, "Unable to read message." });
+        duk_pop(ctx);
+        return;
+    }
+
+    if (duk_pcall(ctx, 1) != DUK_EXEC_SUCCESS)
+    {
+        PushError({});
+    }
+    duk_pop(ctx);
+}
+
+void PluginWorker::PushMessage(PluginWorkerMessage&& message)
+{
+    std::lock_guard lock(_mutex);
+    _outbox.push_back(std::move(message));
+}
+
+void PluginWorker::PushError(std::string_view prefix)
+{
+    auto text = std::string(prefix) + duk_safe_to_string(_context, -1);
+    PushMessage({ PluginWorkerMessage::Kind::Error, {}, std::move(text) });
+}
+
+PluginWorker* PluginWorker::GetWorker(duk_context* ctx)
+{
+    duk_push_global_stash(ctx);
+    duk_get_prop_string(ctx, -1, WORKER_STASH_KEY);
+    auto worker = static_cast<PluginWorker*>(duk_get_pointer(ctx, -1));
+    duk_pop_2(ctx);
+    return worker;
+}
+
+duk_ret_t PluginWorker::PostMessageNative(duk_context* ctx)
+{
+    std::vector<uint8_t> data;
+    if (!DuktapeTryEncodeCbor(ctx, 0, data))
+    {
+        return duk_error(ctx, DUK_ERR_TYPE_ERROR, "Unable to clone message.");
+    }
+    GetWorker(ctx)->PushMessage({ PluginWorkerMessage::Kind::Message, std::move(data), {} });
+    return 0;
+}
+
+duk_ret_t PluginWorker::ConsoleLogNative(duk_context* ctx)
+{
+    std::string line;
+    auto numArgs = duk_get_top(ctx);
+    for (duk_idx_t i = 0; i < numArgs; i++)
+    {
+        if (i != 0)
+        {
+            line.push_back(' ');
+        }
+        line += duk_safe_to_string(ctx, i);
+    }
+    GetWorker(ctx)->PushMessage({ PluginWorkerMessage::Kind::Log, {}, std::move(line) });
+    return 0;
+}
+
+#endif
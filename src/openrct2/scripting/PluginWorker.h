@@ -0,0 +1,89 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2024 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#pragma once
+
+#ifdef ENABLE_SCRIPTING
+
+#    include "DukHeapAllocator.h"
+#    include "Duktape.hpp"
+
+#    include <atomic>
+#    include <deque>
+#    include <mutex>
+#    include <string>
+#    include <vector>
+
+namespace OpenRCT2::Scripting
+{
+    /**
+     * Something a worker sent back to the plugin that created it.
+     */
+    struct PluginWorkerMessage
+    {
+        enum class Kind : uint8_t
+        {
+            Message,
+            Error,
+            Log,
+        };
+
+        Kind Type{};
+        // The cloned message.
+        std::vector<uint8_t> Data;
+        // The error or the logged line.
+        std::string Text;
+    };
+
+    /**
+     * A script running in a Duktape heap of its own on a job pool thread. It has no access to the game, all it can do is
+     * exchange messages with the plugin that created it, which are copied from one heap to the other as CBOR.
+     */
+    class PluginWorker
+    {
+    private:
+        std::string _code;
+        DukHeapAllocator _heapAllocator;
+        duk_context* _context{};
+        std::mutex _mutex;
+        std::deque<std::vector<uint8_t>> _inbox;
+        std::vector<PluginWorkerMessage> _outbox;
+        bool _scheduled = true;
+        std::atomic_bool _terminated{};
+
+    public:
+        explicit PluginWorker(std::string code);
+        PluginWorker(const PluginWorker&) = delete;
+        PluginWorker& operator=(const PluginWorker&) = delete;
+        ~PluginWorker();
+
+        // Returns true if the worker has to be run again to receive the messages.
+        bool Post(std::vector<std::vector<uint8_t>>&& messages);
+        std::vector<PluginWorkerMessage> TakeMessages();
+        // Also stops the script the worker is running.
+        void Terminate();
+        bool IsTerminated() const;
+
+        // Runs the script the first time, then handles the received messages until there are none left. A new worker
+        // has to be run once.
+        void Run();
+
+    private:
+        void Start();
+        void HandleMessage(const std::vector<uint8_t>& message);
+        void PushMessage(PluginWorkerMessage&& message);
+        void PushError(std::string_view prefix);
+
+        static PluginWorker* GetWorker(duk_context* ctx);
+        static duk_ret_t PostMessageNative(duk_context* ctx);
+        static duk_ret_t ConsoleLogNative(duk_context* ctx);
+    };
+} // namespace OpenRCT2::Scripting
+
+#endif
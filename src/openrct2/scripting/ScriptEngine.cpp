@@ -20,6 +20,7 @@
 #    include "../core/EnumMap.hpp"
 #    include "../core/File.h"
 #    include "../core/FileScanner.h"
+#    include "../core/FileStream.h"
 #    include "../core/Path.hpp"
 #    include "../interface/InteractiveConsole.h"
 #    include "../platform/Platform.h"
@@ -36,6 +37,7 @@
 #    include "bindings/game/ScDisposable.hpp"
 #    include "bindings/game/ScPlugin.hpp"
 #    include "bindings/game/ScProfiler.hpp"
+#    include "bindings/game/ScWorker.hpp"
 #    include "bindings/network/ScNetwork.hpp"
 #    include "bindings/network/ScPlayer.hpp"
 #    include "bindings/network/ScPlayerGroup.hpp"
@@ -55,6 +57,7 @@
 #    include "bindings/world/ScTile.hpp"
 #    include "bindings/world/ScTileElement.hpp"
 
+#    include <algorithm>
 #    include <iostream>
 #    include <memory>
 #    include <stdexcept>
@@ -369,9 +372,10 @@ public:
     }
 };
 
-DukContext::DukContext()
+DukContext::DukContext(DukHeapAllocator& heapAllocator)
 {
-    _context = duk_create_heap_default();
+    _context = duk_create_heap(
+        DukHeapAllocator::Alloc, DukHeapAllocator::Realloc, DukHeapAllocator::Free, &heapAllocator, nullptr);
     if (_context == nullptr)
     {
         throw std::runtime_error("Unable to initialise duktape context.");
@@ -386,7 +390,11 @@ DukContext::~DukContext()
 ScriptEngine::ScriptEngine(InteractiveConsole& console, IPlatformEnvironment& env)
     : _console(console)
     , _env(env)
+    , _context(_heapAllocator)
     , _hookEngine(*this)
+    , _execInfo(_heapAllocator)
+    , _sharedStorage(_context)
+    , _parkStorage(_context)
 {
 }
 
@@ -445,6 +453,7 @@ void ScriptEngine::Initialise()
     ScPatrolArea::Register(ctx);
     ScStaff::Register(ctx);
     ScPlugin::Register(ctx);
+    ScWorker::Register(ctx);
 
     dukglue_register_global(ctx, std::make_shared<ScCheats>(), "cheats");
     dukglue_register_global(ctx, std::make_shared<ScClimate>(), "climate");
@@ -630,7 +639,7 @@ void ScriptEngine::RegisterPlugin(std::string_view path)
 {
     try
     {
-        auto plugin = std::make_shared<Plugin>(_context, path);
+        auto plugin = std::make_shared<Plugin>(_context, path, &_heapAllocator);
 
         // We must load the plugin to get the metadata for it
         ScriptExecutionInfo::PluginScope scope(_execInfo, plugin, false);
@@ -694,7 +703,7 @@ void ScriptEngine::LoadTransientPlugins()
 
 void ScriptEngine::LoadPlugin(const std::string& path)
 {
-    auto plugin = std::make_shared<Plugin>(_context, path);
+    auto plugin = std::make_shared<Plugin>(_context, path, &_heapAllocator);
     LoadPlugin(plugin);
 }
 
@@ -762,6 +771,7 @@ void ScriptEngine::StopPlugin(std::shared_ptr<Plugin> plugin)
         RemoveCustomGameActions(plugin);
         RemoveIntervals(plugin);
         RemoveSockets(plugin);
+        RemoveWorkers(plugin);
         _hookEngine.UnsubscribeAll(plugin);
 
         plugin->StopEnd();
@@ -910,9 +920,14 @@ void ScriptEngine::Tick()
 {
     PROFILED_FUNCTION();
 
+    _heapAllocator.SetLimit(static_cast<uint64_t>(std::max(gConfigPlugin.MemoryLimit, 0)) * 1024 * 1024);
+    _heapAllocator.Update();
+    _hookEngine.BeginBudgetWindow();
+
     CheckAndStartPlugins();
     UpdateIntervals();
     UpdateSockets();
+    UpdateWorkers();
     ProcessREPL();
     DoAutoReloadPluginCheck();
 }
@@ -1025,7 +1040,7 @@ void ScriptEngine::LogPluginInfo(const std::shared_ptr<Plugin>& plugin, std::str
 
 void ScriptEngine::AddNetworkPlugin(std::string_view code)
 {
-    auto plugin = std::make_shared<Plugin>(_context, std::string());
+    auto plugin = std::make_shared<Plugin>(_context, std::string(), &_heapAllocator);
     plugin->SetCode(code);
     _plugins.push_back(plugin);
 }
@@ -1421,12 +1436,55 @@ static std::unique_ptr<GameAction> CreateGameActionFromActionId(const std::strin
     return nullptr;
 }
 
+ActionHookFilter ScriptEngine::ParseActionHookFilter(const DukValue& dukFilter)
+{
+    ActionHookFilter filter;
+    if (dukFilter["actions"].type() == DukValue::Type::OBJECT)
+    {
+        for (const auto& dukAction : dukFilter["actions"].as_array())
+        {
+            auto name = AsOrDefault<std::string>(dukAction);
+            auto result = ActionNameToType.find(name);
+            if (result == ActionNameToType.end())
+            {
+                // A misspelled name would otherwise filter out every action without any notice.
+                duk_error(
+                    _context, DUK_ERR_ERROR, "Unknown action '%s', custom actions have to be listed in customActions.",
+                    name.c_str());
+            }
+            filter.Actions.push_back(result->second);
+        }
+    }
+    if (dukFilter["customActions"].type() == DukValue::Type::OBJECT)
+    {
+        // Custom actions may be registered by plugins that are started later, so they are not checked.
+        for (const auto& dukAction : dukFilter["customActions"].as_array())
+        {
+            filter.CustomActions.push_back(AsOrDefault<std::string>(dukAction));
+        }
+    }
+    if (dukFilter["players"].type() == DukValue::Type::OBJECT)
+    {
+        for (const auto& dukPlayer : dukFilter["players"].as_array())
+        {
+            filter.Players.push_back(AsOrDefault<int32_t>(dukPlayer));
+        }
+    }
+    // Flags use the top bit, which does not fit an int32.
+    auto getFlags = [](const DukValue& dukFlags) {
+        return dukFlags.type() == DukValue::Type::NUMBER ? static_cast<uint32_t>(dukFlags.as_double()) : 0;
+    };
+    filter.Flags = getFlags(dukFilter["flags"]);
+    filter.ExcludedFlags = getFlags(dukFilter["excludeFlags"]);
+    return filter;
+}
+
 void ScriptEngine::RunGameActionHooks(const GameAction& action, GameActions::Result& result, bool isExecute)
 {
     DukStackFrame frame(_context);
 
     auto hookType = isExecute ? HOOK_TYPE::ACTION_EXECUTE : HOOK_TYPE::ACTION_QUERY;
-    if (_hookEngine.HasSubscriptions(hookType))
+    if (_hookEngine.HasSubscriptions(hookType, action))
     {
         DukObject obj(_context);
 
@@ -1471,7 +1529,7 @@ void ScriptEngine::RunGameActionHooks(const GameAction& action, GameActions::Res
         obj.Set("result", GameActionResultToDuk(action, result));
         auto dukEventArgs = obj.Take();
 
-        _hookEngine.Call(hookType, dukEventArgs, false);
+        _hookEngine.Call(hookType, action, dukEventArgs, false);
 
         if (!isExecute)
         {
@@ -1528,46 +1586,94 @@ std::unique_ptr<GameAction> ScriptEngine::CreateGameAction(
     return customAction;
 }
 
-void ScriptEngine::InitSharedStorage()
-{
-    duk_push_object(_context);
-    _sharedStorage = std::move(DukValue::take_from_stack(_context));
-}
-
 void ScriptEngine::LoadSharedStorage()
 {
-    InitSharedStorage();
+    _sharedStorage.Clear();
+    _sharedStorageSnapshotSize = 0;
+    _sharedStorageJournalSize = 0;
 
-    auto path = _env.GetFilePath(PATHID::PLUGIN_STORE);
+    auto path = _env.GetFilePath(PATHID::PLUGIN_STORE_DATA);
     try
     {
         if (File::Exists(path))
         {
             auto data = File::ReadAllBytes(path);
-            auto result = DuktapeTryParseJson(
-                _context, std::string_view(reinterpret_cast<const char*>(data.data()), data.size()));
-            if (result)
+            auto result = _sharedStorage.Read(data.data(), data.size());
+            if (result == PluginStoreReadResult::Complete)
+            {
+                _sharedStorageSnapshotSize = data.size();
+                return;
+            }
+            if (result == PluginStoreReadResult::Incomplete)
             {
-                _sharedStorage = std::move(*result);
+                // Changes appended after the damaged record would never be read back, write the file again without it.
+                Console::Error::WriteLine("Ignored a damaged record at the end of '%s'", path.c_str());
+                WriteSharedStorage();
+                return;
             }
+            Console::Error::WriteLine("Unable to read '%s'", path.c_str());
         }
     }
     catch (const std::exception&)
     {
         Console::Error::WriteLine("Unable to read '%s'", path.c_str());
     }
+
+    // Storage used to be kept as JSON, which is imported the first time. The old file is left for older versions.
+    auto legacyPath = _env.GetFilePath(PATHID::PLUGIN_STORE);
+    try
+    {
+        if (File::Exists(legacyPath))
+        {
+            auto data = File::ReadAllBytes(legacyPath);
+            if (_sharedStorage.FromJson(std::string_view(reinterpret_cast<const char*>(data.data()), data.size())))
+            {
+                WriteSharedStorage();
+            }
+        }
+    }
+    catch (const std::exception&)
+    {
+        Console::Error::WriteLine("Unable to read '%s'", legacyPath.c_str());
+    }
 }
 
 void ScriptEngine::SaveSharedStorage()
 {
-    auto path = _env.GetFilePath(PATHID::PLUGIN_STORE);
+    // Only the values that changed are appended, the file is written again once they take up more than the rest of it.
+    constexpr size_t MinJournalSize = 64 * 1024;
+    auto path = _env.GetFilePath(PATHID::PLUGIN_STORE_DATA);
+    if (_sharedStorageSnapshotSize == 0 || _sharedStorageJournalSize > std::max(_sharedStorageSnapshotSize, MinJournalSize))
+    {
+        WriteSharedStorage();
+        return;
+    }
+
     try
     {
-        _sharedStorage.push();
-        auto json = std::string(duk_json_encode(_context, -1));
-        duk_pop(_context);
+        auto data = _sharedStorage.WriteChanges();
+        if (!data.empty())
+        {
+            FileStream fs(path, FILE_MODE_APPEND);
+            fs.Write(data.data(), data.size());
+            _sharedStorageJournalSize += data.size();
+        }
+    }
+    catch (const std::exception&)
+    {
+        Console::Error::WriteLine("Unable to write to '%s'", path.c_str());
+    }
+}
 
-        File::WriteAllBytes(path, json.c_str(), json.size());
+void ScriptEngine::WriteSharedStorage()
+{
+    auto path = _env.GetFilePath(PATHID::PLUGIN_STORE_DATA);
+    try
+    {
+        auto data = _sharedStorage.Write();
+        File::WriteAllBytes(path, data.data(), data.size());
+        _sharedStorageSnapshotSize = data.size();
+        _sharedStorageJournalSize = 0;
     }
     catch (const std::exception&)
     {
@@ -1575,27 +1681,34 @@ void ScriptEngine::SaveSharedStorage()
     }
 }
 
+std::string ScriptEngine::GetSharedStorageAsJSON()
+{
+    return _sharedStorage.ToJson();
+}
+
+bool ScriptEngine::SetSharedStorageFromJSON(std::string_view value)
+{
+    if (!_sharedStorage.FromJson(value))
+    {
+        return false;
+    }
+    WriteSharedStorage();
+    return true;
+}
+
 void ScriptEngine::ClearParkStorage()
 {
-    duk_push_object(_context);
-    _parkStorage = std::move(DukValue::take_from_stack(_context));
+    _parkStorage.Clear();
 }
 
 std::string ScriptEngine::GetParkStorageAsJSON()
 {
-    _parkStorage.push();
-    auto json = std::string(duk_json_encode(_context, -1));
-    duk_pop(_context);
-    return json;
+    return _parkStorage.ToJson();
 }
 
-void ScriptEngine::SetParkStorageFromJSON(std::string_view value)
+bool ScriptEngine::SetParkStorageFromJSON(std::string_view value)
 {
-    auto result = DuktapeTryParseJson(_context, value);
-    if (result)
-    {
-        _parkStorage = std::move(*result);
-    }
+    return _parkStorage.FromJson(value);
 }
 
 IntervalHandle ScriptEngine::AllocateHandle()
@@ -1762,6 +1875,59 @@ void ScriptEngine::RemoveSockets(const std::shared_ptr<Plugin>& plugin)
 #    endif
 }
 
+void ScriptEngine::AddWorker(const std::shared_ptr<ScWorker>& worker)
+{
+    _workers.push_back(worker);
+    RunWorker(worker->GetWorker());
+}
+
+void ScriptEngine::RunWorker(const std::shared_ptr<PluginWorker>& worker)
+{
+    if (_workerJobs == nullptr)
+    {
+        // Leave the remaining cores to the game and the paint jobs.
+        _workerJobs = std::make_unique<JobPool>(2);
+    }
+    _workerJobs->AddTask([worker]() { worker->Run(); });
+}
+
+void ScriptEngine::UpdateWorkers()
+{
+    // Use iterators as handlers can create or terminate workers
+    auto it = _workers.begin();
+    while (it != _workers.end())
+    {
+        auto worker = *it;
+        worker->Update();
+        if (worker->IsTerminated())
+        {
+            it = _workers.erase(it);
+        }
+        else
+        {
+            it++;
+        }
+    }
+}
+
+void ScriptEngine::RemoveWorkers(const std::shared_ptr<Plugin>& plugin)
+{
+    auto it = _workers.begin();
+    while (it != _workers.end())
+    {
+        auto worker = it->get();
+        if (worker->GetPlugin() == plugin)
+        {
+            worker->Terminate();
+            it = _workers.erase(it);
+        }
+        else
+        {
+            it++;
+        }
+    }
+}
+
 std::string OpenRCT2::Scripting::Stringify(const DukValue& val)
 {
     return ExpressionStringifier::StringifyExpression(val);
@@ -1818,9 +1984,10 @@ int32_t OpenRCT2::Scripting::GetTargetAPIVersion()
     return plugin->GetTargetAPIVersion();
 }
 
-duk_bool_t duk_exec_timeout_check(void*)
+duk_bool_t duk_exec_timeout_check(void* udata)
 {
-    return false;
+    // Every heap is created with its allocator as user data.
+    return static_cast<DukHeapAllocator*>(udata)->IsInterrupted();
 }
 
 #endif
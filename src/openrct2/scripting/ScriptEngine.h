@@ -14,10 +14,13 @@
 #    include "../actions/CustomAction.h"
 #    include "../common.h"
 #    include "../core/FileWatcher.h"
+#    include "../core/JobPool.h"
 #    include "../management/Finance.h"
 #    include "../world/Location.hpp"
+#    include "DukHeapAllocator.h"
 #    include "HookEngine.h"
 #    include "Plugin.h"
+#    include "PluginStore.h"
 
 #    include <future>
 #    include <list>
@@ -47,7 +50,7 @@ namespace OpenRCT2
 
 namespace OpenRCT2::Scripting
 {
-    static constexpr int32_t OPENRCT2_PLUGIN_API_VERSION = 83;
+    static constexpr int32_t OPENRCT2_PLUGIN_API_VERSION = 90;
 
     // Versions marking breaking changes.
     static constexpr int32_t API_VERSION_33_PEEP_DEPRECATION = 33;
@@ -58,13 +61,23 @@ namespace OpenRCT2::Scripting
 #    ifndef DISABLE_NETWORK
     class ScSocketBase;
 #    endif
+    class ScWorker;
+    class PluginWorker;
 
     class ScriptExecutionInfo
     {
     private:
+        DukHeapAllocator& _heapAllocator;
         std::shared_ptr<Plugin> _plugin;
         bool _isGameStateMutable{};
 
+        void SetPlugin(std::shared_ptr<Plugin> plugin)
+        {
+            // Whatever the plugin allocates is attributed to it.
+            _heapAllocator.SetOwner(plugin != nullptr ? plugin->GetHeapOwner() : DUK_HEAP_OWNER_NONE);
+            _plugin = std::move(plugin);
+        }
+
     public:
         class PluginScope
         {
@@ -83,17 +96,22 @@ namespace OpenRCT2::Scripting
                 _backupPlugin = _execInfo._plugin;
                 _backupIsGameStateMutable = _execInfo._isGameStateMutable;
 
-                _execInfo._plugin = std::move(plugin);
+                _execInfo.SetPlugin(std::move(plugin));
                 _execInfo._isGameStateMutable = isGameStateMutable;
             }
             PluginScope(const PluginScope&) = delete;
             ~PluginScope()
             {
-                _execInfo._plugin = _backupPlugin;
+                _execInfo.SetPlugin(_backupPlugin);
                 _execInfo._isGameStateMutable = _backupIsGameStateMutable;
             }
         };
 
+        explicit ScriptExecutionInfo(DukHeapAllocator& heapAllocator)
+            : _heapAllocator(heapAllocator)
+        {
+        }
+
         std::shared_ptr<Plugin> GetCurrentPlugin()
         {
             return _plugin;
@@ -111,7 +129,7 @@ namespace OpenRCT2::Scripting
         duk_context* _context{};
 
     public:
-        DukContext();
+        explicit DukContext(DukHeapAllocator& heapAllocator);
         DukContext(DukContext&) = delete;
         DukContext(DukContext&& src) noexcept
             : _context(std::move(src._context))
@@ -142,6 +160,7 @@ namespace OpenRCT2::Scripting
     private:
         InteractiveConsole& _console;
         IPlatformEnvironment& _env;
+        DukHeapAllocator _heapAllocator;
         DukContext _context;
         bool _initialised{};
         bool _hotReloadingInitialised{};
@@ -153,8 +172,11 @@ namespace OpenRCT2::Scripting
         uint32_t _lastHotReloadCheckTick{};
         HookEngine _hookEngine;
         ScriptExecutionInfo _execInfo;
-        DukValue _sharedStorage;
-        DukValue _parkStorage;
+        PluginStore _sharedStorage;
+        PluginStore _parkStorage;
+        // Bytes of the shared storage file taken up by the last complete write and the changes appended since.
+        size_t _sharedStorageSnapshotSize{};
+        size_t _sharedStorageJournalSize{};
 
         uint32_t _lastIntervalTimestamp{};
         std::map<IntervalHandle, ScriptInterval> _intervals;
@@ -177,6 +199,9 @@ namespace OpenRCT2::Scripting
 #    ifndef DISABLE_NETWORK
         std::list<std::shared_ptr<ScSocketBase>> _sockets;
 #    endif
+        std::list<std::shared_ptr<ScWorker>> _workers;
+        // Created with the first worker.
+        std::unique_ptr<JobPool> _workerJobs;
 
     public:
         ScriptEngine(InteractiveConsole& console, IPlatformEnvironment& env);
@@ -194,11 +219,15 @@ namespace OpenRCT2::Scripting
         {
             return _execInfo;
         }
-        DukValue GetSharedStorage()
+        const DukHeapAllocator& GetHeapAllocator() const
+        {
+            return _heapAllocator;
+        }
+        PluginStore& GetSharedStorage()
         {
             return _sharedStorage;
         }
-        DukValue GetParkStorage()
+        PluginStore& GetParkStorage()
         {
             return _parkStorage;
         }
@@ -223,7 +252,9 @@ namespace OpenRCT2::Scripting
 
         void ClearParkStorage();
         std::string GetParkStorageAsJSON();
-        void SetParkStorageFromJSON(std::string_view value);
+        bool SetParkStorageFromJSON(std::string_view value);
+        std::string GetSharedStorageAsJSON();
+        bool SetSharedStorageFromJSON(std::string_view value);
 
         void Initialise();
         void LoadTransientPlugins();
@@ -253,6 +284,7 @@ namespace OpenRCT2::Scripting
         bool RegisterCustomAction(
             const std::shared_ptr<Plugin>& plugin, std::string_view action, const DukValue& query, const DukValue& execute);
         void RunGameActionHooks(const GameAction& action, GameActions::Result& result, bool isExecute);
+        [[nodiscard]] ActionHookFilter ParseActionHookFilter(const DukValue& dukFilter);
         [[nodiscard]] std::unique_ptr<GameAction> CreateGameAction(
             const std::string& actionid, const DukValue& args, const std::string& pluginName);
         [[nodiscard]] DukValue GameActionResultToDuk(const GameAction& action, const GameActions::Result& result);
@@ -265,6 +297,8 @@ namespace OpenRCT2::Scripting
 #    ifndef DISABLE_NETWORK
         void AddSocket(const std::shared_ptr<ScSocketBase>& socket);
 #    endif
+        void AddWorker(const std::shared_ptr<ScWorker>& worker);
+        void RunWorker(const std::shared_ptr<PluginWorker>& worker);
 
     private:
         void RegisterConstants();
@@ -292,8 +326,8 @@ namespace OpenRCT2::Scripting
         static std::string_view ExpenditureTypeToString(ExpenditureType expenditureType);
         static ExpenditureType StringToExpenditureType(std::string_view expenditureType);
 
-        void InitSharedStorage();
         void LoadSharedStorage();
+        void WriteSharedStorage();
 
         IntervalHandle AllocateHandle();
         void UpdateIntervals();
@@ -301,6 +335,9 @@ namespace OpenRCT2::Scripting
 
         void UpdateSockets();
         void RemoveSockets(const std::shared_ptr<Plugin>& plugin);
+
+        void UpdateWorkers();
+        void RemoveWorkers(const std::shared_ptr<Plugin>& plugin);
     };
 
     bool IsGameStateMutable();
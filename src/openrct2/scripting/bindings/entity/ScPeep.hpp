@@ -11,6 +11,8 @@
 
 #ifdef ENABLE_SCRIPTING
 
+#    include "../../../entity/Guest.h"
+#    include "../../../entity/GuestAggregation.h"
 #    include "ScEntity.hpp"
 
 namespace OpenRCT2::Scripting
@@ -111,6 +113,11 @@ namespace OpenRCT2::Scripting
                     peep->PeepFlags |= mask;
                 else
                     peep->PeepFlags &= ~mask;
+                auto* guest = peep->As<Guest>();
+                if (guest != nullptr)
+                {
+                    GetGuestAggregation().MarkChanged(*guest);
+                }
                 peep->Invalidate();
             }
         }
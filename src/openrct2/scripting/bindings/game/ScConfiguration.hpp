@@ -31,6 +31,9 @@ namespace OpenRCT2::Scripting
     private:
         ScConfigurationKind _kind;
         DukValue _backingObject;
+        PluginStore* _store{};
+        // Path within the store of the backing object.
+        PluginStore::Path _storePath;
 
     public:
         // context.configuration
@@ -40,9 +43,12 @@ namespace OpenRCT2::Scripting
         }
 
         // context.sharedStorage / context.getParkStorage
-        ScConfiguration(ScConfigurationKind kind, const DukValue& backingObject)
+        ScConfiguration(
+            ScConfigurationKind kind, const DukValue& backingObject, PluginStore& store, PluginStore::Path storePath = {})
             : _kind(kind)
             , _backingObject(backingObject)
+            , _store(&store)
+            , _storePath(std::move(storePath))
         {
         }
 
@@ -151,6 +157,39 @@ namespace OpenRCT2::Scripting
             return !key.empty() && key.find('.') == std::string_view::npos;
         }
 
+        PluginStore::Path GetStorePath(std::string_view ns) const
+        {
+            auto path = _storePath;
+            if (!ns.empty())
+            {
+                auto k = ns;
+                do
+                {
+                    auto [next, remainder] = GetNextNamespace(k);
+                    path.emplace_back(next);
+                    k = remainder;
+                } while (!k.empty());
+            }
+            return path;
+        }
+
+        PluginStore::Path GetStorePath(std::string_view ns, std::string_view key) const
+        {
+            auto path = GetStorePath(ns);
+            path.emplace_back(key);
+            return path;
+        }
+
+        // Objects and arrays are shared by reference and can be changed without being set again, so the records holding
+        // them are checked for changes on every write.
+        void MarkHandedOut(const PluginStore::Path& path, const DukValue& value) const
+        {
+            if (value.type() == DukValue::Type::OBJECT)
+            {
+                _store->MarkHandedOut(path);
+            }
+        }
+
         DukValue getAll(const DukValue& dukNamespace) const
         {
             DukValue result;
@@ -181,7 +220,15 @@ namespace OpenRCT2::Scripting
                 else
                 {
                     auto obj = GetNamespaceObject(ns);
-                    result = obj ? *obj : DukObject(ctx).Take();
+                    if (obj)
+                    {
+                        MarkHandedOut(GetStorePath(ns), *obj);
+                        result = *obj;
+                    }
+                    else
+                    {
+                        result = DukObject(ctx).Take();
+                    }
                 }
             }
             else
@@ -192,6 +239,11 @@ namespace OpenRCT2::Scripting
         }
 
         DukValue get(const std::string& key, const DukValue& defaultValue) const
+        {
+            return GetValue(key, defaultValue, true);
+        }
+
+        DukValue GetValue(const std::string& key, const DukValue& defaultValue, bool handOut) const
         {
             auto ctx = GetContext()->GetScriptEngine().GetContext();
             if (_kind == ScConfigurationKind::User)
@@ -228,6 +280,10 @@ namespace OpenRCT2::Scripting
                         auto val = (*obj)[n];
                         if (val.type() != DukValue::Type::UNDEFINED)
                         {
+                            if (handOut)
+                            {
+                                MarkHandedOut(GetStorePath(ns, n), val);
+                            }
                             return val;
                         }
                     }
@@ -284,14 +340,20 @@ namespace OpenRCT2::Scripting
                     }
                     duk_pop(ctx);
 
-                    scriptEngine.SaveSharedStorage();
+                    auto path = GetStorePath(ns, n);
+                    _store->MarkChanged(path);
+                    MarkHandedOut(path, value);
+                    if (_kind == ScConfigurationKind::Shared)
+                    {
+                        scriptEngine.SaveSharedStorage();
+                    }
                 }
             }
         }
 
         bool has(const std::string& key) const
         {
-            auto val = get(key, DukValue());
+            auto val = GetValue(key, DukValue(), false);
             return val.type() != DukValue::Type::UNDEFINED;
         }
     };
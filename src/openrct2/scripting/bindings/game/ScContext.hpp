@@ -23,6 +23,7 @@
 #    include "../../ScriptEngine.h"
 #    include "../game/ScConfiguration.hpp"
 #    include "../game/ScDisposable.hpp"
+#    include "../game/ScWorker.hpp"
 #    include "../object/ScObjectManager.h"
 #    include "../ride/ScTrackSegment.h"
 
@@ -58,13 +59,15 @@ namespace OpenRCT2::Scripting
         std::shared_ptr<ScConfiguration> sharedStorage_get()
         {
             auto& scriptEngine = GetContext()->GetScriptEngine();
-            return std::make_shared<ScConfiguration>(ScConfigurationKind::Shared, scriptEngine.GetSharedStorage());
+            auto& sharedStorage = scriptEngine.GetSharedStorage();
+            return std::make_shared<ScConfiguration>(ScConfigurationKind::Shared, sharedStorage.GetRoot(), sharedStorage);
         }
 
         std::shared_ptr<ScConfiguration> GetParkStorageForPlugin(std::string_view pluginName)
         {
             auto& scriptEngine = GetContext()->GetScriptEngine();
-            auto parkStore = scriptEngine.GetParkStorage();
+            auto& parkStorage = scriptEngine.GetParkStorage();
+            auto parkStore = parkStorage.GetRoot();
             auto pluginStore = parkStore[pluginName];
 
             // Create if it doesn't exist
@@ -79,7 +82,8 @@ namespace OpenRCT2::Scripting
                 pluginStore = parkStore[pluginName];
             }
 
-            return std::make_shared<ScConfiguration>(ScConfigurationKind::Park, pluginStore);
+            return std::make_shared<ScConfiguration>(
+                ScConfigurationKind::Park, pluginStore, parkStorage, PluginStore::Path{ std::string(pluginName) });
         }
 
         std::shared_ptr<ScConfiguration> getParkStorage(const DukValue& dukPluginName)
@@ -261,14 +265,15 @@ namespace OpenRCT2::Scripting
         //      Only ensuring it was not in the same generated method fixed it.
         __declspec(noinline)
 #    endif
-            std::shared_ptr<ScDisposable> CreateSubscription(HOOK_TYPE hookType, const DukValue& callback)
+            std::shared_ptr<ScDisposable> CreateSubscription(
+                HOOK_TYPE hookType, const DukValue& callback, std::optional<ActionHookFilter> filter)
         {
             auto owner = _execInfo.GetCurrentPlugin();
-            auto cookie = _hookEngine.Subscribe(hookType, owner, callback);
+            auto cookie = _hookEngine.Subscribe(hookType, owner, callback, std::move(filter));
             return std::make_shared<ScDisposable>([this, hookType, cookie]() { _hookEngine.Unsubscribe(hookType, cookie); });
         }
 
-        std::shared_ptr<ScDisposable> subscribe(const std::string& hook, const DukValue& callback)
+        std::shared_ptr<ScDisposable> subscribe(const std::string& hook, const DukValue& callback, const DukValue& dukFilter)
         {
             auto& scriptEngine = GetContext()->GetScriptEngine();
             auto ctx = scriptEngine.GetContext();
@@ -295,7 +300,17 @@ namespace OpenRCT2::Scripting
                 duk_error(ctx, DUK_ERR_ERROR, "Hook type not available for this plugin type.");
             }
 
-            return CreateSubscription(hookType, callback);
+            std::optional<ActionHookFilter> filter;
+            if (dukFilter.type() == DukValue::Type::OBJECT)
+            {
+                if (hookType != HOOK_TYPE::ACTION_QUERY && hookType != HOOK_TYPE::ACTION_EXECUTE)
+                {
+                    duk_error(ctx, DUK_ERR_ERROR, "Filters are only supported for action hooks.");
+                }
+                filter = scriptEngine.ParseActionHookFilter(dukFilter);
+            }
+
+            return CreateSubscription(hookType, callback, std::move(filter));
         }
 
         void queryAction(const std::string& action, const DukValue& args, const DukValue& callback)
@@ -425,6 +440,20 @@ namespace OpenRCT2::Scripting
             return GetIconByName(iconName);
         }
 
+        std::shared_ptr<ScWorker> createWorker(const std::string& script)
+        {
+            auto& scriptEngine = GetContext()->GetScriptEngine();
+            auto plugin = scriptEngine.GetExecInfo().GetCurrentPlugin();
+            if (plugin == nullptr)
+            {
+                duk_error(scriptEngine.GetContext(), DUK_ERR_ERROR, "Not in a plugin context");
+            }
+
+            auto worker = std::make_shared<ScWorker>(plugin, std::make_shared<PluginWorker>(script));
+            scriptEngine.AddWorker(worker);
+            return worker;
+        }
+
     public:
         static void Register(duk_context* ctx)
         {
@@ -449,6 +478,7 @@ namespace OpenRCT2::Scripting
             dukglue_register_method(ctx, &ScContext::clearInterval, "clearInterval");
             dukglue_register_method(ctx, &ScContext::clearTimeout, "clearTimeout");
             dukglue_register_method(ctx, &ScContext::getIcon, "getIcon");
+            dukglue_register_method(ctx, &ScContext::createWorker, "createWorker");
         }
     };
 
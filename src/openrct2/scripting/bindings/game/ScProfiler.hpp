@@ -11,8 +11,10 @@
 
 #ifdef ENABLE_SCRIPTING
 
+#    include "../../../Context.h"
 #    include "../../../profiling/Profiling.h"
 #    include "../../Duktape.hpp"
+#    include "../../ScriptEngine.h"
 
 namespace OpenRCT2::Scripting
 {
@@ -69,6 +71,50 @@ namespace OpenRCT2::Scripting
             return DukValue::take_from_stack(_ctx);
         }
 
+        DukValue getPluginData()
+        {
+            duk_push_array(_ctx);
+            duk_uarridx_t index = 0;
+            for (const auto& plugin : GetContext()->GetScriptEngine().GetPlugins())
+            {
+                const auto& profile = plugin->GetHookProfile();
+                DukObject hooks(_ctx);
+                for (size_t i = 0; i < profile.Hooks.size(); i++)
+                {
+                    const auto& stats = profile.Hooks[i];
+                    if (stats.CallCount != 0)
+                    {
+                        DukObject hook(_ctx);
+                        hook.Set("callCount", stats.CallCount);
+                        hook.Set("totalTime", stats.TotalTime);
+                        hook.Set("maxTime", stats.MaxTime);
+                        hooks.Set(std::string(GetHookName(static_cast<HOOK_TYPE>(i))).c_str(), hook.Take());
+                    }
+                }
+
+                const auto& heapStats = GetContext()->GetScriptEngine().GetHeapAllocator().GetStats(plugin->GetHeapOwner());
+                DukObject memory(_ctx);
+                memory.Set("liveBytes", heapStats.LiveBytes);
+                memory.Set("peakBytes", heapStats.PeakBytes);
+                memory.Set("allocations", heapStats.Allocations);
+                memory.Set("allocatedBytes", heapStats.AllocatedBytes);
+                memory.Set("allocationRate", heapStats.AllocationRate);
+                memory.Set("allocatedBytesRate", heapStats.AllocatedBytesRate);
+                memory.Set("failedAllocations", heapStats.FailedAllocations);
+
+                DukObject obj(_ctx);
+                obj.Set("name", plugin->GetMetadata().Name);
+                obj.Set("hooks", hooks.Take());
+                obj.Set("memory", memory.Take());
+                obj.Set("overBudgetTicks", profile.OverBudgetTicks);
+                obj.Set("suspended", profile.Suspended);
+                obj.Take().push();
+                duk_put_prop_index(_ctx, /* duk stack index */ -2, index);
+                index++;
+            }
+            return DukValue::take_from_stack(_ctx);
+        }
+
         void start()
         {
             OpenRCT2::Profiling::Enable();
@@ -82,6 +128,12 @@ namespace OpenRCT2::Scripting
         void reset()
         {
             OpenRCT2::Profiling::ResetData();
+            for (const auto& plugin : GetContext()->GetScriptEngine().GetPlugins())
+            {
+                auto& profile = plugin->GetHookProfile();
+                profile.Hooks = {};
+                profile.OverBudgetTicks = 0;
+            }
         }
 
         bool enabled_get() const
@@ -93,6 +145,7 @@ namespace OpenRCT2::Scripting
         static void Register(duk_context* ctx)
         {
             dukglue_register_method(ctx, &ScProfiler::getData, "getData");
+            dukglue_register_method(ctx, &ScProfiler::getPluginData, "getPluginData");
             dukglue_register_method(ctx, &ScProfiler::start, "start");
             dukglue_register_method(ctx, &ScProfiler::stop, "stop");
             dukglue_register_method(ctx, &ScProfiler::reset, "reset");
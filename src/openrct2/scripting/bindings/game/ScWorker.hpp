@@ -0,0 +1,177 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2024 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#pragma once
+
+#ifdef ENABLE_SCRIPTING
+
+#    include "../../../Context.h"
+#    include "../../Duktape.hpp"
+#    include "../../EventList.hpp"
+#    include "../../PluginWorker.h"
+#    include "../../ScriptEngine.h"
+
+#    include <limits>
+#    include <memory>
+#    include <vector>
+
+namespace OpenRCT2::Scripting
+{
+    class ScWorker
+    {
+    private:
+        static constexpr uint32_t EVENT_NONE = std::numeric_limits<uint32_t>::max();
+        static constexpr uint32_t EVENT_MESSAGE = 0;
+        static constexpr uint32_t EVENT_ERROR = 1;
+
+        std::shared_ptr<Plugin> _plugin;
+        std::shared_ptr<PluginWorker> _worker;
+        EventList _eventList;
+        // Messages are handed to the worker at the end of the tick.
+        std::vector<std::vector<uint8_t>> _pendingMessages;
+
+    public:
+        ScWorker(const std::shared_ptr<Plugin>& plugin, const std::shared_ptr<PluginWorker>& worker)
+            : _plugin(plugin)
+            , _worker(worker)
+        {
+        }
+
+        const std::shared_ptr<Plugin>& GetPlugin() const
+        {
+            return _plugin;
+        }
+
+        const std::shared_ptr<PluginWorker>& GetWorker() const
+        {
+            return _worker;
+        }
+
+        bool IsTerminated() const
+        {
+            return _worker->IsTerminated();
+        }
+
+        void Terminate()
+        {
+            _worker->Terminate();
+            _pendingMessages.clear();
+        }
+
+        void Update()
+        {
+            if (IsTerminated())
+                return;
+
+            auto& scriptEngine = GetContext()->GetScriptEngine();
+            if (_worker->Post(std::move(_pendingMessages)))
+            {
+                scriptEngine.RunWorker(_worker);
+            }
+            _pendingMessages.clear();
+
+            // Whenever the worker replies, the handlers can not change the game state as the reply does not arrive on
+            // the same tick for every client.
+            auto ctx = scriptEngine.GetContext();
+            for (auto& message : _worker->TakeMessages())
+            {
+                // A handler may have terminated the worker.
+                if (IsTerminated())
+                    break;
+
+                switch (message.Type)
+                {
+                    case PluginWorkerMessage::Kind::Message:
+                        if (DuktapeTryDecodeCbor(ctx, message.Data.data(), message.Data.size()))
+                        {
+                            auto dukMessage = DukValue::take_from_stack(ctx);
+                            _eventList.Raise(EVENT_MESSAGE, _plugin, { dukMessage }, false);
+                        }
+                        else
+                        {
+                            scriptEngine.LogPluginInfo(_plugin, "Unable to read message from worker.");
+                        }
+                        break;
+                    case PluginWorkerMessage::Kind::Error:
+                        scriptEngine.LogPluginInfo(_plugin, "Worker error: " + message.Text);
+                        _eventList.Raise(EVENT_ERROR, _plugin, { ToDuk(ctx, message.Text) }, false);
+                        break;
+                    case PluginWorkerMessage::Kind::Log:
+                        scriptEngine.LogPluginInfo(_plugin, message.Text);
+                        break;
+                }
+            }
+        }
+
+    private:
+        void postMessage(const DukValue& message)
+        {
+            auto ctx = message.context();
+            if (IsTerminated())
+            {
+                duk_error(ctx, DUK_ERR_ERROR, "Worker has been terminated.");
+            }
+
+            message.push();
+            std::vector<uint8_t> data;
+            auto cloned = DuktapeTryEncodeCbor(ctx, -1, data);
+            duk_pop(ctx);
+            if (!cloned)
+            {
+                duk_error(ctx, DUK_ERR_TYPE_ERROR, "Unable to clone message.");
+            }
+            _pendingMessages.push_back(std::move(data));
+        }
+
+        void terminate()
+        {
+            Terminate();
+        }
+
+        ScWorker* on(const std::string& eventType, const DukValue& callback)
+        {
+            auto eventId = GetEventType(eventType);
+            if (eventId != EVENT_NONE)
+            {
+                _eventList.AddListener(eventId, callback);
+            }
+            return this;
+        }
+
+        ScWorker* off(const std::string& eventType, const DukValue& callback)
+        {
+            auto eventId = GetEventType(eventType);
+            if (eventId != EVENT_NONE)
+            {
+                _eventList.RemoveListener(eventId, callback);
+            }
+            return this;
+        }
+
+        static uint32_t GetEventType(std::string_view name)
+        {
+            if (name == "message")
+                return EVENT_MESSAGE;
+            if (name == "error")
+                return EVENT_ERROR;
+            return EVENT_NONE;
+        }
+
+    public:
+        static void Register(duk_context* ctx)
+        {
+            dukglue_register_method(ctx, &ScWorker::postMessage, "postMessage");
+            dukglue_register_method(ctx, &ScWorker::terminate, "terminate");
+            dukglue_register_method(ctx, &ScWorker::on, "on");
+            dukglue_register_method(ctx, &ScWorker::off, "off");
+        }
+    };
+} // namespace OpenRCT2::Scripting
+
+#endif
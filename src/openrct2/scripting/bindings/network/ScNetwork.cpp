@@ -14,6 +14,7 @@
 #    include "../../../Context.h"
 #    include "../../../actions/NetworkModifyGroupAction.h"
 #    include "../../../actions/PlayerKickAction.h"
+#    include "../../../core/Json.hpp"
 #    include "../../../network/NetworkAction.h"
 #    include "../../../network/network.h"
 
@@ -164,6 +165,17 @@ namespace OpenRCT2::Scripting
             }
             obj.Set("bytesSent", DukValue::take_from_stack(_context));
         }
+        {
+            // Per command and per connection breakdown, the same data as written to the server log.
+            auto telemetry = NetworkGetTelemetryAsJson();
+            auto commands = DuktapeTryParseJson(_context, telemetry["commands"].dump());
+            auto connections = DuktapeTryParseJson(_context, telemetry["connections"].dump());
+            if (commands && connections)
+            {
+                obj.Set("commands", *commands);
+                obj.Set("connections", *connections);
+            }
+        }
         return obj.Take();
 #    else
         return ToDuk(_context, nullptr);
@@ -16,6 +16,7 @@
 #        include "../../../config/Config.h"
 #        include "../../../network/Socket.h"
 #        include "../../Duktape.hpp"
+#        include "../../EventList.hpp"
 #        include "../../ScriptEngine.h"
 
 #        include <algorithm>
@@ -24,56 +25,6 @@
 
 namespace OpenRCT2::Scripting
 {
-    class EventList
-    {
-    private:
-        std::vector<std::vector<DukValue>> _listeners;
-
-        std::vector<DukValue>& GetListenerList(uint32_t id)
-        {
-            if (_listeners.size() <= id)
-            {
-                _listeners.resize(static_cast<size_t>(id) + 1);
-            }
-            return _listeners[id];
-        }
-
-    public:
-        void Raise(
-            uint32_t id, const std::shared_ptr<Plugin>& plugin, const std::vector<DukValue>& args, bool isGameStateMutable)
-        {
-            auto& scriptEngine = GetContext()->GetScriptEngine();
-
-            // Use simple for i loop in case listeners is modified during the loop
-            auto listeners = GetListenerList(id);
-            for (size_t i = 0; i < listeners.size(); i++)
-            {
-                scriptEngine.ExecutePluginCall(plugin, listeners[i], args, isGameStateMutable);
-
-                // Safety, listeners might get reallocated
-                listeners = GetListenerList(id);
-            }
-        }
-
-        void AddListener(uint32_t id, const DukValue& listener)
-        {
-            auto& listeners = GetListenerList(id);
-            listeners.push_back(listener);
-        }
-
-        void RemoveListener(uint32_t id, const DukValue& value)
-        {
-            auto& listeners = GetListenerList(id);
-            listeners.erase(std::remove(listeners.begin(), listeners.end(), value), listeners.end());
-        }
-
-        void RemoveAllListeners(uint32_t id)
-        {
-            auto& listeners = GetListenerList(id);
-            listeners.clear();
-        }
-    };
-
     class ScSocketBase
     {
     private:
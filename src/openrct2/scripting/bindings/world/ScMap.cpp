@@ -103,69 +103,10 @@ namespace OpenRCT2::Scripting
     std::vector<DukValue> ScMap::getAllEntities(const std::string& type) const
     {
         std::vector<DukValue> result;
-        if (type == "balloon")
-        {
-            for (auto sprite : EntityList<Balloon>())
-            {
-                result.push_back(GetObjectAsDukValue(_context, std::make_shared<ScEntity>(sprite->Id)));
-            }
-        }
-        else if (type == "car")
-        {
-            for (auto trainHead : TrainManager::View())
-            {
-                for (auto carId = trainHead->Id; !carId.IsNull();)
-                {
-                    auto car = GetEntity<Vehicle>(carId);
-                    result.push_back(GetObjectAsDukValue(_context, std::make_shared<ScVehicle>(carId)));
-                    carId = car->next_vehicle_on_train;
-                }
-            }
-        }
-        else if (type == "litter")
-        {
-            for (auto sprite : EntityList<Litter>())
-            {
-                result.push_back(GetObjectAsDukValue(_context, std::make_shared<ScLitter>(sprite->Id)));
-            }
-        }
-        else if (type == "duck")
-        {
-            for (auto sprite : EntityList<Duck>())
-            {
-                result.push_back(GetObjectAsDukValue(_context, std::make_shared<ScEntity>(sprite->Id)));
-            }
-        }
-        else if (type == "peep")
-        {
-            for (auto sprite : EntityList<Guest>())
-            {
-                result.push_back(GetObjectAsDukValue(_context, std::make_shared<ScGuest>(sprite->Id)));
-            }
-            for (auto sprite : EntityList<Staff>())
-            {
-                result.push_back(GetObjectAsDukValue(_context, std::make_shared<ScStaff>(sprite->Id)));
-            }
-        }
-        else if (type == "guest")
+        for (auto entity : GetAllEntitiesOfType(type))
         {
-            for (auto sprite : EntityList<Guest>())
-            {
-                result.push_back(GetObjectAsDukValue(_context, std::make_shared<ScGuest>(sprite->Id)));
-            }
+            result.push_back(GetEntityAsDukValue(entity));
         }
-        else if (type == "staff")
-        {
-            for (auto sprite : EntityList<Staff>())
-            {
-                result.push_back(GetObjectAsDukValue(_context, std::make_shared<ScStaff>(sprite->Id)));
-            }
-        }
-        else
-        {
-            duk_error(_context, DUK_ERR_ERROR, "Invalid entity type.");
-        }
-
         return result;
     }
 
@@ -230,6 +171,198 @@ namespace OpenRCT2::Scripting
         return result;
     }
 
+    // A column of a query, filled straight into a typed array.
+    template<typename TItem> struct QueryField
+    {
+        const char* Name;
+        duk_uint_t ArrayType;
+        int32_t (*Get)(const TItem* item);
+    };
+
+    static const SurfaceElement* GetQuerySurface(const TileElement* element)
+    {
+        if (element != nullptr)
+        {
+            do
+            {
+                if (element->GetType() == TileElementType::Surface)
+                {
+                    return element->AsSurface();
+                }
+            } while (!(element++)->IsLastForTile());
+        }
+        return nullptr;
+    }
+
+    template<typename TGetter> static int32_t GetQueryGuestValue(const EntityBase* entity, TGetter getter)
+    {
+        auto guest = entity->As<Guest>();
+        return guest != nullptr ? getter(*guest) : 0;
+    }
+
+    template<typename TGetter> static int32_t GetQuerySurfaceValue(const TileElement* element, TGetter getter)
+    {
+        auto surface = GetQuerySurface(element);
+        return surface != nullptr ? getter(*surface) : 0;
+    }
+
+    // clang-format off
+    static constexpr QueryField<EntityBase> EntityQueryFields[] = {
+        { "id", DUK_BUFOBJ_UINT16ARRAY, [](const EntityBase* e) -> int32_t { return e->Id.ToUnderlying(); } },
+        { "x", DUK_BUFOBJ_INT32ARRAY, [](const EntityBase* e) -> int32_t { return e->x; } },
+        { "y", DUK_BUFOBJ_INT32ARRAY, [](const EntityBase* e) -> int32_t { return e->y; } },
+        { "z", DUK_BUFOBJ_INT32ARRAY, [](const EntityBase* e) -> int32_t { return e->z; } },
+        { "energy", DUK_BUFOBJ_UINT8ARRAY, [](const EntityBase* e) -> int32_t {
+            auto peep = e->As<Peep>();
+            return peep != nullptr ? peep->Energy : 0;
+        } },
+        { "happiness", DUK_BUFOBJ_UINT8ARRAY, [](const EntityBase* e) {
+            return GetQueryGuestValue(e, [](const Guest& g) -> int32_t { return g.Happiness; });
+        } },
+        { "nausea", DUK_BUFOBJ_UINT8ARRAY, [](const EntityBase* e) {
+            return GetQueryGuestValue(e, [](const Guest& g) -> int32_t { return g.Nausea; });
+        } },
+        { "hunger", DUK_BUFOBJ_UINT8ARRAY, [](const EntityBase* e) {
+            return GetQueryGuestValue(e, [](const Guest& g) -> int32_t { return g.Hunger; });
+        } },
+        { "thirst", DUK_BUFOBJ_UINT8ARRAY, [](const EntityBase* e) {
+            return GetQueryGuestValue(e, [](const Guest& g) -> int32_t { return g.Thirst; });
+        } },
+        { "toilet", DUK_BUFOBJ_UINT8ARRAY, [](const EntityBase* e) {
+            return GetQueryGuestValue(e, [](const Guest& g) -> int32_t { return g.Toilet; });
+        } },
+        { "cash", DUK_BUFOBJ_INT32ARRAY, [](const EntityBase* e) {
+            return GetQueryGuestValue(e, [](const Guest& g) { return static_cast<int32_t>(g.CashInPocket); });
+        } },
+    };
+
+    static constexpr QueryField<TileElement> SurfaceQueryFields[] = {
+        { "baseHeight", DUK_BUFOBJ_UINT8ARRAY, [](const TileElement* el) {
+            return GetQuerySurfaceValue(el, [](const SurfaceElement& s) -> int32_t { return s.BaseHeight; });
+        } },
+        { "waterHeight", DUK_BUFOBJ_UINT16ARRAY, [](const TileElement* el) {
+            return GetQuerySurfaceValue(el, [](const SurfaceElement& s) { return s.GetWaterHeight(); });
+        } },
+        { "slope", DUK_BUFOBJ_UINT8ARRAY, [](const TileElement* el) {
+            return GetQuerySurfaceValue(el, [](const SurfaceElement& s) -> int32_t { return s.GetSlope(); });
+        } },
+        { "surfaceStyle", DUK_BUFOBJ_UINT16ARRAY, [](const TileElement* el) {
+            return GetQuerySurfaceValue(el, [](const SurfaceElement& s) -> int32_t { return s.GetSurfaceObjectIndex(); });
+        } },
+        { "edgeStyle", DUK_BUFOBJ_UINT16ARRAY, [](const TileElement* el) {
+            return GetQuerySurfaceValue(el, [](const SurfaceElement& s) -> int32_t { return s.GetEdgeObjectIndex(); });
+        } },
+        { "grassLength", DUK_BUFOBJ_UINT8ARRAY, [](const TileElement* el) {
+            return GetQuerySurfaceValue(el, [](const SurfaceElement& s) -> int32_t { return s.GetGrassLength(); });
+        } },
+        { "ownership", DUK_BUFOBJ_UINT8ARRAY, [](const TileElement* el) {
+            return GetQuerySurfaceValue(el, [](const SurfaceElement& s) -> int32_t { return s.GetOwnership(); });
+        } },
+        { "numElements", DUK_BUFOBJ_UINT16ARRAY, [](const TileElement* el) -> int32_t {
+            int32_t count = 0;
+            if (el != nullptr)
+            {
+                do
+                {
+                    count++;
+                } while (!(el++)->IsLastForTile());
+            }
+            return count;
+        } },
+    };
+    // clang-format on
+
+    template<typename TValue, typename TItem>
+    static void FillQueryColumn(void* data, const QueryField<TItem>& field, const std::vector<const TItem*>& items)
+    {
+        auto values = static_cast<TValue*>(data);
+        for (size_t i = 0; i < items.size(); i++)
+        {
+            values[i] = static_cast<TValue>(field.Get(items[i]));
+        }
+    }
+
+    template<typename TItem, size_t TNumFields>
+    static void AddQueryColumns(
+        duk_context* ctx, DukObject& result, const QueryField<TItem> (&available)[TNumFields],
+        const std::vector<std::string>& fields, const std::vector<const TItem*>& items)
+    {
+        for (const auto& name : fields)
+        {
+            auto field = std::find_if(
+                std::begin(available), std::end(available), [&name](const auto& f) { return name == f.Name; });
+            if (field == std::end(available))
+            {
+                duk_error(ctx, DUK_ERR_ERROR, "Invalid field: %s", name.c_str());
+            }
+
+            size_t size;
+            void* data;
+            switch (field->ArrayType)
+            {
+                case DUK_BUFOBJ_UINT8ARRAY:
+                    size = items.size() * sizeof(uint8_t);
+                    data = duk_push_fixed_buffer(ctx, size);
+                    FillQueryColumn<uint8_t>(data, *field, items);
+                    break;
+                case DUK_BUFOBJ_UINT16ARRAY:
+                    size = items.size() * sizeof(uint16_t);
+                    data = duk_push_fixed_buffer(ctx, size);
+                    FillQueryColumn<uint16_t>(data, *field, items);
+                    break;
+                default:
+                    size = items.size() * sizeof(int32_t);
+                    data = duk_push_fixed_buffer(ctx, size);
+                    FillQueryColumn<int32_t>(data, *field, items);
+                    break;
+            }
+            duk_push_buffer_object(ctx, -1, 0, size, field->ArrayType);
+            duk_remove(ctx, -2);
+            result.Set(name.c_str(), DukValue::take_from_stack(ctx));
+        }
+    }
+
+    DukValue ScMap::queryEntities(const std::string& type, const std::vector<std::string>& fields) const
+    {
+        const auto entities = GetAllEntitiesOfType(type);
+
+        DukObject result(_context);
+        result.Set("count", static_cast<uint32_t>(entities.size()));
+        AddQueryColumns(_context, result, EntityQueryFields, fields, entities);
+        return result.Take();
+    }
+
+    DukValue ScMap::querySurfaces(const DukValue& dukRange, const std::vector<std::string>& fields) const
+    {
+        const auto range = FromDuk<MapRange>(dukRange);
+        const auto& mapSize = GetGameState().MapSize;
+        const auto left = std::max(range.GetLeft() / COORDS_XY_STEP, 0);
+        const auto top = std::max(range.GetTop() / COORDS_XY_STEP, 0);
+        const auto right = std::min(range.GetRight() / COORDS_XY_STEP, mapSize.x - 1);
+        const auto bottom = std::min(range.GetBottom() / COORDS_XY_STEP, mapSize.y - 1);
+        const auto width = std::max(right - left + 1, 0);
+        const auto height = std::max(bottom - top + 1, 0);
+
+        // Row by row, the tile at (x, y) is at index (y - top) * width + (x - left).
+        std::vector<const TileElement*> tiles;
+        tiles.reserve(width * height);
+        for (auto y = top; y < top + height; y++)
+        {
+            for (auto x = left; x < left + width; x++)
+            {
+                tiles.push_back(MapGetFirstElementAt(TileCoordsXY{ x, y }));
+            }
+        }
+
+        DukObject result(_context);
+        result.Set("x", left);
+        result.Set("y", top);
+        result.Set("width", width);
+        result.Set("height", height);
+        AddQueryColumns(_context, result, SurfaceQueryFields, fields, tiles);
+        return result.Take();
+    }
+
     template<typename TEntityType, typename TScriptType>
     DukValue createEntityType(duk_context* ctx, const DukValue& initializer)
     {
@@ -331,6 +464,8 @@ namespace OpenRCT2::Scripting
         dukglue_register_method(ctx, &ScMap::getEntity, "getEntity");
         dukglue_register_method(ctx, &ScMap::getAllEntities, "getAllEntities");
         dukglue_register_method(ctx, &ScMap::getAllEntitiesOnTile, "getAllEntitiesOnTile");
+        dukglue_register_method(ctx, &ScMap::queryEntities, "queryEntities");
+        dukglue_register_method(ctx, &ScMap::querySurfaces, "querySurfaces");
         dukglue_register_method(ctx, &ScMap::createEntity, "createEntity");
         dukglue_register_method(ctx, &ScMap::getTrackIterator, "getTrackIterator");
     }
@@ -353,6 +488,75 @@ namespace OpenRCT2::Scripting
         }
     }
 
+    std::vector<const EntityBase*> ScMap::GetAllEntitiesOfType(const std::string& type) const
+    {
+        std::vector<const EntityBase*> result;
+        if (type == "balloon")
+        {
+            for (auto sprite : EntityList<Balloon>())
+            {
+                result.push_back(sprite);
+            }
+        }
+        else if (type == "car")
+        {
+            for (auto trainHead : TrainManager::View())
+            {
+                for (auto carId = trainHead->Id; !carId.IsNull();)
+                {
+                    auto car = GetEntity<Vehicle>(carId);
+                    result.push_back(car);
+                    carId = car->next_vehicle_on_train;
+                }
+            }
+        }
+        else if (type == "litter")
+        {
+            for (auto sprite : EntityList<Litter>())
+            {
+                result.push_back(sprite);
+            }
+        }
+        else if (type == "duck")
+        {
+            for (auto sprite : EntityList<Duck>())
+            {
+                result.push_back(sprite);
+            }
+        }
+        else if (type == "peep")
+        {
+            for (auto sprite : EntityList<Guest>())
+            {
+                result.push_back(sprite);
+            }
+            for (auto sprite : EntityList<Staff>())
+            {
+                result.push_back(sprite);
+            }
+        }
+        else if (type == "guest")
+        {
+            for (auto sprite : EntityList<Guest>())
+            {
+                result.push_back(sprite);
+            }
+        }
+        else if (type == "staff")
+        {
+            for (auto sprite : EntityList<Staff>())
+            {
+                result.push_back(sprite);
+            }
+        }
+        else
+        {
+            duk_error(_context, DUK_ERR_ERROR, "Invalid entity type.");
+        }
+
+        return result;
+    }
+
 } // namespace OpenRCT2::Scripting
 
 #endif
@@ -45,6 +45,10 @@ namespace OpenRCT2::Scripting
 
         std::vector<DukValue> getAllEntitiesOnTile(const std::string& type, const DukValue& tilePos) const;
 
+        DukValue queryEntities(const std::string& type, const std::vector<std::string>& fields) const;
+
+        DukValue querySurfaces(const DukValue& dukRange, const std::vector<std::string>& fields) const;
+
         DukValue createEntity(const std::string& type, const DukValue& initializer);
 
         DukValue getTrackIterator(const DukValue& position, int32_t elementIndex) const;
@@ -53,6 +57,7 @@ namespace OpenRCT2::Scripting
 
     private:
         DukValue GetEntityAsDukValue(const EntityBase* sprite) const;
+        std::vector<const EntityBase*> GetAllEntitiesOfType(const std::string& type) const;
     };
 
 } // namespace OpenRCT2::Scripting
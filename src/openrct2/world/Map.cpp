@@ -49,6 +49,7 @@
 #include "Park.h"
 #include "Scenery.h"
 #include "Surface.h"
+#include "TileChangeJournal.h"
 #include "TileElementsView.h"
 #include "TileInspector.h"
 #include "Wall.h"
@@ -157,6 +158,7 @@ void SetTileElements(std::vector<TileElement>&& tileElements)
     _tileIndex = TilePointerIndex<TileElement>(
         MAXIMUM_MAP_SIZE_TECHNICAL, gameState.TileElements.data(), gameState.TileElements.size());
     _tileElementsInUse = gameState.TileElements.size();
+    GetTileChangeJournal().MarkAll();
 }
 
 static TileElement GetDefaultSurfaceElement()
@@ -1188,6 +1190,7 @@ TileElement* TileElementInsert(const CoordsXYZ& loc, int32_t occupiedQuadrants,
 
     // Set tile index pointer to point to new element block
     _tileIndex.SetTile(tileLoc, newTileElement);
+    GetTileChangeJournal().MarkTile(tileLoc);
 
     bool isLastForTile = false;
     if (originalTileElement == nullptr)
@@ -1464,6 +1467,7 @@ void MapExtendBoundarySurfaceX()
  */
 static void ClearElementAt(const CoordsXY& loc, TileElement** elementPtr)
 {
+    GetTileChangeJournal().MarkTile(TileCoordsXY(loc));
     TileElement* element = *elementPtr;
     switch (element->GetType())
     {
@@ -1803,6 +1807,8 @@ static void MapInvalidateTileUnderZoom(int32_t x, int32_t y, int32_t z0, int32_t
  */
 void MapInvalidateTile(const CoordsXYRangedZ& tilePos)
 {
+    // Tiles are invalidated in full after their elements change, unlike the zoomed in invalidations for animations
+    GetTileChangeJournal().MarkTile(TileCoordsXY(tilePos));
     MapInvalidateTileUnderZoom(tilePos.x, tilePos.y, tilePos.baseZ, tilePos.clearanceZ, ZoomLevel{ -1 });
 }
 
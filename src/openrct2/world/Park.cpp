@@ -233,6 +233,7 @@ void Park::Initialise()
 
     Name = LanguageGetString(STR_UNNAMED_PARK);
     PluginStorage = {};
+    PluginStorageData = {};
     gameState.StaffHandymanColour = COLOUR_BRIGHT_RED;
     gameState.StaffMechanicColour = COLOUR_LIGHT_BLUE;
     gameState.StaffSecurityColour = COLOUR_YELLOW;
@@ -56,7 +56,9 @@ namespace OpenRCT2
     {
     public:
         std::string Name;
+        // Plugin storage as it was last loaded or saved, JSON from older parks and records from newer ones.
         std::string PluginStorage;
+        std::vector<uint8_t> PluginStorageData;
 
         Park() = default;
         Park(const Park&) = delete;
@@ -0,0 +1,78 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2024 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#include "TileChangeJournal.h"
+
+#include "Map.h"
+
+static size_t GetTileIndex(const TileCoordsXY& coords)
+{
+    return static_cast<size_t>(coords.y) * MAXIMUM_MAP_SIZE_TECHNICAL + coords.x;
+}
+
+void TileChangeJournal::MarkTile(const TileCoordsXY& coords)
+{
+    if (_all || coords.x < 0 || coords.y < 0 || coords.x >= MAXIMUM_MAP_SIZE_TECHNICAL
+        || coords.y >= MAXIMUM_MAP_SIZE_TECHNICAL)
+    {
+        return;
+    }
+
+    if (_marked.empty())
+    {
+        _marked.resize(MAX_TILE_TILE_ELEMENT_POINTERS);
+    }
+
+    const auto index = GetTileIndex(coords);
+    if (_marked[index])
+    {
+        return;
+    }
+
+    if (_tiles.size() >= MaxTiles)
+    {
+        MarkAll();
+        return;
+    }
+    _marked[index] = true;
+    _tiles.push_back(coords);
+}
+
+void TileChangeJournal::MarkAll()
+{
+    for (const auto& coords : _tiles)
+    {
+        _marked[GetTileIndex(coords)] = false;
+    }
+    _tiles.clear();
+    _all = true;
+}
+
+bool TileChangeJournal::TakeChanges(std::vector<TileCoordsXY>& tiles)
+{
+    tiles.clear();
+    if (_all)
+    {
+        _all = false;
+        return true;
+    }
+
+    for (const auto& coords : _tiles)
+    {
+        _marked[GetTileIndex(coords)] = false;
+    }
+    tiles.swap(_tiles);
+    return false;
+}
+
+TileChangeJournal& GetTileChangeJournal()
+{
+    static TileChangeJournal journal;
+    return journal;
+}
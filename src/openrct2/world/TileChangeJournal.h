@@ -0,0 +1,43 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2024 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#pragma once
+
+#include "Location.hpp"
+
+#include <vector>
+
+/**
+ * Tiles that had elements inserted, removed or modified since the changes were last taken, so views of the whole map
+ * can update just those tiles instead of going over the whole map.
+ *
+ * Insertions are recorded by TileElementInsert. Removals and modifications are recorded when the tile is invalidated,
+ * which is done for every change that can be seen, as the element alone does not tell which tile it is on. Replacing
+ * all tile elements marks the whole map as changed, as does recording more tiles than MaxTiles between takes.
+ */
+class TileChangeJournal
+{
+public:
+    static constexpr size_t MaxTiles = 4096;
+
+private:
+    std::vector<bool> _marked;
+    std::vector<TileCoordsXY> _tiles;
+    bool _all = true;
+
+public:
+    void MarkTile(const TileCoordsXY& coords);
+    void MarkAll();
+
+    // Moves the changed tiles into the given list and clears the journal. Returns true if the whole map has changed,
+    // in which case the list is left empty.
+    bool TakeChanges(std::vector<TileCoordsXY>& tiles);
+};
+
+TileChangeJournal& GetTileChangeJournal();
@@ -0,0 +1,249 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2024 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#include "TestData.h"
+
+#include <gtest/gtest.h>
+#include <memory>
+#include <openrct2/Context.h>
+#include <openrct2/Game.h>
+#include <openrct2/GameState.h>
+#include <openrct2/OpenRCT2.h>
+#include <openrct2/ParkImporter.h>
+#include <openrct2/actions/BatchAction.h>
+#include <openrct2/actions/ParkSetEntranceFeeAction.h>
+#include <openrct2/actions/SmallSceneryPlaceAction.h>
+#include <openrct2/core/DataSerialiser.h>
+#include <openrct2/management/Finance.h>
+#include <openrct2/object/ObjectManager.h>
+#include <openrct2/world/Park.h>
+#include <stdexcept>
+
+using namespace OpenRCT2;
+
+// Stands in for an action of the batch, it can be made to fail and counts how often it was executed.
+class TestBatchedAction final : public GameActionBase<GameCommand::SetParkEntranceFee>
+{
+private:
+    money64 _cost{};
+    ExpenditureType _expenditure{};
+    bool _failQuery{};
+    bool _failExecute{};
+    int32_t* _numExecuted{};
+
+public:
+    TestBatchedAction(
+        int32_t* numExecuted, money64 cost, ExpenditureType expenditure, bool failQuery = false, bool failExecute = false)
+        : _cost(cost)
+        , _expenditure(expenditure)
+        , _failQuery(failQuery)
+        , _failExecute(failExecute)
+        , _numExecuted(numExecuted)
+    {
+    }
+
+    GameActions::Result Query() const override
+    {
+        if (_failQuery)
+        {
+            return GameActions::Result(GameActions::Status::Disallowed, STR_CANT_DO_THIS, STR_NONE);
+        }
+        return CreateResult();
+    }
+
+    GameActions::Result Execute() const override
+    {
+        if (_failExecute)
+        {
+            return GameActions::Result(GameActions::Status::NoClearance, STR_CANT_DO_THIS, STR_NONE);
+        }
+        (*_numExecuted)++;
+        return CreateResult();
+    }
+
+private:
+    GameActions::Result CreateResult() const
+    {
+        auto result = GameActions::Result();
+        result.Cost = _cost;
+        result.Expenditure = _expenditure;
+        return result;
+    }
+};
+
+class BatchActionTests : public testing::Test
+{
+protected:
+    std::unique_ptr<IContext> _context;
+    int32_t _numExecuted{};
+
+    void SetUp() override
+    {
+        gOpenRCT2Headless = true;
+        gOpenRCT2NoGraphics = true;
+
+        _context = CreateContext();
+        ASSERT_TRUE(_context->Initialise());
+
+        auto importer = ParkImporter::CreateS6(_context->GetObjectRepository());
+        auto loadResult = importer->LoadSavedGame(TestData::GetParkPath("small_park_with_ferris_wheel.sv6").c_str(), false);
+        _context->GetObjectManager().LoadObjects(loadResult.RequiredObjects);
+        importer->Import(GetGameState());
+
+        auto& gameState = GetGameState();
+        gameState.ParkFlags &= ~PARK_FLAGS_NO_MONEY;
+        gameState.Cash = 10000.00_GBP;
+        for (auto& expenditure : gameState.ExpenditureTable[0])
+        {
+            expenditure = 0;
+        }
+
+        // Run the actions right away like the game logic does instead of queueing them.
+        gInUpdateCode = true;
+    }
+
+    void TearDown() override
+    {
+        gInUpdateCode = false;
+        _context = nullptr;
+    }
+
+    void AddAction(
+        BatchAction& batch, money64 cost, ExpenditureType expenditure, bool failQuery = false, bool failExecute = false)
+    {
+        batch.AddAction(std::make_unique<TestBatchedAction>(&_numExecuted, cost, expenditure, failQuery, failExecute));
+    }
+
+    static std::unique_ptr<BatchAction> SerialiseRoundTrip(BatchAction& batch)
+    {
+        DataSerialiser saving(true);
+        batch.Serialise(saving);
+
+        DataSerialiser loading(false, saving.GetStream());
+        loading.GetStream().SetPosition(0);
+        auto result = std::make_unique<BatchAction>();
+        result->Serialise(loading);
+        return result;
+    }
+};
+
+TEST_F(BatchActionTests, QueryAndExecute)
+{
+    BatchAction batch;
+    AddAction(batch, 100.00_GBP, ExpenditureType::Marketing);
+    AddAction(batch, 50.00_GBP, ExpenditureType::Wages);
+    AddAction(batch, 100.00_GBP, ExpenditureType::Marketing);
+
+    auto queryResult = GameActions::Query(&batch);
+    ASSERT_EQ(queryResult.Error, GameActions::Status::Ok);
+    ASSERT_EQ(queryResult.Cost, 250.00_GBP);
+    ASSERT_FALSE(queryResult.GetData<BatchActionResult>().FailedIndex.has_value());
+    ASSERT_EQ(_numExecuted, 0);
+
+    auto result = GameActions::Execute(&batch);
+    ASSERT_EQ(result.Error, GameActions::Status::Ok);
+    ASSERT_EQ(result.Cost, 250.00_GBP);
+    ASSERT_EQ(result.GetData<BatchActionResult>().NumExecuted, 3u);
+    ASSERT_EQ(_numExecuted, 3);
+
+    // Each action is paid for under its own expenditure type.
+    auto& gameState = GetGameState();
+    ASSERT_EQ(gameState.Cash, 9750.00_GBP);
+    ASSERT_EQ(gameState.ExpenditureTable[0][EnumValue(ExpenditureType::Marketing)], -200.00_GBP);
+    ASSERT_EQ(gameState.ExpenditureTable[0][EnumValue(ExpenditureType::Wages)], -50.00_GBP);
+}
+
+TEST_F(BatchActionTests, QueryFailure)
+{
+    BatchAction batch;
+    AddAction(batch, 100.00_GBP, ExpenditureType::Marketing);
+    AddAction(batch, 100.00_GBP, ExpenditureType::Marketing, true);
+    AddAction(batch, 100.00_GBP, ExpenditureType::Marketing);
+
+    auto queryResult = GameActions::Query(&batch);
+    ASSERT_EQ(queryResult.Error, GameActions::Status::Disallowed);
+    ASSERT_EQ(queryResult.GetData<BatchActionResult>().FailedIndex, 1u);
+
+    // Nothing is executed when one of the actions is not possible.
+    auto result = GameActions::Execute(&batch);
+    ASSERT_EQ(result.Error, GameActions::Status::Disallowed);
+    ASSERT_EQ(_numExecuted, 0);
+    ASSERT_EQ(GetGameState().Cash, 10000.00_GBP);
+}
+
+TEST_F(BatchActionTests, ExecuteFailureInTheMiddle)
+{
+    BatchAction batch;
+    AddAction(batch, 100.00_GBP, ExpenditureType::Marketing);
+    AddAction(batch, 100.00_GBP, ExpenditureType::Marketing, false, true);
+    AddAction(batch, 100.00_GBP, ExpenditureType::Marketing);
+
+    // The batch stops at the failed action, the one before it stays executed and paid for.
+    auto result = GameActions::Execute(&batch);
+    ASSERT_EQ(result.Error, GameActions::Status::Ok);
+    ASSERT_EQ(result.Cost, 100.00_GBP);
+    const auto data = result.GetData<BatchActionResult>();
+    ASSERT_EQ(data.NumExecuted, 1u);
+    ASSERT_EQ(data.FailedIndex, 1u);
+    ASSERT_EQ(_numExecuted, 1);
+    ASSERT_EQ(GetGameState().Cash, 9900.00_GBP);
+}
+
+TEST_F(BatchActionTests, ExecuteFailureFirst)
+{
+    BatchAction batch;
+    AddAction(batch, 100.00_GBP, ExpenditureType::Marketing, false, true);
+    AddAction(batch, 100.00_GBP, ExpenditureType::Marketing);
+
+    auto result = GameActions::Execute(&batch);
+    ASSERT_EQ(result.Error, GameActions::Status::NoClearance);
+    ASSERT_EQ(result.GetData<BatchActionResult>().FailedIndex, 0u);
+    ASSERT_EQ(_numExecuted, 0);
+    ASSERT_EQ(GetGameState().Cash, 10000.00_GBP);
+}
+
+TEST_F(BatchActionTests, Empty)
+{
+    BatchAction batch;
+    ASSERT_EQ(GameActions::Query(&batch).Error, GameActions::Status::InvalidParameters);
+}
+
+TEST_F(BatchActionTests, CooldownOfEachAction)
+{
+    BatchAction batch;
+    for (int32_t i = 0; i < 3; i++)
+    {
+        batch.AddAction(std::make_unique<SmallSceneryPlaceAction>());
+    }
+    ASSERT_EQ(batch.GetCooldownTime(), SmallSceneryPlaceAction().GetCooldownTime() * 3);
+}
+
+TEST_F(BatchActionTests, SizeLimit)
+{
+    BatchAction batch;
+    for (uint32_t i = 0; i < BatchAction::kMaxActions; i++)
+    {
+        batch.AddAction(std::make_unique<ParkSetEntranceFeeAction>(0));
+    }
+    auto loaded = SerialiseRoundTrip(batch);
+    ASSERT_EQ(loaded->GetActions().size(), BatchAction::kMaxActions);
+
+    batch.AddAction(std::make_unique<ParkSetEntranceFeeAction>(0));
+    ASSERT_THROW(SerialiseRoundTrip(batch), std::runtime_error);
+}
+
+TEST_F(BatchActionTests, NestedBatch)
+{
+    auto inner = std::make_unique<BatchAction>();
+    inner->AddAction(std::make_unique<ParkSetEntranceFeeAction>(0));
+
+    BatchAction batch;
+    batch.AddAction(std::move(inner));
+    ASSERT_THROW(SerialiseRoundTrip(batch), std::runtime_error);
+}
@@ -0,0 +1,139 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2024 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#include "TestData.h"
+
+#include <cstring>
+#include <gtest/gtest.h>
+#include <openrct2/OpenRCT2.h>
+#include <openrct2/command_line/CommandLine.hpp>
+#include <openrct2/core/File.h>
+#include <openrct2/core/FileSystem.hpp>
+#include <openrct2/core/Path.hpp>
+#include <openrct2/park/ParkFile.h>
+#include <string>
+#include <vector>
+
+class ConvertCommandTests : public testing::Test
+{
+protected:
+    fs::path _directory;
+    bool _headless{};
+    bool _noGraphics{};
+
+    void SetUp() override
+    {
+        _headless = gOpenRCT2Headless;
+        _noGraphics = gOpenRCT2NoGraphics;
+        _directory = fs::temp_directory_path() / "openrct2_convert_batch_test";
+        fs::remove_all(_directory);
+        fs::create_directories(_directory / "source" / "sub");
+    }
+
+    void TearDown() override
+    {
+        fs::remove_all(_directory);
+        gOpenRCT2Headless = _headless;
+        gOpenRCT2NoGraphics = _noGraphics;
+    }
+
+    std::string SourcePath(const std::string& name) const
+    {
+        return (_directory / "source" / name).string();
+    }
+
+    std::string DestinationPath(const std::string& name) const
+    {
+        return (_directory / "destination" / name).string();
+    }
+
+    void CopyPark(const std::string& park, const std::string& name) const
+    {
+        fs::copy_file(TestData::GetParkPath(park), SourcePath(name));
+    }
+
+    static exitcode_t ConvertBatch(const std::string& source, const std::string& destination)
+    {
+        const char* args[] = { source.c_str(), destination.c_str() };
+        CommandLineArgEnumerator enumerator(args, 2);
+        return CommandLine::HandleCommandConvertBatch(&enumerator);
+    }
+
+    static bool IsParkFile(const std::string& path)
+    {
+        if (!File::Exists(path))
+        {
+            return false;
+        }
+        const auto data = File::ReadAllBytes(path);
+        uint32_t magic{};
+        if (data.size() < sizeof(magic))
+        {
+            return false;
+        }
+        std::memcpy(&magic, data.data(), sizeof(magic));
+        return magic == OpenRCT2::PARK_FILE_MAGIC;
+    }
+};
+
+TEST_F(ConvertCommandTests, Directory)
+{
+    CopyPark("small_park_with_ferris_wheel.sv6", "ferris_wheel.sv6");
+    CopyPark("small_park_car_ride_one_car.sv6", "car_ride.sv6");
+    CopyPark("bpb.sv6", "sub/bpb.sv6");
+    File::WriteAllBytes(SourcePath("readme.txt"), "not a park", 10);
+
+    ASSERT_EQ(ConvertBatch((_directory / "source").string(), (_directory / "destination").string()), EXITCODE_OK);
+
+    // The directory structure of the source is kept.
+    ASSERT_TRUE(IsParkFile(DestinationPath("ferris_wheel.park")));
+    ASSERT_TRUE(IsParkFile(DestinationPath("car_ride.park")));
+    ASSERT_TRUE(IsParkFile(DestinationPath("sub/bpb.park")));
+    ASSERT_FALSE(File::Exists(DestinationPath("readme.park")));
+}
+
+TEST_F(ConvertCommandTests, Manifest)
+{
+    CopyPark("small_park_with_ferris_wheel.sv6", "ferris_wheel.sv6");
+    CopyPark("small_park_car_ride_one_car.sv6", "sub/car_ride.sv6");
+    CopyPark("bpb.sv6", "bpb.sv6");
+
+    // Paths are relative to the manifest, parks not listed in it are not converted.
+    const std::string manifest = "ferris_wheel.sv6\n\n  sub/car_ride.sv6  \n";
+    File::WriteAllBytes(SourcePath("manifest.txt"), manifest.data(), manifest.size());
+
+    ASSERT_EQ(ConvertBatch(SourcePath("manifest.txt"), (_directory / "destination").string()), EXITCODE_OK);
+    ASSERT_TRUE(IsParkFile(DestinationPath("ferris_wheel.park")));
+    ASSERT_TRUE(IsParkFile(DestinationPath("sub/car_ride.park")));
+    ASSERT_FALSE(File::Exists(DestinationPath("bpb.park")));
+}
+
+TEST_F(ConvertCommandTests, BadInput)
+{
+    CopyPark("small_park_with_ferris_wheel.sv6", "a.sv6");
+    CopyPark("small_park_car_ride_one_car.sv6", "c.sv6");
+    const std::vector<uint8_t> corrupt(512, 0xAB);
+    File::WriteAllBytes(SourcePath("b.sv6"), corrupt.data(), corrupt.size());
+
+    // The other parks are still converted, but the batch as a whole fails.
+    ASSERT_EQ(ConvertBatch((_directory / "source").string(), (_directory / "destination").string()), EXITCODE_FAIL);
+    ASSERT_TRUE(IsParkFile(DestinationPath("a.park")));
+    ASSERT_FALSE(File::Exists(DestinationPath("b.park")));
+    ASSERT_TRUE(IsParkFile(DestinationPath("c.park")));
+}
+
+TEST_F(ConvertCommandTests, MissingSource)
+{
+    ASSERT_EQ(ConvertBatch((_directory / "missing").string(), (_directory / "destination").string()), EXITCODE_FAIL);
+    ASSERT_FALSE(fs::exists(_directory / "destination"));
+
+    // A manifest without any parks to convert.
+    File::WriteAllBytes(SourcePath("manifest.txt"), "readme.txt\n", 11);
+    ASSERT_EQ(ConvertBatch(SourcePath("manifest.txt"), (_directory / "destination").string()), EXITCODE_FAIL);
+}
@@ -0,0 +1,206 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2024 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#ifdef ENABLE_SCRIPTING
+
+#    include <cstddef>
+#    include <cstring>
+#    include <gtest/gtest.h>
+#    include <openrct2/scripting/DukHeapAllocator.h>
+#    include <vector>
+
+using namespace OpenRCT2::Scripting;
+
+static bool IsAligned(const void* ptr)
+{
+    return reinterpret_cast<uintptr_t>(ptr) % alignof(std::max_align_t) == 0;
+}
+
+TEST(DukHeapAllocatorTest, SizeClasses)
+{
+    DukHeapAllocator allocator;
+    const auto largestClass = DukHeapAllocator::SizeClasses.back();
+
+    std::vector<void*> pooled;
+    for (size_t size : { size_t{ 1 }, size_t{ 16 }, size_t{ 17 }, size_t{ largestClass } })
+    {
+        auto ptr = DukHeapAllocator::Alloc(&allocator, size);
+        ASSERT_NE(ptr, nullptr);
+        ASSERT_TRUE(IsAligned(ptr));
+        std::memset(ptr, 0xAB, size);
+        pooled.push_back(ptr);
+    }
+    ASSERT_EQ(allocator.GetPooledAllocations(), 4u);
+    ASSERT_EQ(allocator.GetSystemAllocations(), 0u);
+    ASSERT_GT(allocator.GetReservedBytes(), 0u);
+
+    auto large = DukHeapAllocator::Alloc(&allocator, largestClass + 1);
+    ASSERT_NE(large, nullptr);
+    ASSERT_TRUE(IsAligned(large));
+    ASSERT_EQ(allocator.GetPooledAllocations(), 4u);
+    ASSERT_EQ(allocator.GetSystemAllocations(), 1u);
+
+    ASSERT_EQ(DukHeapAllocator::Alloc(&allocator, 0), nullptr);
+
+    for (auto ptr : pooled)
+    {
+        DukHeapAllocator::Free(&allocator, ptr);
+    }
+    DukHeapAllocator::Free(&allocator, large);
+    ASSERT_EQ(allocator.GetStats(DUK_HEAP_OWNER_NONE).LiveBytes, 0u);
+
+    // Freed blocks are reused for the same size class.
+    const auto reserved = allocator.GetReservedBytes();
+    auto ptr = DukHeapAllocator::Alloc(&allocator, 16);
+    ASSERT_EQ(allocator.GetReservedBytes(), reserved);
+    DukHeapAllocator::Free(&allocator, ptr);
+}
+
+TEST(DukHeapAllocatorTest, ReallocWithinSizeClass)
+{
+    DukHeapAllocator allocator;
+    auto ptr = DukHeapAllocator::Alloc(&allocator, 20);
+    ASSERT_NE(ptr, nullptr);
+
+    // 20 and 30 bytes share the 32 byte class, the block is kept.
+    auto grown = DukHeapAllocator::Realloc(&allocator, ptr, 30);
+    ASSERT_EQ(grown, ptr);
+    ASSERT_EQ(allocator.GetStats(DUK_HEAP_OWNER_NONE).LiveBytes, 30u);
+
+    auto shrunk = DukHeapAllocator::Realloc(&allocator, grown, 8);
+    ASSERT_EQ(shrunk, ptr);
+    ASSERT_EQ(allocator.GetStats(DUK_HEAP_OWNER_NONE).LiveBytes, 8u);
+
+    DukHeapAllocator::Free(&allocator, shrunk);
+}
+
+TEST(DukHeapAllocatorTest, ReallocAcrossSizeClasses)
+{
+    DukHeapAllocator allocator;
+    auto ptr = static_cast<uint8_t*>(DukHeapAllocator::Alloc(&allocator, 20));
+    ASSERT_NE(ptr, nullptr);
+    for (uint8_t i = 0; i < 20; i++)
+    {
+        ptr[i] = i;
+    }
+
+    auto pooled = static_cast<uint8_t*>(DukHeapAllocator::Realloc(&allocator, ptr, 100));
+    ASSERT_NE(pooled, nullptr);
+    ASSERT_NE(pooled, ptr);
+    for (uint8_t i = 0; i < 20; i++)
+    {
+        ASSERT_EQ(pooled[i], i);
+    }
+    ASSERT_EQ(allocator.GetStats(DUK_HEAP_OWNER_NONE).LiveBytes, 100u);
+
+    auto system = static_cast<uint8_t*>(DukHeapAllocator::Realloc(&allocator, pooled, 4096));
+    ASSERT_NE(system, nullptr);
+    for (uint8_t i = 0; i < 20; i++)
+    {
+        ASSERT_EQ(system[i], i);
+    }
+    ASSERT_EQ(allocator.GetSystemAllocations(), 1u);
+    ASSERT_EQ(allocator.GetStats(DUK_HEAP_OWNER_NONE).LiveBytes, 4096u);
+
+    // Reallocating to nothing frees, reallocating nothing allocates.
+    ASSERT_EQ(DukHeapAllocator::Realloc(&allocator, system, 0), nullptr);
+    ASSERT_EQ(allocator.GetStats(DUK_HEAP_OWNER_NONE).LiveBytes, 0u);
+    auto fresh = DukHeapAllocator::Realloc(&allocator, nullptr, 10);
+    ASSERT_NE(fresh, nullptr);
+    DukHeapAllocator::Free(&allocator, fresh);
+}
+
+TEST(DukHeapAllocatorTest, Stats)
+{
+    DukHeapAllocator allocator;
+    const auto owner = allocator.AddOwner();
+    ASSERT_NE(owner, DUK_HEAP_OWNER_NONE);
+
+    allocator.SetOwner(owner);
+    auto a = DukHeapAllocator::Alloc(&allocator, 100);
+    auto b = DukHeapAllocator::Alloc(&allocator, 1000);
+    allocator.SetOwner(DUK_HEAP_OWNER_NONE);
+    auto c = DukHeapAllocator::Alloc(&allocator, 10);
+
+    const auto& stats = allocator.GetStats(owner);
+    ASSERT_EQ(stats.LiveBytes, 1100u);
+    ASSERT_EQ(stats.PeakBytes, 1100u);
+    ASSERT_EQ(stats.Allocations, 2u);
+    ASSERT_EQ(stats.AllocatedBytes, 1100u);
+    ASSERT_EQ(allocator.GetStats(DUK_HEAP_OWNER_NONE).LiveBytes, 10u);
+
+    // Memory stays with whoever allocated it, whoever frees it.
+    DukHeapAllocator::Free(&allocator, b);
+    ASSERT_EQ(stats.LiveBytes, 100u);
+    ASSERT_EQ(stats.PeakBytes, 1100u);
+    ASSERT_EQ(stats.AllocatedBytes, 1100u);
+
+    DukHeapAllocator::Free(&allocator, a);
+    DukHeapAllocator::Free(&allocator, c);
+    ASSERT_EQ(stats.LiveBytes, 0u);
+}
+
+TEST(DukHeapAllocatorTest, Limit)
+{
+    DukHeapAllocator allocator;
+    const auto owner = allocator.AddOwner();
+    allocator.SetLimit(1000);
+    allocator.SetOwner(owner);
+
+    auto a = DukHeapAllocator::Alloc(&allocator, 600);
+    ASSERT_NE(a, nullptr);
+
+    // The first allocation over the limit fails, the retry gets the headroom.
+    ASSERT_EQ(DukHeapAllocator::Alloc(&allocator, 600), nullptr);
+    const auto& stats = allocator.GetStats(owner);
+    ASSERT_EQ(stats.FailedAllocations, 1u);
+    ASSERT_TRUE(stats.OverLimit);
+    auto b = DukHeapAllocator::Alloc(&allocator, 600);
+    ASSERT_NE(b, nullptr);
+
+    // Nothing goes beyond the headroom.
+    ASSERT_EQ(DukHeapAllocator::Alloc(&allocator, DukHeapAllocator::LimitHeadroom), nullptr);
+    ASSERT_EQ(DukHeapAllocator::Realloc(&allocator, b, 600 + DukHeapAllocator::LimitHeadroom), nullptr);
+    ASSERT_EQ(stats.FailedAllocations, 3u);
+
+    // Back under the limit, the next allocation over it fails again.
+    DukHeapAllocator::Free(&allocator, b);
+    auto c = DukHeapAllocator::Alloc(&allocator, 100);
+    ASSERT_NE(c, nullptr);
+    ASSERT_FALSE(stats.OverLimit);
+    ASSERT_EQ(DukHeapAllocator::Alloc(&allocator, 600), nullptr);
+
+    // Allocations outside of any plugin are not limited.
+    allocator.SetOwner(DUK_HEAP_OWNER_NONE);
+    auto d = DukHeapAllocator::Alloc(&allocator, 4000);
+    ASSERT_NE(d, nullptr);
+
+    DukHeapAllocator::Free(&allocator, a);
+    DukHeapAllocator::Free(&allocator, c);
+    DukHeapAllocator::Free(&allocator, d);
+}
+
+TEST(DukHeapAllocatorTest, OwnersReused)
+{
+    DukHeapAllocator allocator;
+    const auto owner = allocator.AddOwner();
+    allocator.SetOwner(owner);
+    auto ptr = DukHeapAllocator::Alloc(&allocator, 64);
+    allocator.RemoveOwner(owner);
+
+    // Not reused while memory attributed to it is alive.
+    const auto other = allocator.AddOwner();
+    ASSERT_NE(other, owner);
+
+    DukHeapAllocator::Free(&allocator, ptr);
+    ASSERT_EQ(allocator.AddOwner(), owner);
+    ASSERT_EQ(allocator.GetStats(owner).Allocations, 0u);
+}
+
+#endif // ENABLE_SCRIPTING
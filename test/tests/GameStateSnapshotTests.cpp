@@ -0,0 +1,224 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2024 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#include <gtest/gtest.h>
+#include <numeric>
+#include <openrct2/GameStateSnapshotDelta.h>
+#include <openrct2/GameStateSnapshots.h>
+#include <openrct2/core/DataSerialiser.h>
+#include <openrct2/entity/EntityRegistry.h>
+#include <openrct2/entity/Litter.h>
+#include <stdexcept>
+#include <vector>
+
+using namespace OpenRCT2;
+
+class SnapshotDeltaTests : public testing::Test
+{
+protected:
+    // 64 bytes split into a header and three entities.
+    static constexpr uint32_t DataSize = 64;
+    const std::vector<SnapshotChunk> _chunks = { { 0, 0, 8 }, { 1, 8, 16 }, { 2, 24, 20 }, { 3, 44, 20 } };
+
+    static std::vector<uint8_t> CreateData()
+    {
+        std::vector<uint8_t> data(DataSize);
+        std::iota(data.begin(), data.end(), 0);
+        return data;
+    }
+
+    static MemoryStream ToStream(const std::vector<uint8_t>& data)
+    {
+        MemoryStream stream;
+        stream.Write(data.data(), data.size());
+        return stream;
+    }
+
+    static std::vector<uint8_t> ToVector(const MemoryStream& stream)
+    {
+        const auto* data = static_cast<const uint8_t*>(stream.GetData());
+        return std::vector<uint8_t>(data, data + stream.GetLength());
+    }
+
+    SnapshotKeyframe CreateKeyframe() const
+    {
+        SnapshotKeyframe keyframe;
+        keyframe.data = ToStream(CreateData());
+        keyframe.chunks = _chunks;
+        return keyframe;
+    }
+
+    // Encodes the data against the keyframe and checks it decodes to the same, returns the size of the delta.
+    static size_t RoundTrip(
+        const std::vector<uint8_t>& data, const std::vector<SnapshotChunk>& chunks, const SnapshotKeyframe& keyframe)
+    {
+        const auto delta = SnapshotDelta::Encode(ToStream(data), chunks, keyframe);
+        EXPECT_EQ(ToVector(SnapshotDelta::Decode(delta, keyframe)), data);
+        return delta.size();
+    }
+};
+
+TEST_F(SnapshotDeltaTests, Identical)
+{
+    const auto keyframe = CreateKeyframe();
+    const auto size = RoundTrip(CreateData(), _chunks, keyframe);
+
+    // Only the chunk headers and a single equal run per chunk.
+    ASSERT_LT(size, 32u);
+}
+
+TEST_F(SnapshotDeltaTests, SingleByteChange)
+{
+    const auto keyframe = CreateKeyframe();
+    const auto unchangedSize = RoundTrip(CreateData(), _chunks, keyframe);
+
+    auto data = CreateData();
+    data[30] ^= 0xFF;
+    const auto size = RoundTrip(data, _chunks, keyframe);
+    ASSERT_LE(size, unchangedSize + 3);
+
+    // First and last byte of the data.
+    data = CreateData();
+    data[0] = 0xAA;
+    data[DataSize - 1] = 0xBB;
+    RoundTrip(data, _chunks, keyframe);
+}
+
+TEST_F(SnapshotDeltaTests, RunAtEnd)
+{
+    const auto keyframe = CreateKeyframe();
+
+    // A run of changed bytes reaching the end of a chunk and of the buffer.
+    auto data = CreateData();
+    for (uint32_t i = 16; i < 24; i++)
+    {
+        data[i] = 0x55;
+    }
+    for (uint32_t i = 50; i < DataSize; i++)
+    {
+        data[i] = 0x55;
+    }
+    RoundTrip(data, _chunks, keyframe);
+
+    // All bytes changed.
+    std::fill(data.begin(), data.end(), 0xFF);
+    RoundTrip(data, _chunks, keyframe);
+}
+
+TEST_F(SnapshotDeltaTests, DifferentLengths)
+{
+    const auto keyframe = CreateKeyframe();
+
+    // The second entity grew, the third was removed and a new one was added at the end.
+    auto data = CreateData();
+    data.insert(data.begin() + 24, { 0xDE, 0xAD, 0xBE, 0xEF });
+    data.erase(data.begin() + 28, data.begin() + 48);
+    data.insert(data.end(), { 1, 2, 3, 4, 5, 6 });
+    const std::vector<SnapshotChunk> chunks = { { 0, 0, 8 }, { 1, 8, 20 }, { 3, 28, 20 }, { 7, 48, 6 } };
+    ASSERT_EQ(data.size(), 54u);
+    RoundTrip(data, chunks, keyframe);
+
+    // Shorter than the keyframe as a whole.
+    data = CreateData();
+    data.resize(24);
+    RoundTrip(data, { { 0, 0, 8 }, { 1, 8, 16 } }, keyframe);
+
+    // Nothing in common with the keyframe.
+    RoundTrip({}, {}, keyframe);
+}
+
+TEST_F(SnapshotDeltaTests, Corrupted)
+{
+    const auto keyframe = CreateKeyframe();
+    auto data = CreateData();
+    data[30] ^= 0xFF;
+    auto delta = SnapshotDelta::Encode(ToStream(data), _chunks, keyframe);
+
+    auto truncated = delta;
+    truncated.resize(truncated.size() / 2);
+    ASSERT_THROW((void)SnapshotDelta::Decode(truncated, keyframe), std::runtime_error);
+
+    // Decoding against a keyframe without the chunks it was encoded against.
+    SnapshotKeyframe other;
+    other.data = ToStream(data);
+    other.chunks = { { 0, 0, 64 } };
+    ASSERT_THROW((void)SnapshotDelta::Decode(delta, other), std::runtime_error);
+}
+
+class GameStateSnapshotTests : public testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        ResetAllEntities();
+    }
+
+    void TearDown() override
+    {
+        ResetAllEntities();
+    }
+
+    static std::vector<uint8_t> Serialise(IGameStateSnapshots& snapshots, GameStateSnapshot_t& snapshot)
+    {
+        DataSerialiser ds(true);
+        snapshots.SerialiseSnapshot(snapshot, ds);
+        const auto& stream = ds.GetStream();
+        const auto* data = static_cast<const uint8_t*>(stream.GetData());
+        return std::vector<uint8_t>(data, data + stream.GetLength());
+    }
+};
+
+TEST_F(GameStateSnapshotTests, CapturesAcrossKeyframes)
+{
+    // A new keyframe is taken every 8 captures, all captures have to come out as they were taken.
+    constexpr uint32_t numCaptures = 20;
+
+    auto snapshots = CreateGameStateSnapshots();
+    std::vector<GameStateSnapshot_t*> captured;
+    std::vector<std::vector<uint8_t>> expected;
+
+    std::vector<Litter*> litter;
+    for (uint32_t i = 0; i < numCaptures; i++)
+    {
+        if (i % 3 == 0)
+        {
+            auto* added = CreateEntity<Litter>();
+            added->SubType = Litter::Type::EmptyCan;
+            litter.push_back(added);
+        }
+        if (i == 10)
+        {
+            EntityRemove(litter[1]);
+            litter.erase(litter.begin() + 1);
+        }
+        for (auto* entity : litter)
+        {
+            entity->x += 32;
+            entity->creationTick = i;
+        }
+
+        auto& snapshot = snapshots->CreateSnapshot();
+        snapshots->LinkSnapshot(snapshot, i, i * 7);
+        snapshots->Capture(snapshot);
+        captured.push_back(&snapshot);
+
+        // The first capture is always stored in full.
+        auto reference = CreateGameStateSnapshots();
+        auto& referenceSnapshot = reference->CreateSnapshot();
+        reference->LinkSnapshot(referenceSnapshot, i, i * 7);
+        reference->Capture(referenceSnapshot);
+        expected.push_back(Serialise(*reference, referenceSnapshot));
+    }
+
+    for (uint32_t i = 0; i < numCaptures; i++)
+    {
+        ASSERT_EQ(Serialise(*snapshots, *captured[i]), expected[i]) << "capture " << i;
+        ASSERT_EQ(snapshots->GetLinkedSnapshot(i), captured[i]);
+    }
+}
@@ -0,0 +1,226 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2024 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#include <algorithm>
+#include <gtest/gtest.h>
+#include <map>
+#include <openrct2/entity/EntityList.h>
+#include <openrct2/entity/EntityRegistry.h>
+#include <openrct2/entity/Guest.h>
+#include <openrct2/entity/GuestAggregation.h>
+#include <vector>
+
+class GuestAggregationTests : public testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        ResetAllEntities();
+    }
+
+    void TearDown() override
+    {
+        ResetAllEntities();
+    }
+
+    static Guest* AddGuest(PeepState state, RideId ride = RideId::GetNull())
+    {
+        auto* guest = CreateEntity<Guest>();
+        for (auto& thought : guest->Thoughts)
+        {
+            thought.type = PeepThoughtType::None;
+        }
+        guest->OutsideOfPark = false;
+        guest->CurrentRide = ride;
+        guest->GuestHeadingToRideId = RideId::GetNull();
+        guest->SetState(state);
+        return guest;
+    }
+
+    static void SetThought(Guest& guest, PeepThoughtType type)
+    {
+        guest.Thoughts[0].type = type;
+        guest.Thoughts[0].item = PeepThoughtItemNone;
+        guest.Thoughts[0].freshness = 0;
+        GetGuestAggregation().MarkChanged(guest);
+    }
+
+    // The groups of every kind have to match going through all guests.
+    static void ExpectMatchesScan()
+    {
+        auto& aggregation = GetGuestAggregation();
+        for (size_t i = 0; i < GuestAggregation::NumKinds; i++)
+        {
+            const auto kind = static_cast<GuestAggregationKind>(i);
+
+            std::map<GuestAggregation::Key, std::vector<EntityId>> expected;
+            for (auto* guest : EntityList<Guest>())
+            {
+                const auto key = GuestAggregation::GetKey(kind, *guest);
+                if (!guest->OutsideOfPark && key != GuestAggregation::NoKey)
+                {
+                    expected[key].push_back(guest->Id);
+                }
+            }
+
+            std::map<GuestAggregation::Key, std::vector<EntityId>> actual;
+            for (const auto& group : aggregation.GetGroups(kind))
+            {
+                EXPECT_FALSE(group.Guests.empty());
+                EXPECT_EQ(actual.count(group.GroupKey), 0u);
+                actual[group.GroupKey] = group.Guests;
+            }
+
+            for (auto* groups : { &expected, &actual })
+            {
+                for (auto& [key, guests] : *groups)
+                {
+                    std::sort(guests.begin(), guests.end());
+                }
+            }
+            EXPECT_EQ(actual, expected) << "kind " << i;
+
+            for (auto* guest : EntityList<Guest>())
+            {
+                const auto key = guest->OutsideOfPark ? GuestAggregation::NoKey : GuestAggregation::GetKey(kind, *guest);
+                EXPECT_EQ(aggregation.GetKey(kind, guest->Id), key);
+            }
+        }
+
+        uint32_t numGuests = 0;
+        std::map<PeepThoughtType, uint32_t> numThinking;
+        for (auto* guest : EntityList<Guest>())
+        {
+            if (!guest->OutsideOfPark)
+            {
+                numGuests++;
+                if (GuestAggregation::GetKey(GuestAggregationKind::Thought, *guest) != GuestAggregation::NoKey)
+                {
+                    numThinking[guest->Thoughts[0].type]++;
+                }
+            }
+        }
+        EXPECT_EQ(aggregation.GetNumGuests(), numGuests);
+        for (auto type : { PeepThoughtType::Hungry, PeepThoughtType::Thirsty, PeepThoughtType::Lost })
+        {
+            EXPECT_EQ(aggregation.GetNumGuestsThinking(type), numThinking[type]);
+        }
+    }
+};
+
+TEST_F(GuestAggregationTests, AddedGuests)
+{
+    AddGuest(PeepState::Walking);
+    AddGuest(PeepState::Walking);
+    AddGuest(PeepState::Queuing, RideId::FromUnderlying(3));
+    AddGuest(PeepState::OnRide, RideId::FromUnderlying(3));
+    ExpectMatchesScan();
+
+    auto& aggregation = GetGuestAggregation();
+    ASSERT_EQ(aggregation.GetNumGuests(), 4u);
+    auto* onRide = aggregation.GetGroup(GuestAggregationKind::Ride, 3);
+    ASSERT_NE(onRide, nullptr);
+    ASSERT_EQ(onRide->Guests.size(), 2u);
+
+    // Guests added after the index was built are picked up as well.
+    AddGuest(PeepState::Sitting);
+    ExpectMatchesScan();
+}
+
+TEST_F(GuestAggregationTests, StateChanges)
+{
+    auto* a = AddGuest(PeepState::Walking);
+    auto* b = AddGuest(PeepState::Walking);
+    ExpectMatchesScan();
+
+    a->CurrentRide = RideId::FromUnderlying(5);
+    a->SetState(PeepState::Queuing);
+    ExpectMatchesScan();
+
+    b->GuestHeadingToRideId = RideId::FromUnderlying(7);
+    GetGuestAggregation().MarkChanged(*b);
+    ExpectMatchesScan();
+
+    // Changing several times before the index is used again only counts the last state.
+    a->SetState(PeepState::OnRide);
+    a->SetState(PeepState::LeavingRide);
+    a->CurrentRide = RideId::FromUnderlying(6);
+    ExpectMatchesScan();
+    ASSERT_EQ(GetGuestAggregation().GetGroup(GuestAggregationKind::Ride, 5), nullptr);
+}
+
+TEST_F(GuestAggregationTests, Thoughts)
+{
+    auto* a = AddGuest(PeepState::Walking);
+    auto* b = AddGuest(PeepState::Walking);
+    auto* c = AddGuest(PeepState::Walking);
+    SetThought(*a, PeepThoughtType::Hungry);
+    SetThought(*b, PeepThoughtType::Hungry);
+    SetThought(*c, PeepThoughtType::Thirsty);
+    ExpectMatchesScan();
+    ASSERT_EQ(GetGuestAggregation().GetNumGuestsThinking(PeepThoughtType::Hungry), 2u);
+
+    SetThought(*a, PeepThoughtType::Lost);
+    ExpectMatchesScan();
+    ASSERT_EQ(GetGuestAggregation().GetNumGuestsThinking(PeepThoughtType::Hungry), 1u);
+
+    // Thoughts that are no longer fresh are not counted.
+    b->Thoughts[0].freshness = 10;
+    GetGuestAggregation().MarkChanged(*b);
+    ExpectMatchesScan();
+    ASSERT_EQ(GetGuestAggregation().GetNumGuestsThinking(PeepThoughtType::Hungry), 0u);
+}
+
+TEST_F(GuestAggregationTests, RemovedGuests)
+{
+    auto* a = AddGuest(PeepState::Walking);
+    AddGuest(PeepState::Queuing, RideId::FromUnderlying(2));
+    auto* c = AddGuest(PeepState::Queuing, RideId::FromUnderlying(2));
+    ExpectMatchesScan();
+
+    // Removed with a change still pending.
+    a->SetState(PeepState::Sitting);
+    EntityRemove(a);
+    EntityRemove(c);
+    ExpectMatchesScan();
+    ASSERT_EQ(GetGuestAggregation().GetNumGuests(), 1u);
+
+    // A new guest may take the place of a removed one.
+    AddGuest(PeepState::Watching, RideId::FromUnderlying(4));
+    ExpectMatchesScan();
+}
+
+TEST_F(GuestAggregationTests, LeavingPark)
+{
+    auto* a = AddGuest(PeepState::Walking);
+    AddGuest(PeepState::Walking);
+    ExpectMatchesScan();
+
+    a->OutsideOfPark = true;
+    GetGuestAggregation().MarkChanged(*a);
+    ExpectMatchesScan();
+    ASSERT_EQ(GetGuestAggregation().GetNumGuests(), 1u);
+
+    a->OutsideOfPark = false;
+    GetGuestAggregation().MarkChanged(*a);
+    ExpectMatchesScan();
+    ASSERT_EQ(GetGuestAggregation().GetNumGuests(), 2u);
+}
+
+TEST_F(GuestAggregationTests, Invalidate)
+{
+    auto* a = AddGuest(PeepState::Walking);
+    AddGuest(PeepState::Walking);
+    ExpectMatchesScan();
+
+    // Changes that were not marked, e.g. from entities being replaced, are only picked up by building it again.
+    a->State = PeepState::Sitting;
+    GetGuestAggregation().Invalidate();
+    ExpectMatchesScan();
+}
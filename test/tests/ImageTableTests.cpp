@@ -0,0 +1,198 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2024 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#include "TestData.h"
+
+#include <gtest/gtest.h>
+#include <openrct2/OpenRCT2.h>
+#include <openrct2/config/Config.h>
+#include <openrct2/core/File.h>
+#include <openrct2/core/Json.hpp>
+#include <openrct2/core/Path.hpp>
+#include <openrct2/drawing/ImageImporter.h>
+#include <openrct2/object/ImageTable.h>
+#include <openrct2/object/Object.h>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+using namespace OpenRCT2::Drawing;
+
+// Reads the images of the object from the test data.
+class TestReadObjectContext final : public IReadObjectContext
+{
+public:
+    std::vector<std::string> Warnings;
+
+    std::string_view GetObjectIdentifier() override
+    {
+        return "test.image_table";
+    }
+
+    IObjectRepository& GetObjectRepository() override
+    {
+        throw std::runtime_error("Not used by image tables.");
+    }
+
+    bool ShouldLoadImages() override
+    {
+        return true;
+    }
+
+    std::vector<uint8_t> GetData(std::string_view path) override
+    {
+        return File::ReadAllBytes(Path::Combine(TestData::GetBasePath(), u8"images", path));
+    }
+
+    ObjectAsset GetAsset(std::string_view path) override
+    {
+        return ObjectAsset(Path::Combine(TestData::GetBasePath(), u8"images", path));
+    }
+
+    void LogVerbose(ObjectError code, const utf8* text) override
+    {
+    }
+
+    void LogWarning(ObjectError code, const utf8* text) override
+    {
+        Warnings.emplace_back(text);
+    }
+
+    void LogError(ObjectError code, const utf8* text) override
+    {
+        Warnings.emplace_back(text);
+    }
+};
+
+class ImageTableTests : public testing::Test
+{
+protected:
+    bool _lazyLoadImages{};
+    bool _headless{};
+
+    void SetUp() override
+    {
+        _lazyLoadImages = gConfigGeneral.LazyLoadImages;
+        _headless = gOpenRCT2Headless;
+        gConfigGeneral.LazyLoadImages = true;
+        gOpenRCT2Headless = false;
+    }
+
+    void TearDown() override
+    {
+        gConfigGeneral.LazyLoadImages = _lazyLoadImages;
+        gOpenRCT2Headless = _headless;
+    }
+
+    static json_t CreateImage(std::string_view path, bool keepPalette)
+    {
+        json_t image = json_t::object();
+        image["path"] = path;
+        image["x"] = -16;
+        image["y"] = -8;
+        image["srcX"] = 32;
+        image["srcY"] = 32;
+        image["srcWidth"] = 12;
+        image["srcHeight"] = 10;
+        if (keepPalette)
+        {
+            image["palette"] = "keep";
+        }
+        return image;
+    }
+
+    // The image as an eager load would import it.
+    static std::vector<uint8_t> Import(std::string_view path, bool keepPalette)
+    {
+        auto image = Imaging::ReadFromFile(
+            Path::Combine(TestData::GetBasePath(), u8"images", path), keepPalette ? IMAGE_FORMAT::PNG : IMAGE_FORMAT::PNG_32);
+        ImageImporter importer;
+        auto result = importer.Import(
+            image, 32, 32, 12, 10, -16, -8,
+            keepPalette ? ImageImporter::Palette::KeepIndices : ImageImporter::Palette::OpenRCT2,
+            ImageImporter::ImportFlags::RLE);
+        return result.Buffer;
+    }
+
+    static void ExpectLazyImage(ImageTable& table, uint32_t index, const std::vector<uint8_t>& expected)
+    {
+        ASSERT_TRUE(table.IsImageLazy(index));
+        const auto& entry = table.GetImages()[index];
+        ASSERT_EQ(entry.width, 12);
+        ASSERT_EQ(entry.height, 10);
+        ASSERT_EQ(entry.x_offset, -16);
+        ASSERT_EQ(entry.y_offset, -8);
+
+        G1Element element = entry;
+        const auto size = table.LoadImageData(index, element);
+        ASSERT_EQ(size, expected.size());
+        ASSERT_EQ(std::vector<uint8_t>(element.offset, element.offset + size), expected);
+
+        ASSERT_EQ(table.UnloadImageData(index), size);
+        table.ReleaseLoadCache();
+    }
+};
+
+TEST_F(ImageTableTests, LazyImages)
+{
+    TestReadObjectContext context;
+    json_t root = { { "images", json_t::array({ CreateImage("logo.png", false), CreateImage("logo.png", false) }) } };
+
+    ImageTable table;
+    table.ReadJson(&context, root);
+    ASSERT_TRUE(context.Warnings.empty());
+    ASSERT_TRUE(table.HasLazyImages());
+    ASSERT_EQ(table.GetCount(), 2u);
+
+    const auto expected = Import("logo.png", false);
+    ExpectLazyImage(table, 0, expected);
+    ExpectLazyImage(table, 1, expected);
+}
+
+TEST_F(ImageTableTests, LazyImagesKeepPalette)
+{
+    TestReadObjectContext context;
+    json_t root = { { "images", json_t::array({ CreateImage("logo.png", true) }) } };
+
+    ImageTable table;
+    table.ReadJson(&context, root);
+    ASSERT_TRUE(context.Warnings.empty());
+    ASSERT_EQ(table.GetCount(), 1u);
+    ExpectLazyImage(table, 0, Import("logo.png", true));
+}
+
+TEST_F(ImageTableTests, LazyImagesKeepPaletteNotPaletted)
+{
+    // Keeping the palette of an image without one is reported while loading, not when it is drawn.
+    TestReadObjectContext context;
+    json_t root = { { "images", json_t::array({ CreateImage("rgba.png", true), CreateImage("rgba.png", true) }) } };
+
+    ImageTable table;
+    table.ReadJson(&context, root);
+    ASSERT_EQ(context.Warnings.size(), 2u);
+    ASSERT_NE(context.Warnings[0].find("not paletted"), std::string::npos);
+    ASSERT_EQ(table.GetCount(), 2u);
+    ASSERT_FALSE(table.IsImageLazy(0));
+    ASSERT_FALSE(table.IsImageLazy(1));
+    ASSERT_EQ(table.GetImages()[0].offset, nullptr);
+}
+
+TEST_F(ImageTableTests, LazyImagesMixedPalette)
+{
+    // The first image decides how the source is read, the other one can not be cut from it.
+    TestReadObjectContext context;
+    json_t root = { { "images", json_t::array({ CreateImage("logo.png", true), CreateImage("logo.png", false) }) } };
+
+    ImageTable table;
+    table.ReadJson(&context, root);
+    ASSERT_EQ(context.Warnings.size(), 1u);
+    ASSERT_EQ(table.GetCount(), 2u);
+    ExpectLazyImage(table, 0, Import("logo.png", true));
+    ASSERT_FALSE(table.IsImageLazy(1));
+}
@@ -0,0 +1,147 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2024 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#ifndef DISABLE_NETWORK
+
+#    include "TestData.h"
+
+#    include <gtest/gtest.h>
+#    include <openrct2/Context.h>
+#    include <openrct2/Game.h>
+#    include <openrct2/GameState.h>
+#    include <openrct2/OpenRCT2.h>
+#    include <openrct2/core/Json.hpp>
+#    include <openrct2/network/NetworkResync.h>
+#    include <openrct2/network/NetworkTelemetry.h>
+#    include <openrct2/world/Map.h>
+
+using namespace OpenRCT2;
+
+TEST(NetworkRttHistogramTest, Empty)
+{
+    NetworkRttHistogram histogram;
+    ASSERT_EQ(histogram.GetCount(), 0u);
+    ASSERT_EQ(histogram.GetMin(), 0u);
+    ASSERT_EQ(histogram.GetMax(), 0u);
+    ASSERT_EQ(histogram.GetMean(), 0u);
+    ASSERT_EQ(histogram.GetPercentile(0.5f), 0u);
+}
+
+TEST(NetworkRttHistogramTest, BucketBoundaries)
+{
+    NetworkRttHistogram histogram;
+    // A limit belongs to the bucket it ends, anything above the last limit goes into the extra bucket.
+    for (uint32_t rtt : { 0u, 25u, 26u, 50u, 3200u, 3201u })
+    {
+        histogram.Add(rtt);
+    }
+
+    const auto json = histogram.ToJson();
+    const auto& counts = json["counts"];
+    ASSERT_EQ(counts.size(), NetworkRttHistogram::NumBuckets);
+    ASSERT_EQ(counts[0], 2u);
+    ASSERT_EQ(counts[1], 2u);
+    for (size_t i = 2; i < 7; i++)
+    {
+        ASSERT_EQ(counts[i], 0u);
+    }
+    ASSERT_EQ(counts[7], 1u);
+    ASSERT_EQ(counts[8], 1u);
+}
+
+TEST(NetworkRttHistogramTest, Statistics)
+{
+    NetworkRttHistogram histogram;
+    for (int i = 0; i < 90; i++)
+    {
+        histogram.Add(10);
+    }
+    for (int i = 0; i < 9; i++)
+    {
+        histogram.Add(150);
+    }
+    histogram.Add(5000);
+
+    ASSERT_EQ(histogram.GetCount(), 100u);
+    ASSERT_EQ(histogram.GetMin(), 10u);
+    ASSERT_EQ(histogram.GetMax(), 5000u);
+    ASSERT_EQ(histogram.GetMean(), 72u);
+}
+
+TEST(NetworkRttHistogramTest, Percentiles)
+{
+    NetworkRttHistogram histogram;
+    for (int i = 0; i < 90; i++)
+    {
+        histogram.Add(10);
+    }
+    for (int i = 0; i < 9; i++)
+    {
+        histogram.Add(150);
+    }
+    histogram.Add(5000);
+
+    // Percentiles are reported as the upper bound of their bucket.
+    ASSERT_EQ(histogram.GetPercentile(0.5f), 25u);
+    ASSERT_EQ(histogram.GetPercentile(0.8f), 25u);
+    ASSERT_EQ(histogram.GetPercentile(0.95f), 200u);
+    // The extra bucket has no upper bound, the largest sample is used instead.
+    ASSERT_EQ(histogram.GetPercentile(1.0f), 5000u);
+}
+
+TEST(NetworkRttHistogramTest, PercentileLimitedToMax)
+{
+    NetworkRttHistogram histogram;
+    histogram.Add(30);
+    ASSERT_EQ(histogram.GetPercentile(0.5f), 30u);
+}
+
+TEST(NetworkResyncTest, FindDifferences)
+{
+    const uint64_t a[] = { 1, 2, 3, 4 };
+    const uint64_t b[] = { 1, 5, 3, 4, 6 };
+    ASSERT_TRUE(NetworkResyncFindDifferences(a, std::size(a), a, std::size(a)).empty());
+    ASSERT_EQ(NetworkResyncFindDifferences(a, std::size(a), b, std::size(b)), (std::vector<uint32_t>{ 1, 4 }));
+}
+
+TEST(NetworkResyncTest, RegionHashChangesWithTile)
+{
+    gOpenRCT2Headless = true;
+    gOpenRCT2NoGraphics = true;
+
+    auto context = CreateContext();
+    bool initialised = context->Initialise();
+    ASSERT_TRUE(initialised);
+
+    GetContext()->LoadParkFromFile(TestData::GetParkPath("bpb.sv6"));
+    GameLoadInit();
+
+    const auto before = NetworkResyncHashes::Capture(0);
+    ASSERT_EQ(before.Regions.size(), NetworkResyncGetNumRegions());
+
+    const TileCoordsXY tile{ 37, 21 };
+    auto* element = MapGetFirstElementAt(tile);
+    ASSERT_NE(element, nullptr);
+    element->ClearanceHeight++;
+
+    const auto changed = NetworkResyncHashes::Capture(0);
+    const auto regionsPerRow = (GetGameState().MapSize.x + RESYNC_REGION_SIZE - 1) / RESYNC_REGION_SIZE;
+    const auto regionX = tile.x / RESYNC_REGION_SIZE;
+    const auto regionY = tile.y / RESYNC_REGION_SIZE;
+    const auto expectedRegion = static_cast<uint32_t>(regionY * regionsPerRow + regionX);
+    const auto differences = NetworkResyncFindDifferences(
+        before.Regions.data(), before.Regions.size(), changed.Regions.data(), changed.Regions.size());
+    ASSERT_EQ(differences, (std::vector<uint32_t>{ expectedRegion }));
+
+    element->ClearanceHeight--;
+    const auto restored = NetworkResyncHashes::Capture(0);
+    ASSERT_EQ(restored.Regions, before.Regions);
+}
+
+#endif // DISABLE_NETWORK
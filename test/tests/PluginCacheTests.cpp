@@ -0,0 +1,182 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2024 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#ifdef ENABLE_SCRIPTING
+
+#    include <chrono>
+#    include <gtest/gtest.h>
+#    include <memory>
+#    include <openrct2/Context.h>
+#    include <openrct2/OpenRCT2.h>
+#    include <openrct2/PlatformEnvironment.h>
+#    include <openrct2/audio/AudioContext.h>
+#    include <openrct2/core/File.h>
+#    include <openrct2/core/FileSystem.hpp>
+#    include <openrct2/scripting/Plugin.h>
+#    include <openrct2/ui/UiContext.h>
+#    include <string>
+#    include <vector>
+
+using namespace OpenRCT2;
+using namespace OpenRCT2::Scripting;
+
+class PluginCacheTests : public testing::Test
+{
+protected:
+    fs::path _directory;
+    std::unique_ptr<IContext> _context;
+    duk_context* _dukContext{};
+
+    void SetUp() override
+    {
+        gOpenRCT2Headless = true;
+        gOpenRCT2NoGraphics = true;
+
+        _directory = fs::temp_directory_path() / "openrct2_plugin_cache_test";
+        fs::remove_all(_directory);
+        fs::create_directories(_directory);
+
+        // Keep the compiled plugins out of the actual cache directory.
+        std::shared_ptr<IPlatformEnvironment> env = CreatePlatformEnvironment();
+        env->SetBasePath(DIRBASE::CACHE, (_directory / "cache").string());
+        _context = CreateContext(env, Audio::CreateDummyAudioContext(), Ui::CreateDummyUiContext());
+        ASSERT_TRUE(_context->Initialise());
+
+        _dukContext = duk_create_heap_default();
+        ASSERT_NE(_dukContext, nullptr);
+    }
+
+    void TearDown() override
+    {
+        duk_destroy_heap(_dukContext);
+        _context = nullptr;
+        fs::remove_all(_directory);
+    }
+
+    std::string PluginPath() const
+    {
+        return (_directory / "plugin.js").string();
+    }
+
+    void WritePlugin(const std::string& version) const
+    {
+        const auto code = "registerPlugin({ name: 'test', version: '" + version
+            + "', authors: ['OpenRCT2'], type: 'local', licence: 'MIT', targetApiVersion: 80,"
+              " main: function() { started = '"
+            + version + "'; } });";
+        File::WriteAllBytes(PluginPath(), code.data(), code.size());
+    }
+
+    // Loads and starts the plugin, returns the version it was started as.
+    std::string LoadPlugin()
+    {
+        std::string version;
+        {
+            Plugin plugin(_dukContext, PluginPath());
+            plugin.Load();
+            plugin.Start();
+            version = plugin.GetMetadata().Version;
+            plugin.Unload();
+        }
+
+        duk_get_global_string(_dukContext, "started");
+        const std::string started = duk_safe_to_string(_dukContext, -1);
+        duk_pop(_dukContext);
+        EXPECT_EQ(started, version);
+        return version;
+    }
+
+    // The plugin cache holds one file per plugin.
+    std::string CachePath() const
+    {
+        std::vector<std::string> files;
+        for (const auto& entry : fs::directory_iterator(_directory / "cache" / "plugin"))
+        {
+            files.push_back(entry.path().string());
+        }
+        EXPECT_EQ(files.size(), 1u);
+        return files.empty() ? std::string() : files[0];
+    }
+
+    // Sets the cache file back in time, so that it can be told whether it was written again.
+    static fs::file_time_type Age(const std::string& path)
+    {
+        const auto time = fs::last_write_time(path) - std::chrono::hours(1);
+        fs::last_write_time(path, time);
+        return time;
+    }
+};
+
+TEST_F(PluginCacheTests, CompiledCodeIsCached)
+{
+    WritePlugin("1");
+    ASSERT_EQ(LoadPlugin(), "1");
+
+    const auto cachePath = CachePath();
+    const auto data = File::ReadAllBytes(cachePath);
+    ASSERT_GT(data.size(), 32u);
+
+    // The second load uses the cached function and leaves the file as it is.
+    const auto time = Age(cachePath);
+    ASSERT_EQ(LoadPlugin(), "1");
+    ASSERT_EQ(fs::last_write_time(cachePath), time);
+    ASSERT_EQ(File::ReadAllBytes(cachePath), data);
+}
+
+TEST_F(PluginCacheTests, SourceChanged)
+{
+    WritePlugin("1");
+    ASSERT_EQ(LoadPlugin(), "1");
+    const auto cachePath = CachePath();
+    const auto time = Age(cachePath);
+
+    // The cached function is stale, the plugin is compiled again and the file replaced.
+    WritePlugin("2");
+    ASSERT_EQ(LoadPlugin(), "2");
+    ASSERT_NE(fs::last_write_time(cachePath), time);
+
+    const auto newTime = Age(cachePath);
+    ASSERT_EQ(LoadPlugin(), "2");
+    ASSERT_EQ(fs::last_write_time(cachePath), newTime);
+}
+
+TEST_F(PluginCacheTests, CorruptCache)
+{
+    WritePlugin("1");
+    ASSERT_EQ(LoadPlugin(), "1");
+    const auto cachePath = CachePath();
+    const auto data = File::ReadAllBytes(cachePath);
+
+    std::vector<std::vector<uint8_t>> corrupted;
+    // Damaged bytecode.
+    corrupted.push_back(data);
+    corrupted.back()[data.size() - 4] ^= 0xFF;
+    // Truncated within the bytecode and within the header.
+    corrupted.emplace_back(data.begin(), data.end() - 8);
+    corrupted.emplace_back(data.begin(), data.begin() + 10);
+    // Damaged header.
+    corrupted.push_back(data);
+    corrupted.back()[0] ^= 0xFF;
+    // Not a cache file at all.
+    corrupted.emplace_back(data.size(), 0xAB);
+
+    for (size_t i = 0; i < corrupted.size(); i++)
+    {
+        // The plugin is compiled from source instead and the cache file is written again.
+        File::WriteAllBytes(cachePath, corrupted[i].data(), corrupted[i].size());
+        ASSERT_EQ(LoadPlugin(), "1") << "corruption " << i;
+        ASSERT_NE(File::ReadAllBytes(cachePath), corrupted[i]) << "corruption " << i;
+
+        const auto time = Age(cachePath);
+        ASSERT_EQ(LoadPlugin(), "1") << "corruption " << i;
+        ASSERT_EQ(fs::last_write_time(cachePath), time) << "corruption " << i;
+    }
+}
+
+#endif // ENABLE_SCRIPTING
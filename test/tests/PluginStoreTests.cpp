@@ -0,0 +1,227 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2024 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#ifdef ENABLE_SCRIPTING
+
+#    include <gtest/gtest.h>
+#    include <openrct2/core/Json.hpp>
+#    include <openrct2/scripting/PluginStore.h>
+#    include <vector>
+
+using namespace OpenRCT2::Scripting;
+
+class PluginStoreTests : public testing::Test
+{
+protected:
+    duk_context* _context{};
+
+    void SetUp() override
+    {
+        _context = duk_create_heap_default();
+        ASSERT_NE(_context, nullptr);
+    }
+
+    void TearDown() override
+    {
+        duk_destroy_heap(_context);
+    }
+
+    // Sets the value at the path like a plugin would, the objects along the path have to exist.
+    void SetValue(PluginStore& store, const PluginStore::Path& path, const char* json)
+    {
+        store.GetRoot().push();
+        for (size_t i = 0; i + 1 < path.size(); i++)
+        {
+            duk_get_prop_string(_context, -1, path[i].c_str());
+            duk_remove(_context, -2);
+        }
+        duk_push_string(_context, json);
+        duk_json_decode(_context, -1);
+        duk_put_prop_string(_context, -2, path.back().c_str());
+        duk_pop(_context);
+        store.MarkChanged(path);
+    }
+
+    void DeleteValue(PluginStore& store, const PluginStore::Path& path)
+    {
+        store.GetRoot().push();
+        for (size_t i = 0; i + 1 < path.size(); i++)
+        {
+            duk_get_prop_string(_context, -1, path[i].c_str());
+            duk_remove(_context, -2);
+        }
+        duk_del_prop_string(_context, -1, path.back().c_str());
+        duk_pop(_context);
+        store.MarkChanged(path);
+    }
+
+    // Keys are not necessarily in the same order after reading, compare the values instead.
+    static json_t ToJson(const PluginStore& store)
+    {
+        return json_t::parse(store.ToJson());
+    }
+
+    PluginStore ReadBack(const std::vector<uint8_t>& data, PluginStoreReadResult expected = PluginStoreReadResult::Complete)
+    {
+        PluginStore store(_context);
+        EXPECT_EQ(store.Read(data.data(), data.size()), expected);
+        return store;
+    }
+};
+
+TEST_F(PluginStoreTests, JsonRoundTrip)
+{
+    PluginStore store(_context);
+    store.Clear();
+    ASSERT_TRUE(store.IsEmpty());
+
+    const char* json = R"({"a":{"b":1,"c":[1,2,{"d":true}]},"e":"text"})";
+    ASSERT_TRUE(store.FromJson(json));
+    ASSERT_FALSE(store.IsEmpty());
+    ASSERT_EQ(ToJson(store), json_t::parse(json));
+
+    // Invalid input leaves the storage as it was.
+    ASSERT_FALSE(store.FromJson("{"));
+    ASSERT_FALSE(store.FromJson("[1,2]"));
+    ASSERT_EQ(ToJson(store), json_t::parse(json));
+}
+
+TEST_F(PluginStoreTests, WriteRead)
+{
+    PluginStore store(_context);
+    ASSERT_TRUE(store.FromJson(R"({"a":{"b":1,"c":[1,2]},"e":"text"})"));
+    auto data = store.Write();
+    ASSERT_FALSE(store.HasChanges());
+
+    auto readStore = ReadBack(data);
+    ASSERT_EQ(ToJson(readStore), ToJson(store));
+    ASSERT_FALSE(readStore.HasChanges());
+
+    // Nothing changed, writing again gives the same records.
+    ASSERT_EQ(readStore.Write(), data);
+}
+
+TEST_F(PluginStoreTests, WriteChangesAppended)
+{
+    PluginStore store(_context);
+    ASSERT_TRUE(store.FromJson(R"({"a":{"b":1}})"));
+    auto data = store.Write();
+
+    SetValue(store, { "a", "b" }, "2");
+    SetValue(store, { "a", "f" }, R"({"g":[3]})");
+    ASSERT_TRUE(store.HasChanges());
+    auto changes = store.WriteChanges();
+    ASSERT_FALSE(changes.empty());
+    ASSERT_FALSE(store.HasChanges());
+    ASSERT_TRUE(store.WriteChanges().empty());
+
+    data.insert(data.end(), changes.begin(), changes.end());
+    auto readStore = ReadBack(data);
+    ASSERT_EQ(ToJson(readStore), json_t::parse(R"({"a":{"b":2,"f":{"g":[3]}}})"));
+}
+
+TEST_F(PluginStoreTests, DeleteRecord)
+{
+    PluginStore store(_context);
+    ASSERT_TRUE(store.FromJson(R"({"a":{"b":1,"c":2}})"));
+    auto data = store.Write();
+
+    DeleteValue(store, { "a", "b" });
+    auto changes = store.WriteChanges();
+    data.insert(data.end(), changes.begin(), changes.end());
+
+    auto readStore = ReadBack(data);
+    ASSERT_EQ(ToJson(readStore), json_t::parse(R"({"a":{"c":2}})"));
+
+    // Written in full, the deleted value is left out.
+    auto rewritten = ReadBack(store.Write());
+    ASSERT_EQ(ToJson(rewritten), json_t::parse(R"({"a":{"c":2}})"));
+}
+
+TEST_F(PluginStoreTests, ChangeWithinRecord)
+{
+    PluginStore store(_context);
+    ASSERT_TRUE(store.FromJson(R"({"a":{"b":{"c":1}}})"));
+    auto data = store.Write();
+
+    // a.b is a record, a change within it writes the whole record again.
+    SetValue(store, { "a", "b", "d" }, "2");
+    auto changes = store.WriteChanges();
+    data.insert(data.end(), changes.begin(), changes.end());
+
+    auto readStore = ReadBack(data);
+    ASSERT_EQ(ToJson(readStore), json_t::parse(R"({"a":{"b":{"c":1,"d":2}}})"));
+}
+
+TEST_F(PluginStoreTests, HandedOutRecord)
+{
+    PluginStore store(_context);
+    ASSERT_TRUE(store.FromJson(R"({"a":{"b":{"c":1},"d":{"e":1}}})"));
+    auto data = store.Write();
+
+    // A script keeps a.b and changes it after every write without setting it again.
+    store.MarkHandedOut({ "a", "b" });
+    for (int32_t i = 2; i <= 3; i++)
+    {
+        store.GetRoot().push();
+        duk_get_prop_string(_context, -1, "a");
+        duk_get_prop_string(_context, -1, "b");
+        duk_push_int(_context, i);
+        duk_put_prop_string(_context, -2, "c");
+        duk_pop_3(_context);
+
+        auto changes = store.WriteChanges();
+        ASSERT_FALSE(changes.empty());
+        data.insert(data.end(), changes.begin(), changes.end());
+        ASSERT_EQ(ToJson(ReadBack(data))["a"]["b"]["c"], i);
+    }
+
+    // Nothing changed since, so nothing is appended.
+    ASSERT_TRUE(store.WriteChanges().empty());
+
+    // Handing out the parent covers the records within it.
+    store.MarkHandedOut({ "a" });
+    store.GetRoot().push();
+    duk_get_prop_string(_context, -1, "a");
+    duk_get_prop_string(_context, -1, "d");
+    duk_push_int(_context, 2);
+    duk_put_prop_string(_context, -2, "e");
+    duk_pop_3(_context);
+    ASSERT_EQ(ToJson(ReadBack(store.Write()))["a"]["d"]["e"], 2);
+}
+
+TEST_F(PluginStoreTests, CutShortRecord)
+{
+    PluginStore store(_context);
+    ASSERT_TRUE(store.FromJson(R"({"a":{"b":1}})"));
+    auto data = store.Write();
+    const auto expected = ToJson(store);
+
+    SetValue(store, { "a", "b" }, R"("a longer value")");
+    auto changes = store.WriteChanges();
+    data.insert(data.end(), changes.begin(), changes.end() - 3);
+
+    // The records before the one cut short are kept.
+    auto readStore = ReadBack(data, PluginStoreReadResult::Incomplete);
+    ASSERT_EQ(ToJson(readStore), expected);
+}
+
+TEST_F(PluginStoreTests, InvalidHeader)
+{
+    PluginStore store(_context);
+    ASSERT_TRUE(store.FromJson(R"({"a":{"b":1}})"));
+    auto data = store.Write();
+
+    ReadBack(std::vector<uint8_t>(data.begin(), data.begin() + 3), PluginStoreReadResult::Failed);
+
+    data[0] ^= 0xFF;
+    ReadBack(data, PluginStoreReadResult::Failed);
+}
+
+#endif // ENABLE_SCRIPTING
@@ -15,11 +15,14 @@
 #include <openrct2/GameState.h>
 #include <openrct2/OpenRCT2.h>
 #include <openrct2/ReplayManager.h>
+#include <openrct2/actions/ParkSetParameterAction.h>
 #include <openrct2/audio/AudioContext.h>
 #include <openrct2/core/File.h>
 #include <openrct2/core/FileScanner.h>
+#include <openrct2/core/FileSystem.hpp>
 #include <openrct2/core/Path.hpp>
 #include <openrct2/core/String.hpp>
+#include <openrct2/entity/EntityRegistry.h>
 #include <openrct2/platform/Platform.h>
 #include <openrct2/ride/Ride.h>
 #include <string>
@@ -100,6 +103,121 @@ TEST_P(ReplayTests, RunReplay)
     ASSERT_FALSE(replayManager->IsPlaybackStateMismatching());
 }
 
+TEST(ReplayRecordingTests, ReadSegmentsBack)
+{
+    gOpenRCT2Headless = true;
+    gOpenRCT2NoGraphics = true;
+
+    auto context = CreateContext();
+    bool initialised = context->Initialise();
+    ASSERT_TRUE(initialised);
+
+    GetContext()->LoadParkFromFile(TestData::GetParkPath("small_park_with_ferris_wheel.sv6"));
+    GameLoadInit();
+
+    auto gs = context->GetGameState();
+    ASSERT_NE(gs, nullptr);
+
+    IReplayManager* replayManager = context->GetReplayManager();
+    ASSERT_NE(replayManager, nullptr);
+
+    const auto replayFile = (fs::temp_directory_path() / "openrct2_replay_test.parkrep").string();
+    constexpr uint32_t replayTicks = 200;
+
+    ASSERT_TRUE(replayManager->StartRecording(replayFile, replayTicks));
+    while (replayManager->IsRecording())
+    {
+        gs->UpdateLogic();
+    }
+    ASSERT_TRUE(File::Exists(replayFile));
+
+    // Starting playback decompresses the info and end segments, seeking decompresses the info segment again.
+    bool startedReplay = replayManager->StartPlayback(replayFile);
+    ASSERT_TRUE(startedReplay);
+
+    ReplayRecordInfo info;
+    ASSERT_TRUE(replayManager->GetCurrentReplayInfo(info));
+    ASSERT_EQ(info.Ticks, replayTicks);
+
+    ASSERT_TRUE(replayManager->SeekPlayback(0));
+    while (replayManager->IsReplaying())
+    {
+        gs->UpdateLogic();
+        if (replayManager->IsPlaybackStateMismatching())
+            break;
+    }
+    EXPECT_FALSE(replayManager->IsReplaying());
+    EXPECT_FALSE(replayManager->IsPlaybackStateMismatching());
+
+    File::Delete(replayFile);
+}
+
+TEST(ReplayRecordingTests, SeekToKeyframe)
+{
+    gOpenRCT2Headless = true;
+    gOpenRCT2NoGraphics = true;
+
+    auto context = CreateContext();
+    bool initialised = context->Initialise();
+    ASSERT_TRUE(initialised);
+
+    GetContext()->LoadParkFromFile(TestData::GetParkPath("small_park_with_ferris_wheel.sv6"));
+    GameLoadInit();
+
+    auto gs = context->GetGameState();
+    ASSERT_NE(gs, nullptr);
+
+    IReplayManager* replayManager = context->GetReplayManager();
+    ASSERT_NE(replayManager, nullptr);
+
+    const auto replayFile = (fs::temp_directory_path() / "openrct2_replay_seek_test.parkrep").string();
+
+    // A keyframe is written every five minutes of game time, seek to shortly after the first one.
+    constexpr uint32_t seekTicks = 40 * 60 * 5 + 100;
+    constexpr uint32_t replayTicks = seekTicks + 100;
+
+    ASSERT_TRUE(replayManager->StartRecording(replayFile, replayTicks));
+    const auto tickStart = GetGameState().CurrentTicks;
+
+    // Guests coming into the park make the state differ from the start.
+    ParkSetParameterAction openPark(ParkParameter::Open);
+    GameActions::Execute(&openPark);
+
+    EntitiesChecksum recordedChecksum{};
+    money64 recordedCash{};
+    uint32_t recordedNumGuests{};
+    while (replayManager->IsRecording())
+    {
+        if (GetGameState().CurrentTicks == tickStart + seekTicks)
+        {
+            recordedChecksum = GetAllEntitiesChecksum();
+            recordedCash = GetGameState().Cash;
+            recordedNumGuests = GetGameState().NumGuestsInPark;
+        }
+        gs->UpdateLogic();
+    }
+    ASSERT_GT(recordedNumGuests, 0u);
+
+    ASSERT_TRUE(replayManager->StartPlayback(replayFile));
+    ASSERT_TRUE(replayManager->SeekPlayback(seekTicks));
+    ASSERT_EQ(GetGameState().CurrentTicks, tickStart + seekTicks);
+    EXPECT_EQ(GetAllEntitiesChecksum().raw, recordedChecksum.raw);
+    EXPECT_EQ(GetGameState().Cash, recordedCash);
+    EXPECT_EQ(GetGameState().NumGuestsInPark, recordedNumGuests);
+
+    // The rest of the replay still matches what was recorded.
+    while (replayManager->IsReplaying())
+    {
+        gs->UpdateLogic();
+        if (replayManager->IsPlaybackStateMismatching())
+            break;
+    }
+    EXPECT_FALSE(replayManager->IsReplaying());
+    EXPECT_FALSE(replayManager->IsPlaybackStateMismatching());
+
+    File::Delete(replayFile);
+}
+
 static void PrintTo(const ReplayTestData& testData, std::ostream* os)
 {
     *os << testData.filePath;
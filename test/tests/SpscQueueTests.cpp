@@ -0,0 +1,77 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2024 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+#include <gtest/gtest.h>
+#include <memory>
+#include <openrct2/core/SpscQueue.h>
+#include <thread>
+#include <vector>
+
+TEST(SpscQueueTest, PushPop)
+{
+    SpscQueue<int> queue;
+    ASSERT_TRUE(queue.Empty());
+
+    int value = 0;
+    ASSERT_FALSE(queue.TryPop(value));
+
+    queue.Push(1);
+    queue.Push(2);
+    ASSERT_FALSE(queue.Empty());
+
+    ASSERT_TRUE(queue.TryPop(value));
+    ASSERT_EQ(value, 1);
+    ASSERT_TRUE(queue.TryPop(value));
+    ASSERT_EQ(value, 2);
+    ASSERT_FALSE(queue.TryPop(value));
+    ASSERT_TRUE(queue.Empty());
+}
+
+TEST(SpscQueueTest, MoveOnly)
+{
+    SpscQueue<std::unique_ptr<int>> queue;
+    queue.Push(std::make_unique<int>(5));
+    queue.Push(std::make_unique<int>(6));
+
+    std::unique_ptr<int> value;
+    ASSERT_TRUE(queue.TryPop(value));
+    ASSERT_EQ(*value, 5);
+
+    // Remaining item is released with the queue.
+}
+
+TEST(SpscQueueTest, Threaded)
+{
+    constexpr int kCount = 100000;
+
+    SpscQueue<int> queue;
+    std::thread producer([&queue]() {
+        for (int i = 0; i < kCount; i++)
+        {
+            queue.Push(int{ i });
+        }
+    });
+
+    // Only assert once the producer has been joined, a fatal failure while it is still running would abort the test.
+    std::vector<int> values;
+    values.reserve(kCount);
+    while (values.size() < static_cast<size_t>(kCount))
+    {
+        int value;
+        if (queue.TryPop(value))
+        {
+            values.push_back(value);
+        }
+    }
+    producer.join();
+    ASSERT_TRUE(queue.Empty());
+    for (int i = 0; i < kCount; i++)
+    {
+        ASSERT_EQ(values[i], i);
+    }
+}
@@ -0,0 +1,126 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2024 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#include <gtest/gtest.h>
+#include <openrct2/world/Map.h>
+#include <openrct2/world/TileChangeJournal.h>
+#include <vector>
+
+// Starts out with the whole map marked, take that first so single tiles are recorded.
+static void TakeInitialChanges(TileChangeJournal& journal)
+{
+    std::vector<TileCoordsXY> tiles;
+    ASSERT_TRUE(journal.TakeChanges(tiles));
+    ASSERT_TRUE(tiles.empty());
+}
+
+TEST(TileChangeJournalTest, StartsWithAll)
+{
+    TileChangeJournal journal;
+    std::vector<TileCoordsXY> tiles;
+    ASSERT_TRUE(journal.TakeChanges(tiles));
+    ASSERT_FALSE(journal.TakeChanges(tiles));
+    ASSERT_TRUE(tiles.empty());
+}
+
+TEST(TileChangeJournalTest, MarkTile)
+{
+    TileChangeJournal journal;
+    TakeInitialChanges(journal);
+
+    journal.MarkTile({ 3, 4 });
+    journal.MarkTile({ 10, 2 });
+    journal.MarkTile({ 3, 4 });
+
+    std::vector<TileCoordsXY> tiles;
+    ASSERT_FALSE(journal.TakeChanges(tiles));
+    ASSERT_EQ(tiles, (std::vector<TileCoordsXY>{ { 3, 4 }, { 10, 2 } }));
+}
+
+TEST(TileChangeJournalTest, TakeChangesResets)
+{
+    TileChangeJournal journal;
+    TakeInitialChanges(journal);
+
+    journal.MarkTile({ 3, 4 });
+    std::vector<TileCoordsXY> tiles;
+    ASSERT_FALSE(journal.TakeChanges(tiles));
+    ASSERT_EQ(tiles.size(), 1u);
+
+    ASSERT_FALSE(journal.TakeChanges(tiles));
+    ASSERT_TRUE(tiles.empty());
+
+    // A tile that was taken can be recorded again.
+    journal.MarkTile({ 3, 4 });
+    ASSERT_FALSE(journal.TakeChanges(tiles));
+    ASSERT_EQ(tiles, (std::vector<TileCoordsXY>{ { 3, 4 } }));
+}
+
+TEST(TileChangeJournalTest, OutOfRangeIgnored)
+{
+    TileChangeJournal journal;
+    TakeInitialChanges(journal);
+
+    journal.MarkTile({ -1, 0 });
+    journal.MarkTile({ 0, MAXIMUM_MAP_SIZE_TECHNICAL });
+
+    std::vector<TileCoordsXY> tiles;
+    ASSERT_FALSE(journal.TakeChanges(tiles));
+    ASSERT_TRUE(tiles.empty());
+}
+
+TEST(TileChangeJournalTest, MarkAll)
+{
+    TileChangeJournal journal;
+    TakeInitialChanges(journal);
+
+    journal.MarkTile({ 3, 4 });
+    journal.MarkAll();
+    journal.MarkTile({ 5, 6 });
+
+    std::vector<TileCoordsXY> tiles;
+    ASSERT_TRUE(journal.TakeChanges(tiles));
+    ASSERT_TRUE(tiles.empty());
+
+    // The tiles recorded before are not reported again.
+    ASSERT_FALSE(journal.TakeChanges(tiles));
+    ASSERT_TRUE(tiles.empty());
+}
+
+TEST(TileChangeJournalTest, OverflowMarksAll)
+{
+    TileChangeJournal journal;
+    TakeInitialChanges(journal);
+
+    for (size_t i = 0; i < TileChangeJournal::MaxTiles; i++)
+    {
+        const auto x = static_cast<int32_t>(i % MAXIMUM_MAP_SIZE_TECHNICAL);
+        const auto y = static_cast<int32_t>(i / MAXIMUM_MAP_SIZE_TECHNICAL);
+        journal.MarkTile({ x, y });
+    }
+
+    std::vector<TileCoordsXY> tiles;
+    ASSERT_FALSE(journal.TakeChanges(tiles));
+    ASSERT_EQ(tiles.size(), TileChangeJournal::MaxTiles);
+
+    for (size_t i = 0; i <= TileChangeJournal::MaxTiles; i++)
+    {
+        const auto x = static_cast<int32_t>(i % MAXIMUM_MAP_SIZE_TECHNICAL);
+        const auto y = static_cast<int32_t>(i / MAXIMUM_MAP_SIZE_TECHNICAL);
+        journal.MarkTile({ x, y });
+    }
+
+    ASSERT_TRUE(journal.TakeChanges(tiles));
+    ASSERT_TRUE(tiles.empty());
+
+    // Tiles recorded before the overflow are cleared as well.
+    journal.MarkTile({ 0, 0 });
+    ASSERT_FALSE(journal.TakeChanges(tiles));
+    ASSERT_EQ(tiles, (std::vector<TileCoordsXY>{ { 0, 0 } }));
+}
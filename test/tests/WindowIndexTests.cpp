@@ -0,0 +1,211 @@
+/*****************************************************************************
+ * Copyright (c) 2014-2024 OpenRCT2 developers
+ *
+ * For a complete list of all authors, please refer to contributors.md
+ * Interested in contributing? Visit https://github.com/OpenRCT2/OpenRCT2
+ *
+ * OpenRCT2 is licensed under the GNU General Public License version 3.
+ *****************************************************************************/
+
+#include <gtest/gtest.h>
+#include <memory>
+#include <openrct2/interface/Window.h>
+#include <openrct2/interface/Window_internal.h>
+#include <vector>
+
+class WindowIndexTests : public testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        g_window_list.clear();
+        WindowListChanged();
+    }
+
+    void TearDown() override
+    {
+        g_window_list.clear();
+        WindowListChanged();
+    }
+
+    // Adds the window to the list like WindowCreate does.
+    static WindowBase* OpenWindow(WindowClass cls, rct_windownumber number, uint16_t flags = 0)
+    {
+        auto w = std::make_shared<WindowBase>();
+        w->classification = cls;
+        w->number = number;
+        w->flags = flags;
+
+        auto itDestPos = g_window_list.end();
+        if (flags & WF_STICK_TO_BACK)
+        {
+            itDestPos = g_window_list.begin();
+        }
+        else if (!(flags & WF_STICK_TO_FRONT))
+        {
+            for (auto it = g_window_list.rbegin(); it != g_window_list.rend(); it++)
+            {
+                if (!((*it)->flags & WF_STICK_TO_FRONT))
+                {
+                    itDestPos = it.base();
+                    break;
+                }
+            }
+        }
+        auto* result = g_window_list.insert(itDestPos, std::move(w))->get();
+        WindowListChanged();
+        return result;
+    }
+
+    static WindowBase* ScanByClass(WindowClass cls)
+    {
+        for (auto& w : g_window_list)
+        {
+            if (!(w->flags & WF_DEAD) && w->classification == cls)
+                return w.get();
+        }
+        return nullptr;
+    }
+
+    static WindowBase* ScanByNumber(WindowClass cls, rct_windownumber number)
+    {
+        for (auto& w : g_window_list)
+        {
+            if (!(w->flags & WF_DEAD) && w->classification == cls && w->number == number)
+                return w.get();
+        }
+        return nullptr;
+    }
+
+    // The lookups have to find the same windows as going through the list in order.
+    static void ExpectMatchesScan()
+    {
+        for (auto cls : { WindowClass::MainWindow, WindowClass::Ride, WindowClass::Peep, WindowClass::Error })
+        {
+            EXPECT_EQ(WindowFindByClass(cls), ScanByClass(cls)) << "class " << static_cast<int32_t>(cls);
+            for (rct_windownumber number = 0; number < 8; number++)
+            {
+                EXPECT_EQ(WindowFindByNumber(cls, number), ScanByNumber(cls, number))
+                    << "class " << static_cast<int32_t>(cls) << ", number " << number;
+            }
+        }
+        EXPECT_EQ(WindowGetMain(), ScanByClass(WindowClass::MainWindow));
+    }
+};
+
+TEST_F(WindowIndexTests, Open)
+{
+    ASSERT_EQ(WindowFindByClass(WindowClass::Ride), nullptr);
+    ASSERT_EQ(WindowGetMain(), nullptr);
+
+    auto* main = OpenWindow(WindowClass::MainWindow, 0, WF_STICK_TO_BACK);
+    auto* ride1 = OpenWindow(WindowClass::Ride, 1);
+    ExpectMatchesScan();
+    ASSERT_EQ(WindowGetMain(), main);
+    ASSERT_EQ(WindowFindByNumber(WindowClass::Ride, 1), ride1);
+
+    // Windows opened after the index was used are found as well.
+    auto* ride2 = OpenWindow(WindowClass::Ride, 2);
+    auto* peep = OpenWindow(WindowClass::Peep, 1);
+    ExpectMatchesScan();
+    ASSERT_EQ(WindowFindByClass(WindowClass::Ride), ride1);
+    ASSERT_EQ(WindowFindByNumber(WindowClass::Ride, 2), ride2);
+    ASSERT_EQ(WindowFindByNumber(WindowClass::Peep, 1), peep);
+    ASSERT_EQ(WindowFindByNumber(WindowClass::Peep, 2), nullptr);
+}
+
+TEST_F(WindowIndexTests, NumberSetAfterOpen)
+{
+    // Windows are given their number in OnOpen, after they were added to the list.
+    auto* ride = OpenWindow(WindowClass::Ride, 0);
+    ASSERT_EQ(WindowFindByNumber(WindowClass::Ride, 0), ride);
+
+    ride->number = 3;
+    ASSERT_EQ(WindowFindByNumber(WindowClass::Ride, 3), ride);
+    ASSERT_EQ(WindowFindByNumber(WindowClass::Ride, 0), nullptr);
+    ExpectMatchesScan();
+}
+
+TEST_F(WindowIndexTests, Close)
+{
+    auto* ride1 = OpenWindow(WindowClass::Ride, 1);
+    auto* ride2 = OpenWindow(WindowClass::Ride, 2);
+    OpenWindow(WindowClass::Peep, 1);
+    ExpectMatchesScan();
+
+    // Closed windows are not found, before and after they are removed from the list.
+    WindowClose(*ride1);
+    ExpectMatchesScan();
+    ASSERT_EQ(WindowFindByClass(WindowClass::Ride), ride2);
+    ASSERT_EQ(WindowFindByNumber(WindowClass::Ride, 1), nullptr);
+
+    WindowFlushDead();
+    ASSERT_EQ(g_window_list.size(), 2u);
+    ExpectMatchesScan();
+
+    WindowClose(*ride2);
+    WindowFlushDead();
+    ExpectMatchesScan();
+    ASSERT_EQ(WindowFindByClass(WindowClass::Ride), nullptr);
+
+    // A new window with the number of a closed one.
+    auto* reopened = OpenWindow(WindowClass::Ride, 1);
+    ExpectMatchesScan();
+    ASSERT_EQ(WindowFindByNumber(WindowClass::Ride, 1), reopened);
+}
+
+TEST_F(WindowIndexTests, CloseDuringVisit)
+{
+    OpenWindow(WindowClass::Ride, 1);
+    OpenWindow(WindowClass::Peep, 1);
+    OpenWindow(WindowClass::Ride, 2);
+
+    // Windows closed while visiting stay in the list until the visit is over.
+    std::vector<WindowBase*> visited;
+    WindowVisitEach([&visited](WindowBase* w) {
+        visited.push_back(w);
+        if (w->classification == WindowClass::Ride)
+        {
+            WindowClose(*w);
+            WindowFlushDead();
+        }
+        if (w->classification == WindowClass::Peep)
+        {
+            OpenWindow(WindowClass::Error, 0);
+        }
+    });
+    ASSERT_EQ(visited.size(), 3u);
+    ASSERT_EQ(g_window_list.size(), 4u);
+    ExpectMatchesScan();
+
+    WindowFlushDead();
+    ASSERT_EQ(g_window_list.size(), 2u);
+    ExpectMatchesScan();
+    ASSERT_EQ(WindowFindByClass(WindowClass::Ride), nullptr);
+    ASSERT_NE(WindowFindByClass(WindowClass::Error), nullptr);
+}
+
+TEST_F(WindowIndexTests, BringToFront)
+{
+    auto* main = OpenWindow(WindowClass::MainWindow, 0, WF_STICK_TO_BACK);
+    auto* ride1 = OpenWindow(WindowClass::Ride, 1);
+    auto* ride2 = OpenWindow(WindowClass::Ride, 2);
+    OpenWindow(WindowClass::Peep, 1, WF_STICK_TO_FRONT);
+    ExpectMatchesScan();
+    ASSERT_EQ(WindowFindByClass(WindowClass::Ride), ride1);
+
+    // The window furthest back is found first.
+    WindowBringToFront(*ride1);
+    ExpectMatchesScan();
+    ASSERT_EQ(WindowFindByClass(WindowClass::Ride), ride2);
+    ASSERT_EQ(WindowFindByNumber(WindowClass::Ride, 1), ride1);
+
+    WindowBringToFrontByNumber(WindowClass::Ride, 2);
+    ExpectMatchesScan();
+    ASSERT_EQ(WindowFindByClass(WindowClass::Ride), ride1);
+
+    // Windows that stick to the back are not moved.
+    WindowBringToFront(*main);
+    ASSERT_EQ(g_window_list.front().get(), main);
+    ExpectMatchesScan();
+}